@@ -10,57 +10,68 @@ CREATE TABLE IF NOT EXISTS `scene` (
   `label` varchar(255) DEFAULT NULL,
   `description` longtext NOT NULL,
   `terrain` varchar(255) NOT NULL,
+  `view_distance` float NOT NULL DEFAULT '128',
   PRIMARY KEY (`id`)
 ) ENGINE=InnoDB AUTO_INCREMENT=45 DEFAULT CHARSET=latin1;
 
+-- Galaxies created before the view distance was added don't have the column yet.
+SET @add_view_distance = IF(
+    (SELECT COUNT(*) FROM information_schema.COLUMNS
+        WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = 'scene' AND COLUMN_NAME = 'view_distance') = 0,
+    'ALTER TABLE `scene` ADD COLUMN `view_distance` float NOT NULL DEFAULT ''128'' AFTER `terrain`',
+    'DO 0');
+PREPARE add_view_distance FROM @add_view_distance;
+EXECUTE add_view_distance;
+DEALLOCATE PREPARE add_view_distance;
+
 DELETE FROM `scene`;
     
 /*!40000 ALTER TABLE `scene` DISABLE KEYS */;
-INSERT INTO `scene` (`id`, `name`, `label`, `description`, `terrain`) VALUES
-	(1, 'corellia', 'corellia', '', 'terrain/corellia.trn'),
-	(2, 'dantooine', 'dantooine', '', 'terrain/dantooine.trn'),
-	(3, 'dathomir', 'dathomir', '', 'terrain/dathomir.trn'),
-	(4, 'endor', 'endor', '', 'terrain/endor.trn'),
-	(5, 'lok', 'lok', '', 'terrain/lok.trn'),
-	(6, 'naboo', 'naboo', '', 'terrain/naboo.trn'),
-	(7, 'rori', 'rori', '', 'terrain/rori.trn'),
-	(8, 'talus', 'talus', '', 'terrain/talus.trn'),
-	(9, 'tatooine', 'tatooine', '', 'terrain/tatooine.trn'),
-	(10, 'yavin4', 'yavin4', '', 'terrain/yavin4.trn'),
-	(11, 'space_corellia', 'space_corellia', '', 'terrain/space_corellia.trn'),
-	(12, 'space_corellia_2', 'space_corellia_2', '', 'terrain/space_corellia_2.trn'),
-	(13, 'space_dantooine', 'space_dantooine', '', 'terrain/space_dantooine.trn'),
-	(14, 'space_dathomir', 'space_dathomir', '', 'terrain/space_dathomir.trn'),
-	(15, 'space_endor', 'space_endor', '', 'terrain/space_endor.trn'),
-	(16, 'space_env', 'space_env', '', 'terrain/space_env.trn'),
-	(17, 'space_halos', 'space_halos', '', 'terrain/space_halos.trn'),
-	(18, 'space_heavy1', 'space_heavy1', '', 'terrain/space_heavy1.trn'),
-	(19, 'space_light1', 'space_light1', '', 'terrain/space_light1.trn'),
-	(20, 'space_lok', 'space_lok', '', 'terrain/space_lok.trn'),
-	(21, 'space_naboo', 'space_naboo', '', 'terrain/space_naboo.trn'),
-	(22, 'space_naboo_2', 'space_naboo_2', '', 'terrain/space_naboo_2.trn'),
-	(23, 'space_tatooine', 'space_tatooine', '', 'terrain/space_tatooine.trn'),
-	(24, 'space_tatooine_2', 'space_tatooine_2', '', 'terrain/space_tatooine_2.trn'),
-	(25, 'space_yavin4', 'space_yavin4', '', 'terrain/space_yavin4.trn'),
-	(26, '09', '09', '', 'terrain/09.trn'),
-	(27, '10', '10', '', 'terrain/10.trn'),
-	(28, '11', '11', '', 'terrain/11.trn'),
-	(29, 'character_farm', 'character_farm', '', 'terrain/character_farm.trn'),
-	(30, 'cinco_city_test_m5', 'cinco_city_test_m5', '', 'terrain/cinco_city_test_m5.trn'),
-	(31, 'creature_test', 'creature_test', '', 'terrain/creature_test.trn'),
-	(32, 'dungeon1', 'dungeon1', '', 'terrain/dungeon1.trn'),
-	(33, 'endor_asommers', 'endor_asommers', '', 'terrain/endor_asommers.trn'),
-	(34, 'floratest', 'floratest', '', 'terrain/floratest.trn'),
-	(35, 'godclient_test', 'godclient_test', '', 'terrain/godclient_test.trn'),
-	(36, 'otoh_gunga', 'otoh_gunga', '', 'terrain/otoh_gunga.trn'),
-	(37, 'rivertest', 'rivertest', '', 'terrain/rivertest.trn'),
-	(38, 'runtimerules', 'runtimerules', '', 'terrain/runtimerules.trn'),
-	(39, 'simple', 'simple', '', 'terrain/simple.trn'),
-	(40, 'space_09', 'space_09', '', 'terrain/space_09.trn'),
-	(41, 'test_wearables', 'test_wearables', '', 'terrain/test_wearables.trn'),
-	(42, 'tutorial', 'tutorial', '', 'terrain/tutorial.trn'),
-	(43, 'taanab', 'taanab', '', 'terrain/taanab.trn'),
-	(44, 'dagobah', 'dagobah', '', 'terrain/dagobah.trn');
+INSERT INTO `scene` (`id`, `name`, `label`, `description`, `terrain`, `view_distance`) VALUES
+	(1, 'corellia', 'corellia', '', 'terrain/corellia.trn', 128),
+	(2, 'dantooine', 'dantooine', '', 'terrain/dantooine.trn', 128),
+	(3, 'dathomir', 'dathomir', '', 'terrain/dathomir.trn', 128),
+	(4, 'endor', 'endor', '', 'terrain/endor.trn', 128),
+	(5, 'lok', 'lok', '', 'terrain/lok.trn', 128),
+	(6, 'naboo', 'naboo', '', 'terrain/naboo.trn', 128),
+	(7, 'rori', 'rori', '', 'terrain/rori.trn', 128),
+	(8, 'talus', 'talus', '', 'terrain/talus.trn', 128),
+	(9, 'tatooine', 'tatooine', '', 'terrain/tatooine.trn', 128),
+	(10, 'yavin4', 'yavin4', '', 'terrain/yavin4.trn', 128),
+	(11, 'space_corellia', 'space_corellia', '', 'terrain/space_corellia.trn', 128),
+	(12, 'space_corellia_2', 'space_corellia_2', '', 'terrain/space_corellia_2.trn', 128),
+	(13, 'space_dantooine', 'space_dantooine', '', 'terrain/space_dantooine.trn', 128),
+	(14, 'space_dathomir', 'space_dathomir', '', 'terrain/space_dathomir.trn', 128),
+	(15, 'space_endor', 'space_endor', '', 'terrain/space_endor.trn', 128),
+	(16, 'space_env', 'space_env', '', 'terrain/space_env.trn', 128),
+	(17, 'space_halos', 'space_halos', '', 'terrain/space_halos.trn', 128),
+	(18, 'space_heavy1', 'space_heavy1', '', 'terrain/space_heavy1.trn', 128),
+	(19, 'space_light1', 'space_light1', '', 'terrain/space_light1.trn', 128),
+	(20, 'space_lok', 'space_lok', '', 'terrain/space_lok.trn', 128),
+	(21, 'space_naboo', 'space_naboo', '', 'terrain/space_naboo.trn', 128),
+	(22, 'space_naboo_2', 'space_naboo_2', '', 'terrain/space_naboo_2.trn', 128),
+	(23, 'space_tatooine', 'space_tatooine', '', 'terrain/space_tatooine.trn', 128),
+	(24, 'space_tatooine_2', 'space_tatooine_2', '', 'terrain/space_tatooine_2.trn', 128),
+	(25, 'space_yavin4', 'space_yavin4', '', 'terrain/space_yavin4.trn', 128),
+	(26, '09', '09', '', 'terrain/09.trn', 128),
+	(27, '10', '10', '', 'terrain/10.trn', 128),
+	(28, '11', '11', '', 'terrain/11.trn', 128),
+	(29, 'character_farm', 'character_farm', '', 'terrain/character_farm.trn', 128),
+	(30, 'cinco_city_test_m5', 'cinco_city_test_m5', '', 'terrain/cinco_city_test_m5.trn', 128),
+	(31, 'creature_test', 'creature_test', '', 'terrain/creature_test.trn', 128),
+	(32, 'dungeon1', 'dungeon1', '', 'terrain/dungeon1.trn', 128),
+	(33, 'endor_asommers', 'endor_asommers', '', 'terrain/endor_asommers.trn', 128),
+	(34, 'floratest', 'floratest', '', 'terrain/floratest.trn', 128),
+	(35, 'godclient_test', 'godclient_test', '', 'terrain/godclient_test.trn', 128),
+	(36, 'otoh_gunga', 'otoh_gunga', '', 'terrain/otoh_gunga.trn', 128),
+	(37, 'rivertest', 'rivertest', '', 'terrain/rivertest.trn', 128),
+	(38, 'runtimerules', 'runtimerules', '', 'terrain/runtimerules.trn', 128),
+	(39, 'simple', 'simple', '', 'terrain/simple.trn', 128),
+	(40, 'space_09', 'space_09', '', 'terrain/space_09.trn', 128),
+	(41, 'test_wearables', 'test_wearables', '', 'terrain/test_wearables.trn', 128),
+	(42, 'tutorial', 'tutorial', '', 'terrain/tutorial.trn', 128),
+	(43, 'taanab', 'taanab', '', 'terrain/taanab.trn', 128),
+	(44, 'dagobah', 'dagobah', '', 'terrain/dagobah.trn', 128);
 /*!40000 ALTER TABLE `scene` ENABLE KEYS */;
 
 /*!40101 SET SQL_MODE=@OLD_SQL_MODE */;
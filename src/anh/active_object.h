@@ -14,6 +14,7 @@
 #include <boost/thread/future.hpp>
 
 #include "anh/timing.h"
+#include "anh/timing_wheel.h"
 
 namespace anh {
 
@@ -30,7 +31,17 @@ class ActiveObject {
 public:
     explicit ActiveObject(boost::asio::io_service& io_service)
         : io_service_(io_service)
-        , strand_(io_service) {}
+        , strand_(io_service)
+        , timing_wheel_(nullptr) {}
+
+    /**
+     * Delayed messages are scheduled on the timing wheel rather than each
+     * being given a timer of its own.
+     */
+    ActiveObject(boost::asio::io_service& io_service, TimingWheel* timing_wheel)
+        : io_service_(io_service)
+        , strand_(io_service)
+        , timing_wheel_(timing_wheel) {}
     
     /**
      * Triggers an asyncronous task on the active object's strand. Returns a future
@@ -61,14 +72,27 @@ public:
     boost::unique_future<typename std::result_of<Handler()>::type>
     AsyncDelayed(boost::posix_time::time_duration period, Handler&& func) {
         auto task  = std::make_shared<boost::packaged_task<typename std::result_of<Handler()>::type>>(std::move(func));
+
+        if (timing_wheel_) {
+            // the wheel may outlive this object, so it gets a copy of the strand
+            auto strand = strand_;
+            timing_wheel_->Schedule(period, [strand, task] () mutable {
+                strand.post([task] () {
+                    (*task)();
+                });
+            });
+
+            return task->get_future();
+        }
+
         auto timer = std::make_shared<boost::asio::deadline_timer>(io_service_);
         
         timer->expires_from_now(period);
-        timer->async_wait([task, timer] (const boost::system::error_code& error) {
+        timer->async_wait(strand_.wrap([task, timer] (const boost::system::error_code& error) {
             if (!error) {
                 (*task)();
             }
-        });
+        }));
         
         return task->get_future();
     }
@@ -106,6 +130,7 @@ private:
 
     boost::asio::io_service& io_service_;
     boost::asio::strand strand_;
+    TimingWheel* timing_wheel_;
 };
     
 }  // namespace anh
@@ -17,6 +17,7 @@ namespace database {
 
 namespace anh {
     class EventDispatcher;
+    class TimingWheel;
 }  // namespace anh
 
 namespace anh {
@@ -65,6 +66,8 @@ public:
     
     virtual boost::asio::io_service& GetIoService() = 0;
 
+    virtual anh::TimingWheel* GetTimingWheel() = 0;
+
     virtual anh::resource::ResourceManager* GetResourceManager() = 0;
 
     // also add entity manager, blah blah.
@@ -0,0 +1,43 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_BENCHMARK_H_
+#define ANH_BENCHMARK_H_
+
+#include <cstdlib>
+
+#include <boost/test/unit_test.hpp>
+
+namespace anh {
+
+/**
+ * Benchmarks live with the unit tests they measure but only run when the
+ * SWGANH_BENCHMARKS environment variable is set, keeping the test run after each
+ * build quick. Call this first thing in a benchmark:
+ *
+ * \code
+ * BOOST_AUTO_TEST_CASE(CrcThroughput) {
+ *     if (anh::SkipBenchmark()) {
+ *         return;
+ *     }
+ *     ...
+ * \endcode
+ *
+ * @return True if the benchmark should be skipped, which is noted in the test log.
+ */
+inline bool SkipBenchmark()
+{
+    if (std::getenv("SWGANH_BENCHMARKS"))
+    {
+        return false;
+    }
+
+    BOOST_TEST_MESSAGE(boost::unit_test::framework::current_test_case().p_name.get()
+        << " skipped, set SWGANH_BENCHMARKS to run it");
+
+    return true;
+}
+
+}  // namespace anh
+
+#endif  // ANH_BENCHMARK_H_
@@ -23,7 +23,7 @@ ByteBuffer::ByteBuffer(size_t length)
 ByteBuffer::ByteBuffer(std::vector<unsigned char> data)
 : data_(std::move(data))
 , read_position_(0)
-, write_position_(data.size()) {}
+, write_position_(data_.size()) {}
 
 ByteBuffer::ByteBuffer(const unsigned char* data, size_t length)
 : data_(data, data+length)
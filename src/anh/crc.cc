@@ -3,62 +3,26 @@
 
 #include "anh/crc.h"
 
-using namespace anh;
+#include "anh/encryption.h"
 
-const uint32_t CRC_TABLE[256] = {
-    0x0000000,
-    0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B,
-    0x1A864DB2, 0x1E475005, 0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6,
-    0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
-    0x4C11DB70, 0x48D0C6C7, 0x4593E01E, 0x4152FDA9, 0x5F15ADAC,
-    0x5BD4B01B, 0x569796C2, 0x52568B75, 0x6A1936C8, 0x6ED82B7F,
-    0x639B0DA6, 0x675A1011, 0x791D4014, 0x7DDC5DA3, 0x709F7B7A,
-    0x745E66CD, 0x9823B6E0, 0x9CE2AB57, 0x91A18D8E, 0x95609039,
-    0x8B27C03C, 0x8FE6DD8B, 0x82A5FB52, 0x8664E6E5, 0xBE2B5B58,
-    0xBAEA46EF, 0xB7A96036, 0xB3687D81, 0xAD2F2D84, 0xA9EE3033,
-    0xA4AD16EA, 0xA06C0B5D, 0xD4326D90, 0xD0F37027, 0xDDB056FE,
-    0xD9714B49, 0xC7361B4C, 0xC3F706FB, 0xCEB42022, 0xCA753D95,
-    0xF23A8028, 0xF6FB9D9F, 0xFBB8BB46, 0xFF79A6F1, 0xE13EF6F4,
-    0xE5FFEB43, 0xE8BCCD9A, 0xEC7DD02D, 0x34867077, 0x30476DC0,
-    0x3D044B19, 0x39C556AE, 0x278206AB, 0x23431B1C, 0x2E003DC5,
-    0x2AC12072, 0x128E9DCF, 0x164F8078, 0x1B0CA6A1, 0x1FCDBB16,
-    0x018AEB13, 0x054BF6A4, 0x0808D07D, 0x0CC9CDCA, 0x7897AB07,
-    0x7C56B6B0, 0x71159069, 0x75D48DDE, 0x6B93DDDB, 0x6F52C06C,
-    0x6211E6B5, 0x66D0FB02, 0x5E9F46BF, 0x5A5E5B08, 0x571D7DD1,
-    0x53DC6066, 0x4D9B3063, 0x495A2DD4, 0x44190B0D, 0x40D816BA,
-    0xACA5C697, 0xA864DB20, 0xA527FDF9, 0xA1E6E04E, 0xBFA1B04B,
-    0xBB60ADFC, 0xB6238B25, 0xB2E29692, 0x8AAD2B2F, 0x8E6C3698,
-    0x832F1041, 0x87EE0DF6, 0x99A95DF3, 0x9D684044, 0x902B669D,
-    0x94EA7B2A, 0xE0B41DE7, 0xE4750050, 0xE9362689, 0xEDF73B3E,
-    0xF3B06B3B, 0xF771768C, 0xFA325055, 0xFEF34DE2, 0xC6BCF05F,
-    0xC27DEDE8, 0xCF3ECB31, 0xCBFFD686, 0xD5B88683, 0xD1799B34,
-    0xDC3ABDED, 0xD8FBA05A, 0x690CE0EE, 0x6DCDFD59, 0x608EDB80,
-    0x644FC637, 0x7A089632, 0x7EC98B85, 0x738AAD5C, 0x774BB0EB,
-    0x4F040D56, 0x4BC510E1, 0x46863638, 0x42472B8F, 0x5C007B8A,
-    0x58C1663D, 0x558240E4, 0x51435D53, 0x251D3B9E, 0x21DC2629,
-    0x2C9F00F0, 0x285E1D47, 0x36194D42, 0x32D850F5, 0x3F9B762C,
-    0x3B5A6B9B, 0x0315D626, 0x07D4CB91, 0x0A97ED48, 0x0E56F0FF,
-    0x1011A0FA, 0x14D0BD4D, 0x19939B94, 0x1D528623, 0xF12F560E,
-    0xF5EE4BB9, 0xF8AD6D60, 0xFC6C70D7, 0xE22B20D2, 0xE6EA3D65,
-    0xEBA91BBC, 0xEF68060B, 0xD727BBB6, 0xD3E6A601, 0xDEA580D8,
-    0xDA649D6F, 0xC423CD6A, 0xC0E2D0DD, 0xCDA1F604, 0xC960EBB3,
-    0xBD3E8D7E, 0xB9FF90C9, 0xB4BCB610, 0xB07DABA7, 0xAE3AFBA2,
-    0xAAFBE615, 0xA7B8C0CC, 0xA379DD7B, 0x9B3660C6, 0x9FF77D71,
-    0x92B45BA8, 0x9675461F, 0x8832161A, 0x8CF30BAD, 0x81B02D74,
-    0x857130C3, 0x5D8A9099, 0x594B8D2E, 0x5408ABF7, 0x50C9B640,
-    0x4E8EE645, 0x4A4FFBF2, 0x470CDD2B, 0x43CDC09C, 0x7B827D21,
-    0x7F436096, 0x7200464F, 0x76C15BF8, 0x68860BFD, 0x6C47164A,
-    0x61043093, 0x65C52D24, 0x119B4BE9, 0x155A565E, 0x18197087,
-    0x1CD86D30, 0x029F3D35, 0x065E2082, 0x0B1D065B, 0x0FDC1BEC,
-    0x3793A651, 0x3352BBE6, 0x3E119D3F, 0x3AD08088, 0x2497D08D,
-    0x2056CD3A, 0x2D15EBE3, 0x29D4F654, 0xC5A92679, 0xC1683BCE,
-    0xCC2B1D17, 0xC8EA00A0, 0xD6AD50A5, 0xD26C4D12, 0xDF2F6BCB,
-    0xDBEE767C, 0xE3A1CBC1, 0xE760D676, 0xEA23F0AF, 0xEEE2ED18,
-    0xF0A5BD1D, 0xF464A0AA, 0xF9278673, 0xFDE69BC4, 0x89B8FD09,
-    0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662,
-    0x933EB0BB, 0x97FFAD0C, 0xAFB010B1, 0xAB710D06, 0xA6322BDF,
-    0xA2F33668, 0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4,
-};
+// carry-less multiplication is only built where the compiler can target it per
+// function, whether the cpu has it is checked at runtime
+#if defined(ANH_ENCRYPTION_SSE2) && \
+    (defined(_MSC_VER) || defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define ANH_CRC_CLMUL
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define ANH_CRC_CLMUL_TARGET
+#else
+#include <cpuid.h>
+#define ANH_CRC_CLMUL_TARGET __attribute__((target("pclmul")))
+#endif
+
+#include <wmmintrin.h>
+#endif
+
+using namespace anh;
 
 const uint32_t CRC_ZIP_TABLE[256] = {
   0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
@@ -106,14 +70,395 @@ const uint32_t CRC_ZIP_TABLE[256] = {
   0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
-uint32_t anh::memcrc(const char* source_string, uint32_t length) 
+namespace {
+
+typedef uint32_t (*CrcUpdate)(uint32_t crc, const unsigned char* buffer, uint32_t length);
+typedef uint32_t (*EncryptAndCrcUpdate)(uint32_t crc, unsigned char* buffer, uint32_t length, uint32_t seed);
+
+// tables[k][i] is the checksum of byte i followed by k zero bytes, which lets
+// slicing by 8 look up all 8 bytes of a block independently
+struct SlicingTables
+{
+    uint32_t cksum[8][256];
+    uint32_t zip[8][256];
+
+    SlicingTables()
+    {
+        const uint32_t* cksum_table = detail::CrcTable<void>::values;
+
+        for (uint32_t i = 0; i < 256; ++i) {
+            cksum[0][i] = cksum_table[i];
+            zip[0][i] = CRC_ZIP_TABLE[i];
+        }
+
+        for (uint32_t k = 1; k < 8; ++k) {
+            for (uint32_t i = 0; i < 256; ++i) {
+                cksum[k][i] = cksum_table[cksum[k - 1][i] >> 24] ^ (cksum[k - 1][i] << 8);
+                zip[k][i] = CRC_ZIP_TABLE[zip[k - 1][i] & 0xff] ^ (zip[k - 1][i] >> 8);
+            }
+        }
+    }
+};
+
+const SlicingTables& GetSlicingTables()
+{
+    static SlicingTables tables;
+    return tables;
+}
+
+// the cksum checksum shifts bytes in from the top, so blocks are read big endian
+inline uint32_t LoadBigEndian(const unsigned char* buffer)
+{
+    return (uint32_t(buffer[0]) << 24) | (uint32_t(buffer[1]) << 16) | (uint32_t(buffer[2]) << 8) | buffer[3];
+}
+
+// and the zip checksum shifts them in from the bottom
+inline uint32_t LoadLittleEndian(const unsigned char* buffer)
+{
+    return buffer[0] | (uint32_t(buffer[1]) << 8) | (uint32_t(buffer[2]) << 16) | (uint32_t(buffer[3]) << 24);
+}
+
+uint32_t UpdateCksumBytewise(uint32_t crc, const unsigned char* buffer, uint32_t length)
+{
+    const uint32_t* crc_table = detail::CrcTable<void>::values;
+
+    for (uint32_t i = 0; i < length; ++i) {
+        crc = crc_table[buffer[i] ^ (crc >> 24)] ^ (crc << 8);
+    }
+
+    return crc;
+}
+
+uint32_t UpdateCksumSliceBy8(uint32_t crc, const unsigned char* buffer, uint32_t length)
+{
+    const uint32_t (*tables)[256] = GetSlicingTables().cksum;
+
+    for (; length >= 8; buffer += 8, length -= 8) {
+        uint32_t high = LoadBigEndian(buffer) ^ crc;
+        uint32_t low = LoadBigEndian(buffer + 4);
+
+        crc = tables[7][high >> 24] ^ tables[6][(high >> 16) & 0xff] ^
+              tables[5][(high >> 8) & 0xff] ^ tables[4][high & 0xff] ^
+              tables[3][low >> 24] ^ tables[2][(low >> 16) & 0xff] ^
+              tables[1][(low >> 8) & 0xff] ^ tables[0][low & 0xff];
+    }
+
+    return UpdateCksumBytewise(crc, buffer, length);
+}
+
+uint32_t UpdateZipBytewise(uint32_t crc, const unsigned char* buffer, uint32_t length)
 {
-    uint32_t crc = 0xffffffff;  // starting seed
     for (uint32_t i = 0; i < length; ++i) {
-        crc = CRC_TABLE[source_string[i] ^ (crc >> 24)] ^ (crc << 8);
+        crc = CRC_ZIP_TABLE[(buffer[i] ^ crc) & 0xff] ^ (crc >> 8);
     }
 
-    return ~crc;
+    return crc;
+}
+
+// checksums the next 8 bytes of the buffer
+inline uint32_t SliceZipBlock(const uint32_t (*tables)[256], uint32_t crc, const unsigned char* block)
+{
+    uint32_t low = LoadLittleEndian(block) ^ crc;
+    uint32_t high = LoadLittleEndian(block + 4);
+
+    return tables[7][low & 0xff] ^ tables[6][(low >> 8) & 0xff] ^
+           tables[5][(low >> 16) & 0xff] ^ tables[4][low >> 24] ^
+           tables[3][high & 0xff] ^ tables[2][(high >> 8) & 0xff] ^
+           tables[1][(high >> 16) & 0xff] ^ tables[0][high >> 24];
+}
+
+uint32_t UpdateZipSliceBy8(uint32_t crc, const unsigned char* buffer, uint32_t length)
+{
+    const uint32_t (*tables)[256] = GetSlicingTables().zip;
+
+    for (; length >= 8; buffer += 8, length -= 8) {
+        crc = SliceZipBlock(tables, crc, buffer);
+    }
+
+    return UpdateZipBytewise(crc, buffer, length);
+}
+
+// Encrypts and checksums 8 bytes at a time, each block being checksummed straight
+// after it's written.
+uint32_t EncryptAndUpdateZipSliceBy8(uint32_t crc, unsigned char* buffer, uint32_t length, uint32_t seed)
+{
+    const uint32_t (*tables)[256] = GetSlicingTables().zip;
+
+    for (; length >= 8; buffer += 8, length -= 8) {
+        seed = detail::EncryptWords(buffer, 8, seed);
+        crc = SliceZipBlock(tables, crc, buffer);
+    }
+
+    detail::EncryptWords(buffer, length, seed);
+
+    return UpdateZipBytewise(crc, buffer, length);
+}
+
+#ifdef ANH_CRC_CLMUL
+
+bool CpuHasClmul()
+{
+#ifdef _MSC_VER
+    int registers[4];
+    __cpuid(registers, 1);
+    return (registers[2] & (1 << 1)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_PCLMUL) != 0;
+#endif
+}
+
+// hands the buffer to FoldZipClmul as it is
+struct PlainBlocks
+{
+    const unsigned char* buffer;
+
+    __m128i Next()
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+        buffer += 16;
+
+        return block;
+    }
+};
+
+// encrypts the buffer in place as FoldZipClmul reads it
+struct EncryptedBlocks
+{
+    unsigned char* buffer;
+    __m128i seed;
+
+    __m128i Next()
+    {
+        __m128i block = detail::EncryptBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer)), seed);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), block);
+        buffer += 16;
+
+        return block;
+    }
+};
+
+// Folds the blocks 64 bytes at a time with carry-less multiplication and reduces
+// the remainder to the checksum, following Intel's "Fast CRC Computation for
+// Generic Polynomials Using PCLMULQDQ Instruction". The length has to be a multiple
+// of 16 and at least 64, the blocks are read in order exactly once.
+template<typename Blocks>
+ANH_CRC_CLMUL_TARGET
+uint32_t FoldZipClmul(uint32_t crc, Blocks& source, uint32_t length)
+{
+    // a local copy stays in registers, the caller's would be written back on every read
+    Blocks blocks = source;
+
+    // x^(4*128+32) mod P and x^(4*128-32) mod P, bit reflected
+    static const uint64_t k1k2[] = { 0x0154442bd4ULL, 0x01c6e41596ULL };
+    // x^(128+32) mod P and x^(128-32) mod P
+    static const uint64_t k3k4[] = { 0x01751997d0ULL, 0x00ccaa009eULL };
+    // x^64 mod P
+    static const uint64_t k5k0[] = { 0x0163cd6124ULL, 0x0000000000ULL };
+    // P and the barrett constant floor(x^64 / P)
+    static const uint64_t poly[] = { 0x01db710641ULL, 0x01f7011641ULL };
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = blocks.Next();
+    x2 = blocks.Next();
+    x3 = blocks.Next();
+    x4 = blocks.Next();
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+    x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k1k2));
+
+    // fold 4 lanes of 128 bits forward over each 64 byte block
+    for (length -= 64; length >= 64; length -= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), blocks.Next());
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), blocks.Next());
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), blocks.Next());
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), blocks.Next());
+    }
+
+    // fold the 4 lanes into one
+    x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k3k4));
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // and any remaining 16 byte blocks into that
+    for (; length >= 16; length -= 16) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, blocks.Next()), x5);
+    }
+
+    // reduce 128 bits to 64
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // and barrett reduce the 64 bits to the 32 bit checksum
+    x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(poly));
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    source = blocks;
+
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+}
+
+// Whatever is left after the last 16 byte block, and buffers too short to fold,
+// are sliced by 8.
+uint32_t UpdateZipClmul(uint32_t crc, const unsigned char* buffer, uint32_t length)
+{
+    if (length < 64) {
+        return UpdateZipSliceBy8(crc, buffer, length);
+    }
+
+    PlainBlocks blocks = { buffer };
+    crc = FoldZipClmul(crc, blocks, length & ~15u);
+
+    return UpdateZipSliceBy8(crc, blocks.buffer, length & 15);
+}
+
+uint32_t EncryptAndUpdateZipClmul(uint32_t crc, unsigned char* buffer, uint32_t length, uint32_t seed)
+{
+    if (length < 64) {
+        return EncryptAndUpdateZipSliceBy8(crc, buffer, length, seed);
+    }
+
+    EncryptedBlocks blocks = { buffer, _mm_set1_epi32(static_cast<int>(seed)) };
+    crc = FoldZipClmul(crc, blocks, length & ~15u);
+
+    detail::EncryptWords(blocks.buffer, length & 15, static_cast<uint32_t>(_mm_cvtsi128_si32(blocks.seed)));
+
+    return UpdateZipSliceBy8(crc, blocks.buffer, length & 15);
+}
+
+#endif  // ANH_CRC_CLMUL
+
+CrcUpdate GetZipUpdate(detail::CrcMethod method)
+{
+    switch (method) {
+#ifdef ANH_CRC_CLMUL
+    case detail::CRC_CLMUL:
+        return UpdateZipClmul;
+#endif
+    case detail::CRC_SLICE_BY_8:
+        return UpdateZipSliceBy8;
+    default:
+        return UpdateZipBytewise;
+    }
+}
+
+// encrypts the whole buffer before checksumming any of it, the way the filters used to
+uint32_t EncryptAndUpdateZipBytewise(uint32_t crc, unsigned char* buffer, uint32_t length, uint32_t seed)
+{
+    EncryptXorChain(buffer, length, seed);
+
+    return UpdateZipBytewise(crc, buffer, length);
+}
+
+EncryptAndCrcUpdate GetZipEncryptAndUpdate(detail::CrcMethod method)
+{
+    switch (method) {
+#ifdef ANH_CRC_CLMUL
+    case detail::CRC_CLMUL:
+        return EncryptAndUpdateZipClmul;
+#endif
+    case detail::CRC_SLICE_BY_8:
+        return EncryptAndUpdateZipSliceBy8;
+    default:
+        return EncryptAndUpdateZipBytewise;
+    }
+}
+
+// the seed is checksummed as the first 4 bytes of the buffer
+uint32_t SeedZipCrc(uint32_t seed)
+{
+    const unsigned char seed_bytes[] = {
+        static_cast<unsigned char>(seed),
+        static_cast<unsigned char>(seed >> 8),
+        static_cast<unsigned char>(seed >> 16),
+        static_cast<unsigned char>(seed >> 24)
+    };
+
+    return UpdateZipBytewise(0xffffffff, seed_bytes, sizeof(seed_bytes));
+}
+
+}  // namespace
+
+bool detail::IsCrcMethodSupported(CrcMethod method)
+{
+#ifdef ANH_CRC_CLMUL
+    static const bool has_clmul = CpuHasClmul();
+#else
+    static const bool has_clmul = false;
+#endif
+
+    return method != CRC_CLMUL || has_clmul;
+}
+
+uint32_t detail::memcrc(const char* source_string, uint32_t length, CrcMethod method)
+{
+    const unsigned char* buffer = reinterpret_cast<const unsigned char*>(source_string);
+
+    if (method == CRC_BYTEWISE) {
+        return ~UpdateCksumBytewise(0xffffffff, buffer, length);
+    }
+
+    return ~UpdateCksumSliceBy8(0xffffffff, buffer, length);
+}
+
+uint32_t detail::memcrc(const unsigned char* src_buffer, uint32_t length, uint32_t seed, CrcMethod method)
+{
+    return ~GetZipUpdate(method)(SeedZipCrc(seed), src_buffer, length);
+}
+
+uint32_t detail::EncryptXorChainAndCrc(
+    unsigned char* buffer,
+    uint32_t length,
+    uint32_t encrypt_offset,
+    uint32_t seed,
+    CrcMethod method)
+{
+    uint32_t crc = UpdateZipBytewise(SeedZipCrc(seed), buffer, encrypt_offset);
+
+    return ~GetZipEncryptAndUpdate(method)(crc, buffer + encrypt_offset, length - encrypt_offset, seed);
+}
+
+uint32_t anh::memcrc(const char* source_string, uint32_t length) 
+{
+    return ~UpdateCksumSliceBy8(0xffffffff, reinterpret_cast<const unsigned char*>(source_string), length);
 }
 
 uint32_t anh::memcrc(const std::string& source_string) 
@@ -123,26 +468,17 @@ uint32_t anh::memcrc(const std::string& source_string)
 
 uint32_t anh::memcrc(const unsigned char* src_buffer, uint32_t length, uint32_t seed)
 {
-	uint32_t newCRC = 0, index = 0;
-
-    newCRC = CRC_ZIP_TABLE[(~seed) & 0xFF];
-    newCRC ^= 0x00FFFFFF;
-    index = (seed >> 8) ^ newCRC;
-    newCRC = (newCRC >> 8) & 0x00FFFFFF;
-    newCRC ^= CRC_ZIP_TABLE[index & 0xFF];
-    index = (seed >> 16) ^ newCRC;
-    newCRC = (newCRC >> 8) & 0x00FFFFFF;
-    newCRC ^= CRC_ZIP_TABLE[index & 0xFF];
-    index = (seed >> 24) ^ newCRC;
-    newCRC = (newCRC >> 8) &0x00FFFFFF;
-    newCRC ^= CRC_ZIP_TABLE[index & 0xFF];
-
-    for(uint32_t i = 0; i < length; i++ )
-    {
-        index = (src_buffer[i]) ^ newCRC;
-        newCRC = (newCRC >> 8) & 0x00FFFFFF;
-        newCRC ^= CRC_ZIP_TABLE[index & 0xFF];
-    }
+    // picked once, this runs for every packet in and out
+    static const CrcUpdate update = GetZipUpdate(
+        detail::IsCrcMethodSupported(detail::CRC_CLMUL) ? detail::CRC_CLMUL : detail::CRC_SLICE_BY_8);
 
-    return ~newCRC;
-}
\ No newline at end of file
+    return ~update(SeedZipCrc(seed), src_buffer, length);
+}
+
+uint32_t anh::EncryptXorChainAndCrc(unsigned char* buffer, uint32_t length, uint32_t encrypt_offset, uint32_t seed)
+{
+    static const detail::CrcMethod method =
+        detail::IsCrcMethodSupported(detail::CRC_CLMUL) ? detail::CRC_CLMUL : detail::CRC_SLICE_BY_8;
+
+    return detail::EncryptXorChainAndCrc(buffer, length, encrypt_offset, seed, method);
+}
@@ -1,11 +1,57 @@
 // This file is part of SWGANH which is released under the MIT license.
 // See file LICENSE or go to http://swganh.com/LICENSE
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <boost/chrono.hpp>
 #include <boost/test/unit_test.hpp>
+#include <zlib.h>
 
+#include "anh/benchmark.h"
 #include "anh/crc.h"
 
 using anh::memcrc;
+using anh::detail::CrcMethod;
+using anh::detail::CRC_BYTEWISE;
+using anh::detail::CRC_SLICE_BY_8;
+using anh::detail::CRC_CLMUL;
+using anh::detail::IsCrcMethodSupported;
+
+namespace {
+
+const CrcMethod all_methods[] = { CRC_BYTEWISE, CRC_SLICE_BY_8, CRC_CLMUL };
+
+std::vector<unsigned char> RandomBuffer(uint32_t length) {
+    std::vector<unsigned char> buffer(length);
+
+    uint32_t state = 0x12345678;
+    for (auto& byte : buffer) {
+        state = state * 1103515245 + 12345;
+        byte = static_cast<unsigned char>(state >> 16);
+    }
+
+    return buffer;
+}
+
+// the encryption filter's loop before it encrypted and checksummed in one pass
+void EncryptWordByWord(char* data, uint32_t len, uint32_t seed) {
+    uint32_t blockCount = (len / 4);
+    uint32_t byteCount = (len % 4);
+
+    for(uint32_t count = 0; count < blockCount; count++) {
+        ((uint32_t*)data)[count] ^= seed;
+        seed = ((uint32_t*)data)[count];
+    }
+
+    for(uint32_t count = blockCount * 4; count < blockCount * 4 + byteCount; count++) {
+        data[count] ^= seed;
+    }
+}
+
+}  // namespace
+
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_MODULE ANH CRC
 BOOST_AUTO_TEST_SUITE(ANHCRC)
@@ -22,4 +68,221 @@ BOOST_AUTO_TEST_CASE(CanCrcStdStrings) {
     BOOST_CHECK_EQUAL(0x2643D57C, memcrc(std::string("anothertest")));
     BOOST_CHECK_EQUAL(0x19522193, memcrc(std::string("aThirdTest")));
 }
+
+/// This test shows that the checksum of a constant string is available at compile time.
+BOOST_AUTO_TEST_CASE(CanCrcConstantStringsAtCompileTime) {
+    static_assert(memcrc("test") == 0x338BCFAC, "memcrc is not calculated at compile time");
+
+    switch (memcrc(std::string("anothertest"))) {
+    case memcrc("test"):
+        BOOST_FAIL("Matched the wrong string");
+        break;
+    case memcrc("anothertest"):
+        break;
+    default:
+        BOOST_FAIL("Matched no string");
+    }
+}
+
+/// This test verifies that every overload agrees on strings with bytes above 0x7F.
+BOOST_AUTO_TEST_CASE(CrcOfHighBytesMatchesAcrossOverloads) {
+    const char high_bytes[] = "caf\xE9 \xFF\x80";
+
+    BOOST_CHECK_EQUAL(memcrc(high_bytes), memcrc(high_bytes, sizeof(high_bytes) - 1));
+    BOOST_CHECK_EQUAL(memcrc(high_bytes), memcrc(std::string(high_bytes)));
+}
+
+/// This test verifies that the unseeded checksum is the cksum polynomial with its standard check value.
+BOOST_AUTO_TEST_CASE(CrcOfCheckStringIsStandard) {
+    BOOST_CHECK_EQUAL(0xFC891918, memcrc("123456789"));
+    BOOST_CHECK_EQUAL(0xFC891918, memcrc("123456789", 9));
+}
+
+/// This test verifies that every method gives the bytewise table's checksums at
+/// every length and alignment.
+BOOST_AUTO_TEST_CASE(CrcMethodsMatchBytewiseTable) {
+    auto buffer = RandomBuffer(1024 + 16);
+
+    for (uint32_t offset = 0; offset < 16; offset += 3) {
+        for (uint32_t length = 0; length <= 1024; ++length) {
+            const unsigned char* data = &buffer[offset];
+            const char* string_data = reinterpret_cast<const char*>(data);
+            uint32_t seed = length * 0x9E3779B9;
+
+            uint32_t expected = anh::detail::memcrc(string_data, length, CRC_BYTEWISE);
+            uint32_t expected_seeded = anh::detail::memcrc(data, length, seed, CRC_BYTEWISE);
+
+            BOOST_REQUIRE_EQUAL(expected, memcrc(string_data, length));
+            BOOST_REQUIRE_EQUAL(expected_seeded, memcrc(data, length, seed));
+
+            for (CrcMethod method : all_methods) {
+                if (!IsCrcMethodSupported(method)) {
+                    continue;
+                }
+
+                BOOST_REQUIRE_EQUAL(expected, anh::detail::memcrc(string_data, length, method));
+                BOOST_REQUIRE_EQUAL(expected_seeded, anh::detail::memcrc(data, length, seed, method));
+            }
+        }
+    }
+}
+
+/// This test verifies that the seeded checksum is the zip checksum of the seed followed by the buffer.
+BOOST_AUTO_TEST_CASE(SeededCrcMatchesZlib) {
+    auto buffer = RandomBuffer(4 + 496);
+
+    uint32_t seed = 0xDEADBEEF;
+    buffer[0] = 0xEF;
+    buffer[1] = 0xBE;
+    buffer[2] = 0xAD;
+    buffer[3] = 0xDE;
+
+    uint32_t expected = crc32(0, &buffer[0], buffer.size());
+
+    BOOST_CHECK_EQUAL(expected, memcrc(&buffer[4], buffer.size() - 4, seed));
+}
+
+/// This test verifies that encrypting and checksumming in one pass gives the same
+/// packet and checksum as encrypting word by word and checksumming afterwards.
+BOOST_AUTO_TEST_CASE(EncryptAndCrcMatchesSeparatePasses) {
+    auto plain = RandomBuffer(600);
+
+    for (uint32_t encrypt_offset = 1; encrypt_offset <= 2; ++encrypt_offset) {
+        for (uint32_t length = encrypt_offset; length <= 600; ++length) {
+            uint32_t seed = length * 0x9E3779B9;
+
+            auto expected = plain;
+            EncryptWordByWord(reinterpret_cast<char*>(&expected[encrypt_offset]), length - encrypt_offset, seed);
+            uint32_t expected_crc = anh::detail::memcrc(&expected[0], length, seed, CRC_BYTEWISE);
+
+            auto encrypted = plain;
+            BOOST_REQUIRE_EQUAL(expected_crc, anh::EncryptXorChainAndCrc(&encrypted[0], length, encrypt_offset, seed));
+            BOOST_REQUIRE(expected == encrypted);
+
+            for (CrcMethod method : all_methods) {
+                if (!IsCrcMethodSupported(method)) {
+                    continue;
+                }
+
+                encrypted = plain;
+                BOOST_REQUIRE_EQUAL(expected_crc,
+                    anh::detail::EncryptXorChainAndCrc(&encrypted[0], length, encrypt_offset, seed, method));
+                BOOST_REQUIRE(expected == encrypted);
+            }
+        }
+    }
+}
+
+/// Encrypts and checksums packet sized and multi-kilobyte buffers in separate passes,
+/// the way the filters used to, and in one pass with each method the cpu supports, and
+/// reports the time per buffer.
+BOOST_AUTO_TEST_CASE(EncryptAndCrcThroughput) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t lengths[] = { 496, 4096 };
+    const char* method_names[] = { "bytewise", "slice by 8", "CLMUL" };
+    const uint32_t bytes_per_run = 64 * 1024 * 1024;
+
+    auto plain = RandomBuffer(4096);
+    auto buffer = plain;
+
+    for (uint32_t length : lengths) {
+        uint32_t iterations = bytes_per_run / length;
+        uint32_t checksums = 0;
+
+        // returns the nanoseconds per buffer, the buffer is refreshed before each run
+        auto run = [&] (std::function<uint32_t (uint32_t seed)> work) -> double {
+            std::copy(plain.begin(), plain.end(), buffer.begin());
+
+            auto start = boost::chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i) {
+                checksums ^= work(i);
+            }
+
+            return boost::chrono::duration<double, boost::nano>(
+                boost::chrono::high_resolution_clock::now() - start).count() / iterations;
+        };
+
+        char* data = reinterpret_cast<char*>(&buffer[0]);
+
+        double separate_passes = run([&] (uint32_t seed) -> uint32_t {
+            EncryptWordByWord(data + 2, length - 2, seed);
+            return memcrc(&buffer[0], length, seed);
+        });
+
+        BOOST_TEST_MESSAGE(length << " byte packets");
+        BOOST_TEST_MESSAGE("  Encrypt and crc, separate passes: " << separate_passes << "ns");
+
+        for (CrcMethod method : all_methods) {
+            if (!IsCrcMethodSupported(method)) {
+                continue;
+            }
+
+            double one_pass = run([&] (uint32_t seed) {
+                return anh::detail::EncryptXorChainAndCrc(&buffer[0], length, 2, seed, method);
+            });
+
+            BOOST_TEST_MESSAGE("  Encrypt and crc, " << method_names[method] << ": " << one_pass << "ns");
+        }
+
+        // keeps the loops from being optimized away
+        BOOST_CHECK(checksums != 1);
+    }
+}
+
+/// Checksums packet sized and multi-kilobyte buffers with each method the cpu
+/// supports and reports the throughput.
+BOOST_AUTO_TEST_CASE(CrcThroughput) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t lengths[] = { 64, 496, 4096, 65536 };
+    const char* method_names[] = { "Bytewise:  ", "Slice by 8:", "CLMUL:     " };
+    const uint32_t bytes_per_run = 64 * 1024 * 1024;
+
+    auto buffer = RandomBuffer(65536);
+
+    for (uint32_t length : lengths) {
+        uint32_t iterations = bytes_per_run / length;
+
+        BOOST_TEST_MESSAGE(length << " byte buffers");
+
+        for (CrcMethod method : all_methods) {
+            if (!IsCrcMethodSupported(method)) {
+                continue;
+            }
+
+            uint32_t seeded = 0;
+            auto start = boost::chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i) {
+                seeded ^= anh::detail::memcrc(&buffer[0], length, i, method);
+            }
+
+            double seeded_seconds = boost::chrono::duration<double>(
+                boost::chrono::high_resolution_clock::now() - start).count();
+
+            uint32_t unseeded = 0;
+            start = boost::chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i) {
+                unseeded ^= anh::detail::memcrc(reinterpret_cast<const char*>(&buffer[0]), length, method);
+            }
+
+            double unseeded_seconds = boost::chrono::duration<double>(
+                boost::chrono::high_resolution_clock::now() - start).count();
+
+            // keeps the loops from being optimized away
+            BOOST_CHECK(seeded != 1 || unseeded != 1);
+
+            BOOST_TEST_MESSAGE("  " << method_names[method]
+                << " seeded " << static_cast<uint64_t>(bytes_per_run / seeded_seconds / (1024 * 1024)) << " MB/s,"
+                << " unseeded " << static_cast<uint64_t>(bytes_per_run / unseeded_seconds / (1024 * 1024)) << " MB/s");
+        }
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
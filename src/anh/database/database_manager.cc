@@ -6,24 +6,35 @@
 #include "anh/database/database_manager.h"
 
 #include <algorithm>
+#include <cassert>
+#include <deque>
 #include <functional>
 #include <memory>
-#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/thread_time.hpp>
 
 #include <cppconn/driver.h>
 #include <cppconn/connection.h>
+#include <cppconn/exception.h>
 #include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+
+#include "anh/logger.h"
 
 #ifdef WIN32
 #include <concurrent_unordered_map.h>
-#include <concurrent_queue.h>
 #else
 #include <tbb/concurrent_unordered_map.h>
-#include <tbb/concurrent_queue.h>
 
 namespace Concurrency {
     using ::tbb::concurrent_unordered_map;
-    using ::tbb::concurrent_queue;
 }
 
 #endif
@@ -31,152 +42,494 @@ namespace Concurrency {
 using namespace anh::database;
 using namespace std;
 
-class anh::database::DatabaseManagerImpl {
+namespace {
+
+struct ConnectionData {
+    ConnectionData(std::string schema_, std::string host_, std::string username_, std::string password_)
+        : schema(std::move(schema_))
+        , host(std::move(host_))
+        , username(std::move(username_))
+        , password(std::move(password_))
+    {}
+
+    std::string schema;
+    std::string host;
+    std::string username;
+    std::string password;
+};
+
+/*! A connection owned by a pool along with the statements prepared on it.
+*/
+struct PooledConnection {
+    explicit PooledConnection(sql::Connection* connection_)
+        : connection(connection_)
+    {}
+
+    std::unique_ptr<sql::Connection> connection;
+
+    // declared after the connection so they're released before it's closed
+    std::unordered_map<std::string, std::unique_ptr<sql::PreparedStatement>> statements;
+};
+
+class ConnectionPool;
+
+/*! Deleter for the connections handed out by a pool, returning them to it.
+*/
+struct ConnectionReleaser {
+    void operator() (sql::Connection*);
+
+    std::shared_ptr<ConnectionPool> pool;
+    PooledConnection* pooled_connection;
+};
+
+/*! The connections opened to one storage type.
+*
+* Connections are handed out until max_connections are open, after which requests
+* wait for one to be returned. Idle connections are pinged periodically and those
+* that have died are replaced to keep min_connections open.
+*/
+class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 public:
-     
-    struct ConnectionData {
-        ConnectionData(std::string schema_, std::string host_, std::string username_, std::string password_)
-            : schema(std::move(schema_))
-            , host(std::move(host_))
-            , username(std::move(username_))
-            , password(std::move(password_))
-        {}
-    
-        std::string schema;
-        std::string host;
-        std::string username;
-        std::string password;
-    };
-
-    explicit DatabaseManagerImpl(sql::Driver* driver)
-        : driver_(driver) {}
+    ConnectionPool(sql::Driver* driver, std::shared_ptr<ConnectionData> connection_data, const ConnectionPoolOptions& options)
+        : driver_(driver)
+        , connection_data_(std::move(connection_data))
+        , options_(options)
+        , open_count_(0)
+        , shutting_down_(false)
+    {
+        options_.max_connections = std::max<uint32_t>(options_.max_connections, 1);
+        options_.min_connections = std::min(options_.min_connections, options_.max_connections);
+    }
 
-    ~DatabaseManagerImpl() {
-        std::for_each(connections_.begin(), connections_.end(), [] (ConnectionPoolMap::value_type& conn) {
-            if (conn.second.empty()) {
-                return;
+    ~ConnectionPool() {
+        Shutdown();
+    }
+
+    /*! Opens a connection and adds it to the pool, throwing if it can't be opened.
+    */
+    void AddConnection() {
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            ++open_count_;
+        }
+
+        PooledConnection* pooled_connection;
+
+        try {
+            pooled_connection = Open_();
+        } catch(...) {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            --open_count_;
+            throw;
+        }
+
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        idle_.push_back(pooled_connection);
+        available_.notify_one();
+    }
+
+    std::shared_ptr<sql::Connection> Acquire() {
+        auto start = boost::chrono::steady_clock::now();
+        auto deadline = boost::get_system_time() + options_.acquire_timeout;
+
+        boost::unique_lock<boost::mutex> lock(mutex_);
+
+        for (;;) {
+            if (!idle_.empty()) {
+                // the most recently used connection is the least likely to have timed out
+                PooledConnection* pooled_connection = idle_.back();
+                idle_.pop_back();
+
+                lock.unlock();
+
+                if (pooled_connection->connection->isClosed()) {
+                    Drop_(pooled_connection);
+                    lock.lock();
+                    continue;
+                }
+
+                return Lease_(pooled_connection, start);
+            }
+
+            if (open_count_ < options_.max_connections) {
+                ++open_count_;
+                lock.unlock();
+
+                PooledConnection* pooled_connection;
+
+                try {
+                    pooled_connection = Open_();
+                } catch(...) {
+                    lock.lock();
+                    --open_count_;
+                    available_.notify_one();
+                    throw;
+                }
+
+                return Lease_(pooled_connection, start);
+            }
+
+            if (!available_.timed_wait(lock, deadline)) {
+                ++stats_.timeouts;
+                return nullptr;
+            }
+        }
+    }
+
+    void Release(PooledConnection* pooled_connection) {
+        bool closed = pooled_connection->connection->isClosed();
+
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        --stats_.in_use;
+
+        if (closed || shutting_down_) {
+            lock.unlock();
+
+            if (!closed) {
+                pooled_connection->connection->close();
+            }
+
+            Drop_(pooled_connection);
+            return;
+        }
+
+        ++stats_.recycled;
+        idle_.push_back(pooled_connection);
+        available_.notify_one();
+    }
+
+    /*! Pings the idle connections, dropping any that don't answer, and opens new
+    * ones until min_connections are open again.
+    */
+    void CheckConnections() {
+        std::deque<PooledConnection*> checking;
+
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            checking.swap(idle_);
+        }
+
+        for (auto pooled_connection : checking) {
+            if (!Ping_(pooled_connection)) {
+                Drop_(pooled_connection);
+                continue;
             }
 
-            do {
-                // close each connection and pop it from the list
-                std::shared_ptr<sql::Connection> connection;
-                if (conn.second.try_pop(connection)) {
-                    connection->close();
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            idle_.push_back(pooled_connection);
+            available_.notify_one();
+        }
+
+        for (;;) {
+            {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                if (shutting_down_ || open_count_ >= options_.min_connections) {
+                    break;
                 }
-            } while (!conn.second.empty());
+            }
+
+            try {
+                AddConnection();
+            } catch(sql::SQLException& e) {
+                LOG(error) << "Unable to reopen a pooled connection: " << e.what();
+                break;
+            }
+        }
+    }
+
+    /*! Closes the idle connections; those in use are closed as they're returned.
+    */
+    void Shutdown() {
+        std::deque<PooledConnection*> closing;
+
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            shutting_down_ = true;
+            closing.swap(idle_);
+        }
+
+        for (auto pooled_connection : closing) {
+            pooled_connection->connection->close();
+
+            if (!pooled_connection->connection->isClosed()) {
+                LOG(warning) << "A pooled connection failed to close cleanly";
+            }
+
+            Drop_(pooled_connection);
+        }
+    }
+
+    bool HasIdleConnection() const {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return !idle_.empty();
+    }
+
+    ConnectionPoolStats GetStats() const {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+
+        ConnectionPoolStats stats = stats_;
+        stats.idle = static_cast<uint32_t>(idle_.size());
+
+        return stats;
+    }
+
+private:
+    PooledConnection* Open_() {
+        std::unique_ptr<sql::Connection> connection(driver_->connect(
+            connection_data_->host, connection_data_->username, connection_data_->password));
+        connection->setSchema(connection_data_->schema);
+
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        ++stats_.created;
+
+        return new PooledConnection(connection.release());
+    }
+
+    void Drop_(PooledConnection* pooled_connection) {
+        delete pooled_connection;
+
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        --open_count_;
+        ++stats_.dropped;
+        available_.notify_one();
+    }
+
+    bool Ping_(PooledConnection* pooled_connection) {
+        try {
+            if (pooled_connection->connection->isClosed()) {
+                return false;
+            }
+
+            std::unique_ptr<sql::Statement> statement(pooled_connection->connection->createStatement());
+            statement->execute("SELECT 1");
+        } catch(sql::SQLException& e) {
+            LOG(warning) << "Dropping a pooled connection that failed to answer: " << e.what();
+            return false;
+        }
+
+        return true;
+    }
+
+    std::shared_ptr<sql::Connection> Lease_(PooledConnection* pooled_connection, boost::chrono::steady_clock::time_point start) {
+        uint64_t waited = boost::chrono::duration_cast<boost::chrono::microseconds>(
+            boost::chrono::steady_clock::now() - start).count();
+
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            ++stats_.in_use;
+            ++stats_.acquired;
+            stats_.total_wait_microseconds += waited;
+            stats_.max_wait_microseconds = std::max(stats_.max_wait_microseconds, waited);
+        }
+
+        ConnectionReleaser releaser;
+        releaser.pool = shared_from_this();
+        releaser.pooled_connection = pooled_connection;
+
+        return std::shared_ptr<sql::Connection>(pooled_connection->connection.get(), releaser);
+    }
+
+    sql::Driver* driver_;
+    std::shared_ptr<ConnectionData> connection_data_;
+    ConnectionPoolOptions options_;
+
+    mutable boost::mutex mutex_;
+    boost::condition_variable available_;
+    std::deque<PooledConnection*> idle_;
+    uint32_t open_count_;
+    bool shutting_down_;
+    ConnectionPoolStats stats_;
+};
+
+void ConnectionReleaser::operator() (sql::Connection*) {
+    pool->Release(pooled_connection);
+}
+
+}  // namespace
+
+class anh::database::DatabaseManagerImpl {
+public:
+    DatabaseManagerImpl(sql::Driver* driver, const ConnectionPoolOptions& options)
+        : driver_(driver)
+        , options_(options)
+        , stopping_(false)
+    {
+        ping_thread_ = boost::thread([this] () { CheckConnections_(); });
+    }
+
+    ~DatabaseManagerImpl() {
+        {
+            boost::lock_guard<boost::mutex> lock(ping_mutex_);
+            stopping_ = true;
+        }
+
+        ping_wakeup_.notify_all();
+        ping_thread_.join();
+
+        std::for_each(pools_.begin(), pools_.end(), [] (ConnectionPoolMap::value_type& pool) {
+            pool.second->Shutdown();
         });
     }
-    
+
     bool hasStorageType(const StorageType& storage_type) const {
         return connection_data_.find(storage_type) != connection_data_.end();
     }
 
     bool registerStorageType(
-        const StorageType& storage_type, 
-        const std::string& schema, 
-        const std::string& host, 
-        const std::string& username, 
-        const std::string& password) 
+        const StorageType& storage_type,
+        const std::string& schema,
+        const std::string& host,
+        const std::string& username,
+        const std::string& password)
     {
-        if (hasStorageType(storage_type)) 
+        if (hasStorageType(storage_type))
         {
             return false;
         }
 
-        // create a valid connection to verify the integrity of the data passed in
-        auto connection = std::shared_ptr<sql::Connection>(
-            driver_->connect(host, username, password), 
-            bind(&DatabaseManagerImpl::recycleConnection_, this, storage_type, placeholders::_1));
+        auto connection_data = make_shared<ConnectionData>(schema, host, username, password);
+        auto pool = make_shared<ConnectionPool>(driver_, connection_data, options_);
 
-        connection->setSchema(schema);
+        // create a valid connection to verify the integrity of the data passed in,
+        // then fill the pool up to its minimum
+        do {
+            pool->AddConnection();
+        } while (pool->GetStats().idle < options_.min_connections);
 
         // insert the data
-        connection_data_.insert(make_pair(storage_type, make_shared<ConnectionData>(schema, host, username, password)));
-
-        // add the created connection to the connection pool
-        connections_[storage_type].push(connection);
+        connection_data_.insert(make_pair(storage_type, connection_data));
+        pools_.insert(make_pair(storage_type, pool));
 
         return true;
     }
 
     bool hasConnection(const StorageType& storage_type) const {
         // return whether or not the connection pool for this storage type is empty
-        auto find_iter = connections_.find(storage_type);
+        auto find_iter = pools_.find(storage_type);
 
-        if (find_iter != end(connections_))
+        if (find_iter != end(pools_))
         {
-            return !find_iter->second.empty();
+            return find_iter->second->HasIdleConnection();
         }
 
         return false;
     }
 
-    std::shared_ptr<sql::Connection> getConnection(const StorageType& storage_type) 
+    std::shared_ptr<sql::Connection> getConnection(const StorageType& storage_type)
     {
-        auto connection_pool_iter = connections_.find(storage_type);
+        auto find_iter = pools_.find(storage_type);
 
-        if (connection_pool_iter == connections_.end() || connection_pool_iter->second.empty())
-        {
-            auto connection_data_iter = connection_data_.find(storage_type);
-            if (connection_data_iter == connection_data_.end())
-            {
-                assert(false && "Requested a storage type that has not been registered");
-                return nullptr;
-            }
-        
-            // create a valid connection to verify the integrity of the data passed in
-            return CreateConnection(connection_data_iter->second, storage_type);
-        }
-
-        std::shared_ptr<sql::Connection> connection;        
-        if (!connection_pool_iter->second.try_pop(connection))
+        if (find_iter == pools_.end())
         {
+            assert(false && "Requested a storage type that has not been registered");
             return nullptr;
         }
-        
-        if (connection->isClosed())
+
+        auto connection = find_iter->second->Acquire();
+
+        if (!connection)
         {
-            return nullptr;
+            LOG(warning) << "Timed out waiting for a connection to " << storage_type.ident_string();
         }
 
         return connection;
     }
 
-private:
+    std::shared_ptr<sql::PreparedStatement> getPreparedStatement(
+        const std::shared_ptr<sql::Connection>& connection, const std::string& sql)
+    {
+        auto releaser = std::get_deleter<ConnectionReleaser>(connection);
+
+        if (!releaser)
+        {
+            // not one of ours, so there's nowhere to keep the statement
+            return std::shared_ptr<sql::PreparedStatement>(connection->prepareStatement(sql));
+        }
+
+        // the connection is only used by whoever holds it, the cache needs no lock
+        auto& statement = releaser->pooled_connection->statements[sql];
+
+        if (statement)
+        {
+            DrainResults_(*statement);
+            statement->clearParameters();
+        }
+        else
+        {
+            statement.reset(connection->prepareStatement(sql));
+        }
+
+        // holding the statement holds on to the connection it was prepared on
+        return std::shared_ptr<sql::PreparedStatement>(connection, statement.get());
+    }
 
-    std::shared_ptr<sql::Connection> CreateConnection(const shared_ptr<ConnectionData>& connection_data, const StorageType& storage_type)
+    ConnectionPoolStats getPoolStats(const StorageType& storage_type) const
     {
-        auto connection = std::shared_ptr<sql::Connection>(driver_->connect(connection_data->host, connection_data->username, connection_data->password), 
-                std::bind(&DatabaseManagerImpl::recycleConnection_, this, storage_type, std::placeholders::_1));
-        connection->setSchema(connection_data->schema);
+        auto find_iter = pools_.find(storage_type);
 
-        return connection;
+        if (find_iter == pools_.end())
+        {
+            return ConnectionPoolStats();
+        }
+
+        return find_iter->second->GetStats();
     }
 
-    void recycleConnection_(const StorageType& storage_type, sql::Connection* connection) {
-        if (connection->isClosed()) 
+private:
+    // A CALL returns a result for each select in the procedure and one for the
+    // call itself, any left unread have to go before the statement is executed again.
+    static void DrainResults_(sql::PreparedStatement& statement) {
+        try {
+            while (statement.getMoreResults()) {
+                delete statement.getResultSet();
+            }
+        } catch(sql::SQLException& e) {
+            LOG(warning) << "Discarding the results of a reused statement failed: " << e.what();
+        }
+    }
+
+    void CheckConnections_() {
+        boost::unique_lock<boost::mutex> lock(ping_mutex_);
+
+        while (!stopping_)
         {
-            delete connection;
-            return;
+            auto next_check = boost::get_system_time() + options_.ping_interval;
+
+            while (!stopping_ && ping_wakeup_.timed_wait(lock, next_check))
+            {}
+
+            if (stopping_)
+            {
+                break;
+            }
+
+            lock.unlock();
+
+            std::for_each(pools_.begin(), pools_.end(), [] (ConnectionPoolMap::value_type& pool) {
+                pool.second->CheckConnections();
+            });
+
+            lock.lock();
         }
-        
-        connections_[storage_type].push(shared_ptr<sql::Connection>(
-            connection, 
-            bind(&DatabaseManagerImpl::recycleConnection_, this, storage_type, placeholders::_1)));
     }
-       
+
     sql::Driver* driver_;
-    
+    ConnectionPoolOptions options_;
+
     typedef Concurrency::concurrent_unordered_map<StorageType, std::shared_ptr<ConnectionData>> ConnectionDataMap;
     ConnectionDataMap connection_data_;
-    
-    typedef Concurrency::concurrent_queue<std::shared_ptr<sql::Connection>> ConnectionPool;
-    typedef Concurrency::concurrent_unordered_map<StorageType, ConnectionPool> ConnectionPoolMap;
-    ConnectionPoolMap connections_;
+
+    typedef Concurrency::concurrent_unordered_map<StorageType, std::shared_ptr<ConnectionPool>> ConnectionPoolMap;
+    ConnectionPoolMap pools_;
+
+    boost::mutex ping_mutex_;
+    boost::condition_variable ping_wakeup_;
+    bool stopping_;
+    boost::thread ping_thread_;
 };
 
-DatabaseManager::DatabaseManager(sql::Driver* driver)   
-: pimpl_(std::unique_ptr<DatabaseManagerImpl>(new DatabaseManagerImpl(driver)))
+DatabaseManager::DatabaseManager(sql::Driver* driver, const ConnectionPoolOptions& options)
+: pimpl_(std::unique_ptr<DatabaseManagerImpl>(new DatabaseManagerImpl(driver, options)))
 {}
 
 DatabaseManager::~DatabaseManager() {}
@@ -197,3 +550,13 @@ bool DatabaseManager::hasConnection(const StorageType& storage_type) const {
 shared_ptr<sql::Connection> DatabaseManager::getConnection(const StorageType& storage_type) {
     return pimpl_->getConnection(storage_type);
 }
+
+shared_ptr<sql::PreparedStatement> DatabaseManager::getPreparedStatement(
+    const shared_ptr<sql::Connection>& connection, const std::string& sql)
+{
+    return pimpl_->getPreparedStatement(connection, sql);
+}
+
+ConnectionPoolStats DatabaseManager::getPoolStats(const StorageType& storage_type) const {
+    return pimpl_->getPoolStats(storage_type);
+}
@@ -4,12 +4,34 @@
 #ifndef ANH_DATABASE_DATABASE_MANAGER_H_
 #define ANH_DATABASE_DATABASE_MANAGER_H_
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
 #include "database_manager_interface.h"
 
 namespace anh {
 namespace database {
 class DatabaseManagerImpl;
 
+/*! Limits and timings for the connection pool kept for each storage type.
+*/
+struct ConnectionPoolOptions {
+    ConnectionPoolOptions()
+        : min_connections(1)
+        , max_connections(16)
+        , acquire_timeout(boost::posix_time::seconds(5))
+        , ping_interval(boost::posix_time::seconds(60))
+    {}
+
+    /// Connections kept open even when idle.
+    uint32_t min_connections;
+    /// Connections that may be open at once, in use or idle.
+    uint32_t max_connections;
+    /// How long a request waits for a connection when all of them are in use.
+    boost::posix_time::time_duration acquire_timeout;
+    /// How often idle connections are checked and dead ones replaced.
+    boost::posix_time::time_duration ping_interval;
+};
+
 /*! Concrete implementation of the DatabaseManagerInterface API.
 *
 * @see DatabaseManagerInterface
@@ -21,8 +43,9 @@ public:
     *
     * @param driver An instance of the sql driver used to provide concrete 
     *      functionality for the database layer.
+    * @param options The limits for the connection pool of each storage type.
     */
-    explicit DatabaseManager(sql::Driver* driver);
+    explicit DatabaseManager(sql::Driver* driver, const ConnectionPoolOptions& options = ConnectionPoolOptions());
 
     ~DatabaseManager();
 
@@ -37,6 +60,13 @@ public:
     
     /// @see DatabaseManagerInterface::getConnection
     std::shared_ptr<sql::Connection> getConnection(const StorageType& storage_type);
+
+    /// @see DatabaseManagerInterface::getPreparedStatement
+    std::shared_ptr<sql::PreparedStatement> getPreparedStatement(
+        const std::shared_ptr<sql::Connection>& connection, const std::string& sql);
+
+    /// @see DatabaseManagerInterface::getPoolStats
+    ConnectionPoolStats getPoolStats(const StorageType& storage_type) const;
     
 private:
     // disable the default constructor to ensure that DatabaseManager is always
@@ -14,6 +14,7 @@
 namespace sql {
     class Connection;
     class Driver;
+    class PreparedStatement;
 }
   
 /*! An identifier used to label different persistant data storage types.
@@ -22,6 +23,33 @@ typedef anh::HashString StorageType;
 
 namespace anh {
 namespace database {
+
+/*! A snapshot of the activity of the connection pool for a storage type.
+*/
+struct ConnectionPoolStats {
+    ConnectionPoolStats()
+        : idle(0)
+        , in_use(0)
+        , created(0)
+        , recycled(0)
+        , dropped(0)
+        , acquired(0)
+        , timeouts(0)
+        , total_wait_microseconds(0)
+        , max_wait_microseconds(0)
+    {}
+
+    uint32_t idle;      ///< Connections waiting in the pool.
+    uint32_t in_use;    ///< Connections currently handed out.
+    uint64_t created;   ///< Connections opened to the datastore.
+    uint64_t recycled;  ///< Connections returned to the pool after use.
+    uint64_t dropped;   ///< Connections closed or found dead and discarded.
+    uint64_t acquired;  ///< Connections handed out.
+    uint64_t timeouts;  ///< Requests that gave up waiting for a connection.
+    uint64_t total_wait_microseconds;   ///< Time spent by all requests waiting for a connection.
+    uint64_t max_wait_microseconds;     ///< Longest time a single request waited.
+};
+
 /*! Interface class that exposes an API for managing mysql connector/c++
 * connections.
 */
@@ -52,11 +80,35 @@ public:
 
     /*! Processes a request for a connection to a specific storage type. 
     *
+    * When every connection the pool may open is in use this waits for one to be
+    * returned, up to the pool's acquire timeout.
+    *
     * @param storage_type The storage type a connection is being requested for.
-    * @return Returns a connection or nullptr if one could not be created, or if
-    *   the storage type has not been seen before.
+    * @return Returns a connection or nullptr if one could not be created in time,
+    *   or if the storage type has not been seen before.
     */
     virtual std::shared_ptr<sql::Connection> getConnection(const StorageType& storage_type) = 0;
+
+    /*! Prepares a statement on a connection, reusing the statement prepared for
+    * the same sql the last time the connection was used.
+    *
+    * The statement's parameters are cleared and any results a previous use left
+    * unread are discarded. It keeps the connection from returning to the pool
+    * until it's released.
+    *
+    * @param connection A connection requested from getConnection.
+    * @param sql The sql text of the statement.
+    * @return Returns the prepared statement.
+    */
+    virtual std::shared_ptr<sql::PreparedStatement> getPreparedStatement(
+        const std::shared_ptr<sql::Connection>& connection, const std::string& sql) = 0;
+
+    /*! Reports the activity of the connection pool for a storage type.
+    *
+    * @param storage_type The storage type to report on.
+    * @return The pool's statistics, all zero if the storage type has not been seen before.
+    */
+    virtual ConnectionPoolStats getPoolStats(const StorageType& storage_type) const = 0;
 };
 } // database
 } // anh
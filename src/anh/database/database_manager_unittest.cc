@@ -1,7 +1,12 @@
 // This file is part of SWGANH which is released under the MIT license.
 // See file LICENSE or go to http://swganh.com/LICENSE
 
+#define MOCK_THREAD_SAFE
+
+#include <atomic>
+#include <boost/chrono.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 #include <turtle/mock.hpp>
 
 #include "anh/database/mock_cppconn.h"
@@ -18,6 +23,10 @@ protected:
     void generateExpectations(MockDriver& mock_driver, int connections);
     void generateDefaultConnectionExpectations(MockDriver& mock_driver, MockConnection* mock_connection);
     void generateExpectationsMultipleConnections(MockDriver& mock_driver);
+    // Generates expectations for a driver handing out healthy connections on demand.
+    void generateHealthyConnections(MockDriver& mock_driver);
+    // Options for a pool that never pings its connections during a test.
+    ConnectionPoolOptions poolOptions(uint32_t max_connections);
     sql::SQLString host_;
     sql::SQLString username_;
     sql::SQLString password_;
@@ -204,6 +213,172 @@ BOOST_AUTO_TEST_CASE(DeletingConnectionReturnsItToThePool) {
     BOOST_CHECK(manager.hasStorageType("my_storage_type"));
 }
 
+/// A full pool makes requests wait, and gives up on them after the acquire timeout.
+BOOST_AUTO_TEST_CASE(FullPoolTimesOutWaitingForAConnection) {
+    MockDriver mock_driver;
+    generateHealthyConnections(mock_driver);
+
+    auto options = poolOptions(1);
+    options.acquire_timeout = boost::posix_time::milliseconds(50);
+
+    DatabaseManager manager(&mock_driver, options);
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_);
+
+    auto connection = manager.getConnection("my_storage_type");
+    BOOST_REQUIRE(connection != nullptr);
+
+    BOOST_CHECK(manager.getConnection("my_storage_type") == nullptr);
+
+    auto stats = manager.getPoolStats("my_storage_type");
+    BOOST_CHECK_EQUAL(1, stats.created);
+    BOOST_CHECK_EQUAL(1, stats.in_use);
+    BOOST_CHECK_EQUAL(1, stats.timeouts);
+
+    connection.reset();
+
+    BOOST_CHECK(manager.getConnection("my_storage_type") != nullptr);
+
+    stats = manager.getPoolStats("my_storage_type");
+    BOOST_CHECK_EQUAL(1, stats.created);
+    BOOST_CHECK_EQUAL(2, stats.recycled);
+    BOOST_CHECK_EQUAL(0, stats.in_use);
+}
+
+/// A connection found closed when it's requested is replaced with a new one.
+BOOST_AUTO_TEST_CASE(ClosedConnectionsAreReplaced) {
+    MockDriver mock_driver;
+    MockConnection* closed_connection = new MockConnection();
+
+    MOCK_EXPECT(closed_connection->setSchema).once();
+    MOCK_EXPECT(closed_connection->isClosed).returns(true);
+
+    MOCK_EXPECT(mock_driver.connect3)
+        .once()
+        .returns(closed_connection);
+
+    DatabaseManager manager(&mock_driver, poolOptions(1));
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_);
+
+    generateHealthyConnections(mock_driver);
+
+    auto connection = manager.getConnection("my_storage_type");
+    BOOST_CHECK(connection != nullptr);
+    BOOST_CHECK(connection.get() != closed_connection);
+
+    auto stats = manager.getPoolStats("my_storage_type");
+    BOOST_CHECK_EQUAL(2, stats.created);
+    BOOST_CHECK_EQUAL(1, stats.dropped);
+}
+
+/// A statement prepared on a connection is reused the next time it's prepared,
+/// after the results its last use left unread are discarded.
+BOOST_AUTO_TEST_CASE(PreparedStatementsAreCachedPerConnection) {
+    MockDriver mock_driver;
+    MockConnection* mock_connection = new MockConnection();
+    MockPreparedStatement* mock_statement = new MockPreparedStatement();
+    MockResultSet* unread_result = new MockResultSet();
+
+    MOCK_EXPECT(mock_connection->setSchema).once();
+    MOCK_EXPECT(mock_connection->isClosed).returns(false);
+    MOCK_EXPECT(mock_connection->close);
+    MOCK_EXPECT(mock_connection->tag1)
+        .once()
+        .with(sql::SQLString("CALL sp_PersistObject(?);"))
+        .returns(mock_statement);
+    MOCK_EXPECT(mock_statement->clearParameters).once();
+    MOCK_EXPECT(mock_statement->getMoreResults).once().returns(true);
+    MOCK_EXPECT(mock_statement->getMoreResults).once().returns(false);
+    MOCK_EXPECT(mock_statement->getResultSet).once().returns(unread_result);
+
+    MOCK_EXPECT(mock_driver.connect3)
+        .once()
+        .returns(mock_connection);
+
+    DatabaseManager manager(&mock_driver, poolOptions(1));
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_);
+
+    {
+        auto connection = manager.getConnection("my_storage_type");
+        auto statement = manager.getPreparedStatement(connection, "CALL sp_PersistObject(?);");
+        BOOST_CHECK(statement.get() == mock_statement);
+    }
+
+    {
+        auto connection = manager.getConnection("my_storage_type");
+        auto statement = manager.getPreparedStatement(connection, "CALL sp_PersistObject(?);");
+        BOOST_CHECK(statement.get() == mock_statement);
+
+        // the statement keeps the connection out of the pool until it's released
+        connection.reset();
+        BOOST_CHECK_EQUAL(1, manager.getPoolStats("my_storage_type").in_use);
+    }
+
+    BOOST_CHECK_EQUAL(0, manager.getPoolStats("my_storage_type").in_use);
+}
+
+/// 16 threads sharing a pool of 4 connections, each requesting a connection and
+/// holding it for a moment 500 times. Reports how long requests waited.
+BOOST_AUTO_TEST_CASE(ConnectionsAreSharedUnderContention) {
+    const uint32_t thread_count = 16;
+    const uint32_t requests_per_thread = 500;
+    const uint32_t max_connections = 4;
+
+    MockDriver mock_driver;
+    generateHealthyConnections(mock_driver);
+
+    auto options = poolOptions(max_connections);
+    options.acquire_timeout = boost::posix_time::seconds(30);
+
+    DatabaseManager manager(&mock_driver, options);
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_);
+
+    std::atomic<uint32_t> held(0);
+    std::atomic<uint32_t> most_held(0);
+    std::atomic<uint32_t> failed(0);
+
+    auto start = boost::chrono::steady_clock::now();
+
+    boost::thread_group threads;
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        threads.create_thread([&] {
+            for (uint32_t j = 0; j < requests_per_thread; ++j) {
+                auto connection = manager.getConnection("my_storage_type");
+
+                if (!connection) {
+                    ++failed;
+                    continue;
+                }
+
+                uint32_t now_held = ++held;
+                uint32_t most = most_held;
+                while (now_held > most && !most_held.compare_exchange_weak(most, now_held))
+                {}
+
+                boost::this_thread::sleep(boost::posix_time::microseconds(50));
+
+                --held;
+            }
+        });
+    }
+
+    threads.join_all();
+
+    double seconds = boost::chrono::duration<double>(boost::chrono::steady_clock::now() - start).count();
+
+    auto stats = manager.getPoolStats("my_storage_type");
+
+    BOOST_CHECK_EQUAL(0, failed);
+    BOOST_CHECK(most_held <= max_connections);
+    BOOST_CHECK(stats.created <= max_connections);
+    BOOST_CHECK_EQUAL(thread_count * requests_per_thread, stats.acquired);
+    BOOST_CHECK_EQUAL(0, stats.in_use);
+
+    BOOST_TEST_MESSAGE(thread_count << " threads, " << max_connections << " connections: "
+        << static_cast<uint64_t>(stats.acquired / seconds) << " requests/s, "
+        << stats.total_wait_microseconds / stats.acquired << "us average wait, "
+        << stats.max_wait_microseconds << "us longest wait, " << stats.created << " connections opened");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 /*****************************************************************************/
 // Implementation for the test fixture //
@@ -292,3 +467,24 @@ void DatabaseManagerTest::generateDefaultConnectionExpectations(MockDriver& mock
         .returns(true);
 
 }
+
+void DatabaseManagerTest::generateHealthyConnections(MockDriver& mock_driver) {
+    MOCK_EXPECT(mock_driver.connect3)
+        .calls([] (const sql::SQLString&, const sql::SQLString&, const sql::SQLString&) -> sql::Connection* {
+            MockConnection* connection = new MockConnection();
+
+            MOCK_EXPECT(connection->setSchema).once();
+            MOCK_EXPECT(connection->isClosed).returns(false);
+            MOCK_EXPECT(connection->close);
+
+            return connection;
+        });
+}
+
+ConnectionPoolOptions DatabaseManagerTest::poolOptions(uint32_t max_connections) {
+    ConnectionPoolOptions options;
+    options.max_connections = max_connections;
+    options.ping_interval = boost::posix_time::hours(1);
+
+    return options;
+}
@@ -97,6 +97,25 @@ MOCK_BASE_CLASS(MockStatement, sql::Statement)
 
 MOCK_BASE_CLASS(MockPreparedStatement, sql::PreparedStatement)
 {
+    MOCK_METHOD(getConnection, 0);
+    MOCK_METHOD(cancel, 0);
+    MOCK_METHOD(clearWarnings, 0);
+    MOCK_METHOD(close, 0);
+    MOCK_METHOD(getFetchSize, 0);
+    MOCK_METHOD(getMaxFieldSize, 0);
+    MOCK_METHOD(getMaxRows, 0);
+    MOCK_METHOD(getMoreResults, 0);
+    MOCK_METHOD(getQueryTimeout, 0);
+    MOCK_METHOD(getResultSet, 0);
+    MOCK_METHOD(getResultSetType, 0);
+    MOCK_METHOD(getUpdateCount, 0);
+    MOCK_METHOD(getWarnings, 0);
+    MOCK_METHOD(setCursorName, 1);
+    MOCK_METHOD(setEscapeProcessing, 1);
+    MOCK_METHOD(setFetchSize, 1);
+    MOCK_METHOD(setMaxFieldSize, 1);
+    MOCK_METHOD(setMaxRows, 1);
+    MOCK_METHOD(setQueryTimeout, 1);
     MOCK_METHOD(clearParameters, 0);
     MOCK_METHOD_EXT(execute, 1, bool(const sql::SQLString& sql), tag1);
     MOCK_METHOD_EXT(execute, 0, bool(), tag2);
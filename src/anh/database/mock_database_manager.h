@@ -16,6 +16,8 @@ MOCK_BASE_CLASS(MockDatabaseManager, DatabaseManagerInterface)
     MOCK_METHOD(registerStorageType, 5);
     MOCK_CONST_METHOD_EXT(hasConnection, 1, bool(const StorageType& storage_type), hasConnection);
     MOCK_METHOD(getConnection, 1);    
+    MOCK_METHOD(getPreparedStatement, 2);
+    MOCK_CONST_METHOD_EXT(getPoolStats, 1, ConnectionPoolStats(const StorageType& storage_type), getPoolStats);
 };
 } //namespace database
 } //namespace anh
@@ -0,0 +1,66 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "anh/encryption.h"
+
+using namespace anh;
+
+namespace {
+
+#ifdef ANH_ENCRYPTION_SSE2
+
+// Decrypts 4 words at once, each word only depends on the encrypted word before it.
+// The previous block holds the word before the first in its top lane.
+inline __m128i DecryptBlock(__m128i block, __m128i previous)
+{
+    return _mm_xor_si128(block, _mm_or_si128(_mm_slli_si128(block, 4), _mm_srli_si128(previous, 12)));
+}
+
+#endif  // ANH_ENCRYPTION_SSE2
+
+}  // namespace
+
+void anh::EncryptXorChain(unsigned char* buffer, uint32_t length, uint32_t seed)
+{
+#ifdef ANH_ENCRYPTION_SSE2
+    __m128i seeds = _mm_set1_epi32(static_cast<int>(seed));
+
+    for (; length >= 16; buffer += 16, length -= 16) {
+        __m128i block = detail::EncryptBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer)), seeds);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), block);
+    }
+
+    seed = static_cast<uint32_t>(_mm_cvtsi128_si32(seeds));
+#endif
+
+    detail::EncryptWords(buffer, length, seed);
+}
+
+void anh::DecryptXorChain(unsigned char* buffer, uint32_t length, uint32_t seed)
+{
+#ifdef ANH_ENCRYPTION_SSE2
+    __m128i previous = _mm_slli_si128(_mm_cvtsi32_si128(static_cast<int>(seed)), 12);
+
+    for (; length >= 16; buffer += 16, length -= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), DecryptBlock(block, previous));
+        previous = block;
+    }
+
+    seed = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(previous, 12)));
+#endif
+
+    for (; length >= 4; buffer += 4, length -= 4) {
+        uint32_t word;
+        std::memcpy(&word, buffer, sizeof(word));
+
+        uint32_t decrypted = word ^ seed;
+        std::memcpy(buffer, &decrypted, sizeof(decrypted));
+
+        seed = word;
+    }
+
+    for (uint32_t i = 0; i < length; ++i) {
+        buffer[i] ^= static_cast<unsigned char>(seed);
+    }
+}
@@ -0,0 +1,90 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef LIBANH_ENCRYPTION_H_
+#define LIBANH_ENCRYPTION_H_
+
+#include <cstdint>
+#include <cstring>
+
+// xor chaining works on 16 byte blocks wherever SSE2 can be assumed
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define ANH_ENCRYPTION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace anh {
+
+namespace detail {
+
+    /**
+     * Encrypts the words of a buffer one at a time and then the bytes after them,
+     * returning the last encrypted word. Words are read and written in host order,
+     * the way the client does it.
+     *
+     * Shared with anh::EncryptXorChainAndCrc, which checksums the buffer as it goes.
+     */
+    inline uint32_t EncryptWords(unsigned char* buffer, uint32_t length, uint32_t seed)
+    {
+        for (; length >= 4; buffer += 4, length -= 4) {
+            uint32_t word;
+            std::memcpy(&word, buffer, sizeof(word));
+
+            seed ^= word;
+            std::memcpy(buffer, &seed, sizeof(seed));
+        }
+
+        for (uint32_t i = 0; i < length; ++i) {
+            buffer[i] ^= static_cast<unsigned char>(seed);
+        }
+
+        return seed;
+    }
+
+#ifdef ANH_ENCRYPTION_SSE2
+
+    /**
+     * Encrypts 4 words at once. Each word is xored with all the words before it in
+     * the block, then with the last encrypted word of the previous block, which the
+     * seed holds in every lane and is updated to this block's last word.
+     */
+    inline __m128i EncryptBlock(__m128i block, __m128i& seed)
+    {
+        block = _mm_xor_si128(block, _mm_slli_si128(block, 4));
+        block = _mm_xor_si128(block, _mm_slli_si128(block, 8));
+        block = _mm_xor_si128(block, seed);
+
+        seed = _mm_shuffle_epi32(block, 0xff);
+
+        return block;
+    }
+
+#endif  // ANH_ENCRYPTION_SSE2
+
+}  // namespace detail
+
+/**
+ * @brief Xor chains a buffer in place, the way SOE packets are encrypted.
+ *
+ * Each 4 byte word is xored with the encrypted word before it, the first one with
+ * the seed. Bytes after the last whole word are xored with the low byte of the last
+ * encrypted word.
+ *
+ * @param buffer The data to encrypt.
+ * @param length The length of the buffer.
+ * @param seed Seed for the first word.
+ */
+void EncryptXorChain(unsigned char* buffer, uint32_t length, uint32_t seed);
+
+/**
+ * @brief Reverses EncryptXorChain in place.
+ *
+ * @param buffer The data to decrypt.
+ * @param length The length of the buffer.
+ * @param seed Seed the buffer was encrypted with.
+ */
+void DecryptXorChain(unsigned char* buffer, uint32_t length, uint32_t seed);
+
+}  // namespace anh
+
+#endif  // LIBANH_ENCRYPTION_H_
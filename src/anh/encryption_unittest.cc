@@ -0,0 +1,140 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/encryption.h"
+
+namespace {
+
+std::vector<unsigned char> RandomBuffer(uint32_t length) {
+    std::vector<unsigned char> buffer(length);
+
+    uint32_t state = 0x12345678;
+    for (auto& byte : buffer) {
+        state = state * 1103515245 + 12345;
+        byte = static_cast<unsigned char>(state >> 16);
+    }
+
+    return buffer;
+}
+
+// the encryption filter's loop before it used EncryptXorChain
+void EncryptWordByWord(char* data, uint32_t len, uint32_t seed) {
+    uint32_t blockCount = (len / 4);
+    uint32_t byteCount = (len % 4);
+
+    for(uint32_t count = 0; count < blockCount; count++) {
+        ((uint32_t*)data)[count] ^= seed;
+        seed = ((uint32_t*)data)[count];
+    }
+
+    for(uint32_t count = blockCount * 4; count < blockCount * 4 + byteCount; count++) {
+        data[count] ^= seed;
+    }
+}
+
+// and the decryption filter's
+void DecryptWordByWord(char* buffer, uint32_t len, uint32_t seed) {
+    uint32_t tempSeed = 0;
+    uint32_t blockCount = (len / 4);
+    uint32_t byteCount = (len % 4);
+
+    for(uint32_t count = 0; count < blockCount; count++) {
+        tempSeed = ((uint32_t*)buffer)[count];
+        ((uint32_t*)buffer)[count] ^= seed;
+        seed = tempSeed;
+    }
+
+    for(uint32_t count = blockCount * 4; count < blockCount * 4 + byteCount; count++) {
+        buffer[count] ^= seed;
+    }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ANHEncryption)
+
+/// This test verifies that xor chaining gives the same bytes as the filters' word by
+/// word loops at every length and alignment, and that decrypting reverses it.
+BOOST_AUTO_TEST_CASE(XorChainMatchesWordByWordLoops) {
+    auto plain = RandomBuffer(600 + 16);
+
+    for (uint32_t offset = 0; offset < 4; ++offset) {
+        for (uint32_t length = 0; length <= 600; ++length) {
+            uint32_t seed = length * 0x9E3779B9;
+
+            auto expected = plain;
+            EncryptWordByWord(reinterpret_cast<char*>(&expected[offset]), length, seed);
+
+            auto encrypted = plain;
+            anh::EncryptXorChain(&encrypted[offset], length, seed);
+            BOOST_REQUIRE(expected == encrypted);
+
+            DecryptWordByWord(reinterpret_cast<char*>(&expected[offset]), length, seed);
+            BOOST_REQUIRE(expected == plain);
+
+            anh::DecryptXorChain(&encrypted[offset], length, seed);
+            BOOST_REQUIRE(encrypted == plain);
+        }
+    }
+}
+
+/// Encrypts and decrypts packet sized and multi-kilobyte buffers the way the filters
+/// used to and the way they do now, and reports the time per buffer.
+BOOST_AUTO_TEST_CASE(EncryptionThroughput) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t lengths[] = { 496, 4096 };
+    const uint32_t bytes_per_run = 64 * 1024 * 1024;
+
+    auto plain = RandomBuffer(4096);
+    auto buffer = plain;
+
+    for (uint32_t length : lengths) {
+        uint32_t iterations = bytes_per_run / length;
+
+        // returns the nanoseconds per buffer, the buffer is refreshed before each run
+        auto run = [&] (std::function<void (uint32_t seed)> work) -> double {
+            std::copy(plain.begin(), plain.end(), buffer.begin());
+
+            auto start = boost::chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i) {
+                work(i);
+            }
+
+            return boost::chrono::duration<double, boost::nano>(
+                boost::chrono::high_resolution_clock::now() - start).count() / iterations;
+        };
+
+        char* data = reinterpret_cast<char*>(&buffer[0]);
+
+        double word_encrypt = run([&] (uint32_t seed) {
+            EncryptWordByWord(data + 2, length - 2, seed);
+        });
+        double chain_encrypt = run([&] (uint32_t seed) {
+            anh::EncryptXorChain(&buffer[2], length - 2, seed);
+        });
+        double word_decrypt = run([&] (uint32_t seed) {
+            DecryptWordByWord(data + 2, length - 2, seed);
+        });
+        double chain_decrypt = run([&] (uint32_t seed) {
+            anh::DecryptXorChain(&buffer[2], length - 2, seed);
+        });
+
+        BOOST_TEST_MESSAGE(length << " byte packets");
+        BOOST_TEST_MESSAGE("  Encrypt: word by word " << word_encrypt << "ns, chained " << chain_encrypt << "ns");
+        BOOST_TEST_MESSAGE("  Decrypt: word by word " << word_decrypt << "ns, chained " << chain_decrypt << "ns");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,21 +5,22 @@
 
 #include <algorithm>
 
-#ifdef WIN32
-#include <chrono>
-using namespace std::chrono;
-#else
-#include <boost/chrono.hpp>
-using namespace boost::chrono;
-#endif
-
 #include <boost/asio/io_service.hpp>
 
+#include "anh/logger.h"
+
 using namespace anh;
 using namespace std;
 
 namespace ba = boost::asio;
 
+namespace {
+
+/// The most posted events invoked before the drain yields the io_service thread.
+const size_t max_drain_batch = 256;
+
+}  // namespace
+
 BaseEvent::BaseEvent(EventType type)
 : type_(type)
 {}
@@ -30,49 +31,75 @@ EventType BaseEvent::Type() const
 }
 
 EventDispatcher::EventDispatcher(ba::io_service& io_service)
-: io_service_(io_service)
-{}
+: event_handlers_(make_shared<EventHandlerMap>())
+, next_callback_id_(1)
+, drain_scheduled_(false)
+, io_service_(io_service)
+{
+    drain_batch_.reserve(max_drain_batch);
+}
 
 EventDispatcher::~EventDispatcher()
 {
-    boost::lock_guard<boost::shared_mutex> lg(event_handlers_mutex_);
-    for (auto& item : event_handlers_)
-    {
-        item.second.clear();
-    }
-    event_handlers_.clear();
+    boost::lock_guard<boost::mutex> lg(event_handlers_mutex_);
+    atomic_store(&event_handlers_, shared_ptr<const EventHandlerMap>(make_shared<EventHandlerMap>()));
 }
 
 CallbackId EventDispatcher::Subscribe(EventType type, EventHandlerCallback callback)
 {
     auto handler_id = GenerateCallbackId();
 
-    boost::lock_guard<boost::shared_mutex> lg(event_handlers_mutex_);
+    boost::lock_guard<boost::mutex> lg(event_handlers_mutex_);
 
-    auto find_iter = event_handlers_.find(type);
+    auto event_handlers = make_shared<EventHandlerMap>(*event_handlers_);
+    auto& type_handlers = (*event_handlers)[type];
 
-    if (find_iter == end(event_handlers_))
-    {
-        find_iter = event_handlers_.insert(make_pair(type, EventHandlerList())).first;
-    }
+    auto new_type_handlers = type_handlers 
+        ? make_shared<EventHandlerList>(*type_handlers) 
+        : make_shared<EventHandlerList>();
+    new_type_handlers->push_back(make_pair(handler_id, move(callback)));
+
+    type_handlers = new_type_handlers;
     
-    find_iter->second.insert(std::make_pair(handler_id, move(callback)));
+    atomic_store(&event_handlers_, shared_ptr<const EventHandlerMap>(event_handlers));
 
     return handler_id;
 }
 
 void EventDispatcher::Unsubscribe(EventType type, CallbackId identifier)
 {
-    boost::lock_guard<boost::shared_mutex> lg(event_handlers_mutex_);
+    boost::lock_guard<boost::mutex> lg(event_handlers_mutex_);
 
-    auto event_type_iter = event_handlers_.find(type);
+    auto event_type_iter = event_handlers_->find(type);
     
-    if (event_type_iter != end(event_handlers_))
+    if (event_type_iter == end(*event_handlers_))
+    {
+        return;
+    }
+
+    auto new_type_handlers = make_shared<EventHandlerList>(*event_type_iter->second);
+    new_type_handlers->erase(
+        remove_if(
+            begin(*new_type_handlers), 
+            end(*new_type_handlers), 
+            [identifier] (const EventHandlerList::value_type& handler)
+        {
+            return handler.first == identifier;
+        }),
+        end(*new_type_handlers));
+
+    auto event_handlers = make_shared<EventHandlerMap>(*event_handlers_);
+
+    if (new_type_handlers->empty())
     {
-        auto type_handlers = event_type_iter->second;
-        type_handlers.erase(identifier);
-        type_handlers.clear();
+        event_handlers->erase(type);
     }
+    else
+    {
+        (*event_handlers)[type] = new_type_handlers;
+    }
+
+    atomic_store(&event_handlers_, shared_ptr<const EventHandlerMap>(event_handlers));
 }
 
 boost::unique_future<shared_ptr<EventInterface>> EventDispatcher::Dispatch(const shared_ptr<EventInterface>& dispatch_event)
@@ -92,25 +119,101 @@ boost::unique_future<shared_ptr<EventInterface>> EventDispatcher::Dispatch(const
     return task->get_future();
 }
 
+void EventDispatcher::Post(const shared_ptr<EventInterface>& dispatch_event)
+{
+    posted_events_.push(dispatch_event);
+
+    // Only one drain is queued at a time, it picks up everything posted until it runs.
+    if (!drain_scheduled_.exchange(true))
+    {
+        io_service_.post([this] () { DrainPostedEvents(); });
+    }
+}
+
 CallbackId EventDispatcher::GenerateCallbackId()
 {
-    return CallbackId(steady_clock::now().time_since_epoch().count());
+    return next_callback_id_++;
 }
 
-void EventDispatcher::InvokeCallbacks(const shared_ptr<EventInterface>& dispatch_event)
+shared_ptr<const EventDispatcher::EventHandlerList> EventDispatcher::GetEventHandlers(EventType type) const
 {
-    boost::lock_guard<boost::shared_mutex> lg(event_handlers_mutex_);
+    auto event_handlers = atomic_load(&event_handlers_);
+
+    auto event_type_iter = event_handlers->find(type);
 
-    auto event_type_iter = event_handlers_.find(dispatch_event->Type());
+    if (event_type_iter == end(*event_handlers))
+    {
+        return nullptr;
+    }
+
+    return event_type_iter->second;
+}
+
+void EventDispatcher::InvokeCallbacks(const shared_ptr<EventInterface>& dispatch_event)
+{
+    auto handlers = GetEventHandlers(dispatch_event->Type());
     
-    if (event_type_iter != end(event_handlers_))
+    if (handlers)
+    {
+        InvokeCallbacks(*handlers, dispatch_event);
+    }
+}
+
+void EventDispatcher::InvokeCallbacks(const EventHandlerList& handlers, const shared_ptr<EventInterface>& dispatch_event)
+{
+    for_each(
+        begin(handlers), 
+        end(handlers), 
+        [&dispatch_event] (const EventHandlerList::value_type& handler) 
+    {
+        handler.second(dispatch_event);
+    });
+}
+
+void EventDispatcher::DrainPostedEvents()
+{
+    shared_ptr<EventInterface> posted_event;
+
+    while (drain_batch_.size() < max_drain_batch && posted_events_.try_pop(posted_event))
+    {
+        drain_batch_.push_back(move(posted_event));
+    }
+
+    // Every event in the batch is handled in the order it was posted, with its handlers
+    // looked up in a single snapshot taken for the whole batch.
+    auto event_handlers = atomic_load(&event_handlers_);
+
+    for_each(begin(drain_batch_), end(drain_batch_), [this, &event_handlers] (const shared_ptr<EventInterface>& posted)
     {
-        for_each(
-            begin(event_type_iter->second), 
-            end(event_type_iter->second), 
-            [&dispatch_event] (const EventHandlerList::value_type& handler) 
+        auto event_type_iter = event_handlers->find(posted->Type());
+        if (event_type_iter == end(*event_handlers))
         {
-            handler.second(dispatch_event);
-        });
+            return;
+        }
+
+        try {
+            InvokeCallbacks(*event_type_iter->second, posted);
+        } catch(const exception& e) {
+            LOG(error) << "Error handling event " << posted->Type().ident_string() << ": " << e.what();
+        } catch(...) {
+            // anything escaping would leave the drain scheduled and every later post undelivered
+            LOG(error) << "Unknown error handling event " << posted->Type().ident_string();
+        }
+    });
+
+    drain_batch_.clear();
+
+    if (!posted_events_.empty())
+    {
+        io_service_.post([this] () { DrainPostedEvents(); });
+        return;
+    }
+
+    drain_scheduled_ = false;
+
+    // Catch events posted after the queue was found empty but before the flag was cleared.
+    if (!posted_events_.empty() && !drain_scheduled_.exchange(true))
+    {
+        io_service_.post([this] () { DrainPostedEvents(); });
     }
 }
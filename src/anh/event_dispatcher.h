@@ -4,16 +4,29 @@
 #ifndef ANH_EVENT_DISPATCHER_H_
 #define ANH_EVENT_DISPATCHER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/asio/strand.hpp>
 #include <boost/thread/future.hpp>
-#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/mutex.hpp>
+
+#ifdef WIN32
+#include <concurrent_queue.h>
+#else
+#include <tbb/concurrent_queue.h>
+
+namespace Concurrency {
+    using ::tbb::concurrent_queue;
+}
+
+#endif
 
 #include "hash_string.h"
 
@@ -85,8 +98,25 @@ namespace anh {
         virtual void Unsubscribe(EventType type, CallbackId identifier) = 0;
 
         virtual boost::unique_future<std::shared_ptr<EventInterface>> Dispatch(const std::shared_ptr<EventInterface>& dispatch_event) = 0;
+
+        /**
+         * Dispatches an event without tracking its completion.
+         *
+         * Prefer this to Dispatch when the result isn't waited on, it skips building
+         * the task and future needed to report back.
+         */
+        virtual void Post(const std::shared_ptr<EventInterface>& dispatch_event) = 0;
     };
 
+    /**
+     * Invokes the handlers subscribed to an event type on the io_service threads.
+     *
+     * The handler lists are copy-on-write: subscribing and unsubscribing build a new
+     * snapshot of the handlers and publish it atomically, so dispatching events only
+     * reads the current snapshot and never takes a lock. Posted events are queued and
+     * drained in batches, with the handlers for each event type in a batch looked up
+     * once.
+     */
     class EventDispatcher : public EventDispatcherInterface
     {
     public:
@@ -98,19 +128,32 @@ namespace anh {
 
         boost::unique_future<std::shared_ptr<EventInterface>> Dispatch(const std::shared_ptr<EventInterface>& dispatch_event);
 
+        void Post(const std::shared_ptr<EventInterface>& dispatch_event);
+
     private:
-        typedef std::unordered_map<CallbackId, EventHandlerCallback> EventHandlerList;
+        typedef std::vector<
+            std::pair<CallbackId, EventHandlerCallback>
+        > EventHandlerList;
         
         typedef std::unordered_map<
             EventType, 
-            EventHandlerList
+            std::shared_ptr<const EventHandlerList>
         > EventHandlerMap;
 
         CallbackId GenerateCallbackId();
+        std::shared_ptr<const EventHandlerList> GetEventHandlers(EventType type) const;
         void InvokeCallbacks(const std::shared_ptr<EventInterface>& dispatch_event);
+        void InvokeCallbacks(const EventHandlerList& handlers, const std::shared_ptr<EventInterface>& dispatch_event);
+        void DrainPostedEvents();
+
+        boost::mutex event_handlers_mutex_; ///< Serializes changes to the handlers, never held to read them.
+        std::shared_ptr<const EventHandlerMap> event_handlers_;
+        std::atomic<CallbackId> next_callback_id_;
+
+        Concurrency::concurrent_queue<std::shared_ptr<EventInterface>> posted_events_;
+        std::vector<std::shared_ptr<EventInterface>> drain_batch_;
+        std::atomic<bool> drain_scheduled_;
 
-        boost::shared_mutex event_handlers_mutex_;
-        EventHandlerMap event_handlers_;
         boost::asio::io_service& io_service_;
     };
 
@@ -0,0 +1,258 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <boost/asio/io_service.hpp>
+#include <boost/chrono.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/event_dispatcher.h"
+
+using namespace anh;
+using namespace std;
+
+namespace {
+
+class EventDispatcherTests {
+protected:
+    EventDispatcherTests()
+        : dispatcher_(io_service_)
+    {}
+
+    // runs the queued handlers until there is nothing left to do
+    void Drain() {
+        io_service_.poll();
+        io_service_.reset();
+    }
+
+    boost::asio::io_service io_service_;
+    EventDispatcher dispatcher_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(EventDispatcherTest, EventDispatcherTests)
+
+/// This test verifies that posted events reach the handlers subscribed to their type.
+BOOST_AUTO_TEST_CASE(PostedEventsReachSubscribedHandlers) {
+    int first_count = 0, second_count = 0, other_count = 0;
+
+    dispatcher_.Subscribe("TestEvent", [&first_count] (const shared_ptr<EventInterface>&) { ++first_count; });
+    dispatcher_.Subscribe("TestEvent", [&second_count] (const shared_ptr<EventInterface>&) { ++second_count; });
+    dispatcher_.Subscribe("OtherEvent", [&other_count] (const shared_ptr<EventInterface>&) { ++other_count; });
+
+    dispatcher_.Post(make_shared<BaseEvent>("TestEvent"));
+    dispatcher_.Post(make_shared<BaseEvent>("TestEvent"));
+    dispatcher_.Post(make_shared<BaseEvent>("OtherEvent"));
+    Drain();
+
+    BOOST_CHECK_EQUAL(2, first_count);
+    BOOST_CHECK_EQUAL(2, second_count);
+    BOOST_CHECK_EQUAL(1, other_count);
+}
+
+/// This test verifies that events are handled in the order they were posted, whatever their type.
+BOOST_AUTO_TEST_CASE(PostedEventsKeepTheirOrder) {
+    vector<int> handled;
+
+    dispatcher_.Subscribe("TestEvent", [&handled] (const shared_ptr<EventInterface>& incoming_event) {
+        handled.push_back(static_pointer_cast<ValueEvent<int>>(incoming_event)->Get());
+    });
+    dispatcher_.Subscribe("OtherEvent", [&handled] (const shared_ptr<EventInterface>&) {
+        handled.push_back(-1);
+    });
+
+    for (int i = 0; i < 1000; ++i) {
+        dispatcher_.Post(make_shared<ValueEvent<int>>("TestEvent", i));
+        dispatcher_.Post(make_shared<BaseEvent>("OtherEvent"));
+    }
+    Drain();
+
+    BOOST_REQUIRE_EQUAL(2000, handled.size());
+    for (int i = 0; i < 1000; ++i) {
+        BOOST_CHECK_EQUAL(i, handled[i * 2]);
+        BOOST_CHECK_EQUAL(-1, handled[i * 2 + 1]);
+    }
+}
+
+/// This test verifies that a handler throwing something other than a std::exception
+/// doesn't stop later posted events from being handled.
+BOOST_AUTO_TEST_CASE(PostedEventsAreHandledAfterAHandlerThrows) {
+    int count = 0;
+
+    dispatcher_.Subscribe("ThrowingEvent", [] (const shared_ptr<EventInterface>&) { throw 42; });
+    dispatcher_.Subscribe("TestEvent", [&count] (const shared_ptr<EventInterface>&) { ++count; });
+
+    dispatcher_.Post(make_shared<BaseEvent>("ThrowingEvent"));
+    dispatcher_.Post(make_shared<BaseEvent>("TestEvent"));
+    Drain();
+
+    dispatcher_.Post(make_shared<BaseEvent>("TestEvent"));
+    Drain();
+
+    BOOST_CHECK_EQUAL(2, count);
+}
+
+/// This test verifies that the future returned from Dispatch is ready once the handlers ran.
+BOOST_AUTO_TEST_CASE(DispatchedFutureIsReadyAfterHandlers) {
+    int count = 0;
+
+    dispatcher_.Subscribe("TestEvent", [&count] (const shared_ptr<EventInterface>&) { ++count; });
+
+    auto dispatch_event = make_shared<BaseEvent>("TestEvent");
+    auto future = dispatcher_.Dispatch(dispatch_event);
+    Drain();
+
+    BOOST_REQUIRE(future.is_ready());
+    BOOST_CHECK(dispatch_event == future.get());
+    BOOST_CHECK_EQUAL(1, count);
+}
+
+/// This test verifies that an unsubscribed handler is no longer called.
+BOOST_AUTO_TEST_CASE(UnsubscribedHandlersAreNotCalled) {
+    int removed_count = 0, kept_count = 0;
+
+    auto removed_id = dispatcher_.Subscribe("TestEvent", [&removed_count] (const shared_ptr<EventInterface>&) { ++removed_count; });
+    dispatcher_.Subscribe("TestEvent", [&kept_count] (const shared_ptr<EventInterface>&) { ++kept_count; });
+
+    dispatcher_.Unsubscribe("TestEvent", removed_id);
+
+    dispatcher_.Post(make_shared<BaseEvent>("TestEvent"));
+    Drain();
+
+    BOOST_CHECK_EQUAL(0, removed_count);
+    BOOST_CHECK_EQUAL(1, kept_count);
+}
+
+/// This test verifies that handlers can subscribe other handlers while being invoked.
+BOOST_AUTO_TEST_CASE(HandlersCanSubscribeWhileInvoked) {
+    int count = 0;
+
+    dispatcher_.Subscribe("TestEvent", [this, &count] (const shared_ptr<EventInterface>&) {
+        dispatcher_.Subscribe("OtherEvent", [&count] (const shared_ptr<EventInterface>&) { ++count; });
+    });
+
+    dispatcher_.Post(make_shared<BaseEvent>("TestEvent"));
+    Drain();
+
+    dispatcher_.Post(make_shared<BaseEvent>("OtherEvent"));
+    Drain();
+
+    BOOST_CHECK_EQUAL(1, count);
+}
+
+/// Dispatches events from 1 to 16 threads while as many threads run the io_service, as
+/// the server threads do, and reports the events handled per second for Dispatch and Post.
+BOOST_AUTO_TEST_CASE(DispatchThroughputAcrossThreads) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t events_per_thread = 50000;
+
+    std::atomic<uint64_t> handled(0);
+    dispatcher_.Subscribe("Object::CustomName", [&handled] (const shared_ptr<EventInterface>&) { ++handled; });
+    dispatcher_.Subscribe("Object::Position", [&handled] (const shared_ptr<EventInterface>&) { ++handled; });
+
+    auto run = [&] (uint32_t thread_count, bool use_futures) -> double {
+        const uint64_t event_count = events_per_thread * thread_count;
+        handled = 0;
+
+        io_service_.reset();
+        unique_ptr<boost::asio::io_service::work> work(new boost::asio::io_service::work(io_service_));
+
+        boost::thread_group io_threads;
+        for (uint32_t i = 0; i < thread_count; ++i) {
+            io_threads.create_thread([this] { io_service_.run(); });
+        }
+
+        auto start = boost::chrono::high_resolution_clock::now();
+
+        boost::thread_group dispatch_threads;
+        for (uint32_t i = 0; i < thread_count; ++i) {
+            dispatch_threads.create_thread([&] {
+                for (uint32_t j = 0; j < events_per_thread; ++j) {
+                    auto dispatch_event = make_shared<BaseEvent>((j & 1) ? "Object::CustomName" : "Object::Position");
+
+                    if (use_futures) {
+                        dispatcher_.Dispatch(dispatch_event);
+                    } else {
+                        dispatcher_.Post(dispatch_event);
+                    }
+                }
+            });
+        }
+
+        dispatch_threads.join_all();
+
+        while (handled < event_count) {
+            boost::this_thread::yield();
+        }
+
+        double seconds = boost::chrono::duration<double>(boost::chrono::high_resolution_clock::now() - start).count();
+
+        work.reset();
+        io_threads.join_all();
+
+        BOOST_CHECK_EQUAL(event_count, handled);
+
+        return event_count / seconds;
+    };
+
+    for (uint32_t thread_count = 1; thread_count <= 16; thread_count *= 2) {
+        double dispatched_per_second = run(thread_count, true);
+        double posted_per_second = run(thread_count, false);
+
+        BOOST_TEST_MESSAGE(thread_count << " threads: Dispatch " << static_cast<uint64_t>(dispatched_per_second)
+            << " events/s, Post " << static_cast<uint64_t>(posted_per_second) << " events/s");
+    }
+}
+
+/// Builds 1000000 events with their type given as a string literal, as a runtime string
+/// and as a constant, and reports the time taken per event and per event type alone.
+BOOST_AUTO_TEST_CASE(EventConstructionCost) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t event_count = 1000000;
+
+    static const EventType position_type("Object::Position");
+    const string position_name("Object::Position");
+
+    // returns the nanoseconds taken per call
+    auto run = [&] (const function<uint32_t ()>& create) -> double {
+        uint32_t checksum = 0;
+
+        auto start = boost::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < event_count; ++i) {
+            checksum += create();
+        }
+
+        double nanoseconds = boost::chrono::duration<double, boost::nano>(
+            boost::chrono::high_resolution_clock::now() - start).count();
+
+        BOOST_CHECK_EQUAL(position_type.ident() * event_count, checksum);
+
+        return nanoseconds / event_count;
+    };
+
+    double literal_type = run([] { return EventType("Object::Position").ident(); });
+    double string_type = run([&] { return EventType(position_name).ident(); });
+    double literal_event = run([] { return make_shared<BaseEvent>("Object::Position")->Type().ident(); });
+    double string_event = run([&] { return make_shared<BaseEvent>(position_name)->Type().ident(); });
+    double constant_event = run([] { return make_shared<BaseEvent>(position_type)->Type().ident(); });
+
+    BOOST_TEST_MESSAGE(event_count << " events of type " << position_type.ident_string());
+    BOOST_TEST_MESSAGE("Type from literal:  " << literal_type << "ns, event " << literal_event << "ns");
+    BOOST_TEST_MESSAGE("Type from string:   " << string_type << "ns, event " << string_event << "ns");
+    BOOST_TEST_MESSAGE("Type from constant: event " << constant_event << "ns");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -2,60 +2,55 @@
 // See file LICENSE or go to http://swganh.com/LICENSE
 
 #include "hash_string.h"
-#include "crc.h"
+
+#ifdef WIN32
+#include <concurrent_unordered_map.h>
+#else
+#include <tbb/concurrent_unordered_map.h>
+
+namespace Concurrency {
+    using ::tbb::concurrent_unordered_map;
+}
+
+#endif
 
 using namespace anh;
 
-HashString::HashString()
-    : ident_(0)
-{}
+namespace {
 
-HashString::HashString(std::string ident_string)
-    : ident_(reinterpret_cast<void*>(memcrc(ident_string)))
-    , ident_string_(ident_string)
-{}
+    // Interned strings by their hash. Lookups and inserts don't lock and nothing is
+    // ever removed, so the pointers handed out stay valid for the life of the program.
+    typedef Concurrency::concurrent_unordered_map<uint32_t, std::string> InternTable;
 
-HashString::HashString(const char* ident_string)
-    : ident_(reinterpret_cast<void*>(memcrc(std::string(ident_string))))
-    , ident_string_(ident_string)
-{}
+    InternTable& GetInternTable()
+    {
+        static InternTable intern_table;
+        return intern_table;
+    }
 
-HashString::HashString(uint32_t ident)
-    : ident_(reinterpret_cast<void*>(ident))
-{}
+}  // namespace
 
-HashString::operator uint32_t () const {
-    return ident();
-}
+HashString::HashString(const std::string& ident_string)
+    : ident_(memcrc(ident_string))
+    , ident_string_(Intern_(ident_, ident_string.c_str()))
+{}
 
 HashString::operator std::string () const {
     return ident_string();
 }
 
-uint32_t HashString::ident() const {
-    return static_cast<uint32_t>(reinterpret_cast<uint64_t>(ident_));
-}
-
-const std::string& HashString::ident_string() const {
+std::string HashString::ident_string() const {
     return ident_string_;
 }
 
-bool HashString::operator<(const HashString& other) const {
-    bool r = (ident() < other.ident());
-    return r;
-}
-
-bool HashString::operator>(const HashString& other) const {
-    bool r = (ident() > other.ident());
-    return r;
-}
+const char* HashString::Intern_(uint32_t ident, const char* ident_string) {
+    InternTable& intern_table = GetInternTable();
 
-bool HashString::operator==(const HashString& other) const {
-    bool r = (ident() == other.ident());
-    return r;
-}
+    auto find_iter = intern_table.find(ident);
+    if (find_iter != intern_table.end()) {
+        return find_iter->second.c_str();
+    }
 
-bool HashString::operator!=(const HashString& other) const {
-    bool r = (ident() != other.ident());
-    return r;
+    // inserting leaves the string already there if another thread got here first
+    return intern_table.insert(std::make_pair(ident, std::string(ident_string))).first->second.c_str();
 }
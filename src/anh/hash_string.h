@@ -4,40 +4,90 @@
 #ifndef LIBANH_HASH_STRING_H_
 #define LIBANH_HASH_STRING_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include <type_traits>
+
+#include "anh/crc.h"
 
 namespace anh {
 
 /*! \brief This class provides a utility for generating identifiers that are
  * easy to read and can be used as key values in the standard 
  * associative containers.
+ *
+ * A HashString made from a string literal is hashed at compile time when it is
+ * a constant, and at no point copies the string. Strings that aren't literals
+ * are interned, a single copy of each is kept for the life of the program.
+ * Either way a HashString is just an ident and a pointer, cheap to copy, and
+ * can be used for case labels:
+ *
+ * \code
+ * switch (event->Type()) {
+ * case HashString("Object::Position"):
+ *     ...
+ * }
+ * \endcode
+ *
+ * Strings are told apart by their hash alone. Two strings with the same hash are
+ * the same HashString, and the one interned first is the ident_string of both.
  */
 class HashString {
 public:
     /// Default constructor.
-    HashString();
+    constexpr HashString()
+        : ident_(0)
+        , ident_string_("")
+    {}
 
-    /// Takes a regular std::string and stores a hash of it.
-    HashString(std::string ident_string);
+    /*! Takes a string literal and stores a hash of it.
+     *
+     * The array is kept by pointer, so it must be a literal or have static storage.
+     * Copy a local const array into a std::string to have it interned instead.
+     */
+    template<size_t N>
+    constexpr HashString(const char (&ident_string)[N])
+        : ident_(memcrc(ident_string))
+        , ident_string_(ident_string)
+    {}
+
+    /// Takes a string in a modifiable buffer and stores a hash of it.
+    template<size_t N>
+    HashString(char (&ident_string)[N])
+        : ident_(memcrc(ident_string, static_cast<uint32_t>(std::strlen(ident_string))))
+        , ident_string_(Intern_(ident_, ident_string))
+    {}
+
+    /// Takes a null terminated string and stores a hash of it.
+    template<typename T>
+    HashString(T ident_string,
+        typename std::enable_if<std::is_same<T, const char*>::value || std::is_same<T, char*>::value>::type* = nullptr)
+        : ident_(memcrc(ident_string, static_cast<uint32_t>(std::strlen(ident_string))))
+        , ident_string_(Intern_(ident_, ident_string))
+    {}
 
     /// Takes a regular std::string and stores a hash of it.
-    HashString(const char* ident_string);
+    HashString(const std::string& ident_string);
 
     /// Takes an pre-hashed value and stores it.
-    HashString(uint32_t ident);
+    constexpr HashString(uint32_t ident)
+        : ident_(ident)
+        , ident_string_("")
+    {}
     
     /// Conversion operator allows a hash string to be cast to a uint32_t
-    operator uint32_t () const;
+    constexpr operator uint32_t () const { return ident_; }
 
     /// Conversion operator allows a hash string to be cast to a std::string
     operator std::string () const;
 
     /// Returns a 32bit hash representation of the string.
-    uint32_t ident() const;
+    constexpr uint32_t ident() const { return ident_; }
 
     /// Returns a human readable identifier. Is empty if created from a pre-hashed value.
-    const std::string& ident_string() const;
+    std::string ident_string() const;
 
     /*! Uses a less-than comparison on two HashStrings.
      *
@@ -47,7 +97,7 @@ public:
      * @param other The HashString to compare to the current one.
      * @return True if the ident is less than that of the other's, false if not.
      */
-    bool operator<(const HashString& other) const;
+    constexpr bool operator<(const HashString& other) const { return ident_ < other.ident_; }
 
     /*! Uses a greater-than comparison on two HashStrings.
      *
@@ -57,31 +107,32 @@ public:
      * @param other The HashString to compare to the current one.
      * @return True if the ident is greater than that of the other's, false if not.
      */
-    bool operator>(const HashString& other) const;
+    constexpr bool operator>(const HashString& other) const { return ident_ > other.ident_; }
 
     /*! Compares two HashStrings to determine if they are equal.
      *
      * @param other The HashString to compare to the current one.
      * @return True if the two HashStrings are equal, false if not.
      */
-    bool operator==(const HashString& other) const;
+    constexpr bool operator==(const HashString& other) const { return ident_ == other.ident_; }
 
     /*! Compares two HashStrings to determine if they are not equal.
      *
      * @param other The HashString to compare to the current one.
      * @return True if the two HashStrings are not equal, false if they are.
      */
-    bool operator!=(const HashString& other) const;
+    constexpr bool operator!=(const HashString& other) const { return ident_ != other.ident_; }
 
 private:
+    /**
+     * @return The interned copy of the string with the given hash. The table is
+     *  keyed by the hash only, the first string interned for a hash is the one
+     *  kept and is returned for any other string that collides with it.
+     */
+    static const char* Intern_(uint32_t ident, const char* ident_string);
 
-    // \note: ident_ is stored as a void * not an int, so that in
-    // the debugger it will show up as hex-values instead of
-    // integer values. This is a bit more representative of what
-    // we're doing here and makes it easy to allow external code
-    // to assign event types as desired.
-    void * ident_;              ///< A 32bit hash of the ident_string.
-    std::string ident_string_;
+    uint32_t ident_;                ///< A 32bit hash of the ident_string.
+    const char* ident_string_;      ///< A string literal or an interned string, never freed.
 };
 
 }  // namespace anh
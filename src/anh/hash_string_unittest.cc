@@ -52,4 +52,46 @@ BOOST_AUTO_TEST_CASE(CanUseHashStringAsContainerKey) {
     auto it = hash_string_map.find(HashString("my_key1"));
     BOOST_CHECK_MESSAGE(2000 == it->second, "Cannot find a map entry by a HashString");
 }
+
+/// This test shows that hash strings made from literals are constants that can be used as case labels.
+BOOST_AUTO_TEST_CASE(HashStringsFromLiteralsAreConstants) {
+    static_assert(HashString("test_hash_string").ident() == 0x107D0089, "HashString is not hashed at compile time");
+
+    HashString hash_string(std::string("another_hash_string"));
+
+    switch (hash_string) {
+    case HashString("test_hash_string"):
+        BOOST_FAIL("Matched the wrong hash string");
+        break;
+    case HashString("another_hash_string"):
+        break;
+    default:
+        BOOST_FAIL("Matched no hash string");
+    }
+}
+
+/// This test verifies that the readable identifier is kept however the hash string is made.
+BOOST_AUTO_TEST_CASE(HashStringsKeepTheirReadableIdentifier) {
+    std::string name("my_string_key");
+    char buffer[32] = "my_buffer_key";
+    const char* pointer = name.c_str();
+
+    HashString from_literal("my_literal_key");
+    HashString from_string(name);
+    HashString from_buffer(buffer);
+    HashString from_pointer(pointer);
+
+    // the source strings can go away, only the literal is kept as is
+    name = "changed";
+    buffer[0] = 'M';
+
+    BOOST_CHECK_EQUAL("my_literal_key", from_literal.ident_string());
+    BOOST_CHECK_EQUAL("my_string_key", from_string.ident_string());
+    BOOST_CHECK_EQUAL("my_buffer_key", from_buffer.ident_string());
+    BOOST_CHECK_EQUAL("my_string_key", from_pointer.ident_string());
+
+    BOOST_CHECK_EQUAL(HashString("my_string_key"), from_string);
+    BOOST_CHECK_EQUAL(HashString("my_buffer_key"), from_buffer);
+    BOOST_CHECK_EQUAL("", HashString(from_string.ident()).ident_string());
+}
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -3,10 +3,10 @@
 
 #include "compression_filter.h"
 
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
-#include <zlib.h>
-
 #include "anh/byte_buffer.h"
 #include "anh/network/soe/session.h"
 
@@ -15,12 +15,67 @@ using namespace network::soe;
 using namespace filters;
 using namespace std;
 
-void CompressionFilter::operator()(Session* session, ByteBuffer* message)
+namespace {
+
+    // A packet is never more than a few hundred bytes, a 512 byte window covers all of
+    // it while keeping the stream each session holds on to small.
+    const int window_bits = 9;
+    const int memory_level = 4;
+
+}  // namespace
+
+CompressionFilter::CompressionFilter(uint32_t max_message_size)
+    : compression_level_(Z_DEFAULT_COMPRESSION)
+    , compression_threshold_(max_message_size > 20 ? max_message_size - 20 : 0)
+    , compression_output_(max_message_size)
 {
-    if(message->size() > session->receive_buffer_size() - 20)
+    zstream_.zalloc = Z_NULL;
+    zstream_.zfree = Z_NULL;
+    zstream_.opaque = Z_NULL;
+
+    if (deflateInit2(&zstream_, compression_level_, Z_DEFLATED, window_bits, memory_level, Z_DEFAULT_STRATEGY) != Z_OK)
     {
-        Compress_(message);
+        throw runtime_error("Unable to initialize compression stream");
+    }
+}
+
+CompressionFilter::~CompressionFilter()
+{
+    deflateEnd(&zstream_);
+}
+
+int CompressionFilter::compression_level() const
+{
+    return compression_level_;
+}
+
+void CompressionFilter::compression_level(int compression_level)
+{
+    // Reset first so changing the level never has to flush a finished stream.
+    deflateReset(&zstream_);
+
+    if (deflateParams(&zstream_, compression_level, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw invalid_argument("Invalid compression level");
+    }
 
+    compression_level_ = compression_level;
+}
+
+uint32_t CompressionFilter::compression_threshold() const
+{
+    return compression_threshold_;
+}
+
+void CompressionFilter::compression_threshold(uint32_t compression_threshold)
+{
+    compression_threshold_ = compression_threshold;
+}
+
+void CompressionFilter::operator()(Session* session, ByteBuffer* message)
+{
+    if(message->size() > compression_threshold_ && Compress_(message))
+    {
         message->write<uint8_t>(1); // compressed
     } 
     else 
@@ -29,37 +84,45 @@ void CompressionFilter::operator()(Session* session, ByteBuffer* message)
     }
 }
 
-void CompressionFilter::Compress_(ByteBuffer* message) 
+bool CompressionFilter::Compress_(ByteBuffer* message) 
 {
     vector<uint8_t>& packet_data = message->raw();
     uint32_t packet_size = message->size();
 
     // Determine the offset to begin compressing data at
     uint16_t offset = (packet_data[0] == 0x00) ? 2 : 1;
-    
-    z_stream zstream_;
 
-    zstream_.zalloc = Z_NULL;
-    zstream_.zfree = Z_NULL;
-    zstream_.opaque = Z_NULL;
-    zstream_.avail_in = Z_NULL;
-    zstream_.next_in = Z_NULL;
+    if (packet_size <= offset)
+    {
+        return false;
+    }
 
-    deflateInit(&zstream_, Z_DEFAULT_COMPRESSION);
+    uint32_t payload_size = packet_size - offset;
 
-    vector<uint8_t> compression_output(packet_size);
+    if (compression_output_.size() < payload_size)
+    {
+        compression_output_.resize(payload_size);
+    }
+
+    deflateReset(&zstream_);
 
     zstream_.next_in = reinterpret_cast<Bytef *>(&packet_data[offset]);
-    zstream_.avail_in = packet_size - offset;
-    zstream_.next_out = reinterpret_cast<Bytef *>(&compression_output[0]);
-    zstream_.avail_out = packet_size;
+    zstream_.avail_in = payload_size;
+    zstream_.next_out = reinterpret_cast<Bytef *>(&compression_output_[0]);
 
-    deflate(&zstream_, Z_FINISH);
+    // Only leave room for output smaller than the input, if it doesn't fit it isn't
+    // worth sending compressed.
+    zstream_.avail_out = payload_size - 1;
 
-    ByteBuffer compressed(&packet_data[0], offset);
-    compressed.write(&compression_output[0], zstream_.total_out);
-    
-    deflateEnd(&zstream_);
+    if (deflate(&zstream_, Z_FINISH) != Z_STREAM_END)
+    {
+        return false;
+    }
+
+    // Replace the payload in place, the header in front of it is kept as is.
+    message->resize(offset);
+    message->write_position(offset);
+    message->write(&compression_output_[0], zstream_.total_out);
 
-    message->swap(compressed);
+    return true;
 }
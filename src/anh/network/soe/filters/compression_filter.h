@@ -4,6 +4,11 @@
 #ifndef ANH_NETWORK_SOE_COMPRESSION_FILTER_H_
 #define ANH_NETWORK_SOE_COMPRESSION_FILTER_H_
 
+#include <cstdint>
+#include <vector>
+
+#include <zlib.h>
+
 namespace anh {
 
     class ByteBuffer;
@@ -15,14 +20,56 @@ namespace soe {
 
 namespace filters {
 
+/**
+ * @brief Compresses outgoing packet data above a size threshold.
+ *
+ * A single zlib stream is kept for the lifetime of the filter and reset between
+ * packets. Packets that don't shrink when compressed are sent as they are.
+ */
 class CompressionFilter {
-public:    
+public:
+    /**
+     * @param max_message_size Maximum size of outgoing messages.
+     */
+    explicit CompressionFilter(uint32_t max_message_size);
+    ~CompressionFilter();
+
     void operator()(Session* session, ByteBuffer* message);
 
+    /**
+     * @return The zlib compression level, from 0 (none) to 9 (best).
+     */
+    int compression_level() const;
+
+    /**
+     * Sets the zlib compression level, from 0 (none) to 9 (best).
+     */
+    void compression_level(int compression_level);
+
+    /**
+     * @return The size in bytes a message has to exceed to be compressed.
+     */
+    uint32_t compression_threshold() const;
+
+    /**
+     * Sets the size in bytes a message has to exceed to be compressed.
+     */
+    void compression_threshold(uint32_t compression_threshold);
+
 private:
-	void Compress_(ByteBuffer* message);
+    CompressionFilter();
+    CompressionFilter(const CompressionFilter&);
+    CompressionFilter& operator=(const CompressionFilter&);
+
+	bool Compress_(ByteBuffer* message);
+
+    int compression_level_;
+    uint32_t compression_threshold_;
+
+    z_stream zstream_;
+    std::vector<uint8_t> compression_output_;
 };
 
 }}}} // namespace anh::network::soe::filters
 
-#endif // ANH_NETWORK_SOE_DECOMPRESSION_FILTER_H_
+#endif // ANH_NETWORK_SOE_COMPRESSION_FILTER_H_
@@ -0,0 +1,354 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <zlib.h>
+
+#include "anh/benchmark.h"
+#include "anh/byte_buffer.h"
+#include "anh/utilities.h"
+#include "anh/network/soe/filters/compression_filter.h"
+#include "anh/network/soe/filters/decompression_filter.h"
+
+using namespace anh;
+using namespace anh::network::soe::filters;
+using namespace std;
+
+namespace {
+
+class CompressionFilterTests {
+protected:
+    CompressionFilterTests()
+        : compression_filter_(496)
+        , decompression_filter_(496)
+        , sequence_(0)
+    {}
+
+    // builds a data channel packet packed with baseline-like messages, the large
+    // mostly static object state sent when an object comes into view
+    ByteBuffer buildBaselinePacket();
+
+    // builds a data channel packet packed with delta-like messages, the small
+    // updates to a handful of object members sent every tick
+    ByteBuffer buildDeltaPacket();
+
+    // builds a packet of random bytes that deflate can't shrink
+    ByteBuffer buildRandomPacket();
+
+    CompressionFilter compression_filter_;
+    DecompressionFilter decompression_filter_;
+
+private:
+    ByteBuffer buildPacket_();
+    void finishPacket_(ByteBuffer* packet, ByteBuffer* message);
+
+    uint16_t sequence_;
+    boost::random::mt19937 generator_;
+};
+
+// Compresses the way the filter did before keeping its stream, a full deflateInit and
+// deflateEnd for every packet.
+uint32_t CompressWithNewStream(const ByteBuffer& packet, vector<uint8_t>* output) {
+    z_stream zstream;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree = Z_NULL;
+    zstream.opaque = Z_NULL;
+
+    deflateInit(&zstream, Z_DEFAULT_COMPRESSION);
+
+    zstream.next_in = const_cast<Bytef*>(packet.data() + 2);
+    zstream.avail_in = packet.size() - 2;
+    zstream.next_out = &(*output)[0];
+    zstream.avail_out = output->size();
+
+    deflate(&zstream, Z_FINISH);
+    uint32_t compressed_size = zstream.total_out;
+
+    deflateEnd(&zstream);
+
+    return compressed_size;
+}
+
+// Compresses the payload of a packet the way some clients do, sync flushing the stream
+// rather than finishing it, and appends the compressed flag.
+ByteBuffer CompressWithSyncFlush(const ByteBuffer& packet) {
+    z_stream zstream;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree = Z_NULL;
+    zstream.opaque = Z_NULL;
+
+    deflateInit(&zstream, Z_DEFAULT_COMPRESSION);
+
+    vector<uint8_t> output(496);
+    zstream.next_in = const_cast<Bytef*>(packet.data() + 2);
+    zstream.avail_in = packet.size() - 2;
+    zstream.next_out = &output[0];
+    zstream.avail_out = output.size();
+
+    deflate(&zstream, Z_SYNC_FLUSH);
+
+    ByteBuffer compressed(packet.data(), 2);
+    compressed.write(&output[0], zstream.total_out);
+    compressed.write<uint8_t>(1);
+
+    deflateEnd(&zstream);
+
+    return compressed;
+}
+
+BOOST_FIXTURE_TEST_SUITE(CompressionFilterTest, CompressionFilterTests)
+
+/// This test verifies that a compressed packet is restored by the decompression filter.
+BOOST_AUTO_TEST_CASE(CompressedPacketsRoundTrip) {
+    compression_filter_.compression_threshold(0);
+
+    for (int i = 0; i < 3; ++i) {
+        ByteBuffer packet = buildBaselinePacket();
+        ByteBuffer original = packet;
+
+        compression_filter_(nullptr, &packet);
+
+        BOOST_CHECK_EQUAL(1, packet.peekAt<uint8_t>(packet.size() - 1));
+        BOOST_CHECK(packet.size() < original.size());
+
+        decompression_filter_(nullptr, &packet);
+
+        BOOST_REQUIRE_EQUAL(original.size(), packet.size());
+        BOOST_CHECK(equal(original.data(), original.data() + original.size(), packet.data()));
+    }
+}
+
+/// This test verifies that packets that don't shrink are sent uncompressed.
+BOOST_AUTO_TEST_CASE(IncompressiblePacketsAreSentUncompressed) {
+    compression_filter_.compression_threshold(0);
+
+    ByteBuffer packet = buildRandomPacket();
+    ByteBuffer original = packet;
+
+    compression_filter_(nullptr, &packet);
+
+    BOOST_REQUIRE_EQUAL(original.size() + 1, packet.size());
+    BOOST_CHECK_EQUAL(0, packet.peekAt<uint8_t>(packet.size() - 1));
+    BOOST_CHECK(equal(original.data(), original.data() + original.size(), packet.data()));
+}
+
+/// This test verifies that packets at or under the threshold are not compressed.
+BOOST_AUTO_TEST_CASE(PacketsUnderThresholdAreNotCompressed) {
+    ByteBuffer packet = buildBaselinePacket();
+
+    compression_filter_.compression_threshold(packet.size());
+    compression_filter_(nullptr, &packet);
+
+    BOOST_CHECK_EQUAL(0, packet.peekAt<uint8_t>(packet.size() - 1));
+}
+
+/// This test verifies that the compression level can be changed between packets.
+BOOST_AUTO_TEST_CASE(CompressionLevelCanBeChanged) {
+    compression_filter_.compression_threshold(0);
+
+    for (int level : { 1, 9, 0 }) {
+        compression_filter_.compression_level(level);
+        BOOST_CHECK_EQUAL(level, compression_filter_.compression_level());
+
+        ByteBuffer packet = buildBaselinePacket();
+        ByteBuffer original = packet;
+
+        compression_filter_(nullptr, &packet);
+        decompression_filter_(nullptr, &packet);
+
+        BOOST_CHECK(equal(original.data(), original.data() + original.size(), packet.data()));
+    }
+
+    BOOST_CHECK_THROW(compression_filter_.compression_level(12), invalid_argument);
+}
+
+/// This test verifies that packets whose stream was sync flushed rather than finished
+/// are still decompressed.
+BOOST_AUTO_TEST_CASE(SyncFlushedPacketsAreDecompressed) {
+    ByteBuffer original = buildBaselinePacket();
+    ByteBuffer packet = CompressWithSyncFlush(original);
+
+    decompression_filter_(nullptr, &packet);
+
+    BOOST_REQUIRE_EQUAL(original.size(), packet.size());
+    BOOST_CHECK(equal(original.data(), original.data() + original.size(), packet.data()));
+}
+
+/// This test verifies that a packet whose input is used up while inflating it still
+/// has output pending past the largest message is rejected rather than truncated.
+BOOST_AUTO_TEST_CASE(PacketsInflatingPastTheMaximumSizeAreRejected) {
+    // a zlib header followed by a 7 and back references repeating it 517 times,
+    // the last of which is still being copied out once the input is read
+    const uint8_t compressed[] = {0x78, 0x9c, 0x62, 0x67, 0x1f, 0x05, 0xa3, 0x80};
+
+    ByteBuffer packet;
+    packet.write<uint16_t>(hostToBig<uint16_t>(0x09));
+    packet.write(compressed, sizeof(compressed));
+    packet.write<uint8_t>(1);
+
+    BOOST_CHECK_THROW(decompression_filter_(nullptr, &packet), runtime_error);
+}
+
+/// This test verifies that data that can't be decompressed is rejected.
+BOOST_AUTO_TEST_CASE(DecompressingMalformedPacketThrows) {
+    ByteBuffer packet = buildRandomPacket();
+    packet.write<uint8_t>(1); // compressed
+
+    BOOST_CHECK_THROW(decompression_filter_(nullptr, &packet), runtime_error);
+}
+
+/// Compresses baseline and delta traffic with a new zlib stream per packet and with the
+/// filter's persistent stream, and reports the throughput and compression ratio of each.
+BOOST_AUTO_TEST_CASE(CompressionThroughputOnBaselineAndDeltaTraffic) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t packet_count = 2000;
+
+    compression_filter_.compression_threshold(0);
+
+    vector<ByteBuffer> traffic;
+    for (uint32_t i = 0; i < packet_count; ++i) {
+        traffic.push_back((i % 4 == 0) ? buildBaselinePacket() : buildDeltaPacket());
+    }
+
+    uint64_t input_bytes = 0;
+    for_each(traffic.begin(), traffic.end(), [&input_bytes] (const ByteBuffer& packet) {
+        input_bytes += packet.size();
+    });
+
+    typedef boost::chrono::high_resolution_clock clock;
+    auto megabytes_per_second = [input_bytes] (clock::duration elapsed) {
+        double seconds = boost::chrono::duration<double>(elapsed).count();
+        return (input_bytes / (1024.0 * 1024.0)) / max(seconds, 1e-9);
+    };
+
+    // A new stream for every packet
+    vector<uint8_t> output(496);
+    uint64_t new_stream_bytes = 0;
+
+    auto start = clock::now();
+    for_each(traffic.begin(), traffic.end(), [&] (const ByteBuffer& packet) {
+        new_stream_bytes += 2 + CompressWithNewStream(packet, &output) + 1;
+    });
+    auto new_stream_time = clock::now() - start;
+
+    // The filter's stream, reset between packets
+    vector<ByteBuffer> compressed(traffic);
+    uint64_t filter_bytes = 0;
+
+    start = clock::now();
+    for_each(compressed.begin(), compressed.end(), [&] (ByteBuffer& packet) {
+        compression_filter_(nullptr, &packet);
+        filter_bytes += packet.size();
+    });
+    auto filter_time = clock::now() - start;
+
+    for (uint32_t i = 0; i < packet_count; ++i) {
+        decompression_filter_(nullptr, &compressed[i]);
+        BOOST_REQUIRE(equal(traffic[i].data(), traffic[i].data() + traffic[i].size(), compressed[i].data()));
+    }
+
+    BOOST_CHECK(filter_bytes < input_bytes);
+    BOOST_TEST_MESSAGE(packet_count << " packets, " << input_bytes << " bytes of baseline and delta traffic");
+    BOOST_TEST_MESSAGE("New stream per packet: " << megabytes_per_second(new_stream_time) << " MB/s, "
+        << new_stream_bytes << " bytes out");
+    BOOST_TEST_MESSAGE("Persistent stream:     " << megabytes_per_second(filter_time) << " MB/s, "
+        << filter_bytes << " bytes out");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// Implementation of the CompressionFilterTests's helper members
+
+ByteBuffer CompressionFilterTests::buildBaselinePacket() {
+    static const string templates[] = {
+        "object/creature/player/shared_human_male.iff",
+        "object/tangible/wearables/shirt/shared_shirt_s03.iff",
+        "object/tangible/inventory/shared_character_inventory.iff",
+        "object/weapon/ranged/pistol/shared_pistol_cdef.iff"
+    };
+
+    ByteBuffer packet = buildPacket_();
+
+    while (packet.size() < 400) {
+        ByteBuffer message;
+        message.write<uint16_t>(5);
+        message.write<uint32_t>(0x68A75F0C); // BaselinesMessage
+        message.write<uint64_t>(8589934593 + generator_() % 64);
+        message.write<uint32_t>(0x4352454F); // CREO
+        message.write<uint8_t>(3);
+        message.write<uint32_t>(0);
+        message.write<uint16_t>(13);
+        message.write<float>(1.0f);
+        message.write<string>("species");
+        message.write<uint32_t>(0);
+        message.write<string>("human");
+        message.write<string>(templates[generator_() % 4]);
+        message.write<wstring>(L"Player Name");
+        message.write<uint32_t>(0x000F4240);
+        message.write<uint32_t>(0);
+        message.write<uint64_t>(0);
+        message.write<uint32_t>(0);
+        message.write<float>(static_cast<float>(generator_() % 100) / 10.0f);
+
+        finishPacket_(&packet, &message);
+    }
+
+    return packet;
+}
+
+ByteBuffer CompressionFilterTests::buildDeltaPacket() {
+    ByteBuffer packet = buildPacket_();
+
+    while (packet.size() < 440) {
+        ByteBuffer message;
+        message.write<uint16_t>(5);
+        message.write<uint32_t>(0x12862153); // DeltasMessage
+        message.write<uint64_t>(8589934593 + generator_() % 64);
+        message.write<uint32_t>(0x4352454F); // CREO
+        message.write<uint8_t>(6);
+        message.write<uint32_t>(10);
+        message.write<uint16_t>(1);
+        message.write<uint16_t>(generator_() % 16);
+        message.write<uint32_t>(generator_() % 1000);
+
+        finishPacket_(&packet, &message);
+    }
+
+    return packet;
+}
+
+ByteBuffer CompressionFilterTests::buildRandomPacket() {
+    ByteBuffer packet = buildPacket_();
+
+    while (packet.size() < 480) {
+        packet.write<uint32_t>(generator_());
+    }
+
+    return packet;
+}
+
+ByteBuffer CompressionFilterTests::buildPacket_() {
+    ByteBuffer packet;
+    packet.write<uint16_t>(hostToBig<uint16_t>(0x09));
+    packet.write<uint16_t>(hostToBig<uint16_t>(sequence_++));
+    packet.write<uint16_t>(hostToBig<uint16_t>(0x19));
+
+    return packet;
+}
+
+void CompressionFilterTests::finishPacket_(ByteBuffer* packet, ByteBuffer* message) {
+    packet->write<uint8_t>(static_cast<uint8_t>(message->size()));
+    packet->append(*message);
+}
+
+}  // namespace
@@ -22,12 +22,10 @@ void CrcInFilter::operator()(Session* session, ByteBuffer* message) const
         return;
     }
         
-    // Peel off the crc bits from the packet data.
+    // Read the crc bits from the end of the packet data and then peel them off.
     uint32_t message_size = message->size() - crc_length;
-    vector<uint8_t> crc_bits(message->data() + message_size, message->data() + message->size());
-    message->resize(message_size);
-    
-    uint32_t packet_crc = memcrc(message->data(), message->size(), session->crc_seed());
+    const uint8_t* crc_bits = message->data() + message_size;
+
     uint32_t test_crc = 0;
     uint32_t mask = 0;
 
@@ -37,6 +35,10 @@ void CrcInFilter::operator()(Session* session, ByteBuffer* message) const
         mask |= 0xFF;
     }
 
+    message->resize(message_size);
+    
+    uint32_t packet_crc = memcrc(message->data(), message->size(), session->crc_seed());
+
     packet_crc &= mask;
 
     if (test_crc != packet_crc) 
@@ -3,6 +3,8 @@
 
 #include "anh/network/soe/filters/decompression_filter.h"
 
+#include <stdexcept>
+
 #include "anh/byte_buffer.h"
 #include "anh/network/soe/session.h"
 
@@ -14,7 +16,23 @@ using namespace std;
 DecompressionFilter::DecompressionFilter(uint32_t max_message_size)
     : max_message_size_(max_message_size)
     , decompression_output_(max_message_size_)
-{}
+{
+    zstream_.zalloc = Z_NULL;
+    zstream_.zfree = Z_NULL;
+    zstream_.opaque = Z_NULL;
+    zstream_.avail_in = 0;
+    zstream_.next_in = Z_NULL;
+
+    if (inflateInit(&zstream_) != Z_OK)
+    {
+        throw runtime_error("Unable to initialize decompression stream");
+    }
+}
+
+DecompressionFilter::~DecompressionFilter()
+{
+    inflateEnd(&zstream_);
+}
 
 void DecompressionFilter::operator()(Session* session, ByteBuffer* message)
 {
@@ -30,27 +48,48 @@ void DecompressionFilter::operator()(Session* session, ByteBuffer* message)
 
 void DecompressionFilter::Decompress_(ByteBuffer* buffer) 
 {
-    auto packet_data = buffer->raw();    
+    auto& packet_data = buffer->raw();
 
     uint16_t offset = (packet_data[0] == 0x00) ? 2 : 1;
+
+    if (packet_data.size() <= offset)
+    {
+        throw runtime_error("Compressed message has no payload");
+    }
     
-    zstream_.zalloc = Z_NULL;
-    zstream_.zfree = Z_NULL;
-    zstream_.opaque = Z_NULL;
-    zstream_.avail_in= Z_NULL;
-    zstream_.next_in = Z_NULL;
-    
-    inflateInit(&zstream_);
+    inflateReset(&zstream_);
 
     zstream_.next_in   = reinterpret_cast<Bytef *>(&packet_data[offset]);
     zstream_.avail_in  = packet_data.size() - offset;
     zstream_.next_out  = reinterpret_cast<Bytef *>(&decompression_output_[0]);
     zstream_.avail_out = decompression_output_.size();
 
-    inflate(&zstream_, Z_FINISH); // Decompress Data
+    // Clients may sync flush instead of finishing the stream, so all that's required is
+    // that every byte of input inflates into a maximum sized message.
+    int result = inflate(&zstream_, Z_FINISH);
+    if (result != Z_STREAM_END && !((result == Z_OK || result == Z_BUF_ERROR) && zstream_.avail_in == 0))
+    {
+        throw runtime_error("Malformed message received: unable to decompress");
+    }
+
+    // A full output buffer may still leave inflated data behind, which would otherwise
+    // be dropped and the message passed on truncated.
+    if (result != Z_STREAM_END && zstream_.avail_out == 0)
+    {
+        Bytef overflow;
+        zstream_.next_out  = &overflow;
+        zstream_.avail_out = 1;
+
+        inflate(&zstream_, Z_SYNC_FLUSH);
+
+        if (zstream_.avail_out == 0)
+        {
+            throw runtime_error("Malformed message received: decompresses past the maximum message size");
+        }
+    }
     
+    // Replace the payload in place, the header in front of it is kept as is.
+    buffer->resize(offset);
     buffer->write_position(offset);
     buffer->write(&decompression_output_[0], zstream_.total_out);
-    
-    inflateEnd(&zstream_);
 }
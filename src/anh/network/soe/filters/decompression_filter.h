@@ -23,6 +23,8 @@ namespace filters {
 
     /**
      * @brief Decompresses packet data that is flagged as compressed.
+     *
+     * The inflate stream is set up once and reset for every packet rather than rebuilt.
      */
     class DecompressionFilter {
     public:
@@ -30,11 +32,14 @@ namespace filters {
          * @param max_receive_size Maximum allowed size of incoming messages.
          */
         explicit DecompressionFilter(uint32_t max_message_size);
+        ~DecompressionFilter();
     
         void operator()(Session* session, ByteBuffer* message);
     
     private:
         DecompressionFilter();
+        DecompressionFilter(const DecompressionFilter&);
+        DecompressionFilter& operator=(const DecompressionFilter&);
     
     	void Decompress_(anh::ByteBuffer* buffer);
         
@@ -22,9 +22,6 @@ namespace filters {
     {
     public:
         void operator()(Session* session, ByteBuffer* message) const;
-    
-    private:
-    	int Decrypt_(char* buffer, uint32_t len, uint32_t seed) const;
     };
 
 }}}} // namespace anh::network::soe::filters
@@ -4,6 +4,8 @@
 #include "anh/network/soe/filters/encryption_filter.h"
 
 #include "anh/byte_buffer.h"
+#include "anh/crc.h"
+#include "anh/encryption.h"
 #include "anh/network/soe/session.h"
 
 using namespace anh;
@@ -15,23 +17,22 @@ void EncryptionFilter::operator()(Session* session, ByteBuffer* message)
 {
     uint16_t offset = (message->peek<uint8_t>() == 0x00) ? 2 : 1;
             
-    Encrypt_(
-        (char*)message->data() + offset,
+    EncryptXorChain(
+        &message->raw()[0] + offset,
         message->size() - offset, 
         session->crc_seed());
 }
 
-void EncryptionFilter::Encrypt_(char* data, uint32_t len, uint32_t seed) const
+void EncryptionFilter::EncryptAndAppendCrc(Session* session, ByteBuffer* message)
 {
-    uint32_t blockCount = (len / 4);
-    uint32_t byteCount = (len % 4);
+    uint16_t offset = (message->peek<uint8_t>() == 0x00) ? 2 : 1;
 
-    for(uint32_t count = 0; count < blockCount; count++) {
-        ((uint32_t*)data)[count] ^= seed;
-        seed = ((uint32_t*)data)[count];
-    }
+    uint32_t packet_crc = EncryptXorChainAndCrc(
+        &message->raw()[0],
+        message->size(),
+        offset,
+        session->crc_seed());
 
-    for(uint32_t count = blockCount * 4; count < blockCount * 4 + byteCount; count++) {
-        data[count] ^= seed;
-    }
+    message->write<uint8_t>(static_cast<uint8_t>(packet_crc >> 8));
+    message->write<uint8_t>(static_cast<uint8_t>(packet_crc));
 }
@@ -22,8 +22,11 @@ class EncryptionFilter {
 public:
     void operator()(Session* session, ByteBuffer* message);
 
-private:
-	void Encrypt_(char* buffer, uint32_t len, uint32_t seed) const;
+    /**
+     * Encrypts the message and appends its crc, reading and writing the data once.
+     * Gives the same packet as this filter followed by a CrcOutFilter.
+     */
+    void EncryptAndAppendCrc(Session* session, ByteBuffer* message);
 };
 
 }}}} // namespace anh::network::soe::filters
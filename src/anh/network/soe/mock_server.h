@@ -27,9 +27,12 @@ MOCK_BASE_CLASS(MockServer, ServerInterface )
     MOCK_METHOD(RemoveSession, 1);
     MOCK_METHOD(CreateSession, 1);
     MOCK_METHOD(GetSession, 1);
+    MOCK_METHOD(ScheduleFlush, 1);
+    MOCK_METHOD(ScheduleResend, 1);
 
     MOCK_METHOD(socket, 0);
     MOCK_METHOD(max_receive_size, 0);
+    MOCK_METHOD(packet_pool, 0);
 };
     
 }}}  // namespace anh::network::soe
@@ -0,0 +1,62 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "anh/network/soe/packet_pool.h"
+
+using namespace anh;
+using namespace network::soe;
+using namespace std;
+
+PacketPool::PacketPool(uint32_t packet_size, uint32_t headroom, uint32_t max_pooled)
+    : buffer_capacity_(packet_size + headroom)
+    , max_pooled_(max_pooled)
+    , pooled_(0)
+    , allocations_(0)
+{}
+
+ByteBuffer PacketPool::Acquire()
+{
+    vector<unsigned char> storage;
+
+    if (free_buffers_.try_pop(storage))
+    {
+        --pooled_;
+    }
+    else
+    {
+        storage.reserve(buffer_capacity_);
+        ++allocations_;
+    }
+
+    return ByteBuffer(move(storage));
+}
+
+void PacketPool::Release(ByteBuffer buffer)
+{
+    auto& storage = buffer.raw();
+
+    if (storage.capacity() < buffer_capacity_ || pooled_ >= max_pooled_)
+    {
+        return;
+    }
+
+    storage.clear();
+
+    ++pooled_;
+    free_buffers_.push(move(storage));
+}
+
+uint32_t PacketPool::buffer_capacity() const
+{
+    return buffer_capacity_;
+}
+
+uint64_t PacketPool::allocations() const
+{
+    return allocations_;
+}
+
+uint32_t PacketPool::pooled() const
+{
+    return pooled_;
+}
@@ -0,0 +1,86 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_NETWORK_SOE_PACKET_POOL_H_
+#define ANH_NETWORK_SOE_PACKET_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#ifdef WIN32
+#include <concurrent_queue.h>
+#else
+#include <tbb/concurrent_queue.h>
+
+namespace Concurrency {
+    using ::tbb::concurrent_queue;
+}
+
+#endif
+
+#include "anh/byte_buffer.h"
+
+namespace anh {
+namespace network {
+namespace soe {
+
+/**
+ * @brief Recycles the storage of packet sized buffers.
+ *
+ * Every buffer handed out has room for a full packet plus headroom for the SOE header,
+ * compression flag and crc trailer, so packets can be assembled and run through the
+ * filters without the buffer ever growing. Buffers released back are reused by the
+ * next Acquire instead of going back to the heap.
+ */
+class PacketPool {
+public:
+    /**
+     * @param packet_size The largest packet sent or received.
+     * @param headroom Additional capacity reserved in each buffer.
+     * @param max_pooled The maximum number of idle buffers held on to.
+     */
+    explicit PacketPool(uint32_t packet_size, uint32_t headroom = 16, uint32_t max_pooled = 4096);
+
+    /**
+     * @return An empty buffer able to hold a full packet without growing.
+     */
+    anh::ByteBuffer Acquire();
+
+    /**
+     * Returns a buffer's storage to the pool.
+     *
+     * Buffers that are too small to hold a full packet (copies, moved from buffers and
+     * the like) are left to be freed as usual.
+     */
+    void Release(anh::ByteBuffer buffer);
+
+    /**
+     * @return The capacity of every buffer handed out.
+     */
+    uint32_t buffer_capacity() const;
+
+    /**
+     * @return The number of buffers that had to be allocated because the pool was empty.
+     */
+    uint64_t allocations() const;
+
+    /**
+     * @return The number of idle buffers currently held.
+     */
+    uint32_t pooled() const;
+
+private:
+    PacketPool();
+
+    uint32_t buffer_capacity_;
+    uint32_t max_pooled_;
+
+    Concurrency::concurrent_queue<std::vector<unsigned char>> free_buffers_;
+    std::atomic<uint32_t> pooled_;
+    std::atomic<uint64_t> allocations_;
+};
+
+}}}  // namespace anh::network::soe
+
+#endif  // ANH_NETWORK_SOE_PACKET_POOL_H_
@@ -0,0 +1,233 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/byte_buffer.h"
+#include "anh/utilities.h"
+#include "anh/network/soe/filters/crc_out_filter.h"
+#include "anh/network/soe/packet_pool.h"
+#include "anh/network/soe/session.h"
+
+using namespace boost::asio::ip;
+using namespace std;
+
+namespace {
+
+// Counts every heap allocation made by the test process.
+std::atomic<uint64_t> heap_allocations(0);
+
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    ++heap_allocations;
+
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) throw()
+{
+    std::free(memory);
+}
+
+namespace anh {
+namespace network {
+namespace soe {
+
+/// A server that answers every game message with the same message and recycles
+/// everything it puts on the wire, the way Server does.
+class EchoServer : public ServerInterface {
+public:
+    explicit EchoServer(PacketPool* packet_pool)
+        : packet_pool_(packet_pool)
+        , sent_(0)
+    {}
+
+    void Startup(uint16_t port) {}
+    void Shutdown() {}
+
+    void SendTo(const udp::endpoint& endpoint, ByteBuffer buffer) {
+        ++sent_;
+        packet_pool_->Release(move(buffer));
+    }
+
+    void HandleMessage(const shared_ptr<Session>& session, ByteBuffer message) {
+        session->SendTo(move(message));
+    }
+
+    bool RemoveSession(shared_ptr<Session> session) { return true; }
+    shared_ptr<Session> CreateSession(const udp::endpoint& endpoint) { return nullptr; }
+    shared_ptr<Session> GetSession(const udp::endpoint& endpoint) { return nullptr; }
+
+    // the test updates the session itself
+    void ScheduleFlush(shared_ptr<Session> session) {}
+    void ScheduleResend(shared_ptr<Session> session) {}
+
+    udp::socket* socket() { return nullptr; }
+    uint32_t max_receive_size() { return 496; }
+    PacketPool* packet_pool() { return packet_pool_; }
+
+    uint32_t sent() const { return sent_; }
+
+private:
+    PacketPool* packet_pool_;
+    uint32_t sent_;
+};
+
+class PacketPoolTests {
+protected:
+    PacketPoolTests()
+        : packet_pool_(496)
+    {}
+
+    PacketPool packet_pool_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PacketPoolTest, PacketPoolTests)
+
+/// This test verifies that acquired buffers can hold a full packet without growing.
+BOOST_AUTO_TEST_CASE(AcquiredBuffersHoldAFullPacket) {
+    ByteBuffer buffer = packet_pool_.Acquire();
+
+    BOOST_CHECK_EQUAL(0, buffer.size());
+    BOOST_CHECK(buffer.capacity() >= 496);
+    BOOST_CHECK_EQUAL(packet_pool_.buffer_capacity(), buffer.capacity());
+    BOOST_CHECK_EQUAL(1, packet_pool_.allocations());
+}
+
+/// This test verifies that released buffers are handed out again instead of allocating.
+BOOST_AUTO_TEST_CASE(ReleasedBuffersAreReused) {
+    ByteBuffer buffer = packet_pool_.Acquire();
+    buffer.write<uint32_t>(0xDEADBABE);
+    const unsigned char* storage = buffer.data();
+
+    packet_pool_.Release(move(buffer));
+    BOOST_CHECK_EQUAL(1, packet_pool_.pooled());
+
+    ByteBuffer reused = packet_pool_.Acquire();
+
+    BOOST_CHECK_EQUAL(0, reused.size());
+    BOOST_CHECK_EQUAL(0, reused.write_position());
+    BOOST_CHECK(storage == &reused.raw()[0]);
+    BOOST_CHECK_EQUAL(1, packet_pool_.allocations());
+    BOOST_CHECK_EQUAL(0, packet_pool_.pooled());
+}
+
+/// This test verifies that buffers too small to hold a packet are not pooled.
+BOOST_AUTO_TEST_CASE(SmallBuffersAreNotPooled) {
+    ByteBuffer small_buffer;
+    small_buffer.write<uint32_t>(0xDEADBABE);
+
+    packet_pool_.Release(move(small_buffer));
+
+    BOOST_CHECK_EQUAL(0, packet_pool_.pooled());
+}
+
+/// This test verifies that the pool holds no more than its maximum idle buffers.
+BOOST_AUTO_TEST_CASE(PoolIsBounded) {
+    PacketPool bounded_pool(496, 16, 2);
+
+    for (int i = 0; i < 4; ++i) {
+        bounded_pool.Release(ByteBuffer(bounded_pool.buffer_capacity()));
+    }
+
+    BOOST_CHECK_EQUAL(2, bounded_pool.pooled());
+}
+
+/// Runs game messages through a connected session, from the received datagram through
+/// the incoming filters and dispatch to a reply going back out through the outgoing
+/// filters, and reports the heap allocations made per round trip.
+BOOST_AUTO_TEST_CASE(RoundTripAllocationCount) {
+    boost::asio::io_service io_service;
+    udp::endpoint remote_endpoint(address_v4::from_string("127.0.0.1"), 1000);
+
+    EchoServer server(&packet_pool_);
+    auto session = make_shared<Session>(&server, io_service, remote_endpoint);
+
+    ByteBuffer session_request;
+    SessionRequest(2, 1, 496).serialize(session_request);
+    session->HandleProtocolMessage(move(session_request));
+    io_service.poll();
+    io_service.reset();
+
+    filters::EncryptionFilter encryption_filter;
+    filters::CrcOutFilter crc_output_filter;
+
+    auto round_trip = [&] (uint16_t sequence) {
+        ByteBuffer wire;
+        wire.write<uint16_t>(hostToBig<uint16_t>(0x09));
+        wire.write<uint16_t>(hostToBig<uint16_t>(sequence));
+        wire.write<uint16_t>(1);
+        wire.write<uint32_t>(0xDEADBABE);
+        wire.write<uint64_t>(sequence);
+        wire.write<uint8_t>(0); // not compressed
+        encryption_filter(session.get(), &wire);
+        crc_output_filter(session.get(), &wire);
+
+        // This is where the server's receive path starts.
+        uint64_t allocations_before = heap_allocations;
+
+        ByteBuffer packet = packet_pool_.Acquire();
+        packet.write(wire.data(), wire.size());
+
+        session->HandleProtocolMessage(move(packet));
+        io_service.poll();
+        io_service.reset();
+
+        session->Update();
+        io_service.poll();
+        io_service.reset();
+
+        // The client acknowledges the reply.
+        ByteBuffer ack = packet_pool_.Acquire();
+        AckA(session->server_sequence() - 1).serialize(ack);
+        ack.write<uint8_t>(0); // not compressed
+        encryption_filter(session.get(), &ack);
+        crc_output_filter(session.get(), &ack);
+
+        session->HandleProtocolMessage(move(ack));
+        io_service.poll();
+        io_service.reset();
+
+        return heap_allocations - allocations_before;
+    };
+
+    const uint16_t warmup_count = 100;
+    const uint16_t round_trip_count = 1000;
+
+    uint16_t sequence = 0;
+    for (; sequence < warmup_count; ++sequence) {
+        round_trip(sequence);
+    }
+
+    uint64_t pool_allocations = packet_pool_.allocations();
+    uint64_t allocations = 0;
+
+    for (; sequence < warmup_count + round_trip_count; ++sequence) {
+        allocations += round_trip(sequence);
+    }
+
+    session->Close();
+
+    // Once warmed up every packet buffer comes from the pool.
+    BOOST_CHECK_EQUAL(pool_allocations, packet_pool_.allocations());
+    BOOST_CHECK(server.sent() >= round_trip_count);
+    BOOST_TEST_MESSAGE(round_trip_count << " round trips: " << allocations << " heap allocations ("
+        << static_cast<double>(allocations) / round_trip_count << " per round trip), "
+        << packet_pool_.allocations() << " packet buffers allocated in total");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}}}  // namespace anh::network::soe
@@ -7,15 +7,12 @@
 #include <algorithm>
 #include <stdexcept>
 
-#include <boost/lexical_cast.hpp>
-
 #include "anh/crc.h"
 #include "anh/utilities.h"
 
 using namespace anh;
 using namespace std;
 using anh::memcrc;
-using boost::lexical_cast;
 
 namespace anh {
 namespace network {
@@ -23,22 +20,28 @@ namespace soe {
 
 ByteBuffer BuildDataChannelHeader(uint16_t sequence) {
     ByteBuffer data_channel_header;
-
-    data_channel_header.write<uint16_t>(hostToBig<uint16_t>(0x09));
-    data_channel_header.write<uint16_t>(hostToBig<uint16_t>(sequence));
+    WriteDataChannelHeader(sequence, &data_channel_header);
 
     return data_channel_header;
 }
 
 ByteBuffer BuildFragmentedDataChannelHeader(uint16_t sequence) {
     ByteBuffer data_channel_header;
-
-    data_channel_header.write<uint16_t>(hostToBig<uint16_t>(0x0D));
-    data_channel_header.write<uint16_t>(hostToBig<uint16_t>(sequence));
+    WriteFragmentedDataChannelHeader(sequence, &data_channel_header);
 
     return data_channel_header;
 }
 
+void WriteDataChannelHeader(uint16_t sequence, ByteBuffer* buffer) {
+    buffer->write<uint16_t>(hostToBig<uint16_t>(0x09));
+    buffer->write<uint16_t>(hostToBig<uint16_t>(sequence));
+}
+
+void WriteFragmentedDataChannelHeader(uint16_t sequence, ByteBuffer* buffer) {
+    buffer->write<uint16_t>(hostToBig<uint16_t>(0x0D));
+    buffer->write<uint16_t>(hostToBig<uint16_t>(sequence));
+}
+
 ByteBuffer PackDataChannelMessages(list<ByteBuffer> data_list) {
     ByteBuffer output_buffer;
 
@@ -73,6 +76,41 @@ ByteBuffer PackDataChannelMessages(list<ByteBuffer> data_list) {
     return output_buffer;
 }
 
+ByteBuffer PackDataChannelMessages(const list<shared_ptr<const ByteBuffer>>& data_list) {
+    ByteBuffer output_buffer;
+
+    if (data_list.size() == 1) {
+        output_buffer.write(data_list.front()->data(), data_list.front()->size());
+        return output_buffer;
+    }
+
+    // Size the output up front, every message gets at most 3 bytes of size prefix.
+    size_t packed_size = 2;
+    std::for_each(data_list.begin(), data_list.end(), [&packed_size] (const shared_ptr<const ByteBuffer>& item) {
+        packed_size += item->size() + 3;
+    });
+    output_buffer.reserve(packed_size);
+
+    output_buffer.write<uint16_t>(hostToBig<uint16_t>(0x19));
+
+    std::for_each(
+        data_list.begin(), 
+        data_list.end(), 
+        [&output_buffer] (const shared_ptr<const ByteBuffer>& item)
+    {
+        if (item->size() >= 255) {
+            output_buffer.write<uint8_t>(0xFF);
+            output_buffer.write<uint16_t>(hostToBig<uint16_t>(item->size()));
+        } else {
+            output_buffer.write<uint8_t>(item->size());
+        }
+
+        output_buffer.write(item->data(), item->size());
+    });
+
+    return output_buffer;
+}
+
 list<ByteBuffer> SplitDataChannelMessage(ByteBuffer message, uint32_t max_size) {
     uint32_t message_size = message.size();  
     
@@ -103,9 +141,33 @@ list<ByteBuffer> SplitDataChannelMessage(ByteBuffer message, uint32_t max_size)
     return fragmented_messages;
 }
 
+bool SequenceIsNewer(uint16_t sequence, uint16_t other) {
+    // Sequences are compared within a half range window so that 0x0000 follows 0xFFFF.
+    return static_cast<int16_t>(sequence - other) > 0;
+}
+
 uint32_t CreateEndpointHash(const boost::asio::ip::udp::endpoint& endpoint) {
-    string crc_string = endpoint.address().to_string() + ":" + lexical_cast<string>(endpoint.port());
-    return memcrc(crc_string);
+    // Every datagram is looked up by its endpoint, so the raw address and port are
+    // hashed rather than a string built from them.
+    unsigned char key[18];
+    uint32_t length = 0;
+
+    auto address = endpoint.address();
+    if (address.is_v4()) {
+        auto bytes = address.to_v4().to_bytes();
+        copy(bytes.begin(), bytes.end(), key);
+        length = bytes.size();
+    } else {
+        auto bytes = address.to_v6().to_bytes();
+        copy(bytes.begin(), bytes.end(), key);
+        length = bytes.size();
+    }
+
+    uint16_t port = endpoint.port();
+    key[length++] = static_cast<unsigned char>(port >> 8);
+    key[length++] = static_cast<unsigned char>(port);
+
+    return memcrc(key, length, 0);
 }
 
 }}}  // namespace anh::network::soe
@@ -32,6 +32,22 @@ anh::ByteBuffer BuildDataChannelHeader(uint16_t sequence);
  */
 anh::ByteBuffer BuildFragmentedDataChannelHeader(uint16_t sequence);
 
+/**
+ * Writes a data channel message header with the provided sequence to a buffer.
+ *
+ * @param sequence The sequence of the data channel message header being written.
+ * @param buffer The buffer to write the header to.
+ */
+void WriteDataChannelHeader(uint16_t sequence, anh::ByteBuffer* buffer);
+
+/**
+ * Writes a fragmented data channel message header with the provided sequence to a buffer.
+ *
+ * @param sequence The sequence of the data channel message header being written.
+ * @param buffer The buffer to write the header to.
+ */
+void WriteFragmentedDataChannelHeader(uint16_t sequence, anh::ByteBuffer* buffer);
+
 /**
  * Packs a list of game messages into a single message body.
  *
@@ -40,6 +56,16 @@ anh::ByteBuffer BuildFragmentedDataChannelHeader(uint16_t sequence);
  */
 anh::ByteBuffer PackDataChannelMessages(std::list<anh::ByteBuffer> data_list);
 
+/**
+ * Packs a list of shared game messages into a single message body.
+ *
+ * The messages are copied into the body and left untouched.
+ *
+ * @param data_list A list of game messages to pack.
+ * @return A single data channel message containing 1 or more game messages.
+ */
+anh::ByteBuffer PackDataChannelMessages(const std::list<std::shared_ptr<const anh::ByteBuffer>>& data_list);
+
 /**
  * Splits a large data channel message into fragments.
  *
@@ -49,6 +75,15 @@ anh::ByteBuffer PackDataChannelMessages(std::list<anh::ByteBuffer> data_list);
  */
 std::list<anh::ByteBuffer> SplitDataChannelMessage(anh::ByteBuffer message, uint32_t max_size);
 
+/**
+ * Compares two sequence numbers, taking 16 bit wraparound into account.
+ *
+ * @param sequence The sequence being tested.
+ * @param other The sequence to compare against.
+ * @return True if sequence was issued after other.
+ */
+bool SequenceIsNewer(uint16_t sequence, uint16_t other);
+
 /**
  * Creates a uint32_t hash from an endpoint.
  *
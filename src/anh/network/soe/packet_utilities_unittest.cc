@@ -2,6 +2,7 @@
 // See file LICENSE or go to http://swganh.com/LICENSE
 
 #include <list>
+#include <memory>
 #include <stdexcept>
 #include <tuple>
 #include <boost/test/unit_test.hpp>
@@ -71,6 +72,34 @@ BOOST_AUTO_TEST_CASE(PackingMultipleMessagesAddsMultiMessageHeader) {
 }
 
 
+/// This test ensures that shared messages are packed the same as owned messages and are
+/// left untouched.
+BOOST_AUTO_TEST_CASE(PackingSharedMessagesMatchesPackingOwnedMessages) {
+    ByteBuffer small_buffer;
+    small_buffer.write<uint32_t>(500);
+
+    ByteBuffer large_buffer;
+    for (uint32_t i = 0; i < 100; ++i) {
+        large_buffer.write<uint32_t>(i);
+    }
+
+    list<ByteBuffer> buffer_list;
+    buffer_list.push_back(small_buffer);
+    buffer_list.push_back(large_buffer);
+
+    auto shared_large_buffer = make_shared<const ByteBuffer>(large_buffer);
+
+    list<shared_ptr<const ByteBuffer>> shared_list;
+    shared_list.push_back(make_shared<const ByteBuffer>(small_buffer));
+    shared_list.push_back(shared_large_buffer);
+
+    ByteBuffer out_buffer = PackDataChannelMessages(move(buffer_list));
+    ByteBuffer shared_out_buffer = PackDataChannelMessages(shared_list);
+
+    BOOST_CHECK(out_buffer == shared_out_buffer);
+    BOOST_CHECK(*shared_large_buffer == large_buffer);
+}
+
 /// This test ensures that when packing multiple swg messages that any of the messages with
 /// a length smaller than 255 has an uint8_t size prefixed to them.
 BOOST_AUTO_TEST_CASE(SmallSwgMessagesHave8ByteSizePrefix) {
@@ -141,6 +170,17 @@ BOOST_AUTO_TEST_CASE(SplittingDataChannelMessagePrefixesTotalSizeToFirstMessage)
     BOOST_CHECK_EQUAL(302, split_message.front().read<uint32_t>(true));
 }
 
+/// This test verifies that sequence comparisons handle the 16 bit wraparound.
+BOOST_AUTO_TEST_CASE(SequenceComparisonHandlesWraparound) {
+    BOOST_CHECK(SequenceIsNewer(2, 1));
+    BOOST_CHECK(!SequenceIsNewer(1, 2));
+    BOOST_CHECK(!SequenceIsNewer(1, 1));
+
+    BOOST_CHECK(SequenceIsNewer(0x0000, 0xFFFF));
+    BOOST_CHECK(SequenceIsNewer(0x0005, 0xFFF0));
+    BOOST_CHECK(!SequenceIsNewer(0xFFF0, 0x0005));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 // Implementation of the PacketUtilitiesTests's helper members
 
@@ -108,7 +108,13 @@ struct MultiPacket
     void serialize(anh::ByteBuffer& buffer) {
         buffer.write<uint16_t>(anh::bigToHost<uint16_t>(soe_opcode));
         std::for_each(packets.begin(), packets.end(), [=, &buffer](ByteBuffer& other_buffer) {
-            buffer.write<uint16_t>(anh::bigToHost<uint16_t>(other_buffer.size()));
+            // Sizes of 255 and up are escaped with 0xFF followed by a big endian uint16_t.
+            if (other_buffer.size() >= 0xFF) {
+                buffer.write<uint8_t>(0xFF);
+                buffer.write<uint16_t>(anh::hostToBig<uint16_t>(other_buffer.size()));
+            } else {
+                buffer.write<uint8_t>(other_buffer.size());
+            }
             buffer.append(other_buffer);
         });
     }
@@ -117,6 +123,9 @@ struct MultiPacket
         soe_opcode = buffer.read<uint16_t>(true);
         while(buffer.read_position() < buffer.size()) {
             uint16_t next_chunk_size = buffer.read<uint8_t>();
+            if (next_chunk_size == 0xFF) {
+                next_chunk_size = buffer.read<uint16_t>(true);
+            }
             // Varify that we have enough bytes left to copy.
             if(buffer.size() - buffer.read_position() >= next_chunk_size) {    
                 anh::ByteBuffer chunk(buffer.data() + buffer.read_position(), next_chunk_size);
@@ -3,8 +3,18 @@
 
 #include "anh/network/soe/server.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#define ANH_SOE_HAS_MMSG
+#endif
+
+#include <boost/thread/thread.hpp>
+
 #include "anh/logger.h"
-#include <boost/pool/pool_alloc.hpp>
 
 #include "anh/byte_buffer.h"
 
@@ -17,73 +27,497 @@ using namespace std;
 using boost::asio::ip::udp;
 using boost::asio::buffer;
 
-Server::Server(boost::asio::io_service& io_service)
-    : socket_(io_service)
+namespace {
+
+    // The number of datagrams read or written with a single system call.
+    const uint32_t receive_batch_size = 16;
+    const uint32_t send_batch_size = 32;
+
+    // How often sessions waiting on acks are updated, well under the smallest retransmit timeout.
+    const boost::posix_time::milliseconds resend_interval(20);
+
+    // How long sends back off while the kernel is out of buffers.
+    const boost::posix_time::milliseconds send_retry_interval(1);
+
+#ifdef SO_REUSEPORT
+    typedef boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
+#endif
+
+}  // namespace
+
+/**
+ * The buffers a single receiver reads into, owned by one outstanding receive at a time.
+ */
+struct Server::Receiver
+{
+    Receiver(udp::socket* socket_, uint32_t max_receive_size_)
+        : socket(socket_)
+        , max_receive_size(max_receive_size_)
+        , data(receive_batch_size * max_receive_size_)
+        , lengths(receive_batch_size)
+        , endpoints(receive_batch_size)
+#ifdef ANH_SOE_HAS_MMSG
+        , iovecs(receive_batch_size)
+        , headers(receive_batch_size)
+#endif
+    {
+#ifdef ANH_SOE_HAS_MMSG
+        memset(&headers[0], 0, headers.size() * sizeof(mmsghdr));
+
+        for (uint32_t i = 0; i < receive_batch_size; ++i)
+        {
+            iovecs[i].iov_base = buffer(i);
+            iovecs[i].iov_len = max_receive_size;
+
+            headers[i].msg_hdr.msg_name = endpoints[i].data();
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+#endif
+    }
+
+    char* buffer(uint32_t index) { return &data[index * max_receive_size]; }
+
+    udp::socket* socket;
+    uint32_t max_receive_size;
+    vector<char> data;
+    vector<size_t> lengths;
+    vector<udp::endpoint> endpoints;
+#ifdef ANH_SOE_HAS_MMSG
+    vector<iovec> iovecs;
+    vector<mmsghdr> headers;
+#endif
+};
+
+Server::Server(boost::asio::io_service& io_service, uint32_t receiver_count)
+    : io_service_(io_service)
+    , receiver_count_(receiver_count ? receiver_count : max(boost::thread::hardware_concurrency(), 1u))
+    , flush_scheduled_(false)
+    , send_retry_timer_(io_service)
+    , session_flush_scheduled_(false)
+    , coalescing_timer_(io_service)
+    , coalescing_delay_(0)
+    , resend_timer_(io_service)
+    , bytes_recv_(0)
+    , bytes_sent_(0)
     , max_receive_size_(496)
-{}
+    , packet_pool_(max_receive_size_)
+{
+    for (uint32_t i = 0; i < receiver_count_; ++i)
+    {
+        sockets_.push_back(make_shared<udp::socket>(io_service));
+    }
+}
 
 Server::~Server(void)
-{	
+{
 }
 
 void Server::Startup(uint16_t port)
 {
-    socket_.open(udp::v4());
-    socket_.bind(udp::endpoint(udp::v4(), port));
-    
-    AsyncReceive();
+    auto& first_socket = *sockets_.front();
+    first_socket.open(udp::v4());
+
+    bool share_port = false;
+
+#ifdef SO_REUSEPORT
+    if (sockets_.size() > 1)
+    {
+        boost::system::error_code error;
+        first_socket.set_option(reuse_port(true), error);
+        share_port = !error;
+    }
+#endif
+
+    first_socket.bind(udp::endpoint(udp::v4(), port));
+
+    // Any additional sockets share the port the first one was bound to.
+    port = first_socket.local_endpoint().port();
+
+    uint32_t socket_count = 1;
+
+#ifdef SO_REUSEPORT
+    for (; share_port && socket_count < sockets_.size(); ++socket_count)
+    {
+        auto& socket = *sockets_[socket_count];
+        boost::system::error_code error;
+
+        socket.open(udp::v4(), error);
+        if (!error) socket.set_option(reuse_port(true), error);
+        if (!error) socket.bind(udp::endpoint(udp::v4(), port), error);
+
+        if (error)
+        {
+            LOG(warning) << "Unable to share port " << port << " across sockets: " << error.message();
+            socket.close(error);
+            break;
+        }
+    }
+#endif
+
+    // A socket is only read by one receiver at a time so that datagrams from an endpoint
+    // reach its session in the order they arrived. Without SO_REUSEPORT that leaves a
+    // single receiver.
+    receiver_count_ = socket_count;
+
+    for (uint32_t i = 0; i < receiver_count_; ++i)
+    {
+        receivers_.push_back(make_shared<Receiver>(sockets_[i].get(), max_receive_size_));
+    }
+
+    for_each(receivers_.begin(), receivers_.end(), [this] (const shared_ptr<Receiver>& receiver) {
+        AsyncReceive(receiver);
+    });
+
+    WaitForResendTick_();
 }
 
 void Server::Shutdown(void) {
-    socket_.close();
+    for_each(sockets_.begin(), sockets_.end(), [] (const shared_ptr<udp::socket>& socket) {
+        boost::system::error_code error;
+        socket->close(error);
+    });
+
+    boost::system::error_code error;
+    resend_timer_.cancel(error);
+    coalescing_timer_.cancel(error);
+    send_retry_timer_.cancel(error);
 }
-    
+
 void Server::SendTo(const udp::endpoint& endpoint, ByteBuffer buffer) {
-    socket_.async_send_to(boost::asio::buffer(buffer.data(), buffer.size()), 
-        endpoint, 
-        [this] (const boost::system::error_code& error, std::size_t bytes_transferred)
+    outgoing_messages_.push(make_pair(endpoint, move(buffer)));
+
+    // Only one flush is in flight at a time, it picks up everything queued until it runs.
+    if (!flush_scheduled_.exchange(true))
     {
-        if (bytes_transferred == 0)
+        io_service_.post([this] () { FlushOutgoing_(); });
+    }
+}
+
+void Server::FlushOutgoing_() {
+    auto& socket = *sockets_.front();
+
+    // Messages held back the last time the socket was full go out first.
+    vector<EndpointMessage> batch;
+    batch.swap(blocked_messages_);
+    batch.reserve(send_batch_size);
+
+    EndpointMessage message;
+
+    for (;;)
+    {
+        while (batch.size() < send_batch_size && outgoing_messages_.try_pop(message))
         {
-            LOG(warning) << "Sent 0 bytes";
+            batch.push_back(move(message));
         }
 
-        bytes_sent_ += bytes_transferred;
+        if (batch.empty())
+        {
+            break;
+        }
+
+        uint32_t sent = 0;
+        boost::system::error_code blocked;
+
+#ifdef ANH_SOE_HAS_MMSG
+        mmsghdr headers[send_batch_size];
+        iovec iovecs[send_batch_size];
+        memset(headers, 0, sizeof(headers));
+
+        for (uint32_t i = 0; i < batch.size(); ++i)
+        {
+            iovecs[i].iov_base = &batch[i].second.raw()[0];
+            iovecs[i].iov_len = batch[i].second.size();
+
+            headers[i].msg_hdr.msg_name = batch[i].first.data();
+            headers[i].msg_hdr.msg_namelen = batch[i].first.size();
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        while (sent < batch.size())
+        {
+            int result = ::sendmmsg(socket.native_handle(), &headers[sent], batch.size() - sent, 0);
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (result <= 0)
+            {
+                boost::system::error_code error(errno, boost::system::system_category());
+                if (error == boost::asio::error::would_block || error == boost::asio::error::no_buffer_space)
+                {
+                    blocked = error;
+                    break;
+                }
+
+                // Anything else is down to the first unsent message alone, skip it and carry on.
+                LOG(warning) << "Failed sending message: " << error.message();
+                ++sent;
+                continue;
+            }
+
+            for (int i = 0; i < result; ++i)
+            {
+                bytes_sent_ += headers[sent + i].msg_len;
+            }
+
+            sent += result;
+        }
+#else
+        for (; sent < batch.size(); ++sent)
+        {
+            boost::system::error_code error;
+            bytes_sent_ += socket.send_to(
+                boost::asio::buffer(batch[sent].second.data(), batch[sent].second.size()),
+                batch[sent].first, 0, error);
+
+            if (error == boost::asio::error::would_block || error == boost::asio::error::no_buffer_space)
+            {
+                blocked = error;
+                break;
+            }
+
+            if (error)
+            {
+                LOG(warning) << "Failed sending message: " << error.message();
+            }
+        }
+#endif
+
+        // The sent buffers are recycled for the next packets received or built.
+        for_each(batch.begin(), batch.begin() + sent, [this] (EndpointMessage& outgoing) {
+            packet_pool_.Release(move(outgoing.second));
+        });
+
+        if (blocked)
+        {
+            // Keep the rest in order and hold on to the flush until the socket can take them.
+            batch.erase(batch.begin(), batch.begin() + sent);
+            blocked_messages_ = move(batch);
+
+            WaitToSend_(blocked);
+            return;
+        }
+
+        batch.clear();
+    }
+
+    flush_scheduled_ = false;
+
+    // Catch anything queued after the last pop but before the flag was cleared.
+    if (!outgoing_messages_.empty() && !flush_scheduled_.exchange(true))
+    {
+        io_service_.post([this] () { FlushOutgoing_(); });
+    }
+}
+
+void Server::WaitToSend_(const boost::system::error_code& blocked) {
+    if (blocked == boost::asio::error::no_buffer_space)
+    {
+        // The socket still polls as writable while the kernel is out of buffers, back off instead.
+        send_retry_timer_.expires_from_now(send_retry_interval);
+        send_retry_timer_.async_wait([this] (const boost::system::error_code& error) {
+            if (!error)
+            {
+                FlushOutgoing_();
+            }
+        });
+
+        return;
+    }
+
+    sockets_.front()->async_send(
+        boost::asio::null_buffers(),
+        [this] (const boost::system::error_code& error, std::size_t)
+    {
+        if (!error)
+        {
+            FlushOutgoing_();
+        }
+    });
+}
+
+void Server::ScheduleFlush(shared_ptr<Session> session) {
+    ready_sessions_.push(move(session));
+
+    // Only one flush is in flight at a time, it updates every session queued until it runs.
+    if (!session_flush_scheduled_.exchange(true))
+    {
+        StartSessionFlush_();
+    }
+}
+
+void Server::StartSessionFlush_() {
+    if (coalescing_delay_ == boost::chrono::milliseconds::zero())
+    {
+        io_service_.post([this] () { FlushSessions_(); });
+        return;
+    }
+
+    coalescing_timer_.expires_from_now(boost::posix_time::milliseconds(coalescing_delay_.count()));
+    coalescing_timer_.async_wait([this] (const boost::system::error_code& error) {
+        if (!error)
+        {
+            FlushSessions_();
+        }
+    });
+}
+
+void Server::FlushSessions_() {
+    shared_ptr<Session> session;
+
+    while (ready_sessions_.try_pop(session))
+    {
+        session->Update();
+    }
+
+    session_flush_scheduled_ = false;
+
+    // Catch any session queued after the last pop but before the flag was cleared.
+    if (!ready_sessions_.empty() && !session_flush_scheduled_.exchange(true))
+    {
+        StartSessionFlush_();
+    }
+}
+
+void Server::ScheduleResend(shared_ptr<Session> session) {
+    resending_sessions_.push(move(session));
+}
+
+void Server::WaitForResendTick_() {
+    resend_timer_.expires_from_now(resend_interval);
+    resend_timer_.async_wait([this] (const boost::system::error_code& error) {
+        if (!error)
+        {
+            ResendTick_();
+        }
     });
 }
 
+void Server::ResendTick_() {
+    // Sessions still waiting on acks queue themselves again, only visit the ones queued so far.
+    size_t session_count = resending_sessions_.unsafe_size();
+    shared_ptr<Session> session;
+
+    for (size_t i = 0; i < session_count && resending_sessions_.try_pop(session); ++i)
+    {
+        session->UpdateResends();
+    }
+
+    WaitForResendTick_();
+}
+
+boost::chrono::milliseconds Server::coalescing_delay() const {
+    return coalescing_delay_;
+}
+
+void Server::coalescing_delay(boost::chrono::milliseconds coalescing_delay) {
+    coalescing_delay_ = coalescing_delay;
+}
+
 string Server::Resolve(const string& hostname)
 {
-    udp::resolver resolver(socket_.get_io_service());
+    udp::resolver resolver(io_service_);
     udp::resolver::query query(udp::v4(), hostname, "");
     udp::endpoint resolved_endpoint = *resolver.resolve(query);
 
     return resolved_endpoint.address().to_string();
 }
 
-void Server::AsyncReceive() {
-    socket_.async_receive_from(
-        buffer(&recv_buffer_[0], recv_buffer_.size()), 
-        current_remote_endpoint_,
-        [this] (const boost::system::error_code& error, std::size_t bytes_transferred) {
-            if(!error || error == boost::asio::error::message_size)
-            {
-                bytes_recv_ += bytes_transferred;
+void Server::AsyncReceive(const shared_ptr<Receiver>& receiver) {
+#ifdef ANH_SOE_HAS_MMSG
+    // Wait for the socket to become readable and then drain as much as possible at once.
+    receiver->socket->async_receive(
+        boost::asio::null_buffers(),
+        [this, receiver] (const boost::system::error_code& error, std::size_t)
+    {
+        if (error)
+        {
+            return;
+        }
 
-                ByteBuffer message;
-                message.write((const unsigned char*)recv_buffer_.data(), bytes_transferred);
+        for_each(receiver->headers.begin(), receiver->headers.end(), [&receiver] (mmsghdr& header) {
+            header.msg_hdr.msg_namelen = receiver->endpoints[0].capacity();
+        });
 
-                GetSession(current_remote_endpoint_)->HandleProtocolMessage(move(message));
+        int received = ::recvmmsg(
+            receiver->socket->native_handle(),
+            &receiver->headers[0],
+            receiver->headers.size(),
+            MSG_DONTWAIT,
+            nullptr);
 
-                AsyncReceive();
-            }
+        for (int i = 0; i < received; ++i)
+        {
+            receiver->lengths[i] = receiver->headers[i].msg_len;
+            receiver->endpoints[i].resize(receiver->headers[i].msg_hdr.msg_namelen);
+        }
+
+        HandleReceived_(receiver, max(received, 0));
+    });
+#else
+    receiver->socket->async_receive_from(
+        buffer(receiver->buffer(0), receiver->max_receive_size),
+        receiver->endpoints[0],
+        [this, receiver] (const boost::system::error_code& error, std::size_t bytes_transferred)
+    {
+        if(!error || error == boost::asio::error::message_size)
+        {
+            receiver->lengths[0] = bytes_transferred;
+            HandleReceived_(receiver, 1);
+        }
     });
+#endif
+}
+
+void Server::HandleReceived_(const shared_ptr<Receiver>& receiver, uint32_t message_count) {
+    // Hand every datagram to its session's strand before the receiver is rearmed, the
+    // next batch from the socket then always queues up behind this one.
+    for (uint32_t i = 0; i < message_count; ++i)
+    {
+        bytes_recv_ += receiver->lengths[i];
+
+        auto session = GetSession(receiver->endpoints[i]);
+        if (session)
+        {
+            ByteBuffer message = packet_pool_.Acquire();
+            message.write(reinterpret_cast<const unsigned char*>(receiver->buffer(i)), receiver->lengths[i]);
+
+            session->HandleProtocolMessage(move(message));
+        }
+    }
+
+    AsyncReceive(receiver);
 }
 
 boost::asio::ip::udp::socket* Server::socket() {
-    return &socket_;
+    return sockets_.front().get();
 }
 
 uint32_t Server::max_receive_size() {
     return max_receive_size_;
 }
+
+PacketPool* Server::packet_pool() {
+    return &packet_pool_;
+}
+
+uint32_t Server::socket_count() const {
+    return count_if(sockets_.begin(), sockets_.end(), [] (const shared_ptr<udp::socket>& socket) {
+        return socket->is_open();
+    });
+}
+
+uint32_t Server::receiver_count() const {
+    return receiver_count_;
+}
+
+uint64_t Server::bytes_received() const {
+    return bytes_recv_;
+}
+
+uint64_t Server::bytes_sent() const {
+    return bytes_sent_;
+}
@@ -4,11 +4,27 @@
 #ifndef ANH_NETWORK_SOE_SERVER_H_
 #define ANH_NETWORK_SOE_SERVER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <vector>
+
+#ifdef WIN32
+#include <concurrent_queue.h>
+#else
+#include <tbb/concurrent_queue.h>
+
+namespace Concurrency {
+    using ::tbb::concurrent_queue;
+}
+
+#endif
 
 #include <boost/asio.hpp>
+#include <boost/chrono.hpp>
 
+#include "anh/byte_buffer.h"
+#include "anh/network/soe/packet_pool.h"
 #include "anh/network/soe/server_interface.h"
 
 namespace anh {
@@ -24,35 +40,98 @@ class Session;
 /**
  * @brief An SOE Protocol Service.
  *
- * 
+ * Incoming datagrams are read by several receivers at once so that the receive path
+ * scales with the io_service threads. Where the platform supports SO_REUSEPORT each
+ * receiver gets its own socket bound to the listen port and the kernel spreads remote
+ * endpoints across them, otherwise a single receiver reads the one socket. On Linux each
+ * receiver drains its socket in batches with recvmmsg. Datagrams from an endpoint are
+ * always handed to its session in the order they arrived.
+ *
+ * Outgoing datagrams are queued and flushed in batches, with sendmmsg where available.
+ * When the socket is full the flush waits for it to become writable and picks up where
+ * it left off.
+ *
+ * Sessions are only updated when they have work. A session queues itself for a flush
+ * when it is given something to send, and for the resend tick while it has messages
+ * waiting on an ack, idle sessions cost nothing.
  */
 class Server : public ServerInterface {
 public:
-    explicit Server(boost::asio::io_service& io_service);
+    /**
+     * @param io_service The io_service that drives this server.
+     * @param receiver_count The number of concurrent receivers, 0 uses one per hardware thread.
+     *     Receivers need a socket each, so fewer may be started if the port can't be shared.
+     */
+    explicit Server(boost::asio::io_service& io_service, uint32_t receiver_count = 0);
 
     ~Server();
 
     /**
      * @brief Starts the SOE Frontend Service.
-     * 
-     * @parama port The port to listen for messages on.
+     *
+     * @parama port The port to listen for messages on, 0 picks any free port.
      */
     void Startup(uint16_t port);
-    
+
     /**
      * @brief
      */
     void Shutdown(void);
-    
+
     /**
      * @brief Sends a message on the wire to the target endpoint.
      */
     void SendTo(const boost::asio::ip::udp::endpoint& endpoint, anh::ByteBuffer buffer);
 
+    /**
+     * Queues a session that has something to send.
+     *
+     * The first session queued after a flush starts the coalescing delay, every session
+     * queued by the time it runs is updated together.
+     */
+    void ScheduleFlush(std::shared_ptr<Session> session);
+
+    /**
+     * Queues a session with unacknowledged messages to be updated by the next resend tick.
+     */
+    void ScheduleResend(std::shared_ptr<Session> session);
+
+    /**
+     * @return The time a flush waits for more sessions to be queued.
+     */
+    boost::chrono::milliseconds coalescing_delay() const;
+
+    /**
+     * Sets the time a flush waits for more sessions to be queued, set before Startup.
+     *
+     * With no delay sessions are flushed as soon as an io_service thread is free. A
+     * delay of a few milliseconds packs bursts of messages into fewer packets, at the
+     * cost of that much latency on each send.
+     */
+    void coalescing_delay(boost::chrono::milliseconds coalescing_delay);
+
     boost::asio::ip::udp::socket* socket();
-    
+
     uint32_t max_receive_size();
 
+    /**
+     * @return The pool shared by every packet sent or received through this server.
+     */
+    PacketPool* packet_pool();
+
+    /**
+     * @return The number of sockets bound to the listen port.
+     */
+    uint32_t socket_count() const;
+
+    /**
+     * @return The number of concurrent receivers, once started one per socket.
+     */
+    uint32_t receiver_count() const;
+
+    uint64_t bytes_received() const;
+    uint64_t bytes_sent() const;
+
     /**
      * Resolves a hostname to its ip.
      *
@@ -60,19 +139,46 @@ public:
      * \return The ip the hostname resolves to.
      */
     std::string Resolve(const std::string& hostname);
-    
+
 private:
+    struct Receiver;
+
+    typedef std::pair<boost::asio::ip::udp::endpoint, anh::ByteBuffer> EndpointMessage;
+
     Server();
-    
-    void AsyncReceive();
-    
-    boost::asio::ip::udp::socket socket_;
-    boost::asio::ip::udp::endpoint current_remote_endpoint_;
-    std::array<char, 496> recv_buffer_;
-    
-    uint64_t bytes_recv_;
-    uint64_t bytes_sent_;
+
+    void AsyncReceive(const std::shared_ptr<Receiver>& receiver);
+    void HandleReceived_(const std::shared_ptr<Receiver>& receiver, uint32_t message_count);
+    void FlushOutgoing_();
+    void WaitToSend_(const boost::system::error_code& blocked);
+    void StartSessionFlush_();
+    void FlushSessions_();
+    void WaitForResendTick_();
+    void ResendTick_();
+
+    boost::asio::io_service& io_service_;
+    std::vector<std::shared_ptr<boost::asio::ip::udp::socket>> sockets_;
+    std::vector<std::shared_ptr<Receiver>> receivers_;
+    uint32_t receiver_count_;
+
+    Concurrency::concurrent_queue<EndpointMessage> outgoing_messages_;
+    std::vector<EndpointMessage> blocked_messages_;
+    std::atomic<bool> flush_scheduled_;
+    boost::asio::deadline_timer send_retry_timer_;
+
+    Concurrency::concurrent_queue<std::shared_ptr<Session>> ready_sessions_;
+    std::atomic<bool> session_flush_scheduled_;
+    boost::asio::deadline_timer coalescing_timer_;
+    boost::chrono::milliseconds coalescing_delay_;
+
+    Concurrency::concurrent_queue<std::shared_ptr<Session>> resending_sessions_;
+    boost::asio::deadline_timer resend_timer_;
+
+    std::atomic<uint64_t> bytes_recv_;
+    std::atomic<uint64_t> bytes_sent_;
     uint32_t max_receive_size_;
+
+    PacketPool packet_pool_;
 };
 
 }}} // namespace anh::network::soe
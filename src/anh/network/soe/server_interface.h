@@ -23,6 +23,7 @@ namespace anh {
 namespace network {
 namespace soe {
 
+class PacketPool;
 class Session;
 class SessionManager;
 class Socket;
@@ -46,10 +47,22 @@ public:
     virtual std::shared_ptr<Session> CreateSession(const boost::asio::ip::udp::endpoint& endpoint) = 0;
     
     virtual std::shared_ptr<Session> GetSession(const boost::asio::ip::udp::endpoint& endpoint) = 0;
+
+    /**
+     * Queues a session that has something to send, it is updated by the next flush.
+     */
+    virtual void ScheduleFlush(std::shared_ptr<Session> session) = 0;
+
+    /**
+     * Queues a session with unacknowledged messages, it is updated by the next resend tick.
+     */
+    virtual void ScheduleResend(std::shared_ptr<Session> session) = 0;
     
     virtual boost::asio::ip::udp::socket* socket() = 0;
 
     virtual uint32_t max_receive_size() = 0;
+
+    virtual PacketPool* packet_pool() = 0;
 };
 
 }}} // namespace anh::network::soe
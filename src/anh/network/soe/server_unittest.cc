@@ -0,0 +1,376 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/byte_buffer.h"
+#include "anh/network/soe/server.h"
+#include "anh/network/soe/session.h"
+
+using namespace boost::asio::ip;
+using namespace std;
+
+namespace anh {
+namespace network {
+namespace soe {
+
+/// A server that creates a plain session per remote endpoint and counts the game
+/// messages those sessions hand back to it.
+class CountingServer : public Server {
+public:
+    CountingServer(boost::asio::io_service& io_service, uint32_t receiver_count)
+        : Server(io_service, receiver_count)
+        , io_service_(io_service)
+        , received_(0)
+    {}
+
+    void HandleMessage(const shared_ptr<Session>& session, ByteBuffer message) {
+        last_sender_ = session->remote_endpoint();
+        ++received_;
+    }
+
+    bool RemoveSession(shared_ptr<Session> session) {
+        boost::lock_guard<boost::mutex> lock(session_mutex_);
+        return sessions_.erase(session->remote_endpoint()) > 0;
+    }
+
+    shared_ptr<Session> CreateSession(const udp::endpoint& endpoint) {
+        return GetSession(endpoint);
+    }
+
+    shared_ptr<Session> GetSession(const udp::endpoint& endpoint) {
+        boost::lock_guard<boost::mutex> lock(session_mutex_);
+
+        auto& session = sessions_[endpoint];
+        if (!session) {
+            session = make_shared<Session>(this, io_service_, endpoint);
+        }
+
+        return session;
+    }
+
+    uint64_t received() const { return received_; }
+
+    udp::endpoint last_sender() const { return last_sender_; }
+
+private:
+    boost::asio::io_service& io_service_;
+    boost::mutex session_mutex_;
+    map<udp::endpoint, shared_ptr<Session>> sessions_;
+    atomic<uint64_t> received_;
+    udp::endpoint last_sender_;
+};
+
+/// A server that never puts anything on the wire, it records how long each session's
+/// message took from SendTo to the socket instead. Sessions are told apart by port,
+/// resends are not counted.
+class LatencyServer : public CountingServer {
+public:
+    LatencyServer(boost::asio::io_service& io_service, uint32_t session_count)
+        : CountingServer(io_service, 1)
+        , send_times_(session_count)
+        , sending_(new atomic<bool>[session_count])
+    {
+        for (uint32_t i = 0; i < session_count; ++i) {
+            sending_[i] = false;
+        }
+    }
+
+    void SendTo(const udp::endpoint& endpoint, ByteBuffer buffer) {
+        uint32_t index = endpoint.port() - kFirstPort;
+        if (!sending_[index].exchange(false)) {
+            return;
+        }
+
+        auto latency = boost::chrono::steady_clock::now() - send_times_[index];
+
+        boost::lock_guard<boost::mutex> lock(latency_mutex_);
+        latencies_.push_back(boost::chrono::duration_cast<boost::chrono::microseconds>(latency));
+    }
+
+    void Send(const shared_ptr<Session>& session, ByteBuffer message) {
+        uint32_t index = session->remote_endpoint().port() - kFirstPort;
+
+        send_times_[index] = boost::chrono::steady_clock::now();
+        sending_[index] = true;
+        session->SendTo(move(message));
+    }
+
+    size_t latency_count() {
+        boost::lock_guard<boost::mutex> lock(latency_mutex_);
+        return latencies_.size();
+    }
+
+    // the send latency below which the given fraction of sends arrived
+    boost::chrono::microseconds percentile(double fraction) {
+        boost::lock_guard<boost::mutex> lock(latency_mutex_);
+
+        sort(latencies_.begin(), latencies_.end());
+        return latencies_[min<size_t>(latencies_.size() - 1, static_cast<size_t>(latencies_.size() * fraction))];
+    }
+
+    static const uint16_t kFirstPort = 10000;
+
+private:
+    vector<boost::chrono::steady_clock::time_point> send_times_;
+    unique_ptr<atomic<bool>[]> sending_;
+    boost::mutex latency_mutex_;
+    vector<boost::chrono::microseconds> latencies_;
+};
+
+/// Leaves the sessions to a timer that updates every one of them every 5ms.
+class PollingServer : public LatencyServer {
+public:
+    PollingServer(boost::asio::io_service& io_service, uint32_t session_count)
+        : LatencyServer(io_service, session_count)
+    {}
+
+    void ScheduleFlush(shared_ptr<Session> session) {}
+    void ScheduleResend(shared_ptr<Session> session) {}
+};
+
+class ServerTests {
+protected:
+    ~ServerTests() {
+        work_.reset();
+        io_service_.stop();
+        threads_.join_all();
+    }
+
+    void StartThreads(uint32_t thread_count) {
+        work_.reset(new boost::asio::io_service::work(io_service_));
+
+        for (uint32_t i = 0; i < thread_count; ++i) {
+            threads_.create_thread([this] () { io_service_.run(); });
+        }
+    }
+
+    // lets the threads finish everything still queued, call after shutting a server down
+    // so that none of its handlers outlive it
+    void DrainThreads() {
+        work_.reset();
+        threads_.join_all();
+        io_service_.reset();
+    }
+
+    // builds a message that a session passes straight through to the server
+    ByteBuffer buildGameMessage() const {
+        ByteBuffer buffer;
+        buffer.write<uint16_t>(1);
+        buffer.write<uint32_t>(0xDEADBABE);
+        return buffer;
+    }
+
+    // waits until the server has received the expected count or stops making progress,
+    // returns the time the last message arrived
+    boost::chrono::steady_clock::time_point WaitForMessages(const CountingServer& server, uint64_t expected) {
+        uint64_t last_count = 0;
+        auto last_progress = boost::chrono::steady_clock::now();
+
+        while (server.received() < expected
+            && boost::chrono::steady_clock::now() - last_progress < boost::chrono::milliseconds(500)) {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+
+            if (server.received() != last_count) {
+                last_count = server.received();
+                last_progress = boost::chrono::steady_clock::now();
+            }
+        }
+
+        return last_progress;
+    }
+
+    boost::asio::io_service io_service_;
+    unique_ptr<boost::asio::io_service::work> work_;
+    boost::thread_group threads_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ServerTest, ServerTests)
+
+/// This test verifies that every receiver is listening on the same port from its own socket.
+BOOST_AUTO_TEST_CASE(ReceiversShareTheListenPort) {
+    CountingServer server(io_service_, 4);
+    server.Startup(0);
+
+    BOOST_CHECK(server.socket_count() >= 1 && server.socket_count() <= 4);
+    BOOST_CHECK_EQUAL(server.socket_count(), server.receiver_count());
+    BOOST_CHECK(server.socket()->local_endpoint().port() != 0);
+
+    server.Shutdown();
+}
+
+/// This test verifies that messages are received from and sent to a remote endpoint.
+BOOST_AUTO_TEST_CASE(CanReceiveAndSendMessages) {
+    CountingServer server(io_service_, 2);
+    server.Startup(0);
+    StartThreads(2);
+
+    udp::endpoint server_endpoint(address_v4::loopback(), server.socket()->local_endpoint().port());
+
+    udp::socket client(io_service_, udp::endpoint(address_v4::loopback(), 0));
+    ByteBuffer message = buildGameMessage();
+    client.send_to(boost::asio::buffer(message.data(), message.size()), server_endpoint);
+
+    WaitForMessages(server, 1);
+
+    BOOST_REQUIRE_EQUAL(1, server.received());
+    BOOST_CHECK(server.last_sender() == client.local_endpoint());
+
+    server.SendTo(client.local_endpoint(), buildGameMessage());
+
+    vector<unsigned char> reply(496);
+    udp::endpoint reply_endpoint;
+    size_t reply_size = client.receive_from(boost::asio::buffer(reply), reply_endpoint);
+
+    BOOST_CHECK_EQUAL(message.size(), reply_size);
+    BOOST_CHECK_EQUAL(server_endpoint.port(), reply_endpoint.port());
+
+    server.Shutdown();
+    DrainThreads();
+}
+
+/// Blasts the server from several local sockets and reports the packets per second
+/// received with a single receiver and with one receiver per hardware thread.
+BOOST_AUTO_TEST_CASE(ReceiveThroughputFromLocalBlaster) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t blaster_count = 4;
+    const uint32_t packets_per_blaster = 25000;
+    const uint32_t thread_count = max(boost::thread::hardware_concurrency(), 2u);
+
+    for (uint32_t receivers : { 1u, thread_count }) {
+        CountingServer server(io_service_, receivers);
+        server.Startup(0);
+        StartThreads(thread_count);
+
+        udp::endpoint server_endpoint(address_v4::loopback(), server.socket()->local_endpoint().port());
+        ByteBuffer message = buildGameMessage();
+
+        auto start = boost::chrono::steady_clock::now();
+
+        boost::thread_group blasters;
+        for (uint32_t i = 0; i < blaster_count; ++i) {
+            blasters.create_thread([&] () {
+                boost::asio::io_service blaster_service;
+                udp::socket blaster(blaster_service, udp::endpoint(address_v4::loopback(), 0));
+
+                for (uint32_t j = 0; j < packets_per_blaster; ++j) {
+                    blaster.send_to(boost::asio::buffer(message.data(), message.size()), server_endpoint);
+                }
+            });
+        }
+
+        blasters.join_all();
+        auto finish = WaitForMessages(server, blaster_count * packets_per_blaster);
+
+        auto elapsed = boost::chrono::duration_cast<boost::chrono::microseconds>(finish - start);
+        uint64_t packets_per_second = server.received() * 1000000 / max<int64_t>(elapsed.count(), 1);
+
+        BOOST_CHECK(server.received() > 0);
+        BOOST_TEST_MESSAGE(receivers << " receivers on " << server.socket_count() << " sockets: "
+            << server.received() << " of " << blaster_count * packets_per_blaster << " packets received, "
+            << packets_per_second << " packets/s");
+
+        server.Shutdown();
+        DrainThreads();
+    }
+}
+
+/// Holds 5000 sessions, first idle and then with one at a time sending, and reports
+/// the cpu used per second at idle and the send latency when every session is updated from a
+/// 5ms timer and when sessions are only flushed once they have something to send.
+BOOST_AUTO_TEST_CASE(SendLatencyAndIdleCpu) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t session_count = 5000;
+    const uint32_t send_count = 2000;
+
+    typedef boost::chrono::process_cpu_clock cpu_clock;
+
+    auto run = [&] (LatencyServer& server, bool polled, const char* name) {
+        server.Startup(0);
+        StartThreads(2);
+
+        vector<shared_ptr<Session>> sessions;
+        for (uint32_t i = 0; i < session_count; ++i) {
+            sessions.push_back(server.GetSession(udp::endpoint(address_v4::loopback(), LatencyServer::kFirstPort + i)));
+        }
+
+        shared_ptr<boost::asio::deadline_timer> poll_timer;
+        function<void (const boost::system::error_code&)> poll;
+        if (polled) {
+            poll_timer = make_shared<boost::asio::deadline_timer>(io_service_);
+            poll = [&] (const boost::system::error_code& error) {
+                if (error) {
+                    return;
+                }
+
+                for (auto& session : sessions) {
+                    session->Update();
+                }
+
+                poll_timer->expires_from_now(boost::posix_time::milliseconds(5));
+                poll_timer->async_wait(poll);
+            };
+
+            poll(boost::system::error_code());
+        }
+
+        // the process clock only counts whole scheduler ticks, so idle for a while
+        const uint32_t idle_seconds = 3;
+
+        auto idle_start = cpu_clock::now();
+        boost::this_thread::sleep_for(boost::chrono::seconds(idle_seconds));
+        auto idle_cpu = cpu_clock::now() - idle_start;
+
+        for (uint32_t i = 0; i < send_count; ++i) {
+            server.Send(sessions[(i * 7919) % session_count], buildGameMessage());
+            boost::this_thread::sleep_for(boost::chrono::microseconds(500));
+        }
+
+        while (server.latency_count() < send_count) {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+        }
+
+        if (poll_timer) {
+            poll_timer->cancel();
+        }
+
+        server.Shutdown();
+        DrainThreads();
+
+        double idle_cpu_ms = boost::chrono::duration<double, boost::milli>(
+            boost::chrono::nanoseconds(idle_cpu.count().user + idle_cpu.count().system)).count() / idle_seconds;
+
+        BOOST_TEST_MESSAGE(name << ": " << idle_cpu_ms << "ms cpu per idle second, send latency p50 "
+            << server.percentile(0.5).count() << "us, p99 " << server.percentile(0.99).count() << "us");
+
+        return server.percentile(0.5);
+    };
+
+    PollingServer polling_server(io_service_, session_count);
+    auto polled_p50 = run(polling_server, true, "Updated every 5ms");
+
+    LatencyServer flushing_server(io_service_, session_count);
+    auto flushed_p50 = run(flushing_server, false, "Flushed when ready");
+
+    BOOST_TEST_MESSAGE(session_count << " sessions, " << send_count << " sends");
+    BOOST_CHECK(flushed_p50 < polled_p50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}}}  // namespace anh::network::soe
@@ -17,20 +17,49 @@ using namespace anh::network;
 using namespace anh::network::soe;
 using namespace std;
 
+namespace {
+
+    // Retransmit timeout bounds, the timeout itself is derived from the measured round trip.
+    const boost::chrono::milliseconds initial_retransmit_timeout(500);
+    const boost::chrono::milliseconds min_retransmit_timeout(100);
+    const boost::chrono::milliseconds max_retransmit_timeout(5000);
+
+    const uint32_t default_send_window_packets = 64;
+
+    const uint16_t default_reorder_window = 64;
+
+}  // namespace
+
 Session::Session(ServerInterface* server, boost::asio::io_service& io_service, boost::asio::ip::udp::endpoint remote_endpoint)
     : std::enable_shared_from_this<Session>()
     , remote_endpoint_(remote_endpoint)
     , server_(server)
+    , packet_pool_(server_->packet_pool())
     , strand_(io_service)
+    , bytes_in_flight_(0)
+    , send_window_packets_(default_send_window_packets)
+    , smoothed_rtt_(Clock::duration::zero())
+    , rtt_variance_(Clock::duration::zero())
+    , retransmit_timeout_(initial_retransmit_timeout)
+    , has_rtt_sample_(false)
+    , resent_packets_(0)
+    , delayed_acks_(false)
+    , ack_pending_(false)
+    , flush_scheduled_(false)
+    , resend_scheduled_(false)
     , connected_(false)
+    , receive_buffer_size_(server_->max_receive_size())
+    , crc_length_(0)
     , crc_seed_(0xDEADBABE)
     , last_acknowledged_sequence_(0)
     , next_client_sequence_(0)
     , current_client_sequence_(0)
+    , reorder_window_(default_reorder_window)
     , server_sequence_()
     , server_net_stats_(0, 0, 0, 0, 0, 0)
     , incoming_fragmented_total_len_(0)
     , incoming_fragmented_curr_len_(0)
+    , compression_filter_(server_->max_receive_size())
     , decompression_filter_(server_->max_receive_size())
     , security_filter_(server_->max_receive_size())
 {
@@ -70,7 +99,74 @@ uint32_t Session::crc_seed() const {
     return crc_seed_;
 }
 
+uint32_t Session::send_window_packets() const {
+    return send_window_packets_;
+}
+
+void Session::send_window_packets(uint32_t send_window_packets) {
+    send_window_packets_ = std::max<uint32_t>(send_window_packets, 1);
+}
+
+uint16_t Session::reorder_window() const {
+    return reorder_window_;
+}
+
+void Session::reorder_window(uint16_t reorder_window) {
+    reorder_window_ = reorder_window;
+}
+
+bool Session::delayed_acks() const {
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+    return delayed_acks_;
+}
+
+void Session::delayed_acks(bool delayed_acks) {
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+    delayed_acks_ = delayed_acks;
+}
+
+int Session::compression_level() const {
+    return compression_filter_.compression_level();
+}
+
+void Session::compression_level(int compression_level) {
+    compression_filter_.compression_level(compression_level);
+}
+
+uint32_t Session::compression_threshold() const {
+    return compression_filter_.compression_threshold();
+}
+
+void Session::compression_threshold(uint32_t compression_threshold) {
+    compression_filter_.compression_threshold(compression_threshold);
+}
+
+uint32_t Session::send_window_size() const {
+    return send_window_packets_ * receive_buffer_size_;
+}
+
+boost::chrono::milliseconds Session::smoothed_rtt() const {
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+    return boost::chrono::duration_cast<boost::chrono::milliseconds>(smoothed_rtt_);
+}
+
+boost::chrono::milliseconds Session::retransmit_timeout() const {
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+    return boost::chrono::duration_cast<boost::chrono::milliseconds>(retransmit_timeout_);
+}
+
+uint64_t Session::resent_packets() const {
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+    return resent_packets_;
+}
+
+NetStatsServer Session::server_net_stats() const {
+    return server_net_stats_;
+}
+
 vector<ByteBuffer> Session::GetUnacknowledgedMessages() const {
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+
     vector<ByteBuffer> unacknowledged_messages;
 
     for_each(
@@ -78,31 +174,83 @@ vector<ByteBuffer> Session::GetUnacknowledgedMessages() const {
         sent_messages_.end(),
         [&unacknowledged_messages] (const SequencedMessageMap::value_type& i)
     {
-        unacknowledged_messages.push_back(i.second);
+        unacknowledged_messages.push_back(*i.message);
     });
 
     return unacknowledged_messages;
 }
 
 void Session::Update() {
+    // Anything sent from here on needs a flush of its own.
+    flush_scheduled_ = false;
+
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+
     // Exit as quickly as possible if there is no work currently.
+    if (outgoing_data_messages_.empty() && pending_messages_.empty() && sent_messages_.empty() && !ack_pending_) {
+        return;
+    }
+
+    auto now = CurrentTime_();
+
+    ResendTimedOutMessages_(now);
+
+    // Only pull new messages once the previous batch is on the wire so that anything
+    // held back by the send window is packed together when it does go out.
+    if (pending_messages_.empty()) {
+        QueueOutgoingMessages_();
+    }
+
+    SendPendingMessages_(now);
+
+    // Nothing went out to carry the ack, send it on its own.
+    if (ack_pending_) {
+        SendPendingAck_();
+    }
+
+    // Come back on the resend tick until everything sent has been acknowledged.
+    if (!sent_messages_.empty() && !resend_scheduled_) {
+        resend_scheduled_ = true;
+        server_->ScheduleResend(shared_from_this());
+    }
+}
+
+void Session::UpdateResends() {
+    {
+        boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+        resend_scheduled_ = false;
+    }
+
+    // Nothing more is resent once the session is closed.
+    if (connected_) {
+        Update();
+    }
+}
+
+void Session::ScheduleFlush_() {
+    if (!flush_scheduled_.exchange(true)) {
+        server_->ScheduleFlush(shared_from_this());
+    }
+}
+
+void Session::QueueOutgoingMessages_() {
     if (outgoing_data_messages_.empty()) {
         return;
     }
 
     // Build up a list of data messages to process
     uint32_t message_count = outgoing_data_messages_.unsafe_size();
-    list<ByteBuffer> process_list;
-    ByteBuffer tmp;
+    list<shared_ptr<const ByteBuffer>> process_list;
+    shared_ptr<const ByteBuffer> tmp;
 
     for (uint32_t i = 0; i < message_count; ++i) {
         if (outgoing_data_messages_.try_pop(tmp)) {
-            process_list.push_back(tmp);
+            process_list.push_back(move(tmp));
         }
     }
 
     // Pack the message list into a single data channel payload and send it.
-    ByteBuffer data_channel_payload = PackDataChannelMessages(std::move(process_list));
+    ByteBuffer data_channel_payload = PackDataChannelMessages(process_list);
 
     // Split up the message if it's too big
     // \note: in determining the max size 3 is the size of the soe header + the compression flag.
@@ -114,16 +262,67 @@ void Session::Update() {
             max_data_channel_size);
 
         for_each(fragmented_message.begin(), fragmented_message.end(), [this] (ByteBuffer& fragment) {
-            SendSequencedMessage_(&BuildFragmentedDataChannelHeader, move(fragment));
+            pending_messages_.push_back(make_pair(&WriteFragmentedDataChannelHeader, move(fragment)));
         });
     } else {
-        SendSequencedMessage_(&BuildDataChannelHeader, move(data_channel_payload));
+        pending_messages_.push_back(make_pair(&WriteDataChannelHeader, move(data_channel_payload)));
+    }
+}
+
+void Session::SendPendingMessages_(Clock::time_point now) {
+    uint32_t send_window = send_window_size();
+
+    while (!pending_messages_.empty()) {
+        auto& pending = pending_messages_.front();
+
+        // Always allow a single message through so an oversized one can't stall the channel.
+        if (bytes_in_flight_ > 0 && bytes_in_flight_ + pending.second.size() > send_window) {
+            break;
+        }
+
+        SendSequencedMessage_(pending.first, move(pending.second), now);
+        pending_messages_.pop_front();
+    }
+}
+
+void Session::ResendTimedOutMessages_(Clock::time_point now) {
+    bool timed_out = false;
+
+    for_each(
+        sent_messages_.begin(),
+        sent_messages_.end(),
+        [this, now, &timed_out] (SequencedMessage& message)
+    {
+        if (!message.received_out_of_order && now - message.sent_time >= retransmit_timeout_) {
+            ResendMessage_(message, now);
+            timed_out = true;
+        }
+    });
+
+    // Back off while the remote end is not responding.
+    if (timed_out) {
+        retransmit_timeout_ = std::min<Clock::duration>(retransmit_timeout_ * 2, max_retransmit_timeout);
     }
 }
 
+void Session::ResendMessage_(SequencedMessage& message, Clock::time_point now) {
+    SendSoePacket_(message.message);
+
+    message.sent_time = now;
+    ++message.send_count;
+    ++resent_packets_;
+}
+
 void Session::SendTo(ByteBuffer message)
+{
+    outgoing_data_messages_.push(make_shared<ByteBuffer>(move(message)));
+    ScheduleFlush_();
+}
+
+void Session::SendTo(shared_ptr<const ByteBuffer> message)
 {
     outgoing_data_messages_.push(move(message));
+    ScheduleFlush_();
 }
 
 void Session::Close(void)
@@ -133,7 +332,7 @@ void Session::Close(void)
         connected_ = false;
 
         Disconnect disconnect(connection_id_);
-        ByteBuffer buffer;
+        ByteBuffer buffer = packet_pool_->Acquire();
 
         disconnect.serialize(buffer);
         SendSoePacket_(move(buffer));
@@ -155,7 +354,7 @@ void Session::HandleMessage(anh::ByteBuffer message)
     strand_.post(bind(&Session::HandleMessageInternal, shared_from_this(), move(message)));
 }
 
-void Session::HandleMessageInternal(anh::ByteBuffer message)
+void Session::HandleMessageInternal(anh::ByteBuffer& message)
 {
 	// Sanity Check
 	if (message.size() > 0)
@@ -165,9 +364,9 @@ void Session::HandleMessageInternal(anh::ByteBuffer message)
 		try {
 			switch(soe_opcode)
 			{
-				case CHILD_DATA_A:	   { handleChildDataA_(ChildDataA(message)); break; }
+				case CHILD_DATA_A:	   { HandleSequencedMessage_(move(message)); break; }
 				case MULTI_PACKET:	   { handleMultiPacket_(MultiPacket(message)); break; }
-				case DATA_FRAG_A:	   { handleDataFragA_(DataFragA(message)); break; }
+				case DATA_FRAG_A:	   { HandleSequencedMessage_(move(message)); break; }
 				case ACK_A:			   { handleAckA_(AckA(message)); break; }
 				case PING:			   { handlePing_(Ping(message)); break; }
 				case NET_STATS_CLIENT: { handleNetStatsClient_(NetStatsClient(message)); break; }
@@ -190,6 +389,9 @@ void Session::HandleMessageInternal(anh::ByteBuffer message)
 			LOG(warning) << "Error handling protocol message "
 				<< std::hex << soe_opcode << "\n\n" << e.what();
 		}
+
+		// Anything not passed on is done with, recycle the buffer.
+		packet_pool_->Release(move(message));
 	}
 }
 
@@ -198,8 +400,10 @@ void Session::HandleProtocolMessage(anh::ByteBuffer message)
     strand_.post(bind(&Session::HandleProtocolMessageInternal, shared_from_this(), move(message)));
 }
 
-void Session::HandleProtocolMessageInternal(anh::ByteBuffer message)
+void Session::HandleProtocolMessageInternal(anh::ByteBuffer& message)
 {
+    ++server_net_stats_.server_packets_received;
+
     try {
         security_filter_(this, &message);
 
@@ -217,20 +421,76 @@ void Session::HandleProtocolMessageInternal(anh::ByteBuffer message)
 }
 
 
-void Session::SendSequencedMessage_(HeaderBuilder header_builder, ByteBuffer message) {
+void Session::SendSequencedMessage_(HeaderWriter header_writer, ByteBuffer message, Clock::time_point now) {
     // Get the next sequence number
     uint16_t message_sequence = server_sequence_++;
 
-    // Allocate a new packet
-    ByteBuffer data_channel_message;
-    data_channel_message.append(header_builder(message_sequence));
-    data_channel_message.append(move(message));
+    // Assemble the packet in a pooled buffer, the payload's buffer is recycled. The
+    // packet is never modified again so every send and resend shares it.
+    auto data_channel_message = make_shared<ByteBuffer>(packet_pool_->Acquire());
+    header_writer(message_sequence, data_channel_message.get());
+    data_channel_message->write(message.data(), message.size());
 
-    // Send it over the wire
-    SendSoePacket_(data_channel_message);
+    packet_pool_->Release(move(message));
+
+    // Send it over the wire, along with a pending ack if there is one
+    if (!ack_pending_ || !SendWithPendingAck_(*data_channel_message)) {
+        SendSoePacket_(data_channel_message);
+    }
+
+    bytes_in_flight_ += data_channel_message->size();
 
     // Store it for resending later if necessary
-    sent_messages_.push_back(make_pair(message_sequence, move(data_channel_message)));
+    SequencedMessage sequenced_message = { message_sequence, move(data_channel_message), now, 1, false };
+    sent_messages_.push_back(move(sequenced_message));
+}
+
+bool Session::SendWithPendingAck_(const ByteBuffer& message) {
+    ByteBuffer ack_buffer;
+    AckA(current_client_sequence_).serialize(ack_buffer);
+
+    list<ByteBuffer> packets;
+    packets.push_back(move(ack_buffer));
+    packets.push_back(message);
+
+    ByteBuffer multi_packet_buffer = packet_pool_->Acquire();
+    MultiPacket(move(packets)).serialize(multi_packet_buffer);
+
+    // Leave room for the crc and compression flag.
+    if (multi_packet_buffer.size() + crc_length_ + 1 > receive_buffer_size_) {
+        packet_pool_->Release(move(multi_packet_buffer));
+        return false;
+    }
+
+    SendSoePacket_(move(multi_packet_buffer));
+    ack_pending_ = false;
+
+    return true;
+}
+
+void Session::SendPendingAck_() {
+    ByteBuffer buffer = packet_pool_->Acquire();
+    AckA(current_client_sequence_).serialize(buffer);
+    SendSoePacket_(move(buffer));
+
+    ack_pending_ = false;
+}
+
+void Session::UpdateRoundTripTime_(Clock::duration sample) {
+    if (!has_rtt_sample_) {
+        smoothed_rtt_ = sample;
+        rtt_variance_ = sample / 2;
+        has_rtt_sample_ = true;
+    } else {
+        Clock::duration deviation = (smoothed_rtt_ > sample) ? smoothed_rtt_ - sample : sample - smoothed_rtt_;
+
+        rtt_variance_ = (rtt_variance_ * 3 + deviation) / 4;
+        smoothed_rtt_ = (smoothed_rtt_ * 7 + sample) / 8;
+    }
+
+    retransmit_timeout_ = std::min<Clock::duration>(
+        std::max<Clock::duration>(smoothed_rtt_ + rtt_variance_ * 4, min_retransmit_timeout),
+        max_retransmit_timeout);
 }
 
 void Session::handleSessionRequest_(SessionRequest packet)
@@ -272,7 +532,7 @@ void Session::handlePing_(Ping packet)
 {
     Ping pong;
 
-    ByteBuffer buffer;
+    ByteBuffer buffer = packet_pool_->Acquire();
     pong.serialize(buffer);
     SendSoePacket_(std::move(buffer));
 }
@@ -280,21 +540,18 @@ void Session::handlePing_(Ping packet)
 void Session::handleNetStatsClient_(NetStatsClient packet)
 {
     server_net_stats_.client_tick_count = packet.client_tick_count;
+    server_net_stats_.server_tick_count = static_cast<uint32_t>(
+        boost::chrono::duration_cast<boost::chrono::milliseconds>(CurrentTime_().time_since_epoch()).count());
+    server_net_stats_.client_packets_sent = packet.packets_sent;
+    server_net_stats_.client_packets_received = packet.packets_received;
 
-    ByteBuffer buffer;
+    ByteBuffer buffer = packet_pool_->Acquire();
     server_net_stats_.serialize(buffer);
     SendSoePacket_(std::move(buffer));
 }
 
 void Session::handleChildDataA_(ChildDataA packet)
 {
-    if(!SequenceIsValid_(packet.sequence)) {
-        LOG(warning) << "Invalid sequence: " << packet.sequence << "; Current sequence " << this->next_client_sequence_;
-        return;
-    }
-
-    AcknowledgeSequence_(packet.sequence);
-
     std::for_each(
         begin(packet.messages),
         end(packet.messages),
@@ -306,11 +563,6 @@ void Session::handleChildDataA_(ChildDataA packet)
 
 void Session::handleDataFragA_(DataFragA packet)
 {
-    if(!SequenceIsValid_(packet.sequence))
-        return;
-
-    AcknowledgeSequence_(packet.sequence);
-
     // Continuing a frag
     if(incoming_fragmented_total_len_ > 0)
     {
@@ -350,28 +602,72 @@ void Session::handleDataFragA_(DataFragA packet)
 
 void Session::handleAckA_(AckA packet)
 {
-    auto it = find_if(
-        sent_messages_.begin(),
-        sent_messages_.end(),
-        [this, &packet] (const SequencedMessageMap::value_type& message)
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+
+    auto now = CurrentTime_();
+    bool has_sample = false;
+    Clock::duration sample = Clock::duration::zero();
+
+    // Acks are cumulative, everything up to and including the sequence has arrived.
+    while (!sent_messages_.empty() && !SequenceIsNewer(sent_messages_.front().sequence, packet.sequence))
     {
-        return (message.first == packet.sequence) ? true : false;
-    });
+        auto& message = sent_messages_.front();
+
+        // Only the acknowledged message itself gives a round trip sample, and only if it
+        // was sent exactly once and its ack was not held up waiting for a gap to fill.
+        if (message.sequence == packet.sequence && message.send_count == 1 && !message.received_out_of_order)
+        {
+            sample = now - message.sent_time;
+            has_sample = true;
+        }
 
-    sent_messages_.erase(sent_messages_.begin(), it);
+        bytes_in_flight_ -= message.message->size();
+
+        // Recycle the packet unless a send of it is still queued up.
+        if (message.message.unique())
+        {
+            packet_pool_->Release(move(*message.message));
+        }
+
+        sent_messages_.pop_front();
+    }
+
+    if (has_sample)
+    {
+        UpdateRoundTripTime_(sample);
+    }
 
     last_acknowledged_sequence_ = packet.sequence;
+
+    // The send window has opened up for anything it was holding back.
+    if (!pending_messages_.empty() || !outgoing_data_messages_.empty())
+    {
+        ScheduleFlush_();
+    }
 }
 
 void Session::handleOutOfOrderA_(OutOfOrderA packet)
 {
-    std::for_each(
-        begin(sent_messages_),
-        end(sent_messages_),
-        [=](const SequencedMessageMap::value_type& item)
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
+
+    auto now = CurrentTime_();
+
+    // The remote end is holding on to this sequence, so only the messages sent before it
+    // can have been lost. Each of those is resent straight away once, after that it is
+    // left to the retransmit timer.
+    for (auto it = sent_messages_.begin(); it != sent_messages_.end(); ++it)
     {
-        SendSoePacket_(item.second);
-    });
+        if (it->sequence == packet.sequence)
+        {
+            it->received_out_of_order = true;
+            break;
+        }
+
+        if (!it->received_out_of_order && it->send_count == 1)
+        {
+            ResendMessage_(*it, now);
+        }
+    }
 }
 
 void Session::SendSoePacket_(anh::ByteBuffer message)
@@ -379,40 +675,103 @@ void Session::SendSoePacket_(anh::ByteBuffer message)
     strand_.post(bind(&Session::SendSoePacketInternal, shared_from_this(), std::move(message)));
 }
 
-void Session::SendSoePacketInternal(anh::ByteBuffer message)
+void Session::SendSoePacket_(shared_ptr<const ByteBuffer> message)
+{
+    auto self = shared_from_this();
+
+    strand_.post([self, message] () {
+        // The filters work in place so they get a pooled copy rather than the original.
+        ByteBuffer packet = self->packet_pool_->Acquire();
+        packet.write(message->data(), message->size());
+
+        self->SendSoePacketInternal(packet);
+    });
+}
+
+void Session::SendSoePacketInternal(anh::ByteBuffer& message)
 {
     compression_filter_(this, &message);
-    encryption_filter_(this, &message);
-    crc_output_filter_(this, &message);
+    encryption_filter_.EncryptAndAppendCrc(this, &message);
+
+    ++server_net_stats_.server_packets_sent;
 
     server_->SendTo(remote_endpoint(), move(message));
 }
 
-bool Session::SequenceIsValid_(const uint16_t& sequence)
+void Session::HandleSequencedMessage_(anh::ByteBuffer message)
 {
-    if(next_client_sequence_ == sequence)
+    uint16_t sequence = message.peekAt<uint16_t>(message.read_position() + sizeof(uint16_t), true);
+
+    if (sequence == next_client_sequence_)
     {
-        return true;
+        DispatchSequencedMessage_(move(message));
+
+        // Deliver anything that was waiting on this sequence.
+        auto find_iter = early_client_messages_.find(++sequence);
+        while (find_iter != early_client_messages_.end())
+        {
+            ByteBuffer early_message = move(find_iter->second);
+            early_client_messages_.erase(find_iter);
+
+            DispatchSequencedMessage_(move(early_message));
+
+            find_iter = early_client_messages_.find(++sequence);
+        }
+
+        AcknowledgeSequence_(sequence - 1);
     }
-    else
+    else if (SequenceIsNewer(sequence, next_client_sequence_))
     {
-        // Tell the client we have received an Out of Order sequence.
+        // Anything past the window is dropped and left for the remote end to resend.
+        if (static_cast<uint16_t>(sequence - next_client_sequence_) > reorder_window_)
+        {
+            LOG(warning) << "Sequence outside of reorder window: " << sequence << "; Current sequence " << next_client_sequence_;
+            return;
+        }
+
+        early_client_messages_.insert(make_pair(sequence, move(message)));
+
+        // Tell the client we are holding on to this sequence.
         OutOfOrderA	out_of_order(sequence);
-        ByteBuffer buffer;
+        ByteBuffer buffer = packet_pool_->Acquire();
         out_of_order.serialize(buffer);
         SendSoePacket_(move(buffer));
+    }
+    else
+    {
+        // A resend of something already delivered, the earlier ack was likely lost.
+        AcknowledgeSequence_(next_client_sequence_ - 1);
+    }
+}
 
-        return false;
+void Session::DispatchSequencedMessage_(anh::ByteBuffer message)
+{
+    if (message.peek<uint16_t>(true) == CHILD_DATA_A)
+    {
+        handleChildDataA_(ChildDataA(message));
     }
+    else
+    {
+        handleDataFragA_(DataFragA(message));
+    }
+
+    packet_pool_->Release(move(message));
 }
 
 void Session::AcknowledgeSequence_(const uint16_t& sequence)
 {
-    AckA ack(sequence);
-    ByteBuffer buffer;
-    ack.serialize(buffer);
-    SendSoePacket_(move(buffer));
+    boost::lock_guard<boost::mutex> lock(sent_messages_mutex_);
 
     next_client_sequence_ = sequence + 1;
     current_client_sequence_ = sequence;
+
+    // Acks are cumulative, so with delayed acks only the latest sequence is sent on the next flush.
+    if (delayed_acks_)
+    {
+        ack_pending_ = true;
+        ScheduleFlush_();
+        return;
+    }
+
+    SendPendingAck_();
 }
@@ -6,6 +6,7 @@
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -21,7 +22,10 @@ namespace Concurrency {
 #endif
 
 #include <boost/asio.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/mutex.hpp>
 
+#include "anh/network/soe/packet_pool.h"
 #include "anh/network/soe/protocol_packets.h"
 #include "anh/network/soe/server_interface.h"
 
@@ -29,7 +33,6 @@ namespace Concurrency {
 #include "anh/network/soe/filters/decryption_filter.h"
 #include "anh/network/soe/filters/decompression_filter.h"
 #include "anh/network/soe/filters/compression_filter.h"
-#include "anh/network/soe/filters/crc_out_filter.h"
 #include "anh/network/soe/filters/encryption_filter.h"
 #include "anh/network/soe/filters/security_filter.h"
 
@@ -46,6 +49,8 @@ namespace soe {
  */
 class Session : public std::enable_shared_from_this<Session> {
 public:
+    typedef boost::chrono::steady_clock Clock;
+
     /**
      * Adds itself to the Session Manager.
      */
@@ -81,6 +86,90 @@ public:
      */
     uint32_t crc_seed() const;
 
+    /**
+     * @return The number of maximum sized packets allowed in flight at once.
+     */
+    uint32_t send_window_packets() const;
+
+    /**
+     * Sets the number of maximum sized packets allowed in flight at once.
+     */
+    void send_window_packets(uint32_t send_window_packets);
+
+    /**
+     * @return The number of sequences past the next expected one that are held on to
+     *  when they arrive early.
+     */
+    uint16_t reorder_window() const;
+
+    /**
+     * Sets the number of sequences past the next expected one that are held on to
+     * when they arrive early. A window of 0 drops every early arrival.
+     */
+    void reorder_window(uint16_t reorder_window);
+
+    /**
+     * @return True if acks are delayed until the next update.
+     */
+    bool delayed_acks() const;
+
+    /**
+     * Enables or disables delayed acks.
+     *
+     * When enabled, reliable packets from the remote end are not acknowledged one by one.
+     * Instead a single cumulative ack is sent per flush, and it is folded into a multi
+     * packet with the first outgoing data channel message when there is room for it.
+     */
+    void delayed_acks(bool delayed_acks);
+
+    /**
+     * @return The zlib compression level used for outgoing packets.
+     */
+    int compression_level() const;
+
+    /**
+     * Sets the zlib compression level used for outgoing packets, from 0 (none) to 9 (best).
+     */
+    void compression_level(int compression_level);
+
+    /**
+     * @return The size in bytes an outgoing packet has to exceed to be compressed.
+     */
+    uint32_t compression_threshold() const;
+
+    /**
+     * Sets the size in bytes an outgoing packet has to exceed to be compressed.
+     */
+    void compression_threshold(uint32_t compression_threshold);
+
+    /**
+     * The send window is the number of unacknowledged bytes allowed in flight, it is
+     * sized in multiples of the remote end's receive buffer.
+     *
+     * @return The send window in bytes.
+     */
+    uint32_t send_window_size() const;
+
+    /**
+     * @return The smoothed round trip time to the remote end.
+     */
+    boost::chrono::milliseconds smoothed_rtt() const;
+
+    /**
+     * @return The time an unacknowledged data channel message waits before being resent.
+     */
+    boost::chrono::milliseconds retransmit_timeout() const;
+
+    /**
+     * @return The number of data channel packets that have been resent to the remote end.
+     */
+    uint64_t resent_packets() const;
+
+    /**
+     * @return A snapshot of the packet counters as reported to the client.
+     */
+    NetStatsServer server_net_stats() const;
+
     /**
      * Get a list of all outgoing data channel messages that have not yet been acknowledged
      * by the remote end.
@@ -111,21 +200,47 @@ public:
     */
     template<typename T>
     void SendTo(const T& message) {
-        ByteBuffer message_buffer;
-        message.Serialize(message_buffer);
+        auto message_buffer = std::make_shared<ByteBuffer>();
+        message.Serialize(*message_buffer);
 
         outgoing_data_messages_.push(std::move(message_buffer));
+        ScheduleFlush_();
     }
 
+    /**
+    * Sends a data channel message shared with other sessions to the remote client.
+    *
+    * The message is queued as is and only copied when packed into a data channel
+    * payload, so one serialized message can be broadcast to many sessions.
+    *
+    * @param message The payload to send in the data channel message(s), must not be
+    *   modified once sent.
+    */
+    void SendTo(std::shared_ptr<const anh::ByteBuffer> message);
+
     void HandleMessage(anh::ByteBuffer message);
 
     void HandleProtocolMessage(anh::ByteBuffer message);
 
     /**
      * Clears each message pump.
+     *
+     * Resends any data channel messages that have gone unacknowledged for longer than the
+     * retransmit timeout and then sends as many queued messages as the send window allows.
+     *
+     * The session asks the server to call this when it has something to send, and to
+     * keep calling UpdateResends while anything it sent is unacknowledged.
      */
     void Update();
 
+    /**
+     * Updates the session from the server's resend tick.
+     *
+     * The session stays on the tick for as long as it has unacknowledged messages and
+     * is connected.
+     */
+    void UpdateResends();
+
     /**
      * Closes the Session.
      */
@@ -140,14 +255,42 @@ public:
     ServerInterface* server();
 
 private:
-    typedef std::list<std::pair<uint16_t, anh::ByteBuffer>> SequencedMessageMap;
+    struct SequencedMessage
+    {
+        uint16_t sequence;
+        std::shared_ptr<anh::ByteBuffer> message;
+        Clock::time_point sent_time;
+        uint32_t send_count;
+        bool received_out_of_order;
+    };
+
+    typedef std::list<SequencedMessage> SequencedMessageMap;
 
-    typedef anh::ByteBuffer(*HeaderBuilder)(uint16_t);
+    typedef void(*HeaderWriter)(uint16_t, anh::ByteBuffer*);
 
-    void SendSequencedMessage_(HeaderBuilder header_builder, ByteBuffer message);
+    typedef std::list<std::pair<HeaderWriter, anh::ByteBuffer>> PendingMessageList;
+
+    /**
+     * Asks the server for a flush unless one is already coming.
+     */
+    void ScheduleFlush_();
+
+    void QueueOutgoingMessages_();
+    void SendPendingMessages_(Clock::time_point now);
+    void ResendTimedOutMessages_(Clock::time_point now);
+    void ResendMessage_(SequencedMessage& message, Clock::time_point now);
+    void SendSequencedMessage_(HeaderWriter header_writer, ByteBuffer message, Clock::time_point now);
+    void UpdateRoundTripTime_(Clock::duration sample);
+    bool SendWithPendingAck_(const anh::ByteBuffer& message);
+    void SendPendingAck_();
 
     virtual void OnClose() {}
 
+    /**
+     * @return The current time, used for all round trip and resend timing.
+     */
+    virtual Clock::time_point CurrentTime_() const { return Clock::now(); }
+
     void handleSessionRequest_(SessionRequest packet);
     void handleMultiPacket_(MultiPacket packet);
     void handleDisconnect_(Disconnect packet);
@@ -158,18 +301,59 @@ private:
     void handleAckA_(AckA packet);
     void handleOutOfOrderA_(OutOfOrderA packet);
     void SendSoePacket_(anh::ByteBuffer message);
-    void SendSoePacketInternal(anh::ByteBuffer message);
-    void HandleMessageInternal(anh::ByteBuffer message);
-    void HandleProtocolMessageInternal(anh::ByteBuffer message);
 
-    bool SequenceIsValid_(const uint16_t& sequence);
+    /**
+     * Sends a copy of a packet that is also held on to for resending.
+     */
+    void SendSoePacket_(std::shared_ptr<const anh::ByteBuffer> message);
+
+    // The strand handlers take the message bound into them by reference so that it is
+    // moved along rather than copied out of the handler.
+    void SendSoePacketInternal(anh::ByteBuffer& message);
+    void HandleMessageInternal(anh::ByteBuffer& message);
+    void HandleProtocolMessageInternal(anh::ByteBuffer& message);
+
+    /**
+     * Delivers a sequenced data channel message in order.
+     *
+     * Messages that arrive early but within the reorder window are held and reported
+     * to the remote end with an OutOfOrderA so it only resends what is actually missing.
+     * Once the gap is filled everything that is now in order is delivered and a single
+     * cumulative AckA is sent.
+     */
+    void HandleSequencedMessage_(anh::ByteBuffer message);
+    void DispatchSequencedMessage_(anh::ByteBuffer message);
+
     void AcknowledgeSequence_(const uint16_t& sequence);
 
     boost::asio::ip::udp::endpoint		remote_endpoint_; // ip_address
     ServerInterface*					server_; // owner
+    PacketPool*                         packet_pool_;
     boost::asio::strand strand_;
 
+    // Reliable channel, guarded by sent_messages_mutex_ as Update is driven from outside the strand.
+    mutable boost::mutex                sent_messages_mutex_;
     SequencedMessageMap					sent_messages_;
+    PendingMessageList                  pending_messages_;
+    uint32_t                            bytes_in_flight_;
+    uint32_t                            send_window_packets_;
+
+    // Round trip estimation
+    Clock::duration                     smoothed_rtt_;
+    Clock::duration                     rtt_variance_;
+    Clock::duration                     retransmit_timeout_;
+    bool                                has_rtt_sample_;
+    uint64_t                            resent_packets_;
+
+    // Delayed acks, also guarded by sent_messages_mutex_
+    bool                                delayed_acks_;
+    bool                                ack_pending_;
+
+    // Set while the session is queued on the server for a flush, cleared as the flush starts.
+    std::atomic<bool>                   flush_scheduled_;
+
+    // Set while the session is queued on the server's resend tick, guarded by sent_messages_mutex_.
+    bool                                resend_scheduled_;
 
     bool								connected_;
 
@@ -183,6 +367,8 @@ private:
     uint16_t							last_acknowledged_sequence_;
     uint16_t							next_client_sequence_;
     uint16_t							current_client_sequence_;
+    uint16_t                            reorder_window_;
+    std::map<uint16_t, anh::ByteBuffer> early_client_messages_;
     std::atomic<uint16_t>				server_sequence_;
 
     uint32_t							next_frag_size_;
@@ -190,7 +376,7 @@ private:
     // Net Stats
     NetStatsServer						server_net_stats_;
 
-    Concurrency::concurrent_queue<anh::ByteBuffer> outgoing_data_messages_;
+    Concurrency::concurrent_queue<std::shared_ptr<const anh::ByteBuffer>> outgoing_data_messages_;
 
     std::list<anh::ByteBuffer>			incoming_fragmented_messages_;
     uint16_t							incoming_fragmented_total_len_;
@@ -198,7 +384,6 @@ private:
 
     filters::CompressionFilter compression_filter_;
     filters::CrcInFilter crc_input_filter_;
-    filters::CrcOutFilter crc_output_filter_;
     filters::DecompressionFilter decompression_filter_;
     filters::DecryptionFilter decryption_filter_;
     filters::EncryptionFilter encryption_filter_;
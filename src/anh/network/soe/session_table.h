@@ -0,0 +1,182 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_NETWORK_SOE_SESSION_TABLE_H_
+#define ANH_NETWORK_SOE_SESSION_TABLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/ip/udp.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include "anh/network/soe/packet_utilities.h"
+
+namespace anh {
+namespace network {
+namespace soe {
+
+/**
+ * @brief Sessions keyed by their remote endpoint, split over independently locked shards.
+ *
+ * The endpoint hash is calculated once per call and picks both the shard and the
+ * bucket within it. Lookups only take a shared lock on their own shard, so they
+ * never wait on each other and only wait on an insert or erase landing in the same
+ * shard. ForEach copies one shard at a time and visits the sessions after letting
+ * go of the lock, so a slow visitor holds up no lookups at all.
+ */
+template<typename T>
+class SessionTable : boost::noncopyable {
+public:
+    static const uint32_t kShardCount = 64;
+
+    /**
+     * @return The session for the endpoint or nullptr if there is none.
+     */
+    std::shared_ptr<T> Find(const boost::asio::ip::udp::endpoint& endpoint) const {
+        Key key(endpoint);
+        const Shard& shard = GetShard(key);
+
+        boost::shared_lock<boost::shared_mutex> lock(shard.mutex);
+
+        auto find_iter = shard.sessions.find(key);
+        if (find_iter == shard.sessions.end()) {
+            return nullptr;
+        }
+
+        return find_iter->second;
+    }
+
+    /**
+     * Returns the session for the endpoint, creating and storing a new one when there
+     * is none yet.
+     *
+     * @param create Called with the endpoint to create the session, at most once and
+     *  only if the endpoint has no session.
+     */
+    template<typename Factory>
+    std::shared_ptr<T> FindOrInsert(const boost::asio::ip::udp::endpoint& endpoint, Factory create) {
+        Key key(endpoint);
+        Shard& shard = GetShard(key);
+
+        {
+            boost::shared_lock<boost::shared_mutex> lock(shard.mutex);
+
+            auto find_iter = shard.sessions.find(key);
+            if (find_iter != shard.sessions.end()) {
+                return find_iter->second;
+            }
+        }
+
+        boost::unique_lock<boost::shared_mutex> lock(shard.mutex);
+
+        // another datagram from the endpoint may have got here first
+        auto find_iter = shard.sessions.find(key);
+        if (find_iter != shard.sessions.end()) {
+            return find_iter->second;
+        }
+
+        std::shared_ptr<T> session = create(endpoint);
+        shard.sessions.insert(std::make_pair(key, session));
+
+        return session;
+    }
+
+    /**
+     * @return True if the endpoint had a session to remove.
+     */
+    bool Erase(const boost::asio::ip::udp::endpoint& endpoint) {
+        Key key(endpoint);
+        Shard& shard = GetShard(key);
+
+        boost::unique_lock<boost::shared_mutex> lock(shard.mutex);
+        return shard.sessions.erase(key) > 0;
+    }
+
+    /**
+     * Visits every session stored when the walk reaches its shard. Sessions added or
+     * removed during the walk may or may not be visited.
+     */
+    template<typename Visitor>
+    void ForEach(Visitor visit) const {
+        std::vector<std::shared_ptr<T>> sessions;
+
+        for (uint32_t i = 0; i < kShardCount; ++i) {
+            const Shard& shard = shards_[i];
+
+            sessions.clear();
+
+            {
+                boost::shared_lock<boost::shared_mutex> lock(shard.mutex);
+
+                sessions.reserve(shard.sessions.size());
+                for (auto& entry : shard.sessions) {
+                    sessions.push_back(entry.second);
+                }
+            }
+
+            for (auto& session : sessions) {
+                visit(session);
+            }
+        }
+    }
+
+    /**
+     * @return The number of sessions stored.
+     */
+    size_t Size() const {
+        size_t size = 0;
+
+        for (uint32_t i = 0; i < kShardCount; ++i) {
+            boost::shared_lock<boost::shared_mutex> lock(shards_[i].mutex);
+            size += shards_[i].sessions.size();
+        }
+
+        return size;
+    }
+
+private:
+    struct Key {
+        explicit Key(const boost::asio::ip::udp::endpoint& endpoint)
+            : hash(CreateEndpointHash(endpoint))
+            , endpoint(endpoint)
+        {}
+
+        uint32_t hash;
+        boost::asio::ip::udp::endpoint endpoint;
+
+        bool operator==(const Key& other) const {
+            return hash == other.hash && endpoint == other.endpoint;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return key.hash;
+        }
+    };
+
+    struct Shard {
+        mutable boost::shared_mutex mutex;
+        std::unordered_map<Key, std::shared_ptr<T>, KeyHash> sessions;
+    };
+
+    // the low bits pick the bucket within a shard, the shard comes from the high ones
+    const Shard& GetShard(const Key& key) const {
+        return shards_[(key.hash >> 26) % kShardCount];
+    }
+
+    Shard& GetShard(const Key& key) {
+        return shards_[(key.hash >> 26) % kShardCount];
+    }
+
+    Shard shards_[kShardCount];
+};
+
+}}}  // namespace anh::network::soe
+
+#endif  // ANH_NETWORK_SOE_SESSION_TABLE_H_
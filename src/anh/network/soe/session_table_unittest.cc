@@ -0,0 +1,199 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/network/soe/session_table.h"
+
+using namespace anh::network::soe;
+using namespace std;
+using boost::asio::ip::udp;
+
+namespace {
+
+/// Stands in for a session, counting how often the updater reaches it.
+class FakeSession {
+public:
+    explicit FakeSession(udp::endpoint endpoint)
+        : endpoint_(endpoint)
+        , updates_(0)
+    {}
+
+    const udp::endpoint& remote_endpoint() const { return endpoint_; }
+
+    void Update() { ++updates_; }
+
+    uint32_t updates() const { return updates_; }
+
+private:
+    udp::endpoint endpoint_;
+    std::atomic<uint32_t> updates_;
+};
+
+class SessionTableTests {
+protected:
+    udp::endpoint Endpoint(uint32_t index) {
+        return udp::endpoint(boost::asio::ip::address_v4(0x0A000000 + index / 8), 44453 + index % 8);
+    }
+
+    shared_ptr<FakeSession> Insert(uint32_t index) {
+        return table_.FindOrInsert(Endpoint(index), [] (const udp::endpoint& endpoint) {
+            return make_shared<FakeSession>(endpoint);
+        });
+    }
+
+    SessionTable<FakeSession> table_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SessionTableTest, SessionTableTests)
+
+/// This test verifies that sessions are found by the endpoint they were stored for.
+BOOST_AUTO_TEST_CASE(SessionsAreFoundByEndpoint) {
+    auto session = Insert(1);
+
+    BOOST_CHECK_EQUAL(session, table_.Find(Endpoint(1)));
+    BOOST_CHECK(!table_.Find(Endpoint(2)));
+}
+
+/// This test verifies that an endpoint's session is only created the first time it's asked for.
+BOOST_AUTO_TEST_CASE(SessionsAreCreatedOncePerEndpoint) {
+    uint32_t created = 0;
+
+    auto create = [&created] (const udp::endpoint& endpoint) -> shared_ptr<FakeSession> {
+        ++created;
+        return make_shared<FakeSession>(endpoint);
+    };
+
+    auto first = table_.FindOrInsert(Endpoint(1), create);
+    auto second = table_.FindOrInsert(Endpoint(1), create);
+
+    BOOST_CHECK_EQUAL(first, second);
+    BOOST_CHECK_EQUAL(1, created);
+    BOOST_CHECK_EQUAL(1, table_.Size());
+}
+
+/// This test verifies that erased sessions are no longer found.
+BOOST_AUTO_TEST_CASE(ErasedSessionsAreNotFound) {
+    Insert(1);
+
+    BOOST_CHECK(table_.Erase(Endpoint(1)));
+    BOOST_CHECK(!table_.Erase(Endpoint(1)));
+    BOOST_CHECK(!table_.Find(Endpoint(1)));
+}
+
+/// This test verifies that walking the table visits every session once.
+BOOST_AUTO_TEST_CASE(ForEachVisitsEverySession) {
+    vector<shared_ptr<FakeSession>> sessions;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        sessions.push_back(Insert(i));
+    }
+
+    table_.ForEach([] (const shared_ptr<FakeSession>& session) {
+        session->Update();
+    });
+
+    for (auto& session : sessions) {
+        BOOST_CHECK_EQUAL(1, session->updates());
+    }
+}
+
+/// Looks up 5000 sessions from a thread per core while an updater walks every
+/// session in a loop, once with a map behind a single mutex held for the whole
+/// walk and once with the session table, and reports the lookups per second.
+BOOST_AUTO_TEST_CASE(LookupThroughputWhileUpdating) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t session_count = 5000;
+    const uint32_t lookups_per_thread = 200000;
+    const uint32_t thread_count = std::max(2u, boost::thread::hardware_concurrency());
+
+    vector<udp::endpoint> endpoints;
+    for (uint32_t i = 0; i < session_count; ++i) {
+        endpoints.push_back(Endpoint(i));
+        Insert(i);
+    }
+
+    typedef map<udp::endpoint, shared_ptr<FakeSession>> SessionMap;
+    boost::mutex session_map_mutex;
+    SessionMap session_map;
+    for (auto& endpoint : endpoints) {
+        session_map.insert(make_pair(endpoint, make_shared<FakeSession>(endpoint)));
+    }
+
+    // runs the lookups with the updater walking alongside, returns the lookups per second
+    auto run = [&] (function<shared_ptr<FakeSession> (const udp::endpoint&)> find, function<void ()> update) -> double {
+        std::atomic<bool> done(false);
+        std::atomic<uint32_t> found(0);
+
+        boost::thread updater([&] () {
+            while (!done) {
+                update();
+            }
+        });
+
+        auto start = boost::chrono::high_resolution_clock::now();
+
+        boost::thread_group readers;
+        for (uint32_t i = 0; i < thread_count; ++i) {
+            readers.create_thread([&, i] () {
+                uint32_t hits = 0;
+                for (uint32_t j = 0; j < lookups_per_thread; ++j) {
+                    if (find(endpoints[(j * 7919 + i) % session_count])) {
+                        ++hits;
+                    }
+                }
+                found += hits;
+            });
+        }
+        readers.join_all();
+
+        double seconds = boost::chrono::duration<double>(boost::chrono::high_resolution_clock::now() - start).count();
+
+        done = true;
+        updater.join();
+
+        BOOST_CHECK_EQUAL(thread_count * lookups_per_thread, found);
+
+        return thread_count * lookups_per_thread / seconds;
+    };
+
+    double map_rate = run(
+        [&] (const udp::endpoint& endpoint) -> shared_ptr<FakeSession> {
+            boost::lock_guard<boost::mutex> lock(session_map_mutex);
+            auto find_iter = session_map.find(endpoint);
+            return find_iter != session_map.end() ? find_iter->second : nullptr;
+        },
+        [&] () {
+            boost::lock_guard<boost::mutex> lock(session_map_mutex);
+            for (auto& entry : session_map) {
+                entry.second->Update();
+            }
+        });
+
+    double table_rate = run(
+        [&] (const udp::endpoint& endpoint) { return table_.Find(endpoint); },
+        [&] () {
+            table_.ForEach([] (const shared_ptr<FakeSession>& session) {
+                session->Update();
+            });
+        });
+
+    BOOST_TEST_MESSAGE(session_count << " sessions, " << thread_count << " lookup threads, updater running");
+    BOOST_TEST_MESSAGE("Locked map:    " << static_cast<uint64_t>(map_rate) << " lookups/s");
+    BOOST_TEST_MESSAGE("Session table: " << static_cast<uint64_t>(table_rate) << " lookups/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
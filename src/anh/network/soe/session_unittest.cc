@@ -1,9 +1,12 @@
 // This file is part of SWGANH which is released under the MIT license.
 // See file LICENSE or go to http://swganh.com/LICENSE
 
+#include <deque>
 #include <memory>
+#include <set>
 #include <vector>
 #include <boost/asio.hpp>
+#include <boost/random.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include "anh/byte_buffer.h"
@@ -21,12 +24,22 @@ namespace soe {
 
 class SessionTests {
 protected:
+    SessionTests()
+        : packet_pool_(496)
+    {}
+
     // builds a simple swg message
     ByteBuffer buildSimpleMessage() const;
 
     // builds a simple data channel packet from buildSimpleMessage with the given sequence
     ByteBuffer buildSimpleDataChannelPacket(uint16_t sequence) const;
 
+    // builds a data channel packet whose message carries the packet's sequence
+    ByteBuffer buildNumberedDataChannelPacket(uint16_t sequence) const;
+
+    // strips the crc, encryption and compression from a packet sent by the session
+    ByteBuffer decodeSentPacket(Session* session, ByteBuffer packet) const;
+
     ByteBuffer buildSimpleFragmentedMessage() const;
 
     ByteBuffer buildSimpleFragmentedPacket(uint16_t sequence) const;
@@ -34,6 +47,154 @@ protected:
     udp::endpoint buildTestEndpoint() const;
 
     shared_ptr<MockServer> buildMockServer() const;
+
+    mutable PacketPool packet_pool_;
+};
+
+/// A session that reads the time from a simulated clock.
+class LoopbackSession : public Session {
+public:
+    LoopbackSession(ServerInterface* server, boost::asio::io_service& io_service,
+        udp::endpoint remote_endpoint, const Clock::time_point* now)
+        : Session(server, io_service, remote_endpoint)
+        , now_(now)
+    {}
+
+private:
+    Clock::time_point CurrentTime_() const { return *now_; }
+
+    const Clock::time_point* now_;
+};
+
+/**
+ * Connects a session to a simulated client over a link with configurable loss and
+ * latency in both directions.
+ *
+ * Like the game client, the simulated client holds on to data channel packets that
+ * arrive early and reports each of them with an OutOfOrderA, everything delivered in
+ * order is acknowledged with a cumulative AckA.
+ */
+class LossyLoopback {
+public:
+    LossyLoopback(double loss, boost::chrono::milliseconds latency)
+        : server_(make_shared<MockServer>())
+        , packet_pool_(496)
+        , loss_(loss)
+        , latency_(latency)
+        , next_client_sequence_(0)
+        , delivered_packets_(0)
+        , decompression_filter_(496)
+    {
+        MOCK_EXPECT(server_->max_receive_size).returns(496);
+        MOCK_EXPECT(server_->packet_pool).returns(&packet_pool_);
+        MOCK_EXPECT(server_->SendTo).calls([this] (const udp::endpoint&, ByteBuffer message) {
+            Transmit_(to_client_, move(message));
+        });
+
+        // the session is updated every tick
+        MOCK_EXPECT(server_->ScheduleFlush);
+        MOCK_EXPECT(server_->ScheduleResend);
+
+        session_ = make_shared<LoopbackSession>(server_.get(), io_service_,
+            udp::endpoint(address_v4::from_string("127.0.0.1"), 1000), &now_);
+        session_->crc_length(2);
+    }
+
+    /// Advances the simulated clock by one 5ms update tick.
+    void Tick() {
+        now_ += boost::chrono::milliseconds(5);
+
+        while (!to_client_.empty() && to_client_.front().first <= now_) {
+            ClientReceive_(move(to_client_.front().second));
+            to_client_.pop_front();
+        }
+
+        while (!to_session_.empty() && to_session_.front().first <= now_) {
+            session_->HandleMessage(move(to_session_.front().second));
+            to_session_.pop_front();
+        }
+
+        Poll_();
+        session_->Update();
+        Poll_();
+    }
+
+    shared_ptr<Session> session() { return session_; }
+
+    uint32_t delivered_packets() const { return delivered_packets_; }
+
+private:
+    typedef deque<pair<Session::Clock::time_point, ByteBuffer>> InFlightQueue;
+
+    void Poll_() {
+        io_service_.poll();
+        io_service_.reset();
+    }
+
+    void Transmit_(InFlightQueue& queue, ByteBuffer message) {
+        if (boost::random::bernoulli_distribution<>(loss_)(generator_)) {
+            return;
+        }
+
+        queue.push_back(make_pair(now_ + latency_, move(message)));
+    }
+
+    template<typename T>
+    void ClientSend_(T packet) {
+        ByteBuffer buffer;
+        packet.serialize(buffer);
+        Transmit_(to_session_, move(buffer));
+    }
+
+    void ClientReceive_(ByteBuffer message) {
+        crc_input_filter_(session_.get(), &message);
+        decryption_filter_(session_.get(), &message);
+        decompression_filter_(session_.get(), &message);
+
+        uint16_t opcode = message.read<uint16_t>(true);
+        if (opcode != CHILD_DATA_A && opcode != DATA_FRAG_A) {
+            return;
+        }
+
+        uint16_t sequence = message.read<uint16_t>(true);
+
+        if (sequence == next_client_sequence_) {
+            ++delivered_packets_;
+            ++next_client_sequence_;
+
+            while (early_sequences_.erase(next_client_sequence_) > 0) {
+                ++delivered_packets_;
+                ++next_client_sequence_;
+            }
+
+            ClientSend_(AckA(next_client_sequence_ - 1));
+        } else if (SequenceIsNewer(sequence, next_client_sequence_)) {
+            early_sequences_.insert(sequence);
+            ClientSend_(OutOfOrderA(sequence));
+        } else {
+            ClientSend_(AckA(next_client_sequence_ - 1));
+        }
+    }
+
+    shared_ptr<MockServer> server_;
+    PacketPool packet_pool_;
+    boost::asio::io_service io_service_;
+    shared_ptr<Session> session_;
+
+    double loss_;
+    boost::chrono::milliseconds latency_;
+    boost::random::mt19937 generator_;
+    Session::Clock::time_point now_;
+
+    InFlightQueue to_client_;
+    InFlightQueue to_session_;
+    uint16_t next_client_sequence_;
+    set<uint16_t> early_sequences_;
+    uint32_t delivered_packets_;
+
+    filters::CrcInFilter crc_input_filter_;
+    filters::DecryptionFilter decryption_filter_;
+    filters::DecompressionFilter decompression_filter_;
 };
 
 BOOST_FIXTURE_TEST_SUITE(SessionTest, SessionTests)
@@ -78,6 +239,384 @@ BOOST_AUTO_TEST_CASE(DataChannelMessagesAreStoredForResending) {
     // Expect the vector of sent messages to contain 3 elements
     BOOST_CHECK_EQUAL(3, sent_messages.size());
 }
+
+/// This test verifies that a session queues itself for a flush once per update and for
+/// the resend tick once for as long as it has messages waiting on an ack.
+BOOST_AUTO_TEST_CASE(SessionsQueueThemselvesOncePerUpdate) {
+    auto service = buildMockServer();
+    boost::asio::io_service io_service;
+    shared_ptr<Session> session = make_shared<Session>(service.get(), io_service, buildTestEndpoint());
+
+    ByteBuffer session_request;
+    SessionRequest(2, 1, 496).serialize(session_request);
+    MOCK_EXPECT(service->SendTo);
+    session->HandleProtocolMessage(move(session_request));
+    io_service.poll();
+    io_service.reset();
+
+    uint32_t flushes = 0;
+    uint32_t resends = 0;
+
+    MOCK_RESET(service->ScheduleFlush);
+    MOCK_EXPECT(service->ScheduleFlush).calls([&flushes] (shared_ptr<Session>) { ++flushes; });
+    MOCK_RESET(service->ScheduleResend);
+    MOCK_EXPECT(service->ScheduleResend).calls([&resends] (shared_ptr<Session>) { ++resends; });
+
+    session->SendTo(buildSimpleMessage());
+    session->SendTo(buildSimpleMessage());
+    BOOST_CHECK_EQUAL(1, flushes);
+
+    session->Update();
+    BOOST_CHECK_EQUAL(1, resends);
+
+    session->SendTo(buildSimpleMessage());
+    BOOST_CHECK_EQUAL(2, flushes);
+
+    // already waiting on the resend tick
+    session->Update();
+    BOOST_CHECK_EQUAL(1, resends);
+
+    session->UpdateResends();
+    BOOST_CHECK_EQUAL(2, resends);
+
+    // once everything is acknowledged the resend tick lets go of the session
+    ByteBuffer ack;
+    AckA(session->server_sequence() - 1).serialize(ack);
+    session->HandleMessage(move(ack));
+    io_service.poll();
+    io_service.reset();
+
+    session->UpdateResends();
+    BOOST_CHECK_EQUAL(2, resends);
+    BOOST_CHECK_EQUAL(2, flushes);
+
+    MOCK_EXPECT(service->RemoveSession).returns(true);
+    session->Close();
+}
+
+/// This test verifies that the round trip estimate follows the latency of the link.
+BOOST_AUTO_TEST_CASE(RoundTripTimeTracksLinkLatency) {
+    LossyLoopback link(0.0, boost::chrono::milliseconds(50));
+    auto session = link.session();
+
+    for (int i = 0; i < 100; ++i) {
+        session->SendTo(buildSimpleMessage());
+        link.Tick();
+    }
+
+    BOOST_CHECK(session->smoothed_rtt() >= boost::chrono::milliseconds(100));
+    BOOST_CHECK(session->smoothed_rtt() <= boost::chrono::milliseconds(110));
+    BOOST_CHECK(session->retransmit_timeout() >= session->smoothed_rtt());
+    BOOST_CHECK_EQUAL(0, session->resent_packets());
+}
+
+/// This test verifies that an unacknowledged message is resent once the retransmit
+/// timeout expires and that the timeout backs off afterwards.
+BOOST_AUTO_TEST_CASE(UnacknowledgedMessagesAreResentAfterTimeout) {
+    LossyLoopback link(1.0, boost::chrono::milliseconds(50));
+    auto session = link.session();
+
+    auto timeout = session->retransmit_timeout();
+
+    session->SendTo(buildSimpleMessage());
+    link.Tick();
+
+    for (auto elapsed = boost::chrono::milliseconds(5); elapsed < timeout; elapsed += boost::chrono::milliseconds(5)) {
+        link.Tick();
+    }
+
+    BOOST_CHECK_EQUAL(0, session->resent_packets());
+
+    link.Tick();
+
+    BOOST_CHECK_EQUAL(1, session->resent_packets());
+    BOOST_CHECK(session->retransmit_timeout() == timeout * 2);
+    BOOST_CHECK_EQUAL(1, session->server_sequence());
+}
+
+/// This test verifies that no more than the send window is in flight at once.
+BOOST_AUTO_TEST_CASE(SendWindowLimitsMessagesInFlight) {
+    LossyLoopback link(0.0, boost::chrono::milliseconds(20));
+    auto session = link.session();
+
+    session->send_window_packets(1);
+
+    // Each message takes up over half of the send window.
+    ByteBuffer large_message;
+    for (uint32_t i = 0; i < session->receive_buffer_size() / 2; ++i) {
+        large_message.write<uint8_t>(0xFF);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        session->SendTo(large_message);
+        link.Tick();
+    }
+
+    BOOST_CHECK_EQUAL(1, session->server_sequence());
+
+    for (int i = 0; i < 100; ++i) {
+        link.Tick();
+    }
+
+    BOOST_CHECK_EQUAL(3, session->server_sequence());
+    BOOST_CHECK_EQUAL(3, link.delivered_packets());
+    BOOST_CHECK_EQUAL(0, session->GetUnacknowledgedMessages().size());
+}
+
+/// This test verifies that every message reaches the remote end over a lossy link.
+BOOST_AUTO_TEST_CASE(ReliableDeliveryOverLossyLink) {
+    LossyLoopback link(0.1, boost::chrono::milliseconds(30));
+    auto session = link.session();
+
+    for (int i = 0; i < 200; ++i) {
+        session->SendTo(buildSimpleMessage());
+        link.Tick();
+    }
+
+    for (int i = 0; i < 5000 && !session->GetUnacknowledgedMessages().empty(); ++i) {
+        link.Tick();
+    }
+
+    BOOST_CHECK_EQUAL(200, session->server_sequence());
+    BOOST_CHECK_EQUAL(200, link.delivered_packets());
+    BOOST_CHECK_EQUAL(0, session->GetUnacknowledgedMessages().size());
+    BOOST_CHECK_EQUAL(200 + session->resent_packets(), session->server_net_stats().server_packets_sent);
+
+    BOOST_TEST_MESSAGE("200 packets over a 10% lossy link: " << session->resent_packets() << " resent, "
+        << session->smoothed_rtt().count() << "ms smoothed rtt");
+}
+/// This test verifies that data channel packets arriving out of order are held and
+/// delivered in order once the gap is filled, rather than being dropped.
+BOOST_AUTO_TEST_CASE(ReorderedPacketsAreDeliveredInOrder) {
+    auto service = buildMockServer();
+    boost::asio::io_service io_service;
+    shared_ptr<Session> session = make_shared<Session>(service.get(), io_service, buildTestEndpoint());
+    session->crc_length(2);
+
+    vector<uint32_t> delivered;
+    MOCK_EXPECT(service->HandleMessage).calls([&delivered] (const shared_ptr<Session>&, ByteBuffer message) {
+        message.read<uint16_t>();
+        delivered.push_back(message.read<uint32_t>());
+    });
+
+    vector<ByteBuffer> sent;
+    MOCK_EXPECT(service->SendTo).calls([&sent] (const udp::endpoint&, ByteBuffer message) {
+        sent.push_back(move(message));
+    });
+
+    // Every packet arrives, but a few pairs are swapped and 3 arrives twice.
+    uint16_t arrival_order[] = { 0, 2, 1, 3, 5, 4, 6, 3, 8, 7, 9 };
+    for (uint16_t sequence : arrival_order) {
+        session->HandleMessage(buildNumberedDataChannelPacket(sequence));
+    }
+
+    io_service.run();
+
+    BOOST_REQUIRE_EQUAL(10, delivered.size());
+    for (uint32_t i = 0; i < delivered.size(); ++i) {
+        BOOST_CHECK_EQUAL(i, delivered[i]);
+    }
+
+    uint32_t out_of_order_count = 0;
+    uint16_t last_ack = 0;
+
+    for (auto& packet : sent) {
+        ByteBuffer decoded = decodeSentPacket(session.get(), move(packet));
+        uint16_t opcode = decoded.read<uint16_t>(true);
+        uint16_t sequence = decoded.read<uint16_t>(true);
+
+        if (opcode == OUT_OF_ORDER_A) {
+            ++out_of_order_count;
+        } else if (opcode == ACK_A) {
+            last_ack = sequence;
+        }
+    }
+
+    // Only the early arrivals are reported, so nothing that was received needs resending.
+    BOOST_CHECK_EQUAL(3, out_of_order_count);
+    BOOST_CHECK_EQUAL(9, last_ack);
+
+    BOOST_TEST_MESSAGE(sizeof(arrival_order) / sizeof(uint16_t) << " packets arrived: "
+        << delivered.size() << " delivered, " << out_of_order_count << " out of order reports, "
+        << sent.size() - out_of_order_count << " acks");
+}
+
+/// This test verifies that packets too far ahead of the expected sequence are dropped.
+BOOST_AUTO_TEST_CASE(PacketsBeyondReorderWindowAreDropped) {
+    auto service = buildMockServer();
+    boost::asio::io_service io_service;
+    shared_ptr<Session> session = make_shared<Session>(service.get(), io_service, buildTestEndpoint());
+    session->reorder_window(4);
+
+    vector<uint32_t> delivered;
+    MOCK_EXPECT(service->HandleMessage).calls([&delivered] (const shared_ptr<Session>&, ByteBuffer message) {
+        message.read<uint16_t>();
+        delivered.push_back(message.read<uint32_t>());
+    });
+    MOCK_EXPECT(service->SendTo);
+
+    uint16_t arrival_order[] = { 0, 10, 4, 2, 1, 3 };
+    for (uint16_t sequence : arrival_order) {
+        session->HandleMessage(buildNumberedDataChannelPacket(sequence));
+    }
+
+    io_service.run();
+
+    // 10 was outside of the window and has to be resent.
+    BOOST_CHECK_EQUAL(5, delivered.size());
+    BOOST_CHECK_EQUAL(4, delivered.back());
+}
+
+/// This test verifies that reordering is handled across the 16 bit sequence wraparound.
+BOOST_AUTO_TEST_CASE(ReorderingHandlesSequenceWraparound) {
+    auto service = buildMockServer();
+    boost::asio::io_service io_service;
+    shared_ptr<Session> session = make_shared<Session>(service.get(), io_service, buildTestEndpoint());
+
+    vector<uint32_t> delivered;
+    MOCK_EXPECT(service->HandleMessage).calls([&delivered] (const shared_ptr<Session>&, ByteBuffer message) {
+        message.read<uint16_t>();
+        delivered.push_back(message.read<uint32_t>());
+    });
+    MOCK_EXPECT(service->SendTo);
+
+    for (uint32_t sequence = 0; sequence < 0xFFFC; ++sequence) {
+        session->HandleMessage(buildNumberedDataChannelPacket(static_cast<uint16_t>(sequence)));
+    }
+
+    uint16_t arrival_order[] = { 0xFFFD, 0x0000, 0xFFFC, 0xFFFF, 0x0002, 0xFFFE, 0x0001 };
+    for (uint16_t sequence : arrival_order) {
+        session->HandleMessage(buildNumberedDataChannelPacket(sequence));
+    }
+
+    io_service.run();
+
+    BOOST_REQUIRE_EQUAL(0xFFFC + 7, delivered.size());
+
+    uint32_t expected_tail[] = { 0xFFFC, 0xFFFD, 0xFFFE, 0xFFFF, 0x0000, 0x0001, 0x0002 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(delivered.end() - 7, delivered.end(), begin(expected_tail), end(expected_tail));
+}
+
+/// This test verifies that with delayed acks a single cumulative ack is sent per update.
+BOOST_AUTO_TEST_CASE(DelayedAcksAreCoalescedPerUpdate) {
+    auto service = buildMockServer();
+    boost::asio::io_service io_service;
+    shared_ptr<Session> session = make_shared<Session>(service.get(), io_service, buildTestEndpoint());
+    session->crc_length(2);
+    session->delayed_acks(true);
+
+    MOCK_EXPECT(service->HandleMessage);
+
+    vector<ByteBuffer> sent;
+    MOCK_EXPECT(service->SendTo).calls([&sent] (const udp::endpoint&, ByteBuffer message) {
+        sent.push_back(move(message));
+    });
+
+    for (uint16_t sequence = 0; sequence < 10; ++sequence) {
+        session->HandleMessage(buildSimpleDataChannelPacket(sequence));
+    }
+
+    io_service.run();
+    io_service.reset();
+
+    BOOST_CHECK_EQUAL(0, sent.size());
+
+    session->Update();
+    io_service.run();
+
+    BOOST_REQUIRE_EQUAL(1, sent.size());
+
+    ByteBuffer ack = decodeSentPacket(session.get(), move(sent[0]));
+    BOOST_CHECK_EQUAL(ACK_A, ack.read<uint16_t>(true));
+    BOOST_CHECK_EQUAL(9, ack.read<uint16_t>(true));
+}
+
+/// This test verifies that a delayed ack is carried in a multi packet with outgoing data.
+BOOST_AUTO_TEST_CASE(DelayedAckIsPiggybackedOnOutgoingData) {
+    auto service = buildMockServer();
+    boost::asio::io_service io_service;
+    shared_ptr<Session> session = make_shared<Session>(service.get(), io_service, buildTestEndpoint());
+    session->crc_length(2);
+    session->delayed_acks(true);
+
+    MOCK_EXPECT(service->HandleMessage);
+
+    vector<ByteBuffer> sent;
+    MOCK_EXPECT(service->SendTo).calls([&sent] (const udp::endpoint&, ByteBuffer message) {
+        sent.push_back(move(message));
+    });
+
+    for (uint16_t sequence = 0; sequence < 3; ++sequence) {
+        session->HandleMessage(buildSimpleDataChannelPacket(sequence));
+    }
+
+    io_service.run();
+    io_service.reset();
+
+    session->SendTo(buildSimpleMessage());
+    session->Update();
+    io_service.run();
+
+    BOOST_REQUIRE_EQUAL(1, sent.size());
+
+    ByteBuffer decoded = decodeSentPacket(session.get(), move(sent[0]));
+    BOOST_REQUIRE_EQUAL(MULTI_PACKET, decoded.peek<uint16_t>(true));
+
+    MultiPacket multi_packet(decoded);
+    BOOST_REQUIRE_EQUAL(2, multi_packet.packets.size());
+
+    ByteBuffer& ack = multi_packet.packets.front();
+    BOOST_CHECK_EQUAL(ACK_A, ack.read<uint16_t>(true));
+    BOOST_CHECK_EQUAL(2, ack.read<uint16_t>(true));
+
+    ByteBuffer& data = multi_packet.packets.back();
+    BOOST_CHECK_EQUAL(CHILD_DATA_A, data.read<uint16_t>(true));
+    BOOST_CHECK_EQUAL(0, data.read<uint16_t>(true));
+
+    // Only the data channel message itself is kept for resending.
+    BOOST_REQUIRE_EQUAL(1, session->GetUnacknowledgedMessages().size());
+    BOOST_CHECK(session->GetUnacknowledgedMessages()[0] == buildSimpleDataChannelPacket(0));
+}
+
+/// This test compares the outbound packet count with and without delayed acks when
+/// traffic flows both ways every update.
+BOOST_AUTO_TEST_CASE(DelayedAcksReduceOutboundPackets) {
+    auto count_outbound_packets = [this] (bool delayed_acks) -> uint32_t {
+        auto service = buildMockServer();
+        boost::asio::io_service io_service;
+        shared_ptr<Session> session = make_shared<Session>(service.get(), io_service, buildTestEndpoint());
+        session->delayed_acks(delayed_acks);
+
+        uint32_t sent = 0;
+        MOCK_EXPECT(service->HandleMessage);
+        MOCK_EXPECT(service->SendTo).calls([&sent] (const udp::endpoint&, ByteBuffer) { ++sent; });
+
+        for (uint16_t sequence = 0; sequence < 100; ++sequence) {
+            session->HandleMessage(buildSimpleDataChannelPacket(sequence));
+            session->SendTo(buildSimpleMessage());
+
+            io_service.poll();
+            io_service.reset();
+
+            session->Update();
+
+            io_service.poll();
+            io_service.reset();
+        }
+
+        return sent;
+    };
+
+    uint32_t immediate = count_outbound_packets(false);
+    uint32_t delayed = count_outbound_packets(true);
+
+    BOOST_CHECK_EQUAL(200, immediate);
+    BOOST_CHECK_EQUAL(100, delayed);
+
+    BOOST_TEST_MESSAGE("100 updates with traffic both ways: " << immediate << " packets sent with immediate acks, "
+        << delayed << " with delayed acks");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // SessionTest member implementations
@@ -101,6 +640,29 @@ ByteBuffer SessionTests::buildSimpleDataChannelPacket(uint16_t sequence) const {
     return buffer;
 }
 
+ByteBuffer SessionTests::buildNumberedDataChannelPacket(uint16_t sequence) const {
+    ByteBuffer buffer;
+
+    buffer.write<uint16_t>(hostToBig<uint16_t>(0x09));
+    buffer.write<uint16_t>(hostToBig<uint16_t>(sequence));
+    buffer.write<uint16_t>(1);
+    buffer.write<uint32_t>(sequence);
+
+    return buffer;
+}
+
+ByteBuffer SessionTests::decodeSentPacket(Session* session, ByteBuffer packet) const {
+    filters::CrcInFilter crc_input_filter;
+    filters::DecryptionFilter decryption_filter;
+    filters::DecompressionFilter decompression_filter(496);
+
+    crc_input_filter(session, &packet);
+    decryption_filter(session, &packet);
+    decompression_filter(session, &packet);
+
+    return packet;
+}
+
 ByteBuffer SessionTests::buildSimpleFragmentedMessage() const {
     ByteBuffer buffer;
 
@@ -137,7 +699,12 @@ shared_ptr<MockServer> SessionTests::buildMockServer() const {
     MOCK_EXPECT(server->max_receive_size)
         .at_least(1)
         .returns(496);
-        
+    MOCK_EXPECT(server->packet_pool).returns(&packet_pool_);
+
+    // the tests update their sessions themselves
+    MOCK_EXPECT(server->ScheduleFlush);
+    MOCK_EXPECT(server->ScheduleResend);
+
     return server;
 }
 
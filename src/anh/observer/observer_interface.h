@@ -4,6 +4,9 @@
 #ifndef ANH_OBSERVER_OBSERVER_INTERFACE_H_
 #define ANH_OBSERVER_OBSERVER_INTERFACE_H_
 
+#include <memory>
+#include <type_traits>
+
 #include "anh/byte_buffer.h"
 
 namespace anh {
@@ -55,6 +58,20 @@ namespace observer {
         public:
             static const bool value = sizeof(Yes) == sizeof(Deduce(static_cast<Base*>(0)));
         };
+
+        template<typename T>
+        typename std::enable_if<HasObservableId<T>::value, int32_t>::type
+        ObservableIdOffset()
+        {
+            return T::ObservableIdOffset();
+        }
+
+        template<typename T>
+        typename std::enable_if<!HasObservableId<T>::value, int32_t>::type
+        ObservableIdOffset()
+        {
+            return -1;
+        }
     }
 
     class ObserverInterface
@@ -98,6 +115,78 @@ namespace observer {
          * @param message Message containing the updated state of the observable object.
          */
         virtual void Notify(const anh::ByteBuffer& message) = 0;
+
+        /**
+         * Notifies observer with a message shared with other observers.
+         *
+         * Observers that queue messages can hold on to the shared buffer rather than
+         * copying it. The buffer must not be modified.
+         *
+         * @param message Message containing the updated state of the observable object.
+         */
+        virtual void Notify(const std::shared_ptr<const anh::ByteBuffer>& message)
+        {
+            Notify(*message);
+        }
+    };
+
+    /**
+     * A message serialized once to be delivered to any number of observers.
+     *
+     * Messages addressed to their observer (those with an observable_id) are given to
+     * each observer as a copy of the serialized message with its id written over the
+     * serialized one, everything else is shared between all of the observers.
+     */
+    class BroadcastMessage
+    {
+    public:
+        template<typename T>
+        explicit BroadcastMessage(const T& message)
+            : observable_id_offset_(detail::ObservableIdOffset<T>())
+        {
+            auto buffer = std::make_shared<anh::ByteBuffer>();
+            message.Serialize(*buffer);
+
+            buffer_ = std::move(buffer);
+        }
+
+        explicit BroadcastMessage(anh::ByteBuffer message)
+            : buffer_(std::make_shared<anh::ByteBuffer>(std::move(message)))
+            , observable_id_offset_(-1)
+        {}
+
+        /**
+         * @return The serialized message, shared between observers.
+         */
+        const std::shared_ptr<const anh::ByteBuffer>& buffer() const
+        {
+            return buffer_;
+        }
+
+        /**
+         * Delivers the message to an observer.
+         *
+         * @param observer The observer to notify.
+         */
+        void Notify(ObserverInterface& observer) const
+        {
+            if (observable_id_offset_ < 0)
+            {
+                observer.Notify(buffer_);
+                return;
+            }
+
+            auto addressed = std::make_shared<anh::ByteBuffer>(*buffer_);
+            addressed->writeAt<uint64_t>(observable_id_offset_, observer.GetId());
+
+            observer.Notify(std::shared_ptr<const anh::ByteBuffer>(std::move(addressed)));
+        }
+
+    private:
+        BroadcastMessage();
+
+        std::shared_ptr<const anh::ByteBuffer> buffer_;
+        int32_t observable_id_offset_;
     };
 
 }}  // namespace anh::observer
@@ -0,0 +1,217 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <memory>
+#include <vector>
+#include <boost/chrono.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/byte_buffer.h"
+#include "anh/observer/observer_interface.h"
+
+using namespace anh;
+using namespace anh::observer;
+using namespace std;
+
+namespace {
+
+/// Laid out like the UpdateTransformMessage sent for every movement update.
+struct TransformMessage {
+    uint64_t object_id;
+    int16_t x, y, z;
+    uint32_t update_counter;
+    uint8_t heading;
+
+    void Serialize(ByteBuffer& buffer) const {
+        buffer.write<uint16_t>(8);
+        buffer.write<uint32_t>(0x1B24F808);
+        buffer.write(object_id);
+        buffer.write(x);
+        buffer.write(y);
+        buffer.write(z);
+        buffer.write(update_counter);
+        buffer.write<uint8_t>(0);
+        buffer.write(heading);
+    }
+};
+
+/// Laid out like the ObjControllerMessage, which is addressed to its observer.
+struct AddressedMessage {
+    static int32_t ObservableIdOffset() { return 14; }
+
+    uint32_t controller_type;
+    uint32_t message_type;
+    uint64_t observable_id;
+    uint32_t tick_count;
+
+    void Serialize(ByteBuffer& buffer) const {
+        buffer.write<uint16_t>(5);
+        buffer.write<uint32_t>(0x80CE5E46);
+        buffer.write(controller_type);
+        buffer.write(message_type);
+        buffer.write(observable_id);
+        buffer.write(tick_count);
+    }
+};
+
+/// Queues what it's notified with the way a session queues outgoing messages.
+class QueueingObserver : public ObserverInterface {
+public:
+    explicit QueueingObserver(uint64_t id)
+        : id_(id)
+    {}
+
+    using ObserverInterface::Notify;
+
+    uint64_t GetId() const { return id_; }
+
+    void Notify(const ByteBuffer& message) {
+        queue_.push_back(make_shared<ByteBuffer>(message));
+    }
+
+    void Notify(const shared_ptr<const ByteBuffer>& message) {
+        queue_.push_back(message);
+    }
+
+    vector<shared_ptr<const ByteBuffer>>& queue() { return queue_; }
+
+private:
+    uint64_t id_;
+    vector<shared_ptr<const ByteBuffer>> queue_;
+};
+
+class BroadcastMessageTests {
+protected:
+    BroadcastMessageTests() {
+        for (uint64_t i = 0; i < 3; ++i) {
+            observers_.push_back(make_shared<QueueingObserver>(1000 + i));
+        }
+    }
+
+    vector<shared_ptr<QueueingObserver>> observers_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(BroadcastMessageTest, BroadcastMessageTests)
+
+/// This test verifies that every observer is handed the same serialized message.
+BOOST_AUTO_TEST_CASE(ObserversShareTheSerializedMessage) {
+    TransformMessage message = { 42, 1, 2, 3, 7, 90 };
+
+    BroadcastMessage broadcast(message);
+
+    for (auto& observer : observers_) {
+        broadcast.Notify(*observer);
+    }
+
+    ByteBuffer expected;
+    message.Serialize(expected);
+
+    for (auto& observer : observers_) {
+        BOOST_REQUIRE_EQUAL(1, observer->queue().size());
+        BOOST_CHECK(broadcast.buffer() == observer->queue().front());
+    }
+
+    BOOST_REQUIRE_EQUAL(expected.size(), broadcast.buffer()->size());
+    BOOST_CHECK(equal(expected.data(), expected.data() + expected.size(), broadcast.buffer()->data()));
+}
+
+/// This test verifies that addressed messages carry each observer's own id.
+BOOST_AUTO_TEST_CASE(AddressedMessagesCarryTheObserversId) {
+    AddressedMessage message = { 0x0B, 0x0116, 0, 12345 };
+
+    BroadcastMessage broadcast(message);
+
+    for (auto& observer : observers_) {
+        broadcast.Notify(*observer);
+    }
+
+    for (auto& observer : observers_) {
+        AddressedMessage addressed = message;
+        addressed.observable_id = observer->GetId();
+
+        ByteBuffer expected;
+        addressed.Serialize(expected);
+
+        BOOST_REQUIRE_EQUAL(1, observer->queue().size());
+
+        auto& received = observer->queue().front();
+        BOOST_CHECK(broadcast.buffer() != received);
+        BOOST_REQUIRE_EQUAL(expected.size(), received->size());
+        BOOST_CHECK(equal(expected.data(), expected.data() + expected.size(), received->data()));
+    }
+}
+
+/// A crowd of 200 players all watching each other, each moving at 10 Hz for 10 seconds
+/// of game time. Reports how long the movement updates take to reach every observer
+/// when serialized once per observer and when broadcast.
+BOOST_AUTO_TEST_CASE(CrowdMovementBroadcastThroughput) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t crowd_size = 200;
+    const uint32_t updates = 10 * 10;
+
+    vector<shared_ptr<QueueingObserver>> crowd;
+    for (uint32_t i = 0; i < crowd_size; ++i) {
+        crowd.push_back(make_shared<QueueingObserver>(i));
+        crowd.back()->queue().reserve(crowd_size);
+    }
+
+    typedef boost::chrono::high_resolution_clock clock;
+
+    uint64_t delivered = 0;
+
+    auto run = [&] (bool broadcast) -> double {
+        clock::duration elapsed(0);
+
+        for (uint32_t update = 0; update < updates; ++update) {
+            auto start = clock::now();
+
+            for (uint32_t mover = 0; mover < crowd_size; ++mover) {
+                TransformMessage message = { mover, int16_t(update), 0, int16_t(mover), update, 0 };
+
+                if (broadcast) {
+                    BroadcastMessage broadcast_message(message);
+
+                    for (auto& observer : crowd) {
+                        broadcast_message.Notify(*observer);
+                    }
+                } else {
+                    for (auto& observer : crowd) {
+                        observer->Notify(message);
+                    }
+                }
+            }
+
+            elapsed += clock::now() - start;
+
+            // The sessions send their queues between ticks.
+            for (auto& observer : crowd) {
+                delivered += observer->queue().size();
+                observer->queue().clear();
+            }
+        }
+
+        return boost::chrono::duration<double>(elapsed).count();
+    };
+
+    double per_observer_seconds = run(false);
+    double broadcast_seconds = run(true);
+
+    double deliveries = static_cast<double>(crowd_size) * crowd_size * updates;
+
+    BOOST_CHECK_EQUAL(2 * deliveries, delivered);
+
+    BOOST_TEST_MESSAGE(crowd_size << " observers, " << crowd_size << " movers at 10 Hz for 10s: "
+        << static_cast<uint64_t>(deliveries) << " deliveries");
+    BOOST_TEST_MESSAGE("Serialized per observer: " << per_observer_seconds << "s, "
+        << static_cast<uint64_t>(deliveries / per_observer_seconds) << " deliveries/s");
+    BOOST_TEST_MESSAGE("Broadcast:               " << broadcast_seconds << "s, "
+        << static_cast<uint64_t>(deliveries / broadcast_seconds) << " deliveries/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -0,0 +1,247 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "timing_wheel.h"
+
+#include <algorithm>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+using namespace anh;
+using namespace std;
+
+using boost::posix_time::microsec_clock;
+using boost::posix_time::microseconds;
+using boost::posix_time::time_duration;
+
+TimingWheel::TimingWheel(boost::asio::io_service& io_service, time_duration resolution)
+    : io_service_(io_service)
+    , tick_timer_(io_service)
+    , resolution_(max(resolution, time_duration(microseconds(1))))
+    , running_(false)
+    , current_tick_(0)
+    , next_timer_id_(0)
+{}
+
+TimingWheel::~TimingWheel()
+{
+    Stop();
+}
+
+void TimingWheel::Start()
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    if (running_)
+    {
+        return;
+    }
+
+    running_ = true;
+
+    // carry on counting from the tick the wheel was stopped at
+    started_at_ = microsec_clock::universal_time() - microseconds(resolution_.total_microseconds() * current_tick_);
+
+    Wait_();
+}
+
+void TimingWheel::Stop()
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    running_ = false;
+    tick_timer_.cancel();
+}
+
+TimingWheel::TimerId TimingWheel::Schedule(time_duration delay, Callback callback)
+{
+    int64_t resolution = resolution_.total_microseconds();
+    int64_t ticks = max<int64_t>((delay.total_microseconds() + resolution - 1) / resolution, 0);
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    TimerId timer_id = ++next_timer_id_;
+
+    auto& timer = timers_[timer_id];
+    timer.expires = current_tick_ + static_cast<uint64_t>(ticks);
+    timer.callback = move(callback);
+
+    Add_(timer_id, timer);
+
+    return timer_id;
+}
+
+bool TimingWheel::Cancel(TimerId timer_id)
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    auto find_iter = timers_.find(timer_id);
+
+    if (find_iter == timers_.end())
+    {
+        return false;
+    }
+
+    find_iter->second.slot->erase(find_iter->second.position);
+    timers_.erase(find_iter);
+
+    return true;
+}
+
+void TimingWheel::Advance(uint64_t ticks)
+{
+    vector<Callback> expired;
+
+    for (uint64_t i = 0; i < ticks; ++i)
+    {
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            Tick_(expired);
+        }
+
+        // run outside the lock so callbacks can schedule and cancel, a tick at a
+        // time so what they schedule is counted from the tick they ran on
+        for (auto& callback : expired)
+        {
+            callback();
+        }
+
+        expired.clear();
+    }
+}
+
+size_t TimingWheel::GetScheduledCount()
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return timers_.size();
+}
+
+uint64_t TimingWheel::GetCurrentTick()
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return current_tick_;
+}
+
+void TimingWheel::Add_(TimerId timer_id, Timer& timer)
+{
+    Slot* slot = nullptr;
+
+    if (timer.expires < current_tick_)
+    {
+        // overdue, run on the next tick
+        slot = &near_[current_tick_ & kNearMask];
+    }
+    else if (timer.expires - current_tick_ < kNearSlots)
+    {
+        slot = &near_[timer.expires & kNearMask];
+    }
+    else
+    {
+        // anything further out than the wheel reaches waits in the last level
+        // and is placed again each time it's cascaded until it's in reach
+        const uint64_t reach = uint64_t(1) << (kNearBits + kLevelCount * kLevelBits);
+        uint64_t expires = min(timer.expires, current_tick_ + reach - 1);
+        uint64_t delta = expires - current_tick_;
+
+        for (uint32_t level = 0; level < kLevelCount; ++level)
+        {
+            uint32_t shift = kNearBits + level * kLevelBits;
+
+            if (delta < (uint64_t(1) << (shift + kLevelBits)))
+            {
+                slot = &levels_[level][(expires >> shift) & kLevelMask];
+                break;
+            }
+        }
+    }
+
+    timer.slot = slot;
+    timer.position = slot->insert(slot->end(), timer_id);
+}
+
+uint32_t TimingWheel::Cascade_(uint32_t level)
+{
+    uint32_t index = (current_tick_ >> (kNearBits + level * kLevelBits)) & kLevelMask;
+
+    Slot cascading;
+    cascading.swap(levels_[level][index]);
+
+    for (TimerId timer_id : cascading)
+    {
+        Add_(timer_id, timers_[timer_id]);
+    }
+
+    return index;
+}
+
+void TimingWheel::Tick_(vector<Callback>& expired)
+{
+    uint32_t index = current_tick_ & kNearMask;
+
+    // each time round the near slots bring down the next slot of the level above,
+    // and so on up while those come round too
+    if (index == 0)
+    {
+        for (uint32_t level = 0; level < kLevelCount; ++level)
+        {
+            if (Cascade_(level) != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    Slot due;
+    due.swap(near_[index]);
+
+    ++current_tick_;
+
+    for (TimerId timer_id : due)
+    {
+        auto find_iter = timers_.find(timer_id);
+        expired.push_back(move(find_iter->second.callback));
+        timers_.erase(find_iter);
+    }
+}
+
+void TimingWheel::Wait_()
+{
+    tick_timer_.expires_at(started_at_ + microseconds(resolution_.total_microseconds() * (current_tick_ + 1)));
+    tick_timer_.async_wait([this] (const boost::system::error_code& error) { HandleTick_(error); });
+}
+
+void TimingWheel::HandleTick_(const boost::system::error_code& error)
+{
+    if (error)
+    {
+        return;
+    }
+
+    vector<Callback> expired;
+
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+
+        if (!running_)
+        {
+            return;
+        }
+
+        // catch up on every tick that's passed, not just the one waited for
+        int64_t elapsed = (microsec_clock::universal_time() - started_at_).total_microseconds();
+        uint64_t target_tick = static_cast<uint64_t>(max<int64_t>(elapsed, 0) / resolution_.total_microseconds());
+
+        while (current_tick_ < target_tick)
+        {
+            Tick_(expired);
+        }
+
+        Wait_();
+    }
+
+    // the wheel only keeps time, the callbacks run as handlers of their own
+    for (auto& callback : expired)
+    {
+        io_service_.post(move(callback));
+    }
+}
@@ -0,0 +1,139 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_TIMING_WHEEL_H_
+#define ANH_TIMING_WHEEL_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace anh {
+
+/**
+ * Runs callbacks after a delay, sharing one asio timer between all of them.
+ *
+ * Time is counted in ticks of a fixed resolution. Callbacks due in the next 256
+ * ticks are kept in a slot per tick, later ones in coarser levels of 64 slots each
+ * that are cascaded down as the wheel turns. Scheduling and cancelling a callback
+ * take constant time however many are scheduled.
+ *
+ * Callbacks are posted to the io_service tick by tick as they come due, never
+ * before their delay and usually within a tick after it. They run as handlers of
+ * their own, so a slow callback holds up neither the wheel nor the others due
+ * with it, and owners that need their callbacks serialized wrap them in a strand.
+ */
+class TimingWheel {
+public:
+    typedef std::function<void ()> Callback;
+    typedef uint64_t TimerId;
+
+    /**
+     * @param io_service drives the wheel and runs the callbacks posted to it.
+     * @param resolution the length of a tick.
+     */
+    explicit TimingWheel(boost::asio::io_service& io_service,
+        boost::posix_time::time_duration resolution = boost::posix_time::milliseconds(10));
+    ~TimingWheel();
+
+    /**
+     * Starts turning the wheel on the io_service.
+     */
+    void Start();
+
+    /**
+     * Stops turning the wheel, callbacks still scheduled are not run.
+     */
+    void Stop();
+
+    /**
+     * Schedules a callback to run once after a delay.
+     *
+     * @param delay the time to wait, rounded up to a whole number of ticks.
+     * @param callback the callback to run.
+     * @return An id that can be used to cancel the callback.
+     */
+    TimerId Schedule(boost::posix_time::time_duration delay, Callback callback);
+
+    /**
+     * Cancels a scheduled callback.
+     *
+     * @param timer_id the id returned when the callback was scheduled.
+     * @return True if the callback was cancelled, false if it has already run or
+     *  been cancelled.
+     */
+    bool Cancel(TimerId timer_id);
+
+    /**
+     * Turns the wheel by a number of ticks, running the callbacks that come due
+     * on the calling thread.
+     *
+     * This is only public to drive the wheel by hand, a started wheel turns itself
+     * as time passes and posts the callbacks instead.
+     *
+     * @param ticks the number of ticks to advance.
+     */
+    void Advance(uint64_t ticks);
+
+    /**
+     * @return The number of callbacks waiting to run.
+     */
+    size_t GetScheduledCount();
+
+    /**
+     * @return The number of ticks the wheel has turned.
+     */
+    uint64_t GetCurrentTick();
+
+    boost::posix_time::time_duration GetResolution() const { return resolution_; }
+
+private:
+    static const uint32_t kNearBits = 8;
+    static const uint32_t kNearSlots = 1 << kNearBits;
+    static const uint32_t kNearMask = kNearSlots - 1;
+    static const uint32_t kLevelBits = 6;
+    static const uint32_t kLevelSlots = 1 << kLevelBits;
+    static const uint32_t kLevelMask = kLevelSlots - 1;
+    static const uint32_t kLevelCount = 4;
+
+    typedef std::list<TimerId> Slot;
+
+    struct Timer
+    {
+        uint64_t expires;
+        Callback callback;
+        Slot* slot;
+        Slot::iterator position;
+    };
+
+    void Add_(TimerId timer_id, Timer& timer);
+    uint32_t Cascade_(uint32_t level);
+    void Tick_(std::vector<Callback>& expired);
+    void Wait_();
+    void HandleTick_(const boost::system::error_code& error);
+
+    boost::asio::io_service& io_service_;
+    boost::asio::deadline_timer tick_timer_;
+    boost::posix_time::time_duration resolution_;
+    boost::posix_time::ptime started_at_;
+    bool running_;
+
+    boost::mutex mutex_;
+    uint64_t current_tick_;
+    TimerId next_timer_id_;
+    std::unordered_map<TimerId, Timer> timers_;
+    std::array<Slot, kNearSlots> near_;
+    std::array<std::array<Slot, kLevelSlots>, kLevelCount> levels_;
+};
+
+}  // namespace anh
+
+#endif  // ANH_TIMING_WHEEL_H_
@@ -0,0 +1,247 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/chrono.hpp>
+#include <boost/chrono/process_cpu_clocks.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/timing_wheel.h"
+
+using namespace anh;
+using namespace std;
+
+using boost::posix_time::milliseconds;
+
+namespace {
+
+const boost::posix_time::time_duration resolution = milliseconds(10);
+
+boost::posix_time::time_duration Ticks(uint64_t ticks) {
+    return milliseconds(10 * ticks);
+}
+
+class TimingWheelTests {
+protected:
+    TimingWheelTests()
+        : wheel_(io_service_, resolution)
+    {}
+
+    boost::asio::io_service io_service_;
+    TimingWheel wheel_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TimingWheelTest, TimingWheelTests)
+
+/// This test verifies that callbacks run on the tick they come due and in that order.
+BOOST_AUTO_TEST_CASE(CallbacksRunWhenDue) {
+    vector<int> ran;
+
+    wheel_.Schedule(Ticks(3), [&ran] () { ran.push_back(3); });
+    wheel_.Schedule(milliseconds(0), [&ran] () { ran.push_back(0); });
+    wheel_.Schedule(milliseconds(15), [&ran] () { ran.push_back(2); });
+
+    wheel_.Advance(1);
+    BOOST_REQUIRE_EQUAL(1, ran.size());
+
+    // delays are rounded up to a whole tick
+    wheel_.Advance(1);
+    BOOST_REQUIRE_EQUAL(1, ran.size());
+    wheel_.Advance(1);
+    BOOST_REQUIRE_EQUAL(2, ran.size());
+
+    wheel_.Advance(1);
+    BOOST_REQUIRE_EQUAL(3, ran.size());
+    BOOST_CHECK_EQUAL(0, ran[0]);
+    BOOST_CHECK_EQUAL(2, ran[1]);
+    BOOST_CHECK_EQUAL(3, ran[2]);
+    BOOST_CHECK_EQUAL(0, wheel_.GetScheduledCount());
+}
+
+/// This test verifies that callbacks due beyond the near slots are cascaded down and run on time.
+BOOST_AUTO_TEST_CASE(LongDelaysAreCascadedDown) {
+    const uint64_t delays[] = {1, 255, 256, 257, 1000, 16383, 16384, 70000, (1 << 20) + 5, (1 << 21) + 7};
+
+    // start part way round so the delays don't line up with the slots
+    wheel_.Advance(77);
+
+    for (uint64_t delay : delays) {
+        bool ran = false;
+        wheel_.Schedule(Ticks(delay), [&ran] () { ran = true; });
+
+        wheel_.Advance(delay);
+        BOOST_CHECK_MESSAGE(!ran, "ran early with a delay of " << delay << " ticks");
+
+        wheel_.Advance(1);
+        BOOST_CHECK_MESSAGE(ran, "didn't run with a delay of " << delay << " ticks");
+    }
+}
+
+/// This test verifies that a cancelled callback is never run.
+BOOST_AUTO_TEST_CASE(CancelledCallbacksDontRun) {
+    bool cancelled_ran = false, kept_ran = false;
+
+    auto cancelled = wheel_.Schedule(Ticks(500), [&cancelled_ran] () { cancelled_ran = true; });
+    auto kept = wheel_.Schedule(Ticks(500), [&kept_ran] () { kept_ran = true; });
+
+    BOOST_CHECK(wheel_.Cancel(cancelled));
+    BOOST_CHECK(!wheel_.Cancel(cancelled));
+    BOOST_CHECK_EQUAL(1, wheel_.GetScheduledCount());
+
+    wheel_.Advance(501);
+
+    BOOST_CHECK(!cancelled_ran);
+    BOOST_CHECK(kept_ran);
+    BOOST_CHECK(!wheel_.Cancel(kept));
+}
+
+/// This test verifies that callbacks can schedule more callbacks.
+BOOST_AUTO_TEST_CASE(CallbacksCanReschedule) {
+    uint32_t run_count = 0;
+    function<void ()> repeat = [&] () {
+        if (++run_count < 5) {
+            wheel_.Schedule(Ticks(2), repeat);
+        }
+    };
+
+    wheel_.Schedule(Ticks(2), repeat);
+    wheel_.Advance(100);
+
+    BOOST_CHECK_EQUAL(5, run_count);
+}
+
+/// This test verifies that a started wheel runs callbacks on the io_service no earlier than their delay.
+BOOST_AUTO_TEST_CASE(StartedWheelRunsOnTheIoService) {
+    typedef boost::chrono::steady_clock clock;
+
+    auto start = clock::now();
+    clock::time_point ran_at;
+
+    wheel_.Start();
+    wheel_.Schedule(milliseconds(50), [&] () {
+        ran_at = clock::now();
+        wheel_.Stop();
+    });
+
+    io_service_.run();
+
+    BOOST_CHECK(ran_at - start >= boost::chrono::milliseconds(50));
+}
+
+/// This test verifies that a started wheel posts due callbacks to the io_service
+/// rather than running them in its own tick handler.
+BOOST_AUTO_TEST_CASE(DueCallbacksArePostedToTheIoService) {
+    bool ran = false;
+
+    wheel_.Start();
+    wheel_.Schedule(milliseconds(0), [&] () {
+        ran = true;
+    });
+
+    // the tick the callback comes due on
+    io_service_.run_one();
+    BOOST_CHECK(!ran);
+
+    io_service_.run_one();
+    BOOST_CHECK(ran);
+
+    wheel_.Stop();
+}
+
+/// Schedules 100000 actions due over the next second, once with a deadline_timer each and
+/// once on a 1ms timing wheel, and reports how late they ran and the CPU time used.
+BOOST_AUTO_TEST_CASE(HundredThousandScheduledActions) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t action_count = 100000;
+    const int64_t spread_ms = 1000;
+
+    typedef boost::chrono::steady_clock clock;
+    typedef boost::chrono::process_cpu_clock cpu_clock;
+
+    struct Results {
+        double mean_late_ms;
+        double max_late_ms;
+        double cpu_seconds;
+    };
+
+    auto report = [] (const vector<clock::duration>& lateness, cpu_clock::duration cpu) -> Results {
+        Results results = {0.0, 0.0, 0.0};
+        for (auto& late : lateness) {
+            double late_ms = boost::chrono::duration<double, boost::milli>(late).count();
+            results.mean_late_ms += late_ms;
+            results.max_late_ms = max(results.max_late_ms, late_ms);
+        }
+        results.mean_late_ms /= lateness.size();
+        results.cpu_seconds = boost::chrono::duration<double>(
+            boost::chrono::nanoseconds(cpu.count().user + cpu.count().system)).count();
+        return results;
+    };
+
+    vector<clock::duration> lateness;
+    lateness.reserve(action_count);
+
+    // a timer per action
+    Results timers;
+    {
+        boost::asio::io_service io_service;
+        auto cpu_start = cpu_clock::now();
+        auto start = clock::now();
+
+        for (uint32_t i = 0; i < action_count; ++i) {
+            auto delay = boost::chrono::milliseconds(i % spread_ms);
+            auto timer = make_shared<boost::asio::deadline_timer>(io_service, milliseconds(delay.count()));
+            timer->async_wait([timer, start, delay, &lateness] (const boost::system::error_code&) {
+                lateness.push_back(clock::now() - (start + delay));
+            });
+        }
+
+        io_service.run();
+        timers = report(lateness, cpu_clock::now() - cpu_start);
+    }
+
+    lateness.clear();
+
+    // one timing wheel
+    Results wheel;
+    {
+        boost::asio::io_service io_service;
+        TimingWheel timing_wheel(io_service, milliseconds(1));
+        timing_wheel.Start();
+
+        auto cpu_start = cpu_clock::now();
+        auto start = clock::now();
+
+        for (uint32_t i = 0; i < action_count; ++i) {
+            auto delay = boost::chrono::milliseconds(i % spread_ms);
+            timing_wheel.Schedule(milliseconds(delay.count()), [&timing_wheel, start, delay, &lateness, action_count] () {
+                lateness.push_back(clock::now() - (start + delay));
+                if (lateness.size() == action_count) {
+                    timing_wheel.Stop();
+                }
+            });
+        }
+
+        io_service.run();
+        wheel = report(lateness, cpu_clock::now() - cpu_start);
+    }
+
+    BOOST_CHECK_EQUAL(action_count, lateness.size());
+
+    BOOST_TEST_MESSAGE(action_count << " actions due over " << spread_ms << "ms");
+    BOOST_TEST_MESSAGE("deadline_timer each: " << timers.mean_late_ms << "ms late on average, "
+        << timers.max_late_ms << "ms at most, " << timers.cpu_seconds << "s CPU");
+    BOOST_TEST_MESSAGE("Timing wheel:        " << wheel.mean_late_ms << "ms late on average, "
+        << wheel.max_late_ms << "ms at most, " << wheel.cpu_seconds << "s CPU");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
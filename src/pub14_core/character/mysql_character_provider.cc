@@ -3,6 +3,8 @@
 
 #include "mysql_character_provider.h"
 
+#include <stdexcept>
+
 #include <boost/lexical_cast.hpp>
 
 #ifdef WIN32
@@ -63,6 +65,10 @@ MysqlCharacterProvider::MysqlCharacterProvider(KernelInterface* kernel)
     , kernel_(kernel) 
 {
 	auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
+	if (!conn)
+	{
+		throw std::runtime_error("Unable to load the restricted character names: no connection to the galaxy database");
+	}
 
 	// Load each table of restricted names.
 	auto statement = std::shared_ptr<sql::PreparedStatement>(
@@ -109,6 +115,10 @@ vector<CharacterData> MysqlCharacterProvider::GetCharactersForAccount(uint64_t a
 
     try {
         auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
+        if (!conn)
+        {
+            return characters;
+        }
         auto statement = std::shared_ptr<sql::PreparedStatement>(
             conn->prepareStatement("CALL sp_ReturnAccountCharacters(?);")
             );
@@ -154,6 +164,10 @@ bool MysqlCharacterProvider::DeleteCharacter(uint64_t character_id, uint64_t acc
     int rows_updated = 0;
     try {
         auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
+        if (!conn)
+        {
+            return false;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setUInt64(1, character_id);
         statement->setUInt64(2, account_id);
@@ -172,6 +186,10 @@ bool MysqlCharacterProvider::DeleteCharacter(uint64_t character_id, uint64_t acc
 std::wstring MysqlCharacterProvider::GetRandomNameRequest(const std::string& base_model) {
     try {
         auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
+        if (!conn)
+        {
+            return L"";
+        }
         auto statement = std::shared_ptr<sql::PreparedStatement>(
             conn->prepareStatement("CALL sp_CharacterNameCreate(?);")
             );
@@ -193,6 +211,10 @@ uint16_t MysqlCharacterProvider::GetMaxCharacters(uint64_t player_id) {
     uint16_t max_chars = 2;
     try {
         auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
+        if (!conn)
+        {
+            return max_chars;
+        }
         auto statement = std::shared_ptr<sql::PreparedStatement>(
             conn->prepareStatement("SELECT max_characters from player_account where id = ?")
             );
@@ -239,6 +261,10 @@ tuple<uint64_t, string> MysqlCharacterProvider::CreateCharacter(const ClientCrea
         }
 
         auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
+        if (!conn)
+        {
+            return make_tuple(0, "name_declined_internal_error");
+        }
 
         std::unique_ptr<sql::PreparedStatement> statement(conn->prepareStatement(
             "CALL sp_CharacterCreate(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, @output)"));
@@ -374,6 +400,10 @@ uint64_t MysqlCharacterProvider::GetCharacterIdByName(const string& name)
     uint64_t character_id = 0;
     try {
         auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
+        if (!conn)
+        {
+            return character_id;
+        }
         auto statement = std::unique_ptr<sql::PreparedStatement>(
             conn->prepareStatement("SELECT id FROM object where custom_name like ? and type_id = ?;")
             );
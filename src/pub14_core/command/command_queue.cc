@@ -24,23 +24,26 @@ using pub14_core::command::CommandService;
 using swganh::command::BaseSwgCommand;
 using swganh::command::CommandCallback;
 using swganh::command::CommandInterface;
+using swganh::command::CommandQueueInterface;
 using swganh::object::creature::Creature;
 using swganh::object::tangible::Tangible;
 
 CommandQueue::CommandQueue(
     swganh::app::SwganhKernel* kernel)
     : kernel_(kernel)
-    , timer_(kernel->GetIoService())
+    , timing_wheel_(kernel->GetTimingWheel())
+    , process_timer_(0)
     , processing_(false)
     , default_command_(nullptr)
-    , active_(kernel->GetIoService())
+    , active_(kernel->GetIoService(), kernel->GetTimingWheel())
 {
     command_service_ = kernel->GetServiceManager()->GetService<CommandService>("CommandService");
 }
 
 CommandQueue::~CommandQueue()
 {
-    timer_.cancel();
+    boost::lock_guard<boost::mutex> process_lg(process_mutex_);
+    timing_wheel_->Cancel(process_timer_);
 }
 
 void CommandQueue::EnqueueCommand(const std::shared_ptr<CommandInterface>& command)
@@ -135,18 +138,26 @@ void CommandQueue::Notify()
         {           
             ProcessCommand(command);
 
-            timer_.expires_from_now(boost::posix_time::milliseconds(static_cast<uint64_t>(command->GetDefaultTime() * 1000)));
-            timer_.async_wait([this] (const boost::system::error_code& ec) 
+            // the callback can come due while this queue is being destroyed, cancelling
+            // it in the destructor can be too late once it has been taken off the wheel
+            std::weak_ptr<CommandQueueInterface> weak_queue = shared_from_this();
+
+            process_lg.lock();
+            process_timer_ = timing_wheel_->Schedule(boost::posix_time::milliseconds(static_cast<uint64_t>(command->GetDefaultTime() * 1000)), [weak_queue] ()
             {
-                if (!ec && this)
+                auto queue = std::static_pointer_cast<CommandQueue>(weak_queue.lock());
+                if (!queue)
                 {
-                    {
-                        boost::lock_guard<boost::mutex> lg(process_mutex_);
-                        processing_ = false;
-                    }
-            
-                    this->Notify();
+                    return;
+                }
+
+                {
+                    boost::lock_guard<boost::mutex> lg(queue->process_mutex_);
+                    queue->processing_ = false;
+                    queue->process_timer_ = 0;
                 }
+            
+                queue->Notify();
             });
         }
         else
@@ -159,13 +170,21 @@ void CommandQueue::Notify()
 
 void CommandQueue::HandleCallback(std::shared_ptr<CommandCallback> callback)
 {    
+    std::weak_ptr<CommandQueueInterface> weak_queue = shared_from_this();
+
     active_.AsyncDelayed(boost::posix_time::milliseconds(callback->GetDelayTimeInMs()),
-        [this, callback] ()
+        [weak_queue, callback] ()
     {
+        auto queue = std::static_pointer_cast<CommandQueue>(weak_queue.lock());
+        if (!queue)
+        {
+            return;
+        }
+
         auto new_callback = (*callback)();
         if (new_callback)
         {
-            HandleCallback(*new_callback);
+            queue->HandleCallback(*new_callback);
         }
     });
 }
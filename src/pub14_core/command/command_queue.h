@@ -9,10 +9,10 @@
 #include <queue>
 
 #include <boost/asio/io_service.hpp>
-#include <boost/asio/deadline_timer.hpp>
 #include <boost/thread/mutex.hpp>
 
 #include "anh/active_object.h"
+#include "anh/timing_wheel.h"
 
 #include "swganh/command/command_interface.h"
 #include "swganh/command/command_queue_interface.h"
@@ -68,9 +68,10 @@ namespace command {
         swganh::app::SwganhKernel* kernel_;
         swganh::command::CommandServiceInterface* command_service_;
 
-        boost::asio::deadline_timer	timer_;
+        anh::TimingWheel* timing_wheel_;
         
         boost::mutex process_mutex_;
+        anh::TimingWheel::TimerId process_timer_;
         bool processing_;
         
         boost::mutex queue_mutex_;        
@@ -29,6 +29,10 @@ uint32_t MysqlGalaxyProvider::GetPopulation()
     try {
         string sql = "call sp_GetPopulation();";
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return population;
+        }
         auto statement = shared_ptr<sql::Statement>(conn->createStatement());
         auto result_set = unique_ptr<sql::ResultSet>(statement->executeQuery(sql));
 
@@ -34,6 +34,9 @@ shared_ptr<Account> MysqlAccountProvider::FindByUsername(string username) {
     try {
         string sql = "select id, username, password, salt, enabled from account where username = ?";
         auto conn = db_manager_->getConnection("galaxy_manager");
+        if (!conn) {
+            return account;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setString(1, username);
         auto result_set = unique_ptr<sql::ResultSet>(statement->executeQuery());
@@ -67,6 +70,9 @@ void MysqlAccountProvider::EndSessions()
     try {
         string sql = "delete from account_session";
         auto conn = db_manager_->getConnection("galaxy_manager");
+        if (!conn) {
+            return;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         /* int rows_updated = */statement->executeUpdate();
 
@@ -81,6 +87,9 @@ uint32_t MysqlAccountProvider::FindBySessionKey(const string& session_key) {
      try {
         string sql = "select account from account_session where session_key = ?";
         auto conn = db_manager_->getConnection("galaxy_manager");
+        if (!conn) {
+            return account_id;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setString(1, session_key);
         auto result_set = unique_ptr<sql::ResultSet>(statement->executeQuery());
@@ -103,6 +112,9 @@ bool MysqlAccountProvider::CreateAccountSession(uint32_t account_id, const std::
     try {
         string sql = "INSERT INTO account_session(account, session_key) VALUES(?,?);";
         auto conn = db_manager_->getConnection("galaxy_manager");
+        if (!conn) {
+            return success;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setUInt64(1, account_id);
         statement->setString(2, session_key);
@@ -123,6 +135,9 @@ bool MysqlAccountProvider::AutoRegisterAccount(std::string username, std::string
     try {
         string sql = "call sp_CreateAccount(?,?,?);";
         auto conn = db_manager_->getConnection("galaxy_manager");
+        if (!conn) {
+            return success;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setString(1, username);
         statement->setString(2, password);
@@ -146,6 +161,9 @@ bool MysqlAccountProvider::CreatePlayerAccount(uint64_t account_id)
     try {
         string sql = "call sp_CreatePlayerAccount(?);";
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn) {
+            return success;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setUInt64(1, account_id);
         auto rows_updated = statement->executeUpdate();
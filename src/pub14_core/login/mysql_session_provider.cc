@@ -32,6 +32,9 @@ uint64_t MysqlSessionProvider::GetPlayerId(uint32_t account_id) {
     try {
         string sql = "select id from player_account where reference_id = ?";
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn) {
+            return player_id;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setUInt(1, account_id);
         auto result_set = unique_ptr<sql::ResultSet>(statement->executeQuery());
@@ -60,6 +63,9 @@ bool MysqlSessionProvider::CreateGameSession(uint64_t player_id, uint32_t sessio
     try {
         string sql = "INSERT INTO player_session(player,session_key) VALUES (?,?)";
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn) {
+            return updated;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setUInt64(1, player_id);
         statement->setString(2, game_session);
@@ -83,6 +89,9 @@ void MysqlSessionProvider::EndGameSession(uint64_t player_id)
 	try {
         string sql = "DELETE FROM player_session where player = ?";
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn) {
+            return;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setUInt64(1, player_id);
         auto rows_updated = statement->executeUpdate();
@@ -102,6 +111,9 @@ uint32_t MysqlSessionProvider::GetAccountId(uint64_t player_id) {
     try {
         string sql = "select reference_id from player_account where id = ?";
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn) {
+            return account_id;
+        }
         auto statement = shared_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
         statement->setUInt64(1, player_id);
         auto result_set = unique_ptr<sql::ResultSet>(statement->executeQuery());
@@ -25,6 +25,11 @@ string Sha512Encoder::EncodePassword(string raw, string salt) {
 
     string sql = "SELECT SHA1(CONCAT('" + raw + "', '{" + salt + "}'))";
     auto conn = db_manager_->getConnection("galaxy_manager");
+    if (!conn)
+    {
+        return result;
+    }
+
     auto statement = shared_ptr<sql::Statement>(conn->createStatement());
     auto result_set = unique_ptr<sql::ResultSet>(statement->executeQuery(sql));
     if (result_set->next())
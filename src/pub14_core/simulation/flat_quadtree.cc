@@ -0,0 +1,195 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "flat_quadtree.h"
+
+#include <algorithm>
+
+namespace quadtree
+{
+
+FlatQuadtree::FlatQuadtree(Region region, uint32_t max_level, uint32_t node_capacity)
+	: max_level_(std::min<uint32_t>(max_level, MAX_LEVEL))
+	, node_capacity_(std::max<uint32_t>(node_capacity, 1))
+{
+	NodeData root;
+	root.min_x = static_cast<float>(region.min_corner().x());
+	root.min_z = static_cast<float>(region.min_corner().y());
+	root.max_x = static_cast<float>(region.max_corner().x());
+	root.max_z = static_cast<float>(region.max_corner().y());
+	root.level = 0;
+	root.first_child = NO_CHILDREN;
+
+	nodes_.push_back(std::move(root));
+}
+
+void FlatQuadtree::Insert(uint64_t object_id, float x, float z)
+{
+	if (Contains(object_id))
+	{
+		Update(object_id, x, z);
+		return;
+	}
+
+	Entry entry = { object_id, x, z };
+	uint32_t leaf = FindLeaf_(x, z);
+
+	Append_(leaf, entry);
+	SplitIfFull_(leaf);
+}
+
+void FlatQuadtree::Remove(uint64_t object_id)
+{
+	auto find_iter = locations_.find(object_id);
+	if (find_iter == locations_.end())
+		return;
+
+	Erase_(find_iter->second);
+	locations_.erase(find_iter);
+}
+
+void FlatQuadtree::Update(uint64_t object_id, float x, float z)
+{
+	auto find_iter = locations_.find(object_id);
+	if (find_iter == locations_.end())
+	{
+		Insert(object_id, x, z);
+		return;
+	}
+
+	Location location = find_iter->second;
+	NodeData& node = nodes_[location.node];
+
+	// Most moves stay within the same leaf, only the coordinates change.
+	if (node.first_child == NO_CHILDREN && IsWithin_(node, x, z))
+	{
+		node.entries[location.slot].x = x;
+		node.entries[location.slot].z = z;
+		return;
+	}
+
+	Erase_(location);
+
+	Entry entry = { object_id, x, z };
+	uint32_t leaf = FindLeaf_(x, z);
+
+	Append_(leaf, entry);
+	SplitIfFull_(leaf);
+}
+
+bool FlatQuadtree::Contains(uint64_t object_id) const
+{
+	return locations_.find(object_id) != locations_.end();
+}
+
+uint32_t FlatQuadtree::FindLeaf_(float x, float z) const
+{
+	// Objects outside of the indexed area are kept in the root.
+	if (!IsWithin_(nodes_[0], x, z))
+		return 0;
+
+	uint32_t index = 0;
+
+	while (nodes_[index].first_child != NO_CHILDREN)
+	{
+		const NodeData& node = nodes_[index];
+
+		float center_x = (node.min_x + node.max_x) / 2;
+		float center_z = (node.min_z + node.max_z) / 2;
+
+		index = node.first_child + (x >= center_x ? 1 : 0) + (z >= center_z ? 2 : 0);
+	}
+
+	return index;
+}
+
+void FlatQuadtree::Append_(uint32_t node, const Entry& entry)
+{
+	Location location = { node, static_cast<uint32_t>(nodes_[node].entries.size()) };
+	locations_[entry.object_id] = location;
+
+	nodes_[node].entries.push_back(entry);
+}
+
+void FlatQuadtree::SplitIfFull_(uint32_t node)
+{
+	if (nodes_[node].first_child == NO_CHILDREN
+		&& nodes_[node].entries.size() > node_capacity_
+		&& nodes_[node].level < max_level_)
+	{
+		Split_(node);
+	}
+}
+
+void FlatQuadtree::Erase_(const Location& location)
+{
+	auto& entries = nodes_[location.node].entries;
+
+	// Fill the hole with the last entry so the array stays contiguous.
+	if (location.slot != entries.size() - 1)
+	{
+		entries[location.slot] = entries.back();
+		locations_[entries[location.slot].object_id].slot = location.slot;
+	}
+
+	entries.pop_back();
+}
+
+void FlatQuadtree::Split_(uint32_t index)
+{
+	// Copy what we need up front, growing the pool invalidates references.
+	NodeData parent_bounds;
+	parent_bounds.min_x = nodes_[index].min_x;
+	parent_bounds.min_z = nodes_[index].min_z;
+	parent_bounds.max_x = nodes_[index].max_x;
+	parent_bounds.max_z = nodes_[index].max_z;
+	uint32_t level = nodes_[index].level + 1;
+
+	float center_x = (parent_bounds.min_x + parent_bounds.max_x) / 2;
+	float center_z = (parent_bounds.min_z + parent_bounds.max_z) / 2;
+
+	uint32_t first_child = static_cast<uint32_t>(nodes_.size());
+
+	// Children are laid out as SW, SE, NW, NE to match the quadrant selection in FindLeaf_.
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		NodeData child;
+		child.min_x = (i & 1) ? center_x : parent_bounds.min_x;
+		child.max_x = (i & 1) ? parent_bounds.max_x : center_x;
+		child.min_z = (i & 2) ? center_z : parent_bounds.min_z;
+		child.max_z = (i & 2) ? parent_bounds.max_z : center_z;
+		child.level = level;
+		child.first_child = NO_CHILDREN;
+
+		nodes_.push_back(std::move(child));
+	}
+
+	nodes_[index].first_child = first_child;
+
+	std::vector<Entry> entries;
+	entries.swap(nodes_[index].entries);
+
+	for (const Entry& entry : entries)
+	{
+		// Out of bounds entries can only be found in the root and stay there.
+		if (!IsWithin_(parent_bounds, entry.x, entry.z))
+		{
+			Append_(index, entry);
+			continue;
+		}
+
+		Append_(first_child + (entry.x >= center_x ? 1 : 0) + (entry.z >= center_z ? 2 : 0), entry);
+	}
+
+	for (uint32_t i = first_child; i < first_child + 4; ++i)
+	{
+		SplitIfFull_(i);
+	}
+}
+
+bool FlatQuadtree::IsWithin_(const NodeData& node, float x, float z) const
+{
+	return x >= node.min_x && x <= node.max_x && z >= node.min_z && z <= node.max_z;
+}
+
+} // namespace quadtree
@@ -0,0 +1,164 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef FLAT_QUADTREE_H_
+#define FLAT_QUADTREE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "node.h"
+
+namespace quadtree
+{
+
+/**
+ * \brief A compact record of an object stored in a FlatQuadtree.
+ */
+struct Entry
+{
+	uint64_t object_id;
+	float x;
+	float z;
+};
+
+/**
+ * \brief A quadtree that keeps its nodes in a single pool and its objects as
+ * plain (object_id, x, z) entries.
+ *
+ * Each node owns a contiguous array of entries and children are allocated four
+ * at a time from the node pool, so once the tree has grown to fit its population
+ * inserts, moves and queries do not allocate. A table from object id to the node
+ * and slot that holds it makes relocation O(1).
+ *
+ * Queries hand each matching Entry to a visitor instead of building a result list.
+ */
+class FlatQuadtree
+{
+public:
+	FlatQuadtree(Region region, uint32_t max_level, uint32_t node_capacity = 16);
+
+	void Insert(uint64_t object_id, float x, float z);
+	void Remove(uint64_t object_id);
+	void Update(uint64_t object_id, float x, float z);
+
+	bool Contains(uint64_t object_id) const;
+	size_t GetSize() const { return locations_.size(); }
+	size_t GetNodeCount() const { return nodes_.size(); }
+
+	/**
+	 * Calls visitor(const Entry&) for every entry within the query box.
+	 */
+	template<typename Visitor>
+	void Query(const QueryBox& query_box, Visitor visitor) const
+	{
+		float min_x = static_cast<float>(query_box.min_corner().x());
+		float min_z = static_cast<float>(query_box.min_corner().y());
+		float max_x = static_cast<float>(query_box.max_corner().x());
+		float max_z = static_cast<float>(query_box.max_corner().y());
+
+		Traverse_(
+			[=] (const NodeData& node) -> bool {
+				return node.max_x >= min_x && node.min_x <= max_x && node.max_z >= min_z && node.min_z <= max_z;
+			},
+			[=, &visitor] (const Entry& entry) {
+				if (entry.x >= min_x && entry.x <= max_x && entry.z >= min_z && entry.z <= max_z)
+					visitor(entry);
+			});
+	}
+
+	/**
+	 * Calls visitor(const Entry&) for every entry within range of (x, z).
+	 */
+	template<typename Visitor>
+	void QueryRange(float x, float z, float range, Visitor visitor) const
+	{
+		float range_squared = range * range;
+
+		Traverse_(
+			[=] (const NodeData& node) -> bool {
+				// Distance from the point to the closest point of the node bounds.
+				float dx = std::max(std::max(node.min_x - x, x - node.max_x), 0.0f);
+				float dz = std::max(std::max(node.min_z - z, z - node.max_z), 0.0f);
+				return (dx * dx + dz * dz) <= range_squared;
+			},
+			[=, &visitor] (const Entry& entry) {
+				float dx = entry.x - x;
+				float dz = entry.z - z;
+				if ((dx * dx + dz * dz) <= range_squared)
+					visitor(entry);
+			});
+	}
+
+private:
+	enum { NO_CHILDREN = 0xFFFFFFFF, MAX_LEVEL = 16 };
+
+	struct NodeData
+	{
+		float min_x;
+		float min_z;
+		float max_x;
+		float max_z;
+		uint32_t level;
+		uint32_t first_child;
+		std::vector<Entry> entries;
+	};
+
+	struct Location
+	{
+		uint32_t node;
+		uint32_t slot;
+	};
+
+	/**
+	 * Depth first walk over every node accepted by prune, starting at the root.
+	 * The root is always visited as it also holds out of bounds entries.
+	 */
+	template<typename Prune, typename EntryVisitor>
+	void Traverse_(Prune prune, EntryVisitor visit) const
+	{
+		// Every visited node replaces itself with at most four children, so the
+		// pending list never exceeds three per level plus the root.
+		uint32_t stack[3 * MAX_LEVEL + 4];
+		uint32_t stack_size = 0;
+
+		stack[stack_size++] = 0;
+
+		while (stack_size > 0)
+		{
+			const NodeData& node = nodes_[stack[--stack_size]];
+
+			for (const Entry& entry : node.entries)
+			{
+				visit(entry);
+			}
+
+			if (node.first_child != NO_CHILDREN)
+			{
+				for (uint32_t i = node.first_child; i < node.first_child + 4; ++i)
+				{
+					if (prune(nodes_[i]))
+						stack[stack_size++] = i;
+				}
+			}
+		}
+	}
+
+	uint32_t FindLeaf_(float x, float z) const;
+	void Append_(uint32_t node, const Entry& entry);
+	void SplitIfFull_(uint32_t node);
+	void Erase_(const Location& location);
+	void Split_(uint32_t node);
+	bool IsWithin_(const NodeData& node, float x, float z) const;
+
+	std::vector<NodeData> nodes_;
+	std::unordered_map<uint64_t, Location> locations_;
+	uint32_t max_level_;
+	uint32_t node_capacity_;
+};
+
+} // namespace quadtree
+
+#endif // FLAT_QUADTREE_H_
@@ -0,0 +1,195 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include "anh/benchmark.h"
+
+#include "flat_quadtree.h"
+#include <swganh/object/object.h>
+
+using namespace quadtree;
+
+///
+class FlatQuadtreeTest {
+public:
+	FlatQuadtreeTest()
+		: tree_(Region(Point(-3000.0f, -3000.0f), Point(3000.0f, 3000.0f)), 9)
+	{}
+
+	~FlatQuadtreeTest()
+	{}
+
+protected:
+	size_t CountInBox(const QueryBox& query_box)
+	{
+		size_t count = 0;
+		tree_.Query(query_box, [&count] (const Entry&) { ++count; });
+		return count;
+	}
+
+	FlatQuadtree tree_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SpatialIndexFlatQuadtree, FlatQuadtreeTest)
+///
+BOOST_AUTO_TEST_CASE(CanInsertRemoveEntry)
+{
+	tree_.Insert(1, 10.0f, 10.0f);
+	BOOST_CHECK(tree_.Contains(1));
+	BOOST_CHECK_EQUAL(1, tree_.GetSize());
+
+	tree_.Remove(1);
+	BOOST_CHECK(!tree_.Contains(1));
+	BOOST_CHECK_EQUAL(0, tree_.GetSize());
+}
+
+///
+BOOST_AUTO_TEST_CASE(CanQuery)
+{
+	tree_.Insert(1, 10.0f, 10.0f);
+
+	BOOST_CHECK_EQUAL(1, CountInBox(QueryBox(Point(0.0f, 0.0f), Point(15.0f, 15.0f))));
+
+	tree_.Remove(1);
+
+	BOOST_CHECK_EQUAL(0, CountInBox(QueryBox(Point(0.0f, 0.0f), Point(15.0f, 15.0f))));
+}
+
+///
+BOOST_AUTO_TEST_CASE(CanQueryRange)
+{
+	tree_.Insert(1, 10.0f, 10.0f);
+	tree_.Insert(2, 19.0f, 19.0f);
+
+	std::vector<uint64_t> found;
+	tree_.QueryRange(0.0f, 0.0f, 20.0f, [&found] (const Entry& entry) { found.push_back(entry.object_id); });
+
+	BOOST_REQUIRE_EQUAL(1, found.size());
+	BOOST_CHECK_EQUAL(1, found[0]);
+}
+
+///
+BOOST_AUTO_TEST_CASE(CanUpdateEntryAcrossNodes)
+{
+	// Enough entries to force a few splits.
+	for(uint64_t i = 1; i <= 100; i++)
+	{
+		tree_.Insert(i, static_cast<float>(i), static_cast<float>(i));
+	}
+
+	tree_.Update(50, -2500.0f, 2500.0f);
+
+	BOOST_CHECK_EQUAL(0, CountInBox(QueryBox(Point(49.0f, 49.0f), Point(51.0f, 51.0f))));
+	BOOST_CHECK_EQUAL(1, CountInBox(QueryBox(Point(-2501.0f, 2499.0f), Point(-2499.0f, 2501.0f))));
+	BOOST_CHECK_EQUAL(100, tree_.GetSize());
+
+	// Objects outside of the indexed area are still found.
+	tree_.Update(51, 5000.0f, 5000.0f);
+	BOOST_CHECK_EQUAL(1, CountInBox(QueryBox(Point(4999.0f, 4999.0f), Point(5001.0f, 5001.0f))));
+}
+
+///
+BOOST_AUTO_TEST_CASE(CanInsertRemoveQueryTenThousand)
+{
+	boost::random::mt19937 gen;
+	boost::random::uniform_real_distribution<> random_generator(-3000.0f, 3000.0f);
+
+	for(uint64_t i = 0; i < 10000; i++)
+	{
+		tree_.Insert(i, static_cast<float>(random_generator(gen)), static_cast<float>(random_generator(gen)));
+	}
+
+	BOOST_CHECK_EQUAL(10000, tree_.GetSize());
+	BOOST_CHECK_EQUAL(10000, CountInBox(QueryBox(Point(-3000, -3000), Point(3000, 3000))));
+
+	for(uint64_t i = 0; i < 10000; i++)
+	{
+		tree_.Remove(i);
+	}
+
+	BOOST_CHECK_EQUAL(0, tree_.GetSize());
+	BOOST_CHECK_EQUAL(0, CountInBox(QueryBox(Point(-3000, -3000), Point(3000, 3000))));
+}
+
+///
+BOOST_AUTO_TEST_CASE(CompareWithNodeTenThousand)
+{
+	if (anh::SkipBenchmark())
+	{
+		return;
+	}
+
+	boost::asio::io_service io_service;
+	anh::EventDispatcher event_dispatcher(io_service);
+	Node root_node(ROOT, Region(Point(-3000.0f, -3000.0f), Point(3000.0f, 3000.0f)), 0, 9, nullptr);
+
+	boost::random::mt19937 gen;
+	boost::random::uniform_real_distribution<> random_generator(-2900.0f, 2900.0f);
+	boost::random::uniform_real_distribution<> step_generator(-5.0f, 5.0f);
+
+	std::vector<std::shared_ptr<swganh::object::Object>> objects;
+	for(int i = 0; i < 10000; i++)
+	{
+		objects.push_back(std::make_shared<swganh::object::Object>());
+		objects[i]->SetEventDispatcher(&event_dispatcher);
+		objects[i]->SetObjectId(i + 1);
+		objects[i]->SetPosition(glm::vec3(random_generator(gen), 0.0f, random_generator(gen)));
+	}
+
+	std::vector<glm::vec3> moves;
+	for(int i = 0; i < 10000; i++)
+	{
+		auto position = objects[i]->GetPosition();
+		moves.push_back(glm::vec3(position.x + step_generator(gen), 0.0f, position.z + step_generator(gen)));
+	}
+
+	typedef boost::chrono::high_resolution_clock clock;
+	auto elapsed = [] (clock::time_point start) {
+		return boost::chrono::duration_cast<boost::chrono::microseconds>(clock::now() - start).count();
+	};
+
+	// Node
+	auto start = clock::now();
+	for(auto& obj : objects)
+		root_node.InsertObject(obj);
+	auto node_insert = elapsed(start);
+
+	start = clock::now();
+	for(int i = 0; i < 10000; i++)
+		root_node.UpdateObject(objects[i], objects[i]->GetPosition(), moves[i]);
+	auto node_update = elapsed(start);
+
+	size_t node_found = 0;
+	start = clock::now();
+	for(int i = 0; i < 1000; i++)
+		node_found += root_node.Query(QueryBox(Point(moves[i].x - 64, moves[i].z - 64), Point(moves[i].x + 64, moves[i].z + 64))).size();
+	auto node_query = elapsed(start);
+
+	// FlatQuadtree
+	start = clock::now();
+	for(auto& obj : objects)
+		tree_.Insert(obj->GetObjectId(), obj->GetPosition().x, obj->GetPosition().z);
+	auto flat_insert = elapsed(start);
+
+	start = clock::now();
+	for(int i = 0; i < 10000; i++)
+		tree_.Update(objects[i]->GetObjectId(), moves[i].x, moves[i].z);
+	auto flat_update = elapsed(start);
+
+	size_t flat_found = 0;
+	start = clock::now();
+	for(int i = 0; i < 1000; i++)
+		flat_found += CountInBox(QueryBox(Point(moves[i].x - 64, moves[i].z - 64), Point(moves[i].x + 64, moves[i].z + 64)));
+	auto flat_query = elapsed(start);
+
+	BOOST_CHECK_EQUAL(10000, tree_.GetSize());
+	BOOST_CHECK(flat_found > 0);
+	BOOST_TEST_MESSAGE("Node:         insert " << node_insert << "us, update " << node_update << "us, query " << node_query << "us (" << node_found << " found)");
+	BOOST_TEST_MESSAGE("FlatQuadtree: insert " << flat_insert << "us, update " << flat_update << "us, query " << flat_query << "us (" << flat_found << " found)");
+}
+BOOST_AUTO_TEST_SUITE_END()
+/*****************************************************************************/
@@ -0,0 +1,219 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "interest_manager.h"
+
+#include <algorithm>
+
+#include "swganh/object/object.h"
+#include "swganh/object/object_controller.h"
+#include "swganh/simulation/spatial_provider_interface.h"
+
+#include "pub14_core/messages/scene_destroy_object.h"
+
+using namespace std;
+using namespace swganh::messages;
+using namespace swganh::object;
+using namespace swganh::simulation;
+using namespace swganh_core::simulation;
+
+InterestManager::InterestManager(SpatialProviderInterface* spatial_provider, float view_distance)
+    : spatial_provider_(spatial_provider)
+    , view_distance_(view_distance)
+{}
+
+float InterestManager::GetViewDistance() const
+{
+    return view_distance_;
+}
+
+void InterestManager::AddObject(const shared_ptr<Object>& object)
+{
+    ViewChanges entered;
+
+    {
+        boost::lock_guard<boost::mutex> lock(view_mutex_);
+
+        if (views_.find(object->GetObjectId()) != views_.end())
+        {
+            return;
+        }
+
+        views_.insert(make_pair(object->GetObjectId(), ViewSet()));
+
+        auto view = QueryView_(object);
+        for_each(begin(view), end(view), [this, &object, &entered] (const ViewSet::value_type& entry)
+        {
+            EnterView_(object, entry.second, entered);
+        });
+    }
+
+    // An object always sees itself and everything it contains.
+    AddViewer_(object, object);
+
+    NotifyViewChanges_(entered, ViewChanges());
+}
+
+void InterestManager::UpdateObject(const shared_ptr<Object>& object)
+{
+    ViewChanges entered, left;
+
+    {
+        boost::lock_guard<boost::mutex> lock(view_mutex_);
+
+        auto find_iter = views_.find(object->GetObjectId());
+        if (find_iter == views_.end())
+        {
+            return;
+        }
+
+        auto new_view = QueryView_(object);
+        auto current_view = find_iter->second;
+
+        for_each(begin(current_view), end(current_view), [this, &object, &new_view, &left] (const ViewSet::value_type& entry)
+        {
+            if (new_view.find(entry.first) == new_view.end())
+            {
+                LeaveView_(object, entry.second, left);
+            }
+        });
+
+        for_each(begin(new_view), end(new_view), [this, &object, &current_view, &entered] (const ViewSet::value_type& entry)
+        {
+            if (current_view.find(entry.first) == current_view.end())
+            {
+                EnterView_(object, entry.second, entered);
+            }
+        });
+    }
+
+    NotifyViewChanges_(entered, left);
+}
+
+void InterestManager::RemoveObject(const shared_ptr<Object>& object)
+{
+    ViewChanges left;
+
+    {
+        boost::lock_guard<boost::mutex> lock(view_mutex_);
+
+        auto find_iter = views_.find(object->GetObjectId());
+        if (find_iter == views_.end())
+        {
+            return;
+        }
+
+        auto view = find_iter->second;
+
+        for_each(begin(view), end(view), [this, &object, &left] (const ViewSet::value_type& entry)
+        {
+            LeaveView_(object, entry.second, left);
+        });
+
+        views_.erase(object->GetObjectId());
+    }
+
+    NotifyViewChanges_(ViewChanges(), left);
+}
+
+vector<shared_ptr<Object>> InterestManager::GetObjectsInView(uint64_t object_id)
+{
+    boost::lock_guard<boost::mutex> lock(view_mutex_);
+
+    vector<shared_ptr<Object>> objects;
+
+    auto find_iter = views_.find(object_id);
+    if (find_iter != views_.end())
+    {
+        for_each(begin(find_iter->second), end(find_iter->second), [&objects] (const ViewSet::value_type& entry)
+        {
+            objects.push_back(entry.second);
+        });
+    }
+
+    return objects;
+}
+
+InterestManager::ViewSet InterestManager::QueryView_(const shared_ptr<Object>& object)
+{
+    ViewSet view;
+
+    auto object_id = object->GetObjectId();
+    auto in_range = spatial_provider_->GetObjectsInRange(object->GetPosition(), view_distance_);
+
+    for_each(begin(in_range), end(in_range), [this, object_id, &view] (const shared_ptr<Object>& other)
+    {
+        auto other_id = other->GetObjectId();
+
+        // The spatial index can hold objects that were never added here.
+        if (other_id == object_id || views_.find(other_id) == views_.end())
+        {
+            return;
+        }
+
+        view.insert(make_pair(other_id, other));
+    });
+
+    return view;
+}
+
+void InterestManager::EnterView_(const shared_ptr<Object>& object, const shared_ptr<Object>& other, ViewChanges& entered)
+{
+    views_[object->GetObjectId()].insert(make_pair(other->GetObjectId(), other));
+    views_[other->GetObjectId()].insert(make_pair(object->GetObjectId(), object));
+
+    entered.push_back(make_pair(object, other));
+}
+
+void InterestManager::LeaveView_(const shared_ptr<Object>& object, const shared_ptr<Object>& other, ViewChanges& left)
+{
+    views_[object->GetObjectId()].erase(other->GetObjectId());
+    views_[other->GetObjectId()].erase(object->GetObjectId());
+
+    left.push_back(make_pair(object, other));
+}
+
+void InterestManager::NotifyViewChanges_(const ViewChanges& entered, const ViewChanges& left)
+{
+    for_each(begin(left), end(left), [this] (const ViewChanges::value_type& change)
+    {
+        RemoveViewer_(change.second, change.first);
+        RemoveViewer_(change.first, change.second);
+    });
+
+    for_each(begin(entered), end(entered), [this] (const ViewChanges::value_type& change)
+    {
+        AddViewer_(change.second, change.first);
+        AddViewer_(change.first, change.second);
+    });
+}
+
+void InterestManager::AddViewer_(const shared_ptr<Object>& target, const shared_ptr<Object>& viewer)
+{
+    target->AddAwareObject(viewer);
+
+    auto contained_objects = target->GetContainedObjects();
+    for_each(begin(contained_objects), end(contained_objects), [this, &viewer] (const Object::ObjectMap::value_type& entry)
+    {
+        AddViewer_(entry.second, viewer);
+    });
+}
+
+void InterestManager::RemoveViewer_(const shared_ptr<Object>& target, const shared_ptr<Object>& viewer)
+{
+    target->RemoveAwareObject(viewer);
+
+    auto contained_objects = target->GetContainedObjects();
+    for_each(begin(contained_objects), end(contained_objects), [this, &viewer] (const Object::ObjectMap::value_type& entry)
+    {
+        RemoveViewer_(entry.second, viewer);
+    });
+
+    if (viewer->HasController())
+    {
+        SceneDestroyObject destroy_message;
+        destroy_message.object_id = target->GetObjectId();
+
+        viewer->GetController()->Notify(destroy_message);
+    }
+}
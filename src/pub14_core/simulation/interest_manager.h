@@ -0,0 +1,105 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef PUB14_CORE_SIMULATION_INTEREST_MANAGER_H_
+#define PUB14_CORE_SIMULATION_INTEREST_MANAGER_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace swganh {
+namespace object {
+    class Object;
+}}  // namespace swganh::object
+
+namespace swganh {
+namespace simulation {
+    class SpatialProviderInterface;
+}}  // namespace swganh::simulation
+
+namespace swganh_core {
+namespace simulation {
+
+    /**
+     * Keeps the awareness of objects in a scene limited to what is within view
+     * distance of each other.
+     *
+     * Only objects added to the interest manager are considered as candidates,
+     * contained objects follow the visibility of their container.
+     */
+    class InterestManager : boost::noncopyable
+    {
+    public:
+        InterestManager(swganh::simulation::SpatialProviderInterface* spatial_provider, float view_distance);
+
+        float GetViewDistance() const;
+
+        /**
+         * Makes the object aware of itself and of everything within its view
+         * distance, and everything within its view distance aware of it.
+         */
+        void AddObject(const std::shared_ptr<swganh::object::Object>& object);
+
+        /**
+         * Recalculates the view of an object that has moved. Objects that entered
+         * the view receive baselines, objects that left it are destroyed on the
+         * clients that can no longer see them.
+         */
+        void UpdateObject(const std::shared_ptr<swganh::object::Object>& object);
+
+        /**
+         * Removes the object from the view of everything that could see it.
+         */
+        void RemoveObject(const std::shared_ptr<swganh::object::Object>& object);
+
+        /**
+         * @return The objects currently within view of the given object.
+         */
+        std::vector<std::shared_ptr<swganh::object::Object>> GetObjectsInView(uint64_t object_id);
+
+    private:
+        typedef std::map<
+            uint64_t,
+            std::shared_ptr<swganh::object::Object>
+        > ViewSet;
+
+        typedef std::map<
+            uint64_t,
+            ViewSet
+        > ViewMap;
+
+        // pairs of objects that came into or went out of view of each other
+        typedef std::vector<std::pair<
+            std::shared_ptr<swganh::object::Object>,
+            std::shared_ptr<swganh::object::Object>
+        >> ViewChanges;
+
+        ViewSet QueryView_(const std::shared_ptr<swganh::object::Object>& object);
+
+        // Update the views with the view mutex held and record the change, the
+        // objects are only told about it by NotifyViewChanges_ once the mutex is
+        // released so sending messages never holds up other interest updates.
+        void EnterView_(const std::shared_ptr<swganh::object::Object>& object, const std::shared_ptr<swganh::object::Object>& other, ViewChanges& entered);
+        void LeaveView_(const std::shared_ptr<swganh::object::Object>& object, const std::shared_ptr<swganh::object::Object>& other, ViewChanges& left);
+
+        void NotifyViewChanges_(const ViewChanges& entered, const ViewChanges& left);
+
+        void AddViewer_(const std::shared_ptr<swganh::object::Object>& target, const std::shared_ptr<swganh::object::Object>& viewer);
+        void RemoveViewer_(const std::shared_ptr<swganh::object::Object>& target, const std::shared_ptr<swganh::object::Object>& viewer);
+
+        swganh::simulation::SpatialProviderInterface* spatial_provider_;
+        float view_distance_;
+
+        boost::mutex view_mutex_;
+        ViewMap views_;
+    };
+
+}}  // namespace swganh_core::simulation
+
+#endif  // PUB14_CORE_SIMULATION_INTEREST_MANAGER_H_
@@ -0,0 +1,154 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/chrono.hpp>
+
+#include "interest_manager.h"
+#include "quadtree_spatial_provider.h"
+#include <swganh/object/object.h>
+
+using namespace swganh_core::simulation;
+
+///
+class InterestManagerTest {
+public:
+	InterestManagerTest()
+		: spatial_provider_(nullptr)
+		, interest_manager_(&spatial_provider_, 128.0f)
+		, event_dispatcher_(io_service_)
+		, next_object_id_(1)
+	{}
+
+	~InterestManagerTest()
+	{}
+
+protected:
+	std::shared_ptr<swganh::object::Object> CreateObject(float x, float z)
+	{
+		auto obj = std::make_shared<swganh::object::Object>();
+		obj->SetEventDispatcher(&event_dispatcher_);
+		obj->SetObjectId(next_object_id_++);
+		obj->SetPosition(glm::vec3(x, 0.0f, z));
+		return obj;
+	}
+
+	void MoveObject(QuadtreeSpatialProvider& spatial_provider, InterestManager& interest_manager,
+		const std::shared_ptr<swganh::object::Object>& obj, glm::vec3 new_position)
+	{
+		spatial_provider.UpdateObject(obj, obj->GetPosition(), new_position);
+		obj->SetPosition(new_position);
+		interest_manager.UpdateObject(obj);
+	}
+
+	QuadtreeSpatialProvider spatial_provider_;
+	InterestManager interest_manager_;
+	boost::asio::io_service io_service_;
+	anh::EventDispatcher event_dispatcher_;
+	uint64_t next_object_id_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SimulationInterestManager, InterestManagerTest)
+///
+BOOST_AUTO_TEST_CASE(ObjectsWithinViewDistanceAreAwareOfEachOther)
+{
+	auto obj1 = CreateObject(0.0f, 0.0f);
+	auto obj2 = CreateObject(50.0f, 0.0f);
+	auto obj3 = CreateObject(500.0f, 0.0f);
+
+	for(auto& obj : { obj1, obj2, obj3 })
+	{
+		spatial_provider_.AddObject(obj);
+		interest_manager_.AddObject(obj);
+	}
+
+	BOOST_CHECK(obj1->IsAwareOfObject(obj2));
+	BOOST_CHECK(obj2->IsAwareOfObject(obj1));
+	BOOST_CHECK(!obj1->IsAwareOfObject(obj3));
+	BOOST_CHECK(!obj3->IsAwareOfObject(obj1));
+
+	BOOST_CHECK_EQUAL(1, interest_manager_.GetObjectsInView(obj1->GetObjectId()).size());
+	BOOST_CHECK_EQUAL(0, interest_manager_.GetObjectsInView(obj3->GetObjectId()).size());
+}
+
+///
+BOOST_AUTO_TEST_CASE(MovingChangesAwarenessIncrementally)
+{
+	auto obj1 = CreateObject(0.0f, 0.0f);
+	auto obj2 = CreateObject(50.0f, 0.0f);
+	auto obj3 = CreateObject(500.0f, 0.0f);
+
+	for(auto& obj : { obj1, obj2, obj3 })
+	{
+		spatial_provider_.AddObject(obj);
+		interest_manager_.AddObject(obj);
+	}
+
+	// obj2 leaves the view of obj1 and enters the view of obj3.
+	MoveObject(spatial_provider_, interest_manager_, obj2, glm::vec3(450.0f, 0.0f, 0.0f));
+
+	BOOST_CHECK(!obj1->IsAwareOfObject(obj2));
+	BOOST_CHECK(!obj2->IsAwareOfObject(obj1));
+	BOOST_CHECK(obj2->IsAwareOfObject(obj3));
+	BOOST_CHECK(obj3->IsAwareOfObject(obj2));
+
+	interest_manager_.RemoveObject(obj3);
+
+	BOOST_CHECK(!obj2->IsAwareOfObject(obj3));
+	BOOST_CHECK_EQUAL(0, interest_manager_.GetObjectsInView(obj2->GetObjectId()).size());
+}
+
+///
+BOOST_AUTO_TEST_CASE(UpdateCostIsBoundedAsPopulationGrows)
+{
+	// Objects are placed on a grid with a constant density, so a growing population
+	// covers a larger area of the planet but each view should stay the same size.
+	const float spacing = 32.0f;
+	std::vector<size_t> view_sizes;
+
+	for(int side : { 32, 100, 200 })
+	{
+		QuadtreeSpatialProvider spatial_provider(nullptr);
+		InterestManager interest_manager(&spatial_provider, 128.0f);
+
+		std::vector<std::shared_ptr<swganh::object::Object>> objects;
+		std::shared_ptr<swganh::object::Object> center;
+
+		for(int i = 0; i < side; i++)
+		{
+			for(int j = 0; j < side; j++)
+			{
+				auto obj = CreateObject((i - side / 2) * spacing, (j - side / 2) * spacing);
+				if (i == side / 2 && j == side / 2)
+					center = obj;
+
+				spatial_provider.AddObject(obj);
+				interest_manager.AddObject(obj);
+				objects.push_back(obj);
+			}
+		}
+
+		auto start = boost::chrono::high_resolution_clock::now();
+		for(int step = 1; step <= 50; step++)
+		{
+			MoveObject(spatial_provider, interest_manager, center, glm::vec3(step * 4.0f, 0.0f, 0.0f));
+		}
+		auto elapsed = boost::chrono::duration_cast<boost::chrono::microseconds>(boost::chrono::high_resolution_clock::now() - start);
+
+		view_sizes.push_back(interest_manager.GetObjectsInView(center->GetObjectId()).size());
+		BOOST_TEST_MESSAGE(objects.size() << " objects: 50 movement updates in " << elapsed.count() << "us, " << view_sizes.back() << " objects in view");
+
+		for(auto& obj : objects)
+		{
+			interest_manager.RemoveObject(obj);
+			spatial_provider.RemoveObject(obj);
+		}
+	}
+
+	BOOST_CHECK(view_sizes[0] > 0);
+	BOOST_CHECK_EQUAL(view_sizes[0], view_sizes[1]);
+	BOOST_CHECK_EQUAL(view_sizes[1], view_sizes[2]);
+}
+BOOST_AUTO_TEST_SUITE_END()
+/*****************************************************************************/
@@ -17,7 +17,8 @@
 #include "pub14_core/messages/update_transform_message.h"
 #include "pub14_core/messages/update_transform_with_parent_message.h"
 
-#include "swganh/simulation/spatial_provider_interface.h"
+#include "swganh/simulation/scene_interface.h"
+#include "swganh/simulation/scene_manager_interface.h"
 
 using namespace anh::event_dispatcher;
 using namespace std;
@@ -29,7 +30,8 @@ using namespace swganh::simulation;
 using namespace swganh_core::simulation;
 
 MovementManager::MovementManager(swganh::app::SwganhKernel* kernel)
-	: kernel_(kernel)
+	: scene_manager_(nullptr)
+	, kernel_(kernel)
 {
 	RegisterEvents(kernel_->GetEventDispatcher());
 }
@@ -39,21 +41,41 @@ void MovementManager::HandleDataTransform(
     DataTransform message)
 {
     auto object = controller->GetObject();
-    
-    if (!ValidateCounter_(object->GetObjectId(), message.counter))
+
+    auto update = [this, object, message] ()
     {
-        return;
-    }
+        if (!ValidateCounter_(object->GetObjectId(), message.counter))
+        {
+            return;
+        }
 
-    counter_map_[object->GetObjectId()] = message.counter;
-    
-	glm::vec3 old_position = object->GetPosition();
-	spatial_provider_->UpdateObject(controller->GetObject(), old_position, message.position);
+        counter_map_[object->GetObjectId()] = message.counter;
 
-    object->SetPosition(message.position);
-    object->SetOrientation(message.orientation);
-    
-    SendUpdateDataTransformMessage(object);
+        object->SetPosition(message.position);
+        object->SetOrientation(message.orientation);
+
+        // Bring objects that came into view in and drop the ones that left it
+        // before anyone is told about the move.
+        auto scene = scene_manager_->GetScene(object->GetSceneId());
+        if (scene)
+        {
+            scene->UpdateObject(object);
+        }
+
+        SendUpdateDataTransformMessage(object);
+    };
+
+    // Movement is applied on the strand of the scene the object is in so moves
+    // within a scene are serialized while separate scenes run in parallel.
+    auto scene = scene_manager_->GetScene(object->GetSceneId());
+    if (scene)
+    {
+        scene->Post(update);
+    }
+    else
+    {
+        update();
+    }
 }
 
 void MovementManager::HandleDataTransformWithParent(
@@ -156,7 +178,7 @@ bool MovementManager::ValidateCounter_(uint64_t object_id, uint32_t counter)
     return counter > counter_map_[object_id];
 }
 
-void MovementManager::SetSpatialProvider(swganh::simulation::SpatialProviderInterface* spatial_provider)
+void MovementManager::SetSceneManager(swganh::simulation::SceneManagerInterface* scene_manager)
 {
-	spatial_provider_ = spatial_provider;
+	scene_manager_ = scene_manager;
 }
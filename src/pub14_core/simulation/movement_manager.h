@@ -22,7 +22,7 @@ namespace app {
 	class SwganhKernel;
 } // app
 namespace simulation {
-	class SpatialProviderInterface;
+	class SceneManagerInterface;
 }} // swganh::simulation
 
 namespace swganh_core {
@@ -46,7 +46,7 @@ namespace simulation {
         void SendDataTransformWithParentMessage(const std::shared_ptr<swganh::object::Object>& object, uint32_t unknown = 0x0000000B);
         void SendUpdateDataTransformWithParentMessage(const std::shared_ptr<swganh::object::Object>& object);
 
-		void SetSpatialProvider(swganh::simulation::SpatialProviderInterface* spatial_provider);
+		void SetSceneManager(swganh::simulation::SceneManagerInterface* scene_manager);
 
     private:
         void RegisterEvents(anh::EventDispatcher* event_dispatcher);
@@ -58,7 +58,7 @@ namespace simulation {
         > UpdateCounterMap;
 
         UpdateCounterMap counter_map_;
-		swganh::simulation::SpatialProviderInterface* spatial_provider_;
+		swganh::simulation::SceneManagerInterface* scene_manager_;
 		swganh::app::SwganhKernel* kernel_;
     };
 
@@ -5,6 +5,8 @@
 
 #include "anh/logger.h"
 
+#include "swganh/object/object.h"
+
 using std::shared_ptr;
 
 using anh::app::KernelInterface;
@@ -13,7 +15,7 @@ using namespace quadtree;
 
 QuadtreeSpatialProvider::QuadtreeSpatialProvider(anh::app::KernelInterface* kernel)
 	: SpatialProviderInterface(kernel)
-	, root_node_(ROOT, Region(Point(-8300.0f, -8300.0f), Point(8300.0f, 8300.0f)), 0, 9, nullptr)
+	, tree_(Region(Point(-8300.0f, -8300.0f), Point(8300.0f, 8300.0f)), 9)
 {
 }
 
@@ -23,21 +25,39 @@ QuadtreeSpatialProvider::~QuadtreeSpatialProvider(void)
 
 void QuadtreeSpatialProvider::AddObject(shared_ptr<Object> obj)
 {
-	root_node_.InsertObject(obj);
+	auto position = obj->GetPosition();
+
+	boost::lock_guard<boost::mutex> lock(tree_mutex_);
+	objects_[obj->GetObjectId()] = obj;
+	tree_.Insert(obj->GetObjectId(), position.x, position.z);
 }
 
 void QuadtreeSpatialProvider::RemoveObject(shared_ptr<Object> obj)
 {
-	root_node_.RemoveObject(obj);
+	boost::lock_guard<boost::mutex> lock(tree_mutex_);
+	tree_.Remove(obj->GetObjectId());
+	objects_.erase(obj->GetObjectId());
 }
 
 void QuadtreeSpatialProvider::UpdateObject(shared_ptr<Object> obj, glm::vec3 old_position, glm::vec3 new_position)
 {
-	root_node_.UpdateObject(obj, old_position, new_position);
+	boost::lock_guard<boost::mutex> lock(tree_mutex_);
+	if (objects_.find(obj->GetObjectId()) == objects_.end())
+		return;
 
+	tree_.Update(obj->GetObjectId(), new_position.x, new_position.z);
 }
 
 std::vector<std::shared_ptr<swganh::object::Object>> QuadtreeSpatialProvider::GetObjectsInRange(glm::vec3 point, float range)
 {
-	return std::vector<shared_ptr<Object>>();
+	std::vector<shared_ptr<Object>> objects;
+
+	// The tree prunes by node bounds and does the squared distance test against
+	// the positions it stores, the objects are only touched to build the result.
+	boost::lock_guard<boost::mutex> lock(tree_mutex_);
+	tree_.QueryRange(point.x, point.z, range, [this, &objects] (const Entry& entry) {
+		objects.push_back(objects_[entry.object_id]);
+	});
+
+	return objects;
 }
@@ -4,8 +4,12 @@
 #ifndef QUADTREE_SPATIAL_PROVIDER_H_
 #define QUADTREE_SPATIAL_PROVIDER_H_
 
+#include <unordered_map>
+
+#include <boost/thread/mutex.hpp>
+
 #include "swganh/simulation/spatial_provider_interface.h"
-#include "node.h"
+#include "flat_quadtree.h"
 
 class QuadtreeSpatialProvider : public swganh::simulation::SpatialProviderInterface
 {
@@ -20,7 +24,14 @@ public:
 	virtual std::vector<std::shared_ptr<swganh::object::Object>> GetObjectsInRange(glm::vec3 point, float range);
 
 private:
-	quadtree::Node root_node_;
+	typedef std::unordered_map<
+		uint64_t,
+		std::shared_ptr<swganh::object::Object>
+	> ObjectMap;
+
+	boost::mutex tree_mutex_;
+	quadtree::FlatQuadtree tree_;
+	ObjectMap objects_;
 };
 
-#endif // QUADTREE_SPATIAL_PROVIDER_H_
\ No newline at end of file
+#endif // QUADTREE_SPATIAL_PROVIDER_H_
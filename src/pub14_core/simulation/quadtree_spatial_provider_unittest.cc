@@ -0,0 +1,141 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include "quadtree_spatial_provider.h"
+#include <swganh/object/object.h>
+
+using namespace quadtree;
+
+///
+class QuadtreeSpatialProviderTest {
+public:
+	QuadtreeSpatialProviderTest()
+		: spatial_provider_(nullptr)
+		, event_dispatcher_(io_service_)
+		, next_object_id_(1)
+	{}
+
+	~QuadtreeSpatialProviderTest()
+	{}
+
+protected:
+	std::shared_ptr<swganh::object::Object> CreateObject(float x, float z)
+	{
+		auto obj = std::make_shared<swganh::object::Object>();
+		obj->SetEventDispatcher(&event_dispatcher_);
+		obj->SetObjectId(next_object_id_++);
+		obj->SetPosition(glm::vec3(x, 0.0f, z));
+		return obj;
+	}
+
+	/// Fills the provider with count randomly placed objects and compares the results
+	/// of a batch of range queries against a brute force scan of the same objects.
+	void QueryRandomPopulation(uint32_t count)
+	{
+		std::vector<std::shared_ptr<swganh::object::Object>> objects;
+		boost::random::mt19937 gen;
+		boost::random::uniform_real_distribution<> random_generator(-8000.0f, 8000.0f);
+
+		for(uint32_t i = 0; i < count; i++)
+		{
+			objects.push_back(CreateObject(static_cast<float>(random_generator(gen)), static_cast<float>(random_generator(gen))));
+			spatial_provider_.AddObject(objects[i]);
+		}
+
+		const float range = 128.0f;
+		const uint32_t query_count = 1000;
+		size_t found = 0, expected = 0;
+
+		std::vector<glm::vec3> query_points;
+		for(uint32_t i = 0; i < query_count; i++)
+		{
+			query_points.push_back(objects[i % count]->GetPosition());
+		}
+
+		auto start = boost::chrono::high_resolution_clock::now();
+		for(auto& point : query_points)
+		{
+			found += spatial_provider_.GetObjectsInRange(point, range).size();
+		}
+		auto elapsed = boost::chrono::duration_cast<boost::chrono::microseconds>(boost::chrono::high_resolution_clock::now() - start);
+
+		std::vector<glm::vec3> positions;
+		for(auto& obj : objects)
+		{
+			positions.push_back(obj->GetPosition());
+		}
+
+		for(auto& point : query_points)
+		{
+			for(auto& position : positions)
+			{
+				float dx = position.x - point.x;
+				float dz = position.z - point.z;
+				if((dx * dx + dz * dz) <= range * range)
+					expected++;
+			}
+		}
+
+		BOOST_CHECK_EQUAL(expected, found);
+		BOOST_TEST_MESSAGE(count << " objects: " << query_count << " range queries in " << elapsed.count() << "us");
+
+		for(auto& obj : objects)
+		{
+			spatial_provider_.RemoveObject(obj);
+		}
+	}
+
+	QuadtreeSpatialProvider spatial_provider_;
+	boost::asio::io_service io_service_;
+	anh::EventDispatcher event_dispatcher_;
+	uint64_t next_object_id_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(QuadtreeSpatialProviderRange, QuadtreeSpatialProviderTest)
+///
+BOOST_AUTO_TEST_CASE(RangeQueryIsCircular)
+{
+	auto inside = CreateObject(10.0f, 10.0f);
+	auto corner = CreateObject(19.0f, 19.0f);
+	auto outside = CreateObject(50.0f, 50.0f);
+
+	spatial_provider_.AddObject(inside);
+	spatial_provider_.AddObject(corner);
+	spatial_provider_.AddObject(outside);
+
+	// corner lies within the bounding square of the query but outside of the circle.
+	auto objects = spatial_provider_.GetObjectsInRange(glm::vec3(0.0f, 0.0f, 0.0f), 20.0f);
+	BOOST_REQUIRE_EQUAL(1, objects.size());
+	BOOST_CHECK(inside == objects[0]);
+
+	spatial_provider_.RemoveObject(inside);
+	spatial_provider_.RemoveObject(corner);
+	spatial_provider_.RemoveObject(outside);
+
+	BOOST_CHECK_EQUAL(0, spatial_provider_.GetObjectsInRange(glm::vec3(0.0f, 0.0f, 0.0f), 20.0f).size());
+}
+
+///
+BOOST_AUTO_TEST_CASE(CanQueryRangeOneThousand)
+{
+	QueryRandomPopulation(1000);
+}
+
+///
+BOOST_AUTO_TEST_CASE(CanQueryRangeTenThousand)
+{
+	QueryRandomPopulation(10000);
+}
+
+///
+BOOST_AUTO_TEST_CASE(CanQueryRangeOneHundredThousand)
+{
+	QueryRandomPopulation(100000);
+}
+BOOST_AUTO_TEST_SUITE_END()
+/*****************************************************************************/
@@ -5,9 +5,15 @@
 
 #include <algorithm>
 
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/thread/mutex.hpp>
+
 #include "swganh/object/object.h"
 #include "swganh/object/object_controller.h"
-#include "pub14_core/messages/scene_destroy_object.h"
+#include "swganh/simulation/spatial_provider_interface.h"
+
+#include "interest_manager.h"
 
 using namespace std;
 using namespace swganh::messages;
@@ -18,9 +24,21 @@ using namespace swganh_core::simulation;
 class Scene::SceneImpl
 {
 public:
-    SceneImpl(SceneDescription description)
+    SceneImpl(
+        SceneDescription description,
+        shared_ptr<SpatialProviderInterface> owned_provider,
+        SpatialProviderInterface* spatial_provider,
+        boost::asio::io_service* io_service)
         : description_(move(description))
-    {}
+        , owned_provider_(move(owned_provider))
+        , spatial_provider_(spatial_provider)
+        , interest_manager_(spatial_provider, description_.view_distance)
+    {
+        if (io_service)
+        {
+            strand_.reset(new boost::asio::io_service::strand(*io_service));
+        }
+    }
 
     const SceneDescription& GetDescription() const
     {
@@ -29,6 +47,7 @@ public:
 
     bool HasObject(const shared_ptr<Object>& object)
     {
+        boost::lock_guard<boost::mutex> lock(object_mutex_);
         return objects_.find(object) != objects_.end();
     }
 
@@ -36,69 +55,122 @@ public:
     {
 		InsertObject(object);
 
-        for_each(begin(object_map_), end(object_map_),
-            [&object] (const ObjectMap::value_type& object_entry) 
+        spatial_provider_->AddObject(object);
+        interest_manager_.AddObject(object);
+    }
+    
+    void RemoveObject(const shared_ptr<Object>& object)
+    {
+        if (!HasObject(object))
         {
-            auto& stored_object = object_entry.second;
+            return;
+        }
 
-            stored_object->AddAwareObject(object);
-            object->AddAwareObject(stored_object);
-        });
+		EraseObject(object);
 
-        auto contained_objects = object->GetContainedObjects();
-        
-        for_each(begin(contained_objects), end(contained_objects),
-            [this] (const ObjectMap::value_type& object_entry) 
+        // observers that are about to lose sight of the object still get its last updates
+        object->FlushDeltas();
+
+        auto container = object->GetContainer();
+        if (container)
         {
-            auto& stored_object = object_entry.second;
-            AddObject(stored_object);
-        });
+            container->RemoveContainedObject(object);
+        }
 
+        interest_manager_.RemoveObject(object);
+        spatial_provider_->RemoveObject(object);
     }
-    
-    void RemoveObject(const shared_ptr<Object>& object)
+
+    void UpdateObject(const shared_ptr<Object>& object)
     {
         if (!HasObject(object))
         {
             return;
         }
 
-		EraseObject(object);
-                
-        SceneDestroyObject destroy_message;
-        destroy_message.object_id = object->GetObjectId();
+        auto position = object->GetPosition();
+        spatial_provider_->UpdateObject(object, position, position);
+
+        interest_manager_.UpdateObject(object);
+    }
+
+    void QueueDeltas(const shared_ptr<Object>& object)
+    {
+        boost::lock_guard<boost::mutex> lock(deltas_mutex_);
+        pending_deltas_.push_back(object);
+    }
+
+    void FlushDeltas()
+    {
+        vector<shared_ptr<Object>> pending_deltas;
+
+        {
+            boost::lock_guard<boost::mutex> lock(deltas_mutex_);
+            pending_deltas_.swap(pending_deltas);
+        }
 
-        for_each(begin(object_map_), end(object_map_),
-            [&object, &destroy_message] (const ObjectMap::value_type& object_entry) 
+        for_each(begin(pending_deltas), end(pending_deltas),
+            [] (const shared_ptr<Object>& object)
         {
-            auto& stored_object = object_entry.second;
-            
-            stored_object->RemoveContainedObject(object);
-            stored_object->RemoveAwareObject(object);
-
-            if (stored_object->HasController())
-            {
-                stored_object->GetController()->Notify(destroy_message);
-            }
+            object->FlushDeltas();
         });
     }
 
+    SpatialProviderInterface* GetSpatialProvider() const
+    {
+        return spatial_provider_;
+    }
+
+    void Post(function<void ()> task)
+    {
+        if (!strand_)
+        {
+            task();
+            return;
+        }
+
+        strand_->post(move(task));
+    }
+
 	void InsertObject(const shared_ptr<Object>& object)
 	{
-		// make sure it's not already there
-		auto find_iter = objects_.find(object);
-		if (find_iter == end(objects_))
-			objects_.insert(find_iter, object);
-
-		auto find_map = object_map_.find(object->GetObjectId());
-		if (find_map == end(object_map_))
-			object_map_.insert(find_map, ObjectPair(object->GetObjectId(), object));
+        {
+            boost::lock_guard<boost::mutex> lock(object_mutex_);
+
+		    // make sure it's not already there
+		    auto find_iter = objects_.find(object);
+		    if (find_iter == end(objects_))
+			    objects_.insert(find_iter, object);
+
+		    auto find_map = object_map_.find(object->GetObjectId());
+		    if (find_map == end(object_map_))
+			    object_map_.insert(find_map, ObjectPair(object->GetObjectId(), object));
+        }
+
+        auto contained_objects = object->GetContainedObjects();
+        
+        for_each(begin(contained_objects), end(contained_objects),
+            [this] (const ObjectMap::value_type& object_entry) 
+        {
+            InsertObject(object_entry.second);
+        });
 	}
 
 	void EraseObject(const shared_ptr<Object>& object)
-	{        
-		objects_.erase(object);
-        object_map_.erase(object->GetObjectId());
+	{
+        {
+            boost::lock_guard<boost::mutex> lock(object_mutex_);
+		    objects_.erase(object);
+            object_map_.erase(object->GetObjectId());
+        }
+
+        auto contained_objects = object->GetContainedObjects();
+        
+        for_each(begin(contained_objects), end(contained_objects),
+            [this] (const ObjectMap::value_type& object_entry) 
+        {
+            EraseObject(object_entry.second);
+        });
 	}
 
 
@@ -115,17 +187,33 @@ private:
 
     typedef std::set<std::shared_ptr<Object>> ObjectSet;
 
+    boost::mutex object_mutex_;
     ObjectSet objects_;
     ObjectMap object_map_;
 
+    boost::mutex deltas_mutex_;
+    std::vector<shared_ptr<Object>> pending_deltas_;
+
     SceneDescription description_;
+
+    shared_ptr<SpatialProviderInterface> owned_provider_;
+    SpatialProviderInterface* spatial_provider_;
+    unique_ptr<boost::asio::io_service::strand> strand_;
+
+    InterestManager interest_manager_;
 };
 
-Scene::Scene(SceneDescription description)
-: impl_(new SceneImpl(move(description)))
+Scene::Scene(SceneDescription description, shared_ptr<SpatialProviderInterface> spatial_provider, boost::asio::io_service& io_service)
+{
+    auto provider = spatial_provider.get();
+    impl_.reset(new SceneImpl(move(description), move(spatial_provider), provider, &io_service));
+}
+
+Scene::Scene(SceneDescription description, SpatialProviderInterface* spatial_provider)
+: impl_(new SceneImpl(move(description), nullptr, spatial_provider, nullptr))
 {}
 
-Scene::Scene(uint32_t scene_id, string name, string label, string description, string terrain) 
+Scene::Scene(uint32_t scene_id, string name, string label, string description, string terrain, float view_distance, SpatialProviderInterface* spatial_provider) 
 {
     SceneDescription scene_description;
 
@@ -134,8 +222,9 @@ Scene::Scene(uint32_t scene_id, string name, string label, string description, s
     scene_description.label = move(label);
     scene_description.description = move(description);
     scene_description.terrain = move(terrain);
+    scene_description.view_distance = view_distance;
 
-    impl_.reset(new SceneImpl(move(scene_description)));
+    impl_.reset(new SceneImpl(move(scene_description), nullptr, spatial_provider, nullptr));
 }
 
 uint32_t Scene::GetSceneId() const
@@ -161,6 +250,10 @@ const std::string& Scene::GetTerrainMap() const
 {
 	return impl_->GetDescription().terrain;
 }
+float Scene::GetViewDistance() const
+{
+    return impl_->GetDescription().view_distance;
+}
 void Scene::AddObject(const std::shared_ptr<swganh::object::Object>& object)
 {
     impl_->AddObject(object);
@@ -170,3 +263,28 @@ void Scene::RemoveObject(const std::shared_ptr<swganh::object::Object>& object)
 {
     impl_->RemoveObject(object);
 }
+
+void Scene::UpdateObject(const std::shared_ptr<swganh::object::Object>& object)
+{
+    impl_->UpdateObject(object);
+}
+
+void Scene::QueueDeltas(const std::shared_ptr<swganh::object::Object>& object)
+{
+    impl_->QueueDeltas(object);
+}
+
+void Scene::FlushDeltas()
+{
+    impl_->FlushDeltas();
+}
+
+SpatialProviderInterface* Scene::GetSpatialProvider() const
+{
+    return impl_->GetSpatialProvider();
+}
+
+void Scene::Post(std::function<void ()> task)
+{
+    impl_->Post(move(task));
+}
@@ -6,8 +6,19 @@
 
 #include "swganh/simulation/scene_interface.h"
 #include <cstdint>
+#include <memory>
 #include <string>
 
+namespace boost {
+namespace asio {
+    class io_service;
+}}  // namespace boost::asio
+
+namespace swganh {
+namespace simulation {
+    class SpatialProviderInterface;
+}}  // namespace swganh::simulation
+
 namespace swganh_core {
 namespace simulation {
 
@@ -18,29 +29,56 @@ namespace simulation {
         std::string label;
         std::string description;
         std::string terrain;
+        float view_distance;
     };
 
     class Scene : public swganh::simulation::SceneInterface
     {
     public:
-        explicit Scene(SceneDescription description);
+        /**
+         * Creates a scene that owns its spatial index and runs the work posted to it
+         * on its own strand of the given io_service.
+         */
+        Scene(
+            SceneDescription description,
+            std::shared_ptr<swganh::simulation::SpatialProviderInterface> spatial_provider,
+            boost::asio::io_service& io_service);
+
+        /**
+         * Creates a scene using a spatial index owned elsewhere, work posted to it
+         * runs immediately on the calling thread.
+         */
+        Scene(SceneDescription description, swganh::simulation::SpatialProviderInterface* spatial_provider);
         Scene(
             uint32_t id,
             std::string name,
             std::string label,
             std::string description,
-            std::string terrain);
+            std::string terrain,
+            float view_distance,
+            swganh::simulation::SpatialProviderInterface* spatial_provider);
 
         uint32_t GetSceneId() const;
         const std::string& GetName() const;
         const std::string& GetLabel() const;
         const std::string& GetDescription() const;
 		const std::string& GetTerrainMap() const;
+        float GetViewDistance() const;
 
         void AddObject(const std::shared_ptr<swganh::object::Object>& object);
 
         void RemoveObject(const std::shared_ptr<swganh::object::Object>& object);
 
+        void UpdateObject(const std::shared_ptr<swganh::object::Object>& object);
+
+        void QueueDeltas(const std::shared_ptr<swganh::object::Object>& object);
+
+        void FlushDeltas();
+
+        swganh::simulation::SpatialProviderInterface* GetSpatialProvider() const;
+
+        void Post(std::function<void ()> task);
+
     private:
         Scene();
 
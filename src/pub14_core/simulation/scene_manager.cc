@@ -21,6 +21,15 @@ using namespace std;
 using namespace swganh::object;
 using namespace swganh_core::simulation;
 
+namespace {
+    // used for galaxies whose scene table predates the view_distance column
+    const float kDefaultViewDistance = 128.0f;
+}
+
+SceneManager::SceneManager(boost::asio::io_service& io_service)
+    : io_service_(io_service)
+{}
+
 void SceneManager::LoadSceneDescriptionsFromDatabase(const std::shared_ptr<sql::Connection>& connection)
 {
     try 
@@ -39,6 +48,16 @@ void SceneManager::LoadSceneDescriptionsFromDatabase(const std::shared_ptr<sql::
             description.description = result->getString("description");
             description.terrain = result->getString("terrain");
 
+            try
+            {
+                description.view_distance = static_cast<float>(result->getDouble("view_distance"));
+            }
+            catch(SQLException&)
+            {
+                LOG(warning) << "Scene " << description.label << " has no view distance, using " << kDefaultViewDistance;
+                description.view_distance = kDefaultViewDistance;
+            }
+
             scene_descriptions_.insert(make_pair(description.label, description));
         }
     }
@@ -91,9 +110,14 @@ void SceneManager::StartScene(const std::string& scene_label)
         throw std::runtime_error("Scene has already been loaded: " + scene_label);
     }
 
+    if (!spatial_provider_factory_)
+    {
+        throw std::runtime_error("No spatial provider available for scene: " + scene_label);
+    }
+
     LOG(info) << "Starting scene: " << scene_label;
 
-    auto scene = make_shared<Scene>(description_iter->second);
+    auto scene = make_shared<Scene>(description_iter->second, spatial_provider_factory_(), io_service_);
 
     scenes_.insert(make_pair(scene_label, scene));
 }
@@ -102,3 +126,16 @@ void SceneManager::StopScene(const std::string& scene_label)
 {
     scenes_.erase(scene_label);
 }
+
+void SceneManager::FlushDeltas()
+{
+    for_each(begin(scenes_), end(scenes_), [] (const SceneMap::value_type& scene_entry) {
+        auto scene = scene_entry.second;
+        scene->Post([scene] () { scene->FlushDeltas(); });
+    });
+}
+
+void SceneManager::SetSpatialProviderFactory(SpatialProviderFactory spatial_provider_factory)
+{
+    spatial_provider_factory_ = move(spatial_provider_factory);
+}
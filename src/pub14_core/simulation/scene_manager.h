@@ -5,6 +5,7 @@
 #define PUB14_CORE_SIMULATION_SCENE_MANAGER_H_
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -12,12 +13,30 @@
 #include "scene.h"
 #include "swganh/simulation/scene_manager_interface.h"
 
+namespace boost {
+namespace asio {
+    class io_service;
+}}  // namespace boost::asio
+
+namespace swganh {
+namespace simulation {
+    class SpatialProviderInterface;
+}}  // namespace swganh::simulation
+
 namespace swganh_core {
 namespace simulation {
     
     class SceneManager : public swganh::simulation::SceneManagerInterface
     {
     public:
+        typedef std::function<
+            std::shared_ptr<swganh::simulation::SpatialProviderInterface> ()
+        > SpatialProviderFactory;
+
+        /**
+         * @param io_service The io_service each scene's strand runs its work on.
+         */
+        explicit SceneManager(boost::asio::io_service& io_service);
 
         void LoadSceneDescriptionsFromDatabase(const std::shared_ptr<sql::Connection>& connection);
         
@@ -27,6 +46,17 @@ namespace simulation {
         void StartScene(const std::string& scene_label);
         void StopScene(const std::string& scene_label);
 
+        /**
+         * Flushes each running scene's deltas on its own strand.
+         */
+        void FlushDeltas();
+
+        /**
+         * Sets how the spatial index owned by each scene started from now on is
+         * created, every scene gets its own.
+         */
+        void SetSpatialProviderFactory(SpatialProviderFactory spatial_provider_factory);
+
     private:
         typedef std::map<
             std::string,
@@ -45,6 +75,9 @@ namespace simulation {
 
         SceneDescriptionMap scene_descriptions_;
         SceneMap scenes_;
+
+        boost::asio::io_service& io_service_;
+        SpatialProviderFactory spatial_provider_factory_;
     };
 
 }}  // namespace swganh_core::simulation
@@ -0,0 +1,420 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <atomic>
+
+#include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/byte_buffer.h"
+#include "anh/event_dispatcher.h"
+#include "anh/observer/observer_interface.h"
+
+#include "scene.h"
+#include "quadtree_spatial_provider.h"
+#include <swganh/object/creature/creature.h>
+#include <swganh/object/creature/creature_message_builder.h>
+
+using namespace swganh::object;
+using namespace swganh::object::creature;
+using namespace swganh_core::simulation;
+
+/// Counts the messages and bytes an object sends it, standing in for a player's session.
+class CountingObserver : public anh::observer::ObserverInterface
+{
+public:
+	explicit CountingObserver(uint64_t id)
+		: id_(id)
+		, messages_(0)
+		, bytes_(0)
+	{}
+
+	uint64_t GetId() const { return id_; }
+
+	void Notify(const anh::ByteBuffer& message)
+	{
+		++messages_;
+		bytes_ += message.size();
+		last_message_ = message;
+	}
+
+	void Notify(const std::shared_ptr<const anh::ByteBuffer>& message)
+	{
+		Notify(*message);
+	}
+
+	uint64_t messages() const { return messages_; }
+	uint64_t bytes() const { return bytes_; }
+	const anh::ByteBuffer& last_message() const { return last_message_; }
+
+private:
+	uint64_t id_;
+	uint64_t messages_;
+	uint64_t bytes_;
+	anh::ByteBuffer last_message_;
+};
+
+///
+class SceneTest {
+public:
+	SceneTest()
+		: spatial_provider_(nullptr)
+		, event_dispatcher_(io_service_)
+		, scene_(1, "corellia", "corellia", "", "terrain/corellia.trn", 128.0f, &spatial_provider_)
+		, next_object_id_(1)
+	{
+		// Queues objects for the scene's tick the way the simulation service does.
+		event_dispatcher_.Subscribe("Object::DeltasPending", [this] (const std::shared_ptr<anh::EventInterface>& incoming_event)
+		{
+			scene_.QueueDeltas(std::static_pointer_cast<Object::ObjectEvent>(incoming_event)->Get());
+		});
+	}
+
+protected:
+	std::shared_ptr<Creature> CreateCreature()
+	{
+		auto creature = std::make_shared<Creature>();
+		creature->SetEventDispatcher(&event_dispatcher_);
+		creature->SetObjectId(next_object_id_++);
+		creature->SetPosition(glm::vec3(0.0f, 0.0f, 0.0f));
+		return creature;
+	}
+
+	std::shared_ptr<CountingObserver> Observe(const std::shared_ptr<Creature>& creature)
+	{
+		auto observer = std::make_shared<CountingObserver>(next_object_id_++);
+		creature->Subscribe(observer);
+		return observer;
+	}
+
+	// One round of combat against the creature: a hit to each of its pools, a state
+	// applied and refreshed and a knockdown it gets back up from. Sending every update
+	// as soon as it's made is how deltas went out before the scene tick.
+	void Attack(const std::shared_ptr<Creature>& creature, bool send_each_update = false)
+	{
+		auto send = [&creature, send_each_update] ()
+		{
+			if (send_each_update)
+			{
+				creature->FlushDeltas();
+			}
+		};
+
+		for (auto stat : { HEALTH, ACTION, MIND })
+		{
+			creature->DeductStatCurrent(stat, 10);
+			CreatureMessageBuilder::BuildStatCurrentDelta(creature);
+			send();
+		}
+
+		creature->ToggleStateOn(COMBAT);
+		CreatureMessageBuilder::BuildStateBitmaskDelta(creature);
+		send();
+		creature->ToggleStateOn(STUNNED);
+		CreatureMessageBuilder::BuildStateBitmaskDelta(creature);
+		send();
+
+		creature->SetPosture(KNOCKED_DOWN);
+		CreatureMessageBuilder::BuildPostureDelta(creature);
+		send();
+		creature->SetPosture(UPRIGHT);
+		CreatureMessageBuilder::BuildPostureDelta(creature);
+		send();
+	}
+
+	// Runs the events posted by the object setters.
+	void RunEvents()
+	{
+		io_service_.poll();
+		io_service_.reset();
+	}
+
+	QuadtreeSpatialProvider spatial_provider_;
+	boost::asio::io_service io_service_;
+	anh::EventDispatcher event_dispatcher_;
+	Scene scene_;
+	uint64_t next_object_id_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SimulationScene, SceneTest)
+
+///
+BOOST_AUTO_TEST_CASE(DeltasAreHeldUntilTheSceneTicks)
+{
+	auto creature = CreateCreature();
+	auto observer = Observe(creature);
+
+	Attack(creature);
+	RunEvents();
+
+	BOOST_CHECK(creature->HasPendingDeltas());
+	BOOST_CHECK_EQUAL(0, observer->messages());
+
+	scene_.FlushDeltas();
+
+	BOOST_CHECK(!creature->HasPendingDeltas());
+	BOOST_CHECK_EQUAL(2, observer->messages());
+}
+
+///
+BOOST_AUTO_TEST_CASE(RepeatedUpdatesToAMemberCollapseToTheLatest)
+{
+	auto creature = CreateCreature();
+	auto observer = Observe(creature);
+
+	creature->SetPosture(KNOCKED_DOWN);
+	CreatureMessageBuilder::BuildPostureDelta(creature);
+	creature->SetPosture(SITTING);
+	CreatureMessageBuilder::BuildPostureDelta(creature);
+	RunEvents();
+
+	scene_.FlushDeltas();
+
+	BOOST_REQUIRE_EQUAL(1, observer->messages());
+
+	anh::ByteBuffer message = observer->last_message();
+	message.read_position(2 + 4 + 8 + 4);
+
+	BOOST_CHECK_EQUAL(Object::VIEW_3, message.read<uint8_t>());
+	BOOST_CHECK_EQUAL(2 + 2 + 1, message.read<uint32_t>());
+	BOOST_CHECK_EQUAL(1, message.read<uint16_t>());
+	BOOST_CHECK_EQUAL(11, message.read<uint16_t>());
+	BOOST_CHECK_EQUAL(SITTING, message.read<uint8_t>());
+}
+
+///
+BOOST_AUTO_TEST_CASE(UpdatesToAViewAreSentInOneMessage)
+{
+	auto creature = CreateCreature();
+	auto observer = Observe(creature);
+
+	creature->SetPosture(KNOCKED_DOWN);
+	CreatureMessageBuilder::BuildPostureDelta(creature);
+	creature->ToggleStateOn(COMBAT);
+	CreatureMessageBuilder::BuildStateBitmaskDelta(creature);
+	RunEvents();
+
+	scene_.FlushDeltas();
+
+	BOOST_REQUIRE_EQUAL(1, observer->messages());
+
+	anh::ByteBuffer message = observer->last_message();
+	message.read_position(2 + 4 + 8 + 4 + 1);
+
+	BOOST_CHECK_EQUAL(2 + 2 + 1 + 2 + 8, message.read<uint32_t>());
+	BOOST_CHECK_EQUAL(2, message.read<uint16_t>());
+	BOOST_CHECK_EQUAL(11, message.read<uint16_t>());
+	BOOST_CHECK_EQUAL(KNOCKED_DOWN, message.read<uint8_t>());
+	BOOST_CHECK_EQUAL(16, message.read<uint16_t>());
+	BOOST_CHECK_EQUAL(static_cast<uint64_t>(COMBAT), message.read<uint64_t>() & COMBAT);
+}
+
+///
+BOOST_AUTO_TEST_CASE(SequencedUpdatesAreAllSent)
+{
+	auto creature = CreateCreature();
+	auto observer = Observe(creature);
+
+	for (auto stat : { HEALTH, ACTION, MIND })
+	{
+		creature->DeductStatCurrent(stat, 10);
+		CreatureMessageBuilder::BuildStatCurrentDelta(creature);
+	}
+	RunEvents();
+
+	scene_.FlushDeltas();
+
+	BOOST_REQUIRE_EQUAL(1, observer->messages());
+
+	anh::ByteBuffer message = observer->last_message();
+	message.read_position(2 + 4 + 8 + 4 + 1 + 4);
+
+	BOOST_CHECK_EQUAL(3, message.read<uint16_t>());
+}
+
+/// A fight between 20 creatures, each watched by 25 players, every creature taking
+/// two rounds of attacks per 100ms tick. Reports the packets and bytes sent per tick
+/// when every update goes out on its own and when the scene tick sends them together.
+BOOST_AUTO_TEST_CASE(CombatDeltasSavedPerTick)
+{
+	const uint32_t combatant_count = 20;
+	const uint32_t observers_per_combatant = 25;
+	const uint32_t attacks_per_tick = 2;
+	const uint32_t tick_count = 50;
+
+	// Each run fights with its own creatures, the stats of a creature that has already
+	// fought would make the updates of the second run larger than those of the first.
+	auto fight = [&] (bool send_each_update) -> std::pair<uint64_t, uint64_t>
+	{
+		std::vector<std::shared_ptr<Creature>> combatants;
+		std::vector<std::shared_ptr<CountingObserver>> observers;
+
+		for (uint32_t i = 0; i < combatant_count; ++i)
+		{
+			combatants.push_back(CreateCreature());
+
+			for (uint32_t j = 0; j < observers_per_combatant; ++j)
+			{
+				observers.push_back(Observe(combatants.back()));
+			}
+		}
+
+		for (uint32_t tick = 0; tick < tick_count; ++tick)
+		{
+			for (auto& combatant : combatants)
+			{
+				for (uint32_t attack = 0; attack < attacks_per_tick; ++attack)
+				{
+					Attack(combatant, send_each_update);
+				}
+			}
+			RunEvents();
+			scene_.FlushDeltas();
+		}
+
+		std::pair<uint64_t, uint64_t> sent(0, 0);
+		for (auto& observer : observers)
+		{
+			sent.first += observer->messages();
+			sent.second += observer->bytes();
+		}
+		return sent;
+	};
+
+	// Every update sent as soon as it's made.
+	auto unbatched = fight(true);
+
+	// The updates made within a tick sent together.
+	auto batched = fight(false);
+
+	BOOST_CHECK(batched.first < unbatched.first);
+	BOOST_CHECK(batched.second < unbatched.second);
+
+	BOOST_TEST_MESSAGE(combatant_count << " combatants, " << observers_per_combatant << " observers each, "
+		<< attacks_per_tick << " attacks per tick");
+	BOOST_TEST_MESSAGE("Sent per update:  " << unbatched.first / tick_count << " messages, "
+		<< unbatched.second / tick_count << " bytes per tick");
+	BOOST_TEST_MESSAGE("Sent per tick:    " << batched.first / tick_count << " messages, "
+		<< batched.second / tick_count << " bytes per tick");
+	BOOST_TEST_MESSAGE("Saved:            " << (unbatched.first - batched.first) / tick_count << " messages, "
+		<< (unbatched.second - batched.second) / tick_count << " bytes per tick");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/// Moves creatures around scenes that each own their spatial index and strand,
+/// running every scene's moves on the given number of threads.
+class SceneLoad {
+protected:
+	/// @return The moves made per second.
+	double RunMoves(uint32_t scene_count, uint32_t thread_count, uint32_t moves_per_scene)
+	{
+		const uint32_t creatures_per_scene = 100;
+
+		boost::asio::io_service io_service;
+
+		// The events the moves post are never run, nothing here listens for them.
+		boost::asio::io_service event_io_service;
+		anh::EventDispatcher event_dispatcher(event_io_service);
+
+		std::vector<std::shared_ptr<Scene>> scenes;
+		std::vector<std::vector<std::shared_ptr<Creature>>> creatures(scene_count);
+		uint64_t next_object_id = 1;
+
+		for (uint32_t i = 0; i < scene_count; ++i)
+		{
+			SceneDescription description;
+			description.id = i + 1;
+			description.name = description.label = "scene";
+			description.terrain = "terrain/scene.trn";
+			description.view_distance = 128.0f;
+
+			auto scene = std::make_shared<Scene>(description, std::make_shared<QuadtreeSpatialProvider>(nullptr), io_service);
+
+			for (uint32_t j = 0; j < creatures_per_scene; ++j)
+			{
+				auto creature = std::make_shared<Creature>();
+				creature->SetEventDispatcher(&event_dispatcher);
+				creature->SetObjectId(next_object_id++);
+				creature->SetPosition(glm::vec3((j % 10) * 200.0f - 1000.0f, 0.0f, (j / 10) * 200.0f - 1000.0f));
+
+				scene->AddObject(creature);
+				creatures[i].push_back(creature);
+			}
+
+			scenes.push_back(scene);
+		}
+
+		std::atomic<uint32_t> moves_made(0);
+
+		for (uint32_t i = 0; i < scene_count; ++i)
+		{
+			auto scene = scenes[i];
+
+			for (uint32_t move = 0; move < moves_per_scene; ++move)
+			{
+				auto creature = creatures[i][move % creatures_per_scene];
+				float step = static_cast<float>((move * 37) % 400) - 200.0f;
+
+				scene->Post([scene, creature, step, &moves_made] ()
+				{
+					auto position = creature->GetPosition();
+					creature->SetPosition(glm::vec3(position.x + step, 0.0f, position.z - step));
+					scene->UpdateObject(creature);
+
+					++moves_made;
+				});
+			}
+		}
+
+		auto start = boost::chrono::high_resolution_clock::now();
+
+		boost::thread_group threads;
+		for (uint32_t i = 0; i < thread_count; ++i)
+		{
+			threads.create_thread([&io_service] () { io_service.run(); });
+		}
+		threads.join_all();
+
+		double seconds = boost::chrono::duration<double>(boost::chrono::high_resolution_clock::now() - start).count();
+
+		BOOST_CHECK_EQUAL(scene_count * moves_per_scene, moves_made);
+
+		return moves_made / seconds;
+	}
+};
+
+BOOST_FIXTURE_TEST_SUITE(SimulationSceneLoad, SceneLoad)
+
+/// Moves creatures around 8 scenes on one thread and on a thread per core and reports
+/// the moves made per second. Scenes share no spatial index or lock so the throughput
+/// grows with the cores running them.
+BOOST_AUTO_TEST_CASE(MovesScaleWithCores)
+{
+	if (anh::SkipBenchmark())
+	{
+		return;
+	}
+
+	const uint32_t scene_count = 8;
+	const uint32_t moves_per_scene = 20000;
+
+	uint32_t cores = std::max(1u, boost::thread::hardware_concurrency());
+
+	double single_thread = RunMoves(scene_count, 1, moves_per_scene);
+
+	BOOST_TEST_MESSAGE(scene_count << " scenes, " << moves_per_scene << " moves each");
+	BOOST_TEST_MESSAGE("1 thread:   " << static_cast<uint64_t>(single_thread) << " moves/s");
+
+	for (uint32_t thread_count = 2; thread_count <= cores; thread_count *= 2)
+	{
+		double rate = RunMoves(scene_count, thread_count, moves_per_scene);
+
+		BOOST_TEST_MESSAGE(thread_count << " threads:  " << static_cast<uint64_t>(rate) << " moves/s, "
+			<< rate / single_thread << "x");
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
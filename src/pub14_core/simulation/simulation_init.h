@@ -63,7 +63,7 @@ inline void Initialize(swganh::app::SwganhKernel* kernel)
 	// Register Scene Manager
 	{
 		registration.CreateObject = [kernel] (anh::plugin::ObjectParams* params) -> void* {
-			return new SceneManager();
+			return new SceneManager(kernel->GetIoService());
 		};
 		registration.DestroyObject = [] (void * object) {
 			if (object) {
@@ -3,11 +3,14 @@
 
 #include "simulation_service.h"
 
+#include <stdexcept>
+
 #include <boost/algorithm/string.hpp>
 
 #include "anh/byte_buffer.h"
 #include "anh/crc.h"
 #include "anh/event_dispatcher.h"
+#include "anh/timing.h"
 #include "anh/service/service_manager.h"
 #include "anh/database/database_manager.h"
 #include "anh/network/soe/server_interface.h"
@@ -75,12 +78,21 @@ using swganh::app::SwganhKernel;
 namespace swganh_core {
 namespace simulation {
 
+// Delta updates made to objects within one tick are sent together at the end of it.
+static const boost::posix_time::time_duration kDeltasTickPeriod = boost::posix_time::milliseconds(100);
+
 class SimulationServiceImpl {
 public:
     SimulationServiceImpl(SwganhKernel* kernel)
         : kernel_(kernel)
+    {}
+
+    ~SimulationServiceImpl()
     {
-		spatial_provider_ = kernel->GetPluginManager()->CreateObject<SpatialProviderInterface>("Simulation::SpatialProvider");
+        if (deltas_timer_)
+        {
+            deltas_timer_->cancel();
+        }
     }
 
     const shared_ptr<ObjectManager>& GetObjectManager()
@@ -97,7 +109,16 @@ public:
     {
         if (!scene_manager_)
         {
-            scene_manager_ = kernel_->GetPluginManager()->CreateObject<SceneManager>("Simulation::SceneManager");
+            auto scene_manager = kernel_->GetPluginManager()->CreateObject<SceneManager>("Simulation::SceneManager");
+
+            // each scene indexes only its own objects
+            auto kernel = kernel_;
+            scene_manager->SetSpatialProviderFactory([kernel] ()
+            {
+                return kernel->GetPluginManager()->CreateObject<SpatialProviderInterface>("Simulation::SpatialProvider");
+            });
+
+            scene_manager_ = scene_manager;
         }
 
         return scene_manager_;
@@ -108,7 +129,7 @@ public:
         if (!movement_manager_)
         {
 			movement_manager_ = kernel_->GetPluginManager()->CreateObject<MovementManager>("Simulation::MovementManager");
-			movement_manager_->SetSpatialProvider(spatial_provider_.get());
+			movement_manager_->SetSceneManager(GetSceneManager().get());
 		}
 
         return movement_manager_.get();
@@ -125,20 +146,12 @@ public:
 
     shared_ptr<Object> LoadObjectById(uint64_t object_id)
     {
-        auto object = object_manager_->LoadObjectById(object_id);
-
-		spatial_provider_->AddObject(object); // Add object to spatial indexing.
-        
-        return object;
+        return object_manager_->LoadObjectById(object_id);
     }
 
     shared_ptr<Object> LoadObjectById(uint64_t object_id, uint32_t type)
     {
-        auto object = object_manager_->LoadObjectById(object_id, type);
-
-		spatial_provider_->AddObject(object); // Add object to spatial indexing.
-
-        return object;
+        return object_manager_->LoadObjectById(object_id, type);
     }
 
     shared_ptr<Object> GetObjectById(uint64_t object_id)
@@ -155,6 +168,37 @@ public:
         }
     }
 
+    void QueueDeltas(const shared_ptr<Object>& object)
+    {
+        auto scene = scene_manager_->GetScene(object->GetSceneId());
+        if (scene)
+        {
+            scene->QueueDeltas(object);
+        }
+        else
+        {
+            // not part of a running scene so there's no tick to wait for
+            object->FlushDeltas();
+        }
+    }
+
+    void StartDeltasTick()
+    {
+        deltas_timer_ = make_shared<boost::asio::deadline_timer>(kernel_->GetIoService(), kDeltasTickPeriod);
+
+        std::function<void (const boost::system::error_code&)> handler =
+            [this] (const boost::system::error_code& error)
+        {
+            if (!error)
+            {
+                scene_manager_->FlushDeltas();
+            }
+        };
+
+        deltas_timer_->async_wait(
+            RepeatHandler<std::function<void (const boost::system::error_code&)>>(deltas_timer_, kDeltasTickPeriod, handler));
+    }
+
     void RemoveObject(const shared_ptr<Object>& object)
     {
         auto scene = scene_manager_->GetScene(object->GetSceneId());
@@ -163,8 +207,6 @@ public:
             scene->RemoveObject(object);
         }
 
-		spatial_provider_->RemoveObject(object); // Remove the object from spatial indexing.
-
         StopControllingObject(object);
 
         object_manager_->RemoveObject(object);
@@ -375,6 +417,21 @@ public:
 
     void SendToAllInScene(ByteBuffer message, uint32_t scene_id)
     {
+        auto scene_objects = object_manager_->GetObjectsInScene(scene_id);
+
+        // walk whichever of the scene and the controlled objects is smaller
+        if (scene_objects.size() < controlled_objects_.size())
+        {
+            for (auto& object : scene_objects)
+            {
+                auto find_iter = controlled_objects_.find(object->GetObjectId());
+                if (find_iter != controlled_objects_.end())
+                    find_iter->second->GetRemoteClient()->SendTo(message);
+            }
+
+            return;
+        }
+
         for_each(begin(controlled_objects_), end(controlled_objects_), [=] (const pair<uint64_t, shared_ptr<ObjectController>>& pair) {
             auto controller = pair.second;
             if (controller->GetObject()->GetSceneId() == scene_id)
@@ -388,7 +445,7 @@ private:
     shared_ptr<MovementManagerInterface> movement_manager_;
     SwganhKernel* kernel_;
 	ServerInterface* server_;
-	shared_ptr<SpatialProviderInterface> spatial_provider_;
+    shared_ptr<boost::asio::deadline_timer> deltas_timer_;
 
     ObjControllerHandlerMap controller_handlers_;
 
@@ -401,7 +458,16 @@ SimulationService::SimulationService(SwganhKernel* kernel)
     : impl_(new SimulationServiceImpl(kernel))
     , kernel_(kernel)
 {
-    impl_->GetSceneManager()->LoadSceneDescriptionsFromDatabase(kernel_->GetDatabaseManager()->getConnection("galaxy"));
+    {
+        auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
+        if (!conn)
+        {
+            throw std::runtime_error("Unable to load the scene descriptions: no connection to the galaxy database");
+        }
+
+        impl_->GetSceneManager()->LoadSceneDescriptionsFromDatabase(conn);
+    }
+
     RegisterObjectFactories();
 }
 
@@ -550,6 +616,15 @@ void SimulationService::Startup()
     SimulationServiceInterface::RegisterControllerHandler(
         &MovementManagerInterface::HandleDataTransformWithParent, impl_->GetMovementManager());
 
+    kernel_->GetEventDispatcher()->Subscribe(
+        "Object::DeltasPending",
+        [this] (const shared_ptr<EventInterface>& incoming_event)
+    {
+        auto object = static_pointer_cast<Object::ObjectEvent>(incoming_event)->Get();
+        impl_->QueueDeltas(object);
+    });
+
+    impl_->StartDeltasTick();
     
 	auto command_service = kernel_->GetServiceManager()->GetService<swganh::command::CommandServiceInterface>("CommandService");
 
@@ -113,6 +113,19 @@ options_description AppConfig::BuildConfigDescription() {
             "Username for authentication with the galaxy datastore")
         ("db.galaxy.password", boost::program_options::value<std::string>(&galaxy_db.password),
             "Password for authentication with the galaxy datastore")
+
+        ("db.pool.min_connections",
+            boost::program_options::value<uint32_t>(&db_pool.min_connections)->default_value(1),
+            "The number of connections kept open to each datastore, even when idle")
+        ("db.pool.max_connections",
+            boost::program_options::value<uint32_t>(&db_pool.max_connections)->default_value(16),
+            "The most connections open to each datastore at once")
+        ("db.pool.acquire_timeout_secs",
+            boost::program_options::value<uint32_t>(&db_pool.acquire_timeout_secs)->default_value(5),
+            "The number of seconds to wait for a free connection before giving up")
+        ("db.pool.ping_interval_secs",
+            boost::program_options::value<uint32_t>(&db_pool.ping_interval_secs)->default_value(60),
+            "The number of seconds between checks that idle connections are still alive")
             
         ("service.login.udp_port", 
             boost::program_options::value<uint16_t>(&login_config.listen_port),
@@ -129,6 +142,9 @@ options_description AppConfig::BuildConfigDescription() {
         ("service.login.auto_registration",
             boost::program_options::value<bool>(&login_config.login_auto_registration)->default_value(false),
             "Auto Registration flag")
+        ("service.login.coalescing_delay_ms",
+            boost::program_options::value<uint32_t>(&login_config.coalescing_delay_ms)->default_value(0),
+            "Milliseconds a session with data to send waits for more before it is flushed")
             
         ("service.connection.ping_port", boost::program_options::value<uint16_t>(&connection_config.ping_port),
             "The port the connection service will listen for incoming client ping requests on")
@@ -136,6 +152,18 @@ options_description AppConfig::BuildConfigDescription() {
             "The port the connection service will listen for incoming client connections on")
         ("service.connection.address", boost::program_options::value<string>(&connection_config.listen_address),
             "The public address the connection service will listen for incoming client connections on")
+        ("service.connection.delayed_acks",
+            boost::program_options::value<bool>(&connection_config.delayed_acks)->default_value(true),
+            "Acknowledge client packets once per flush, piggybacked on outgoing data where possible")
+        ("service.connection.compression_level",
+            boost::program_options::value<int>(&connection_config.compression_level)->default_value(6),
+            "The zlib compression level for outgoing packets, from 0 (none) to 9 (best)")
+        ("service.connection.compression_threshold",
+            boost::program_options::value<uint32_t>(&connection_config.compression_threshold)->default_value(476),
+            "Outgoing packets larger than this many bytes are compressed")
+        ("service.connection.coalescing_delay_ms",
+            boost::program_options::value<uint32_t>(&connection_config.coalescing_delay_ms)->default_value(0),
+            "Milliseconds a session with data to send waits for more before it is flushed")
     ;
 
     return desc;
@@ -364,6 +392,7 @@ void SwganhApp::LoadCoreServices_()
 		login_service->galaxy_status_check_duration_secs(app_config.login_config.galaxy_status_check_duration_secs);
 		login_service->login_error_timeout_secs(app_config.login_config.login_error_timeout_secs);
         login_service->login_auto_registration(app_config.login_config.login_auto_registration);
+        login_service->coalescing_delay(boost::chrono::milliseconds(app_config.login_config.coalescing_delay_ms));
     
 		kernel_->GetServiceManager()->AddService("LoginService", login_service);
 	}
@@ -375,6 +404,11 @@ void SwganhApp::LoadCoreServices_()
 			app_config.connection_config.listen_port, 
 			app_config.connection_config.ping_port, 
 			kernel_.get());
+
+		connection_service->delayed_acks(app_config.connection_config.delayed_acks);
+		connection_service->compression_level(app_config.connection_config.compression_level);
+		connection_service->compression_threshold(app_config.connection_config.compression_threshold);
+		connection_service->coalescing_delay(boost::chrono::milliseconds(app_config.connection_config.coalescing_delay_ms));
     
 		kernel_->GetServiceManager()->AddService("ConnectionService", connection_service);
 	}
@@ -3,12 +3,15 @@
 
 #include "swganh/app/swganh_kernel.h"
 
+#include <stdexcept>
+
 #include <mysql_driver.h>
 #include <cppconn/connection.h>
 #include <cppconn/driver.h>
 
 #include "anh/database/database_manager.h"
 #include "anh/event_dispatcher.h"
+#include "anh/timing_wheel.h"
 #include "anh/plugin/plugin_manager.h"
 #include "anh/resource/resource_manager.h"
 #include "anh/service/datastore.h"
@@ -24,6 +27,7 @@ using namespace swganh::app;
 
 using anh::app::Version;
 using anh::database::DatabaseManagerInterface;
+using anh::database::ConnectionPoolOptions;
 using anh::database::DatabaseManager;
 using anh::plugin::PluginManager;
 using anh::service::ServiceManager;
@@ -32,24 +36,32 @@ using std::make_shared;
 using std::shared_ptr;
 
 SwganhKernel::SwganhKernel(boost::asio::io_service& io_service)
-    : io_service_(io_service)
+    : timing_wheel_(new anh::TimingWheel(io_service))
+    , io_service_(io_service)
 {
     version_.major = VERSION_MAJOR;
     version_.minor = VERSION_MINOR;
 
     plugin_manager_ = nullptr;
     service_manager_ = nullptr;
+
+    // created up front rather than on first use, services ask for it from their own threads
+    timing_wheel_->Start();
 }
 
 SwganhKernel::~SwganhKernel()
 {
     service_manager_->Stop();
+    timing_wheel_->Stop();
 
     resource_manager_.reset();
     event_dispatcher_.reset();
     service_manager_.reset();
     service_directory_.reset();
     plugin_manager_.reset();
+
+    // last, whatever the services leave behind may still cancel its timers
+    timing_wheel_.reset();
 }
 
 const Version& SwganhKernel::GetVersion() {
@@ -62,7 +74,13 @@ AppConfig& SwganhKernel::GetAppConfig() {
 
 DatabaseManagerInterface* SwganhKernel::GetDatabaseManager() {
     if (!database_manager_) {
-        database_manager_.reset(new DatabaseManager(sql::mysql::get_driver_instance()));
+        ConnectionPoolOptions pool_options;
+        pool_options.min_connections = app_config_.db_pool.min_connections;
+        pool_options.max_connections = app_config_.db_pool.max_connections;
+        pool_options.acquire_timeout = boost::posix_time::seconds(app_config_.db_pool.acquire_timeout_secs);
+        pool_options.ping_interval = boost::posix_time::seconds(app_config_.db_pool.ping_interval_secs);
+
+        database_manager_.reset(new DatabaseManager(sql::mysql::get_driver_instance(), pool_options));
     }
 
     return database_manager_.get();
@@ -94,7 +112,12 @@ ServiceManager* SwganhKernel::GetServiceManager() {
 
 ServiceDirectoryInterface* SwganhKernel::GetServiceDirectory() {
     if (!service_directory_) {        
-        auto data_store = make_shared<Datastore>(GetDatabaseManager()->getConnection("galaxy_manager"));
+        auto connection = GetDatabaseManager()->getConnection("galaxy_manager");
+        if (!connection) {
+            throw std::runtime_error("Unable to start the service directory: no connection to the galaxy_manager database");
+        }
+
+        auto data_store = make_shared<Datastore>(connection);
         service_directory_.reset(new ServiceDirectory(
             data_store, 
             GetEventDispatcher(),
@@ -110,6 +133,10 @@ boost::asio::io_service& SwganhKernel::GetIoService() {
     return io_service_;
 }
 
+anh::TimingWheel* SwganhKernel::GetTimingWheel() {
+    return timing_wheel_.get();
+}
+
 anh::resource::ResourceManager* SwganhKernel::GetResourceManager()
 {
     if (!resource_manager_)
@@ -44,6 +44,16 @@ struct AppConfig {
         std::string password;
     } galaxy_manager_db, galaxy_db;
 
+    /*!
+    * @Brief Contains the limits for the database connection pools"
+    */
+    struct DatabasePoolConfig {
+        uint32_t min_connections;
+        uint32_t max_connections;
+        uint32_t acquire_timeout_secs;
+        uint32_t ping_interval_secs;
+    } db_pool;
+
     /*!
     * @Brief Contains information about the Login config"
      */
@@ -53,6 +63,7 @@ struct AppConfig {
         int galaxy_status_check_duration_secs;
         int login_error_timeout_secs;
         bool login_auto_registration;
+        uint32_t coalescing_delay_ms;
     } login_config;
     /*!
     * @Brief Contains information about the app config"
@@ -61,6 +72,10 @@ struct AppConfig {
         std::string listen_address;
         uint16_t listen_port;
         uint16_t ping_port;
+        bool delayed_acks;
+        int compression_level;
+        uint32_t compression_threshold;
+        uint32_t coalescing_delay_ms;
     } connection_config;
 
     boost::program_options::options_description BuildConfigDescription();
@@ -87,6 +102,8 @@ public:
     
     boost::asio::io_service& GetIoService();
 
+    anh::TimingWheel* GetTimingWheel();
+
     anh::resource::ResourceManager* GetResourceManager();
 
 private:
@@ -100,6 +117,7 @@ private:
     std::unique_ptr<anh::service::ServiceManager> service_manager_;
     std::unique_ptr<anh::service::ServiceDirectoryInterface> service_directory_;
     std::unique_ptr<anh::resource::ResourceManager> resource_manager_;
+    std::unique_ptr<anh::TimingWheel> timing_wheel_;
 
     boost::asio::io_service& io_service_;
 };
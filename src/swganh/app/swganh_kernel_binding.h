@@ -66,7 +66,7 @@ void exportEventDispatcher()
     class_<anh::EventDispatcher, boost::noncopyable>("EventDispatcher", no_init)
         .def("dispatch",
             make_function(
-                std::bind(&anh::EventDispatcher::Dispatch, std::placeholders::_1, std::placeholders::_2),
+                std::bind(&anh::EventDispatcher::Post, std::placeholders::_1, std::placeholders::_2),
                 default_call_policies(),
                 boost::mpl::vector<void, anh::EventDispatcher*, std::shared_ptr<anh::EventInterface>>()), 
             "dispatches an event to be processed later")
@@ -28,6 +28,7 @@
 #include "swganh/command/command_service_interface.h"
 #include "swganh/command/python_command_creator.h"
 #include "swganh/command/base_combat_command.h"
+#include "swganh/command/combat_command_creator.h"
 #include "swganh/simulation/simulation_service_interface.h"
 
 #include "swganh/messages/controllers/combat_action_message.h"
@@ -54,7 +55,7 @@ using swganh::app::SwganhKernel;
 
 CombatService::CombatService(SwganhKernel* kernel)
 : generator_(1, 100)
-, active_(kernel->GetIoService())
+, active_(kernel->GetIoService(), kernel->GetTimingWheel())
 , kernel_(kernel)
 {
 }
@@ -81,14 +82,14 @@ void CombatService::Startup()
 	command_service_ = kernel_->GetServiceManager()
 		->GetService<CommandServiceInterface>("CommandService");
     
-    command_service_->AddCommandCreator("attack", swganh::command::PythonCommandCreator("commands.attack", "AttackCommand"));
+    command_service_->AddCommandCreator("attack", swganh::command::CombatCommandCreator("commands.attack", "AttackCommand"));
     command_service_->AddCommandCreator("deathblow", swganh::command::PythonCommandCreator("commands.deathblow", "DeathBlowCommand")); 
-    command_service_->AddCommandCreator("defaultattack", swganh::command::PythonCommandCreator("commands.defaultattack", "DefaultAttackCommand"));
+    command_service_->AddCommandCreator("defaultattack", swganh::command::CombatCommandCreator("commands.defaultattack", "DefaultAttackCommand"));
     command_service_->AddCommandCreator("duel", swganh::command::PythonCommandCreator("commands.duel", "DuelCommand"));
     command_service_->AddCommandCreator("endduel", swganh::command::PythonCommandCreator("commands.endduel", "EndDuelCommand"));
     command_service_->AddCommandCreator("kneel", swganh::command::PythonCommandCreator("commands.kneel", "KneelCommand"));
-    command_service_->AddCommandCreator("berserk1", swganh::command::PythonCommandCreator("commands.berserk1", "Berserk1Command"));
-    command_service_->AddCommandCreator("overchargeshot1", swganh::command::PythonCommandCreator("commands.overchargeshot1", "OverchargeShot1Command"));
+    command_service_->AddCommandCreator("berserk1", swganh::command::CombatCommandCreator("commands.berserk1", "Berserk1Command"));
+    command_service_->AddCommandCreator("overchargeshot1", swganh::command::CombatCommandCreator("commands.overchargeshot1", "OverchargeShot1Command"));
     command_service_->AddCommandCreator("peace", swganh::command::PythonCommandCreator("commands.peace", "PeaceCommand"));
     command_service_->AddCommandCreator("prone", swganh::command::PythonCommandCreator("commands.prone", "ProneCommand"));
     command_service_->AddCommandCreator("sitserver", swganh::command::PythonCommandCreator("commands.sitserver", "SitServerCommand"));
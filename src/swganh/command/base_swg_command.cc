@@ -142,3 +142,11 @@ void BaseSwgCommand::SetCommandRequest(const swganh::messages::controllers::Comm
 {
     command_request_ = command_request;
 }
+
+void BaseSwgCommand::Reset()
+{
+    controller_.reset();
+    actor_.reset();
+    target_.reset();
+    command_request_ = CommandQueueEnqueue();
+}
@@ -80,6 +80,11 @@ namespace command {
         const swganh::messages::controllers::CommandQueueEnqueue& GetCommandRequest() const;
 
         void SetCommandRequest(const swganh::messages::controllers::CommandQueueEnqueue& command_request);
+
+        /**
+         * Clears the controller and request of the last use so the command can be used again.
+         */
+        void Reset();
     private:    
         swganh::app::SwganhKernel* kernel_;
         const CommandProperties* properties_;
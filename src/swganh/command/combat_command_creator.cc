@@ -0,0 +1,173 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "combat_command_creator.h"
+
+#include <boost/python.hpp>
+
+#include "swganh/scripting/utilities.h"
+
+namespace bp = boost::python;
+using swganh::command::CombatCommandCreator;
+using swganh::command::CombatCommandValues;
+using swganh::command::CommandInterface;
+using swganh::command::CommandProperties;
+using swganh::command::NativeCombatCommand;
+using swganh::command::PythonCommandCreator;
+using swganh::scripting::ScopedGilLock;
+
+namespace {
+
+    template<typename T>
+    void ExtractValue(const bp::object& command_class, const char* name, T& value)
+    {
+        if (PyObject_HasAttrString(command_class.ptr(), name))
+        {
+            bp::extract<T> extracted(command_class.attr(name));
+            if (extracted.check())
+            {
+                value = extracted();
+            }
+        }
+    }
+
+    // checks the classes between the command class and BaseCombatCommand for
+    // anything that has to be run in python, classes that aren't combat
+    // commands at all are run in python too
+    bool OverridesCombatCommand(const bp::object& command_class)
+    {
+        bp::object mro = command_class.attr("__mro__");
+
+        for (bp::ssize_t i = 0; i < bp::len(mro); ++i)
+        {
+            bp::object klass = mro[i];
+
+            std::string name = bp::extract<std::string>(klass.attr("__name__"));
+            if (name == "BaseCombatCommand")
+            {
+                return false;
+            }
+
+            bp::object members = klass.attr("__dict__");
+            if (PyMapping_HasKeyString(members.ptr(), "Run") || PyMapping_HasKeyString(members.ptr(), "__init__"))
+            {
+                return true;
+            }
+        }
+
+        return true;
+    }
+
+}  // namespace
+
+CombatCommandValues::CombatCommandValues()
+    : min_damage(0)
+    , max_damage(0)
+    , damage_multiplier(0.0f)
+    , accuracy_bonus(0)
+    , speed_multiplier(0.0f)
+    , health_hit_chance(0.0f)
+    , action_hit_chance(0.0f)
+    , mind_hit_chance(0.0f)
+{}
+
+NativeCombatCommand::NativeCombatCommand(
+    swganh::app::SwganhKernel* kernel,
+    const CommandProperties& properties,
+    std::shared_ptr<const CombatCommandValues> values)
+    : BaseCombatCommand(kernel, properties)
+    , values_(std::move(values))
+{}
+
+int NativeCombatCommand::GetMinDamage()
+{
+    return values_->min_damage;
+}
+
+int NativeCombatCommand::GetMaxDamage()
+{
+    return values_->max_damage;
+}
+
+float NativeCombatCommand::GetDamageMultiplier()
+{
+    return values_->damage_multiplier;
+}
+
+int NativeCombatCommand::GetAccuracyBonus()
+{
+    return values_->accuracy_bonus;
+}
+
+float NativeCombatCommand::GetSpeedMultiplier()
+{
+    return values_->speed_multiplier;
+}
+
+float NativeCombatCommand::GetHealthHitChance()
+{
+    return values_->health_hit_chance;
+}
+
+float NativeCombatCommand::GetActionHitChance()
+{
+    return values_->action_hit_chance;
+}
+
+float NativeCombatCommand::GetMindHitChance()
+{
+    return values_->mind_hit_chance;
+}
+
+CombatCommandCreator::CombatCommandCreator(std::string module_name, std::string class_name)
+{
+    bool overridden = true;
+
+    {
+        ScopedGilLock lock;
+
+        try
+        {
+            bp::object command_class = bp::import(module_name.c_str()).attr(class_name.c_str());
+
+            overridden = OverridesCombatCommand(command_class);
+
+            if (!overridden)
+            {
+                auto values = std::make_shared<CombatCommandValues>();
+
+                ExtractValue(command_class, "min_damage", values->min_damage);
+                ExtractValue(command_class, "max_damage", values->max_damage);
+                ExtractValue(command_class, "damage_multiplier", values->damage_multiplier);
+                ExtractValue(command_class, "accuracy_bonus", values->accuracy_bonus);
+                ExtractValue(command_class, "speed_multiplier", values->speed_multiplier);
+                ExtractValue(command_class, "health_hit_chance", values->health_hit_chance);
+                ExtractValue(command_class, "action_hit_chance", values->action_hit_chance);
+                ExtractValue(command_class, "mind_hit_chance", values->mind_hit_chance);
+
+                values_ = values;
+            }
+        }
+        catch(bp::error_already_set& /*e*/)
+        {
+            PyErr_Print();
+        }
+    }
+
+    if (overridden)
+    {
+        python_creator_ = std::make_shared<PythonCommandCreator>(module_name, class_name);
+    }
+}
+
+std::shared_ptr<CommandInterface> CombatCommandCreator::operator() (
+    swganh::app::SwganhKernel* kernel,
+    const CommandProperties& properties)
+{
+    if (python_creator_)
+    {
+        return (*python_creator_)(kernel, properties);
+    }
+
+    return std::make_shared<NativeCombatCommand>(kernel, properties, values_);
+}
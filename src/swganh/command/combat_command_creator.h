@@ -0,0 +1,88 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef SWGANH_COMMAND_COMBAT_COMMAND_CREATOR_H_
+#define SWGANH_COMMAND_COMBAT_COMMAND_CREATOR_H_
+
+#include <memory>
+#include <string>
+
+#include "base_combat_command.h"
+#include "python_command_creator.h"
+
+namespace swganh {
+namespace command {
+
+    /**
+     * The values a combat command script sets on its class.
+     */
+    struct CombatCommandValues
+    {
+        CombatCommandValues();
+
+        int min_damage;
+        int max_damage;
+        float damage_multiplier;
+        int accuracy_bonus;
+        float speed_multiplier;
+        float health_hit_chance;
+        float action_hit_chance;
+        float mind_hit_chance;
+    };
+
+    /**
+     * A combat command run entirely in C++ from values read from its script once.
+     */
+    class NativeCombatCommand : public BaseCombatCommand
+    {
+    public:
+        NativeCombatCommand(
+            swganh::app::SwganhKernel* kernel,
+            const CommandProperties& properties,
+            std::shared_ptr<const CombatCommandValues> values);
+
+        int GetMinDamage();
+        int GetMaxDamage();
+
+        float GetDamageMultiplier();
+        int GetAccuracyBonus();
+        float GetSpeedMultiplier();
+
+        float GetHealthHitChance();
+        float GetActionHitChance();
+        float GetMindHitChance();
+
+    private:
+        std::shared_ptr<const CombatCommandValues> values_;
+    };
+
+    /**
+     * Creates combat commands defined by a BaseCombatCommand subclass in a python
+     * module.
+     *
+     * Scripts that only set values on the class are read once and run as a
+     * NativeCombatCommand, without taking the GIL per command. Scripts that
+     * override Run or __init__ are run in python through a PythonCommandCreator.
+     */
+    class CombatCommandCreator
+    {
+    public:
+        CombatCommandCreator(std::string module_name, std::string class_name);
+
+        std::shared_ptr<CommandInterface> operator() (
+            swganh::app::SwganhKernel* kernel,
+            const CommandProperties& properties);
+
+        /**
+         * @return True if the commands are run in python.
+         */
+        bool IsOverridden() const { return python_creator_ != nullptr; }
+
+    private:
+        std::shared_ptr<const CombatCommandValues> values_;
+        std::shared_ptr<PythonCommandCreator> python_creator_;
+    };
+
+}}
+
+#endif  // SWGANH_COMMAND_COMBAT_COMMAND_CREATOR_H_
@@ -28,8 +28,11 @@ namespace command {
 
     /**
      * A queue for managing the flow of command processing for a single controlled object.
+     *
+     * Queues are owned by shared pointers so the delayed work they schedule can hold
+     * weak references to them and find out whether they're still around.
      */
-    class CommandQueueInterface
+    class CommandQueueInterface : public std::enable_shared_from_this<CommandQueueInterface>
     {
     public:
         virtual ~CommandQueueInterface() {}
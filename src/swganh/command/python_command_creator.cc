@@ -1,9 +1,14 @@
 
 #include "python_command_creator.h"
 
+#include <atomic>
+#include <vector>
+
 #include <boost/python.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include "swganh/app/swganh_kernel.h"
+#include "swganh/command/base_swg_command.h"
 #include "swganh/command/command_interface.h"
 #include "swganh/command/command_properties.h"
 #include "swganh/messages/controllers/command_queue_enqueue.h"
@@ -12,6 +17,7 @@
 
 namespace bp = boost::python;
 using swganh::app::SwganhKernel;
+using swganh::command::BaseSwgCommand;
 using swganh::command::CommandInterface;
 using swganh::command::CommandProperties;
 using swganh::command::PythonCommandCreator;
@@ -19,13 +25,96 @@ using swganh::messages::controllers::CommandQueueEnqueue;
 using swganh::object::ObjectController;
 using swganh::scripting::ScopedGilLock;
 
-PythonCommandCreator::PythonCommandCreator(std::string module_name, std::string class_name)
+#ifdef _DEBUG
+// the module is reloaded for every command so script changes are picked up
+static const bool kReuseInstances = false;
+#else
+static const bool kReuseInstances = true;
+#endif
+
+struct PythonCommandCreator::InstancePool
+{
+    struct Instance
+    {
+        PyObject* object;
+        BaseSwgCommand* command;
+    };
+
+    explicit InstancePool(size_t max_idle)
+        : max_idle(max_idle)
+        , created(0)
+    {}
+
+    ~InstancePool()
+    {
+        // the interpreter is already gone if the pool outlives it at shutdown
+        if (Py_IsInitialized())
+        {
+            ScopedGilLock lock;
+
+            for (auto& instance : idle)
+            {
+                Py_DECREF(instance.object);
+            }
+        }
+    }
+
+    bool Acquire(Instance& instance)
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+
+        if (idle.empty())
+        {
+            return false;
+        }
+
+        instance = idle.back();
+        idle.pop_back();
+
+        return true;
+    }
+
+    void Release(Instance instance)
+    {
+        instance.command->Reset();
+
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+
+            if (idle.size() < max_idle)
+            {
+                idle.push_back(instance);
+                return;
+            }
+        }
+
+        ScopedGilLock lock;
+        Py_DECREF(instance.object);
+    }
+
+    static std::shared_ptr<CommandInterface> Wrap(const std::shared_ptr<InstancePool>& pool, Instance instance)
+    {
+        // handing the instance back needs no python, only the last reference to it does
+        return std::shared_ptr<CommandInterface>(instance.command, [pool, instance] (CommandInterface*)
+        {
+            pool->Release(instance);
+        });
+    }
+
+    boost::mutex mutex;
+    std::vector<Instance> idle;
+    size_t max_idle;
+    std::atomic<uint64_t> created;
+};
+
+PythonCommandCreator::PythonCommandCreator(std::string module_name, std::string class_name, size_t max_idle)
     : module_name_(module_name)
     , class_name_(class_name)
+    , pool_(std::make_shared<InstancePool>(max_idle))
 {
     ScopedGilLock lock;
 
-    try 
+    try
     {
         command_module_ = bp::import(module_name_.c_str());
     }
@@ -40,22 +129,43 @@ std::shared_ptr<CommandInterface> PythonCommandCreator::operator() (
     const CommandProperties& properties)
 {
     std::shared_ptr<CommandInterface> command = nullptr;
-    
+
+    InstancePool::Instance instance;
+    if (kReuseInstances && pool_->Acquire(instance))
+    {
+        instance.command->SetCommandProperties(properties);
+        return InstancePool::Wrap(pool_, instance);
+    }
+
     ScopedGilLock lock;
 
-    try 
+    try
     {
 
 #ifdef _DEBUG
         command_module_ = bp::object(bp::handle<>(PyImport_ReloadModule(command_module_.ptr())));
 #endif
-        
+
         auto new_instance = command_module_.attr(class_name_.c_str())(bp::ptr(kernel), boost::ref(properties));
 
         if (!new_instance.is_none())
         {
-            CommandInterface* obj_pointer = bp::extract<CommandInterface*>(new_instance);
-            command.reset(obj_pointer, [new_instance] (CommandInterface*) {});
+            ++pool_->created;
+
+            bp::extract<BaseSwgCommand*> swg_command(new_instance);
+
+            if (kReuseInstances && swg_command.check())
+            {
+                instance.object = bp::incref(new_instance.ptr());
+                instance.command = swg_command();
+
+                command = InstancePool::Wrap(pool_, instance);
+            }
+            else
+            {
+                CommandInterface* obj_pointer = bp::extract<CommandInterface*>(new_instance);
+                command.reset(obj_pointer, [new_instance] (CommandInterface*) {});
+            }
         }
     }
     catch(bp::error_already_set& /*e*/)
@@ -65,3 +175,14 @@ std::shared_ptr<CommandInterface> PythonCommandCreator::operator() (
 
     return command;
 }
+
+size_t PythonCommandCreator::GetIdleCount() const
+{
+    boost::lock_guard<boost::mutex> lock(pool_->mutex);
+    return pool_->idle.size();
+}
+
+uint64_t PythonCommandCreator::GetCreatedCount() const
+{
+    return pool_->created;
+}
@@ -4,6 +4,7 @@
 #ifndef SWGANH_COMMAND_PYTHON_COMMAND_CREATOR_H_
 #define SWGANH_COMMAND_PYTHON_COMMAND_CREATOR_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -28,20 +29,49 @@ namespace command {
     class CommandInterface;
     struct CommandProperties;
 
+    /**
+     * Creates commands from a class defined in a python module.
+     *
+     * Instances of the class are kept in a pool once the command they were handed
+     * out for is released, and are reset and handed out again rather than creating
+     * a new python object for every request. Scripts should keep nothing specific
+     * to a single use of the command on the instance.
+     */
     class PythonCommandCreator
     {
     public:
-        PythonCommandCreator(std::string module_name, std::string class_name);
+        static const size_t kDefaultMaxIdle = 32;
+
+        /**
+         * @param module_name the module the command class is defined in.
+         * @param class_name the command class.
+         * @param max_idle the most released instances kept for reuse.
+         */
+        PythonCommandCreator(std::string module_name, std::string class_name, size_t max_idle = kDefaultMaxIdle);
 
         std::shared_ptr<CommandInterface> operator() (
             swganh::app::SwganhKernel* kernel,
             const CommandProperties& properties);
 
+        /**
+         * @return The number of released instances waiting to be reused.
+         */
+        size_t GetIdleCount() const;
+
+        /**
+         * @return The number of python instances created.
+         */
+        uint64_t GetCreatedCount() const;
+
     private:
+        struct InstancePool;
+
         std::string module_name_;
         std::string class_name_;
-        
+
         boost::python::object command_module_;
+
+        std::shared_ptr<InstancePool> pool_;
     };
 
 }}
@@ -0,0 +1,226 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <memory>
+#include <vector>
+#include <boost/chrono.hpp>
+#include <boost/python.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+
+#include "swganh/app/swganh_kernel.h"
+#include "swganh/command/base_combat_command.h"
+#include "swganh/command/base_swg_command.h"
+#include "swganh/command/combat_command_creator.h"
+#include "swganh/command/command_properties.h"
+#include "swganh/command/python_command_creator.h"
+#include "swganh/scripting/utilities.h"
+
+namespace bp = boost::python;
+using namespace std;
+using namespace swganh::command;
+using swganh::app::SwganhKernel;
+using swganh::scripting::GetGilTimings;
+using swganh::scripting::GilTimings;
+using swganh::scripting::ScopedGilLock;
+
+namespace {
+
+/// The simplest command a script can derive from.
+class TestCommand : public BaseSwgCommand {
+public:
+    TestCommand(SwganhKernel* kernel, const CommandProperties& properties)
+        : BaseSwgCommand(kernel, properties)
+    {}
+
+    boost::optional<shared_ptr<CommandCallback>> Run() {
+        return boost::optional<shared_ptr<CommandCallback>>();
+    }
+};
+
+}  // namespace
+
+BOOST_PYTHON_MODULE(command_test)
+{
+    bp::class_<SwganhKernel, boost::noncopyable>("SwganhKernel", bp::no_init);
+    bp::class_<CommandProperties>("CommandProperties", bp::no_init);
+    bp::class_<CommandInterface, boost::noncopyable>("CommandInterface", bp::no_init);
+    bp::class_<BaseSwgCommand, bp::bases<CommandInterface>, boost::noncopyable>("BaseSwgCommand", bp::no_init);
+    bp::class_<BaseCombatCommand, bp::bases<BaseSwgCommand>, boost::noncopyable>("BaseCombatCommand", bp::no_init);
+    bp::class_<TestCommand, bp::bases<BaseSwgCommand>, boost::noncopyable>("TestCommand",
+        bp::init<SwganhKernel*, const CommandProperties&>());
+}
+
+namespace {
+
+/// Starts python with the test module and the scripts the tests load, and leaves
+/// the GIL released the way the server runs.
+class PythonFixture {
+public:
+    PythonFixture() {
+        PyImport_AppendInittab("command_test", &PyInit_command_test);
+        Py_Initialize();
+
+        PyRun_SimpleString(
+            "import sys, types, command_test\n"
+            "scripts = types.ModuleType('test_scripts')\n"
+            "exec('''\n"
+            "import command_test\n"
+            "\n"
+            "class PythonTestCommand(command_test.TestCommand):\n"
+            "    pass\n"
+            "\n"
+            "class AttackCommand(command_test.BaseCombatCommand):\n"
+            "    min_damage = 10\n"
+            "    max_damage = 20\n"
+            "    damage_multiplier = 1.5\n"
+            "\n"
+            "class ScriptedAttackCommand(AttackCommand):\n"
+            "    def Run(self):\n"
+            "        pass\n"
+            "\n"
+            "class NotACombatCommand(command_test.TestCommand):\n"
+            "    pass\n"
+            "''', scripts.__dict__)\n"
+            "sys.modules['test_scripts'] = scripts\n");
+
+        state_ = PyEval_SaveThread();
+    }
+
+    ~PythonFixture() {
+        PyEval_RestoreThread(state_);
+    }
+
+private:
+    PyThreadState* state_;
+};
+
+BOOST_GLOBAL_FIXTURE(PythonFixture);
+
+class PythonCommandCreatorTests {
+protected:
+    PythonCommandCreatorTests() {
+        properties_.command_name = "test";
+    }
+
+    CommandProperties properties_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PythonCommandCreatorTest, PythonCommandCreatorTests)
+
+/// This test verifies that a released command's python instance is reset and handed out again.
+BOOST_AUTO_TEST_CASE(ReleasedInstancesAreReused) {
+    PythonCommandCreator creator("test_scripts", "PythonTestCommand");
+
+    CommandInterface* first_instance = nullptr;
+
+    {
+        auto command = creator(nullptr, properties_);
+        BOOST_REQUIRE(command);
+
+        swganh::messages::controllers::CommandQueueEnqueue request;
+        request.action_counter = 7;
+        static_pointer_cast<BaseSwgCommand>(command)->SetCommandRequest(request);
+
+        first_instance = command.get();
+    }
+
+    BOOST_CHECK_EQUAL(1, creator.GetIdleCount());
+
+    auto command = creator(nullptr, properties_);
+
+    BOOST_CHECK_EQUAL(first_instance, command.get());
+    BOOST_CHECK_EQUAL(0, static_pointer_cast<BaseSwgCommand>(command)->GetActionCounter());
+    BOOST_CHECK_EQUAL(1, creator.GetCreatedCount());
+}
+
+/// This test verifies that commands in use at the same time get their own instances.
+BOOST_AUTO_TEST_CASE(CommandsInUseAreNotShared) {
+    PythonCommandCreator creator("test_scripts", "PythonTestCommand", 1);
+
+    {
+        auto first = creator(nullptr, properties_);
+        auto second = creator(nullptr, properties_);
+
+        BOOST_CHECK(first.get() != second.get());
+    }
+
+    // only as many as asked for are kept
+    BOOST_CHECK_EQUAL(1, creator.GetIdleCount());
+    BOOST_CHECK_EQUAL(2, creator.GetCreatedCount());
+}
+
+/// This test verifies that combat commands only setting values are run natively.
+BOOST_AUTO_TEST_CASE(CombatCommandsWithValuesOnlyRunNatively) {
+    CombatCommandCreator creator("test_scripts", "AttackCommand");
+    BOOST_REQUIRE(!creator.IsOverridden());
+
+    auto command = dynamic_pointer_cast<NativeCombatCommand>(creator(nullptr, properties_));
+    BOOST_REQUIRE(command);
+
+    BOOST_CHECK_EQUAL(10, command->GetMinDamage());
+    BOOST_CHECK_EQUAL(20, command->GetMaxDamage());
+    BOOST_CHECK_CLOSE(1.5f, command->GetDamageMultiplier(), 0.001f);
+    BOOST_CHECK_EQUAL(0, command->GetAccuracyBonus());
+}
+
+/// This test verifies that combat commands overriding Run, and commands that aren't combat commands, run in python.
+BOOST_AUTO_TEST_CASE(OverriddenCombatCommandsRunInPython) {
+    BOOST_CHECK(CombatCommandCreator("test_scripts", "ScriptedAttackCommand").IsOverridden());
+    BOOST_CHECK(CombatCommandCreator("test_scripts", "NotACombatCommand").IsOverridden());
+}
+
+/// Creates and releases 100000 commands with a new python instance for each, with
+/// pooled python instances and natively, and reports the commands created per second
+/// and the time the GIL is held per command.
+BOOST_AUTO_TEST_CASE(CommandsPerSecond) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t command_count = 100000;
+
+    typedef boost::chrono::high_resolution_clock clock;
+
+    auto run = [&] (function<shared_ptr<CommandInterface> ()> create, double& gil_us_per_command) -> double {
+        GilTimings before = GetGilTimings();
+        auto start = clock::now();
+
+        for (uint32_t i = 0; i < command_count; ++i) {
+            auto command = create();
+            BOOST_REQUIRE(command);
+        }
+
+        double seconds = boost::chrono::duration<double>(clock::now() - start).count();
+        GilTimings after = GetGilTimings();
+
+        gil_us_per_command = static_cast<double>(after.hold_microseconds - before.hold_microseconds) / command_count;
+
+        return command_count / seconds;
+    };
+
+    PythonCommandCreator unpooled("test_scripts", "PythonTestCommand", 0);
+    PythonCommandCreator pooled("test_scripts", "PythonTestCommand");
+    CombatCommandCreator native("test_scripts", "AttackCommand");
+
+    double unpooled_gil, pooled_gil, native_gil;
+    double unpooled_rate = run([&] () { return unpooled(nullptr, properties_); }, unpooled_gil);
+    double pooled_rate = run([&] () { return pooled(nullptr, properties_); }, pooled_gil);
+    double native_rate = run([&] () { return native(nullptr, properties_); }, native_gil);
+
+    BOOST_CHECK_EQUAL(1, pooled.GetCreatedCount());
+    BOOST_CHECK(pooled_gil < unpooled_gil);
+
+    BOOST_TEST_MESSAGE(command_count << " commands created and released");
+    BOOST_TEST_MESSAGE("New python instance: " << static_cast<uint64_t>(unpooled_rate) << " commands/s, "
+        << unpooled_gil << "us GIL held per command");
+    BOOST_TEST_MESSAGE("Pooled instances:    " << static_cast<uint64_t>(pooled_rate) << " commands/s, "
+        << pooled_gil << "us GIL held per command");
+    BOOST_TEST_MESSAGE("Native combat:       " << static_cast<uint64_t>(native_rate) << " commands/s, "
+        << native_gil << "us GIL held per command");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
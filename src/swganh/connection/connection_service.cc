@@ -4,7 +4,6 @@
 #include "swganh/connection/connection_service.h"
 
 #include <boost/bind.hpp>
-#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/lexical_cast.hpp>
 #include "anh/logger.h"
 
@@ -54,10 +53,12 @@ ConnectionService::ConnectionService(
     : swganh::network::BaseSwgServer(kernel->GetIoService())
     , kernel_(kernel)
     , ping_server_(nullptr)
-    , active_(kernel->GetIoService())
     , listen_address_(listen_address)
     , listen_port_(listen_port)
     , ping_port_(ping_port)
+    , delayed_acks_(false)
+    , compression_level_(6)
+    , compression_threshold_(max_receive_size() - 20)
 {
 
     session_provider_ = kernel_->GetPluginManager()->CreateObject<providers::SessionProviderInterface>("Login::SessionProvider");
@@ -66,9 +67,7 @@ ConnectionService::ConnectionService(
 }
 
 ConnectionService::~ConnectionService()
-{
-    session_timer_->cancel();
-}
+{}
 
 ServiceDescription ConnectionService::GetServiceDescription() {
     auto listen_address = Resolve(listen_address_);
@@ -96,17 +95,6 @@ void ConnectionService::Startup() {
     RegisterMessageHandler(&ConnectionService::HandleCmdSceneReady_, this);
 
     Server::Startup(listen_port_);
-
-    session_timer_ = active_.AsyncRepeated(boost::posix_time::milliseconds(5), [this] () {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        for_each(
-            begin(session_map_),
-            end(session_map_),
-            [=] (SessionMap::value_type& type)
-        {
-            type.second->Update();
-        });
-    });
 }
 
 void ConnectionService::Shutdown() {
@@ -121,30 +109,59 @@ uint16_t ConnectionService::listen_port() {
     return listen_port_;
 }
 
+bool ConnectionService::delayed_acks() const {
+    return delayed_acks_;
+}
+
+void ConnectionService::delayed_acks(bool delayed_acks) {
+    delayed_acks_ = delayed_acks;
+}
+
+int ConnectionService::compression_level() const {
+    return compression_level_;
+}
+
+void ConnectionService::compression_level(int compression_level) {
+    compression_level_ = compression_level;
+}
+
+uint32_t ConnectionService::compression_threshold() const {
+    return compression_threshold_;
+}
+
+void ConnectionService::compression_threshold(uint32_t compression_threshold) {
+    compression_threshold_ = compression_threshold;
+}
+
 shared_ptr<Session> ConnectionService::CreateSession(const udp::endpoint& endpoint)
 {
-    shared_ptr<ConnectionClient> session = nullptr;
-
+    return sessions_.FindOrInsert(endpoint, [this] (const udp::endpoint& endpoint) -> shared_ptr<ConnectionClient>
     {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        if (session_map_.find(endpoint) == session_map_.end())
-        {
-            session = make_shared<ConnectionClient>(this, kernel_->GetIoService(), endpoint);
-            session_map_.insert(make_pair(endpoint, session));
-        }
-    }
+        auto session = make_shared<ConnectionClient>(this, kernel_->GetIoService(), endpoint);
+        session->delayed_acks(delayed_acks_);
+        session->compression_level(compression_level_);
+        session->compression_threshold(compression_threshold_);
 
-    return session;
+        return session;
+    });
 }
 
 bool ConnectionService::RemoveSession(std::shared_ptr<Session> session) {
-    {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        session_map_.erase(session->remote_endpoint());
-    }
+    sessions_.Erase(session->remote_endpoint());
 
     auto connection_client = static_pointer_cast<ConnectionClient>(session);
 
+    {
+        boost::unique_lock<boost::shared_mutex> lock(player_index_mutex_);
+
+        // a newer session may have taken over the player already
+        auto find_iter = player_index_.find(connection_client->GetPlayerId());
+        if (find_iter != player_index_.end() && find_iter->second == connection_client)
+        {
+            player_index_.erase(find_iter);
+        }
+    }
+
     auto controller = connection_client->GetController();
     if (controller)
     {
@@ -161,14 +178,10 @@ bool ConnectionService::RemoveSession(std::shared_ptr<Session> session) {
 }
 
 shared_ptr<Session> ConnectionService::GetSession(const udp::endpoint& endpoint) {
+    auto session = sessions_.Find(endpoint);
+    if (session)
     {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-
-        auto find_iter = session_map_.find(endpoint);
-        if (find_iter != session_map_.end())
-        {
-            return find_iter->second;
-        }
+        return session;
     }
 
     return CreateSession(endpoint);
@@ -176,26 +189,15 @@ shared_ptr<Session> ConnectionService::GetSession(const udp::endpoint& endpoint)
 
 std::shared_ptr<ConnectionClient> ConnectionService::FindConnectionByPlayerId(uint64_t player_id)
 {
-    shared_ptr<ConnectionClient> connection = nullptr;
+    boost::shared_lock<boost::shared_mutex> lock(player_index_mutex_);
 
+    auto find_iter = player_index_.find(player_id);
+    if (find_iter == player_index_.end())
     {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-
-        auto find_iter = find_if(
-            begin(session_map_),
-            end(session_map_),
-            [player_id] (SessionMap::value_type& item)
-        {
-            return item.second->GetPlayerId() == player_id;
-        });
-
-        if (find_iter != end(session_map_))
-        {
-            connection = find_iter->second;
-        }
+        return nullptr;
     }
 
-    return connection;
+    return find_iter->second;
 }
 
 void ConnectionService::HandleCmdSceneReady_(
@@ -249,6 +251,11 @@ void ConnectionService::HandleClientIdMsg_(
 
     client->Connect(account_id, player_id);
 
+    {
+        boost::unique_lock<boost::shared_mutex> lock(player_index_mutex_);
+        player_index_[player_id] = client;
+    }
+
     ClientPermissionsMessage client_permissions;
     client_permissions.galaxy_available = kernel_->GetServiceDirectory()->galaxy().status();
     client_permissions.available_character_slots = static_cast<uint8_t>(character_provider_->GetMaxCharacters(account_id));
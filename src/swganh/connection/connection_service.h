@@ -9,13 +9,13 @@
 #include <string>
 #include <unordered_map>
 
-#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
 
-#include "anh/active_object.h"
 #include "anh/hash_string.h"
 
 #include "anh/network/soe/packet_utilities.h"
 #include "anh/network/soe/session.h"
+#include "anh/network/soe/session_table.h"
 #include "anh/service/service_interface.h"
 
 #include "swganh/network/base_swg_server.h"
@@ -75,6 +75,15 @@ public:
     const std::string& listen_address();
 
     uint16_t listen_port();
+
+    bool delayed_acks() const;
+    void delayed_acks(bool delayed_acks);
+
+    int compression_level() const;
+    void compression_level(int compression_level);
+
+    uint32_t compression_threshold() const;
+    void compression_threshold(uint32_t compression_threshold);
         
 private:        
     std::shared_ptr<anh::network::soe::Session> CreateSession(const boost::asio::ip::udp::endpoint& endpoint);
@@ -87,13 +96,15 @@ private:
         const std::shared_ptr<ConnectionClient>& client, 
         swganh::messages::CmdSceneReady message);
    
-    typedef std::map<
-        boost::asio::ip::udp::endpoint,
+    anh::network::soe::SessionTable<ConnectionClient> sessions_;
+
+    typedef std::unordered_map<
+        uint64_t,
         std::shared_ptr<ConnectionClient>
-    > SessionMap;
-    
-    boost::mutex session_map_mutex_;
-    SessionMap session_map_;
+    > PlayerIndex;
+
+    boost::shared_mutex player_index_mutex_;
+    PlayerIndex player_index_;
 
     swganh::app::SwganhKernel* kernel_;
     std::shared_ptr<PingServer> ping_server_;
@@ -105,11 +116,12 @@ private:
     swganh::login::LoginService* login_service_;
     swganh::simulation::SimulationServiceInterface* simulation_service_;
 
-    anh::ActiveObject active_;
     std::string listen_address_;
     uint16_t listen_port_;
     uint16_t ping_port_;
-    std::shared_ptr<boost::asio::deadline_timer> session_timer_;
+    bool delayed_acks_;
+    int compression_level_;
+    uint32_t compression_threshold_;
 };
     
 }}  // namespace swganh::connection
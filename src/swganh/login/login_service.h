@@ -7,13 +7,12 @@
 #include <unordered_map>
 
 #include <boost/asio.hpp>
-#include <boost/thread/mutex.hpp>
 
-#include "anh/active_object.h"
 #include "anh/logger.h"
 
 #include "anh/network/soe/packet_utilities.h"
 #include "anh/network/soe/server.h"
+#include "anh/network/soe/session_table.h"
 #include "anh/service/service_interface.h"
 
 #include "swganh/network/base_swg_server.h"
@@ -98,13 +97,7 @@ private:
     std::vector<GalaxyStatus> GetGalaxyStatus_();
     void UpdateGalaxyStatus_();
     
-    typedef std::map<
-        boost::asio::ip::udp::endpoint,
-        std::shared_ptr<LoginClient>
-    > SessionMap;
-    
-    boost::mutex session_map_mutex_;
-    SessionMap session_map_;
+    anh::network::soe::SessionTable<LoginClient> sessions_;
 
     swganh::app::SwganhKernel* kernel_;
     swganh::character::CharacterServiceInterface* character_service_;
@@ -120,11 +113,9 @@ private:
     int galaxy_status_check_duration_secs_;
     int login_error_timeout_secs_;
     boost::asio::deadline_timer galaxy_status_timer_;
-    std::shared_ptr<boost::asio::deadline_timer> session_timer_;
     
     std::string listen_address_;
     uint16_t listen_port_;
-    anh::ActiveObject active_;
 };
 
 }} // namespace swganh::login
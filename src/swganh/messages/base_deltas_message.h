@@ -16,12 +16,20 @@ namespace messages {
     template<typename T>
     struct BaseDeltasMessage : public BaseSwgMessage<T>
     {    
+        BaseDeltasMessage()
+            : sequenced(false)
+        {}
+
         uint64_t object_id;
         uint32_t object_type;
         uint8_t view_type;
         uint16_t update_count;
         uint16_t update_type;
         anh::ByteBuffer data;
+
+        /// Set by the network containers, their updates carry a counter the client checks
+        /// so they can't be replaced by a later update to the same member. Not serialized.
+        bool sequenced;
     
         void OnSerialize(anh::ByteBuffer& buffer) const
         {
@@ -124,6 +124,8 @@ public:
 
     void Serialize(swganh::messages::DeltasMessage& message)
     {
+        message.sequenced = true;
+
         message.data.write<uint32_t>(added_items_.size() + removed_items_.size());
         message.data.write<uint32_t>(++update_counter_);
 
@@ -176,6 +176,8 @@ public:
 
     void Serialize(swganh::messages::DeltasMessage& message)
     {
+        message.sequenced = true;
+
         uint32_t size = items_added_.size() + items_removed_.size() + items_changed_.size() + reinstall_ + clear_;
         message.data.write<uint32_t>(size);
         message.data.write<uint32_t>(++update_counter_);
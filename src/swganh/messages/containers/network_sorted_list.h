@@ -182,6 +182,8 @@ public:
 
     void Serialize(swganh::messages::DeltasMessage& message)
     {
+        message.sequenced = true;
+
         message.data.write<uint32_t>(items_added_.size() + items_removed_.size() + items_changed_.size() + clear_ + reinstall_);
         message.data.write<uint32_t>(++update_counter_);
 
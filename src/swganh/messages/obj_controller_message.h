@@ -19,6 +19,10 @@ namespace messages {
         static uint16_t Opcount() { return 5; }
         static uint32_t Opcode() { return 0x80CE5E46; }
 
+        /// Offset of observable_id in the serialized message (after the opcount, opcode,
+        /// controller_type and message_type).
+        static int32_t ObservableIdOffset() { return 14; }
+
         ObjControllerMessage()
         {}
 
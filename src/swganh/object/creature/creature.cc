@@ -75,7 +75,7 @@ uint32_t Creature::GetType() const
 void Creature::SetBankCredits(uint32_t bank_credits)
 {
     bank_credits_ = bank_credits;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Bank", static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -87,7 +87,7 @@ uint32_t Creature::GetBankCredits(void)
 void Creature::SetCashCredits(uint32_t cash_credits)
 {
     cash_credits = cash_credits;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Cash",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -102,7 +102,7 @@ void Creature::SetStatBase(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_base_list_.Update(stat_index, Stat(value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatBase",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -113,7 +113,7 @@ void Creature::AddStatBase(StatIndex stat_index, int32_t value)
         uint32_t new_stat = stat_base_list_[stat_index].value + value;
         stat_base_list_.Update(stat_index, Stat(new_stat));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatBase",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -132,7 +132,7 @@ void Creature::DeductStatBase(StatIndex stat_index, int32_t value)
         }
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatBase",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -155,7 +155,7 @@ void Creature::AddSkill(std::string skill)
         skills_.Add(Skill(skill));
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Skill",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -175,7 +175,7 @@ void Creature::RemoveSkill(std::string skill)
         skills_.Remove(iter);
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Skill",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -238,7 +238,7 @@ void  Creature::RemoveSkillCommand(std::string skill_command)
 void Creature::SetPosture(Posture posture)
 {
     posture_ = posture;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Posture",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -260,7 +260,7 @@ bool Creature::IsIncapacitated()
 void Creature::SetFactionRank(uint8_t faction_rank)
 {
     faction_rank_ = faction_rank;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::FactionRank",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -272,7 +272,7 @@ uint8_t Creature::GetFactionRank(void)
 void Creature::SetOwnerId(uint64_t owner_id)
 {
     owner_id_ = owner_id;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::OwnerId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -288,7 +288,7 @@ void Creature::SetScale(float scale)
         scale_ = scale;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Scale",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -302,13 +302,13 @@ void Creature::SetBattleFatigue(uint32_t battle_fatigue)
 {
     battle_fatigue_ = battle_fatigue;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::BattleFatigue",static_pointer_cast<Creature>(shared_from_this())));
 }
 void Creature::AddBattleFatigue(uint32_t battle_fatigue)
 {
     battle_fatigue += battle_fatigue;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::BattleFatigue",static_pointer_cast<Creature>(shared_from_this())));
 }
 uint32_t Creature::GetBattleFatigue(void)
@@ -319,7 +319,7 @@ uint32_t Creature::GetBattleFatigue(void)
 void Creature::SetStateBitmask(uint64_t state_bitmask)
 {
     state_bitmask_ = state_bitmask;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StateBitmask",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -335,21 +335,21 @@ void Creature::ToggleStateOn(uint64_t state)
 {
     state_bitmask_ = ( state_bitmask_ | state);
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StateBitmask",static_pointer_cast<Creature>(shared_from_this())));
 }
 void Creature::ToggleStateOff(uint64_t state)
 {
     state_bitmask_ = ( state_bitmask_ & ~ state);
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StateBitmask",static_pointer_cast<Creature>(shared_from_this())));
 }
 void Creature::ToggleStateBitmask(uint64_t state_bitmask)
 {
     state_bitmask_ = (state_bitmask_ ^ state_bitmask);
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StateBitmask",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -360,7 +360,7 @@ void Creature::SetStatWound(StatIndex stat_index, int32_t value)
         stat_wound_list_.Update(stat_index, Stat(value));
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatWound",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -371,7 +371,7 @@ void Creature::AddStatWound(StatIndex stat_index, int32_t value)
         int32_t new_stat = stat_wound_list_[stat_index].value + value;
         stat_wound_list_.Update(stat_index, Stat(new_stat));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatWound",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -390,7 +390,7 @@ void Creature::DeductStatWound(StatIndex stat_index, int32_t value)
         }
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatWound",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -413,7 +413,7 @@ void Creature::SetAccelerationMultiplierBase(float acceleration_multiplier_base)
         acceleration_multiplier_base_ = acceleration_multiplier_base;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::AccelerationMultiplierBase",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -430,7 +430,7 @@ void Creature::SetAccelerationMultiplierModifier(float acceleration_multiplier_m
         acceleration_multiplier_modifier_ = acceleration_multiplier_modifier;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::AccelerationMultiplierModifier",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -446,7 +446,7 @@ void Creature::SetStatEncumberance(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_encumberance_list_.Update(stat_index, Stat(value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatEncumberance",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -457,7 +457,7 @@ void Creature::AddStatEncumberance(StatIndex stat_index, int32_t value)
         int32_t new_stat = stat_encumberance_list_[stat_index].value + value;
         stat_encumberance_list_.Update(stat_index, Stat(new_stat));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatEncumberance",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -475,7 +475,7 @@ void Creature::DeductStatEncumberance(StatIndex stat_index, int32_t value)
             stat_encumberance_list_.Update(stat_index, Stat(0));
         }
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatEncumberance",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -497,7 +497,7 @@ void Creature::AddSkillMod(SkillMod mod)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         skill_mod_list_.Add(mod.identifier, mod);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::SkillMod",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -517,7 +517,7 @@ void Creature::RemoveSkillMod(std::string identifier)
         skill_mod_list_.Remove(iter);
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::SkillMod",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -527,7 +527,7 @@ void Creature::SetSkillMod(SkillMod mod)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         skill_mod_list_.Update(mod.identifier, mod);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::SkillMod",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -537,7 +537,7 @@ void Creature::ClearSkillMods(void)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         skill_mod_list_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::SkillMod",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -566,7 +566,7 @@ void Creature::SetSpeedMultiplierBase(float speed_multiplier_base)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         speed_multiplier_base_ = speed_multiplier_base;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::SpeedMultiplierBase",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -582,7 +582,7 @@ void Creature::SetSpeedMultiplierModifier(float speed_multiplier_modifier)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         speed_multiplier_modifier_ = speed_multiplier_modifier;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::SpeedMultiplierModifer",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -596,7 +596,7 @@ void Creature::SetListenToId(uint64_t listen_to_id)
 {
     listen_to_id_ = listen_to_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::ListenToId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -611,7 +611,7 @@ void Creature::SetRunSpeed(float run_speed)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         run_speed_ = run_speed;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::RunSpeed",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -627,7 +627,7 @@ void Creature::SetSlopeModifierAngle(float slope_modifier_angle)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         slope_modifier_angle_ = slope_modifier_angle;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::SlopeModifierAngle",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -643,7 +643,7 @@ void Creature::SetSlopeModifierPercent(float slope_modifier_percent)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         slope_modifier_percent_ = slope_modifier_percent;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::SlopeModifierPercent",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -659,7 +659,7 @@ void Creature::SetTurnRadius(float turn_radius)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         turn_radius_ = turn_radius;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::TurnRadius",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -675,7 +675,7 @@ void Creature::SetWalkingSpeed(float walking_speed)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         walking_speed_ = walking_speed;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::WalkingSpeed",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -691,7 +691,7 @@ void Creature::SetWaterModifierPercent(float water_modifier_percent)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         water_modifier_percent_ = water_modifier_percent;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::WaterModifierPercent",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -707,7 +707,7 @@ void Creature::AddMissionCriticalObject(MissionCriticalObject& object)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         mission_critical_object_list_.Add(object);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::MissionCriticalObject",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -732,7 +732,7 @@ void Creature::RemoveMissionCriticalObject(uint64_t mission_owner, uint64_t obje
 
         mission_critical_object_list_.Remove(iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::MissionCriticalObject",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -765,7 +765,7 @@ void Creature::SetCombatLevel(uint16_t combat_level)
 {
     combat_level_ = combat_level;
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::CombatLevel",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -780,7 +780,7 @@ void Creature::SetAnimation(std::string animation)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         animation_ = animation;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Animation",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -796,7 +796,7 @@ void Creature::SetMoodAnimation(std::string mood_animation)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         mood_animation_ = mood_animation;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::MoodAnimation",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -810,7 +810,7 @@ void Creature::SetWeaponId(uint64_t weapon_id)
 {
     weapon_id_ = weapon_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::WeaponId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -823,7 +823,7 @@ void Creature::SetGroupId(uint64_t group_id)
 {
     group_id_ = group_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::GroupId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -836,7 +836,7 @@ void Creature::SetInviteSenderId(uint64_t invite_sender_id)
 {
     invite_sender_id_ = invite_sender_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::InviteSenderId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -864,7 +864,7 @@ void Creature::SetGuildId(uint32_t guild_id)
 {
     guild_id_ = guild_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::GuildId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -877,7 +877,7 @@ void Creature::SetTargetId(uint64_t target_id)
 {
     target_id_ = target_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::TargetId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -890,7 +890,7 @@ void Creature::SetMoodId(uint8_t mood_id)
 {
     mood_id_ = mood_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::MoodId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -903,7 +903,7 @@ void Creature::SetPerformanceId(uint32_t performance_id)
 {
     performance_id_ = performance_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::PerformanceId",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -933,7 +933,7 @@ void Creature::SetStatCurrent(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_current_list_.Update(stat_index, Stat(value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatCurrent",static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this()))));
 }
 
@@ -944,7 +944,7 @@ void Creature::AddStatCurrent(StatIndex stat_index, int32_t value)
         int32_t new_value = stat_current_list_[stat_index].value + value;
         stat_current_list_.Update(stat_index, Stat(new_value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatCurrent",static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this()))));
 }
 
@@ -962,7 +962,7 @@ void Creature::DeductStatCurrent(StatIndex stat_index, int32_t value)
             stat_current_list_.Update(stat_index, Stat(0));
         }
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatCurrent",static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this()))));
 }
 
@@ -984,7 +984,7 @@ void Creature::SetStatMax(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_max_list_.Update(stat_index, Stat(value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatMax",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -994,7 +994,7 @@ void Creature::AddStatMax(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_max_list_.Update(stat_index, Stat(stat_max_list_.At(stat_index).value + value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatMax",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1012,7 +1012,7 @@ void Creature::DeductStatMax(StatIndex stat_index, int32_t value)
             stat_max_list_.Update(stat_index, Stat(0));
         }
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::StatMax",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1035,7 +1035,7 @@ void Creature::AddEquipmentItem(EquipmentItem& item)
         equipment_list_.Add(item);
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::EquipmentItem",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1053,7 +1053,7 @@ void Creature::RemoveEquipmentItem(uint64_t object_id)
         }
         equipment_list_.Remove(iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::EquipmentItem",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1065,7 +1065,7 @@ void Creature::UpdateEquipmentItem(EquipmentItem& item)
         if(iter != end(equipment_list_))
             equipment_list_.Update(iter->first, item);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::EquipmentItem",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1095,7 +1095,7 @@ void Creature::SetDisguise(std::string disguise)
         disguise_ = disguise;
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Disguise",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1109,7 +1109,7 @@ void Creature::SetStationary(bool stationary)
 {
     stationary_ = stationary;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::Stationary",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1130,7 +1130,7 @@ void Creature::SetPvPStatus(PvpStatus status)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         pvp_status_ = status;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::PvPStatus",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1140,7 +1140,7 @@ void Creature::TogglePvpStateOn(PvpStatus state)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         pvp_status_ = static_cast<PvpStatus>(pvp_status_ | state);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::PvPStatus",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1150,7 +1150,7 @@ void Creature::TogglePvpStateOff(PvpStatus state)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         pvp_status_ = static_cast<PvpStatus>(pvp_status_ & ~state);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::PvPStatus",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1160,7 +1160,7 @@ void Creature::TogglePvpState(PvpStatus state)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         pvp_status_ = static_cast<PvpStatus>(pvp_status_ ^ state);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
+    PostEvent(make_shared<CreatureEvent>
         ("Creature::PvPStatus",static_pointer_cast<Creature>(shared_from_this())));
 }
 
@@ -1226,6 +1226,22 @@ shared_ptr<Player> Creature::GetPlayer()
 
 void Creature::CreateBaselines(std::shared_ptr<ObjectController> controller)
 {
-    GetEventDispatcher()->Dispatch(make_shared<swganh::object::ControllerEvent>
+    PostEvent(make_shared<swganh::object::ControllerEvent>
         ("Creature::Baselines", shared_from_this(), controller));
 }
+
+void Creature::OnHydrated()
+{
+    Tangible::OnHydrated();
+
+    boost::lock_guard<boost::mutex> lock(creature_mutex_);
+    stat_base_list_.ClearDeltas();
+    skills_.ClearDeltas();
+    stat_wound_list_.ClearDeltas();
+    stat_encumberance_list_.ClearDeltas();
+    skill_mod_list_.ClearDeltas();
+    mission_critical_object_list_.ClearDeltas();
+    stat_current_list_.ClearDeltas();
+    stat_max_list_.ClearDeltas();
+    equipment_list_.ClearDeltas();
+}
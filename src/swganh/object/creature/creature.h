@@ -602,6 +602,8 @@ public:
     std::shared_ptr<swganh::object::player::Player> GetPlayer();
 
     typedef anh::ValueEvent<std::shared_ptr<Creature>> CreatureEvent;
+protected:
+    virtual void OnHydrated();
 private:
     mutable boost::mutex creature_mutex_;
 
@@ -46,11 +46,15 @@ void CreatureFactory::PersistObject(const shared_ptr<Object>& object)
     // Now for the biggy
     try
     {
-        auto conn = db_manager_->getConnection("galaxy");
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
         // 65 of these
         string sql = "CALL sp_PersistCreature(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,"
             "?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);";
-        auto statement = unique_ptr<sql::PreparedStatement>(conn->prepareStatement(sql));
+        auto statement = db_manager_->getPreparedStatement(conn, sql);
         auto creature = static_pointer_cast<Creature>(object);
         statement->setUInt64(1, creature->GetObjectId());
         statement->setUInt64(2, creature->GetOwnerId());
@@ -126,6 +130,7 @@ void CreatureFactory::PersistObject(const shared_ptr<Object>& object)
     }
     catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -138,8 +143,19 @@ shared_ptr<Object> CreatureFactory::CreateObjectFromStorage(uint64_t object_id)
 {
     auto creature = make_shared<Creature>();
     creature->SetObjectId(object_id);
+    creature->SetEventDispatcher(event_dispatcher_);
+    creature->BeginHydration();
+
+    ContainedObjectList contained_objects;
+
     try {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            creature->EndHydration();
+            return creature;
+        }
+
         auto statement = shared_ptr<sql::Statement>(conn->createStatement());
         unique_ptr<sql::ResultSet> result;
         stringstream ss;
@@ -234,13 +250,19 @@ shared_ptr<Object> CreatureFactory::CreateObjectFromStorage(uint64_t object_id)
         LoadSkillMods_(creature, statement);
         LoadSkillCommands_(creature, statement);
 
-        LoadContainedObjects(creature, statement);
+        contained_objects = ReadContainedObjects(statement);
     }
     catch(sql::SQLException &e)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
+
+    // the connection is back in the pool by now, the contained objects take their own
+    LoadContainedObjects(creature, contained_objects);
+
+    creature->EndHydration();
+
     return creature;
 }
 
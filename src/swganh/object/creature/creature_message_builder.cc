@@ -224,16 +224,20 @@ void CreatureMessageBuilder::RegisterEventHandlers()
 }
 void CreatureMessageBuilder::SendBaselines(const shared_ptr<Creature>& creature, const shared_ptr<ObjectController>& controller)
 {
-    creature->AddBaselineToCache(BuildBaseline1(creature));
-    creature->AddBaselineToCache(BuildBaseline3(creature));
-    creature->AddBaselineToCache(BuildBaseline4(creature));
-    creature->AddBaselineToCache(BuildBaseline6(creature));
-    for (auto& baseline : creature->GetBaselines())
-    {
-        controller->Notify(baseline);
-    }
+    if (!creature->SendCachedBaselines(controller))
+    {
+        creature->ClearBaselines();
+        creature->AddBaselineToCache(BuildBaseline1(creature));
+        creature->AddBaselineToCache(BuildBaseline3(creature));
+        creature->AddBaselineToCache(BuildBaseline4(creature));
+        creature->AddBaselineToCache(BuildBaseline6(creature));
+        for (auto& baseline : creature->GetBaselines())
+        {
+            controller->Notify(baseline);
+        }
         
-    SendEndBaselines(creature, controller);
+        SendEndBaselines(creature, controller);
+    }
 
     BuildUpdatePvpStatusMessage(creature);
 }
@@ -26,7 +26,7 @@ public:
     }
     virtual void RegisterEventHandlers();
     virtual void SendBaselines(const std::shared_ptr<Creature>& creature, const std::shared_ptr<ObjectController>& controller);
-private:
+
     // deltas
     static void BuildBankCreditsDelta(const std::shared_ptr<Creature>& creature);
     static void BuildCashCreditsDelta(const std::shared_ptr<Creature>& creature);
@@ -77,6 +77,7 @@ private:
     static swganh::messages::BaselinesMessage BuildBaseline4(const std::shared_ptr<Creature>& creature);
     static swganh::messages::BaselinesMessage BuildBaseline6(const std::shared_ptr<Creature>& creature);
 
+private:
     typedef anh::ValueEvent<std::shared_ptr<Creature>> CreatureEvent;
 };
 
@@ -35,7 +35,7 @@ void Group::AddGroupMember(uint64_t member, std::string name)
     boost::lock_guard<boost::mutex> lock(group_mutex_);
     member_list_.Add(Member(member, name));
     
-    GetEventDispatcher()->Dispatch(make_shared<GroupEvent>
+    PostEvent(make_shared<GroupEvent>
         ("Group::Member",static_pointer_cast<Group>(shared_from_this())));
 }
 
@@ -53,7 +53,7 @@ void Group::RemoveGroupMember(uint64_t member)
         
     member_list_.Remove(iter);
     
-    GetEventDispatcher()->Dispatch(make_shared<GroupEvent>
+    PostEvent(make_shared<GroupEvent>
         ("Group::Member",static_pointer_cast<Group>(shared_from_this())));
 }
     
@@ -67,7 +67,7 @@ void Group::SetLootMode(LootMode loot_mode)
 {
     loot_mode_ = loot_mode;
 
-    GetEventDispatcher()->Dispatch(make_shared<GroupEvent>
+    PostEvent(make_shared<GroupEvent>
         ("Group::LootMode",static_pointer_cast<Group>(shared_from_this())));
 }
 
@@ -81,7 +81,7 @@ void Group::SetDifficulty(uint16_t difficulty)
 {
     difficulty_ = difficulty;
 
-    GetEventDispatcher()->Dispatch(make_shared<GroupEvent>
+    PostEvent(make_shared<GroupEvent>
         ("Group::Difficulty",static_pointer_cast<Group>(shared_from_this())));
 }
 
@@ -94,7 +94,7 @@ void Group::SetLootMaster(uint64_t loot_master)
 {
     loot_master_ = loot_master;
 
-    GetEventDispatcher()->Dispatch(make_shared<GroupEvent>
+    PostEvent(make_shared<GroupEvent>
         ("Group::LootMaster",static_pointer_cast<Group>(shared_from_this())));
 }
 
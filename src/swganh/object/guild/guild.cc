@@ -35,7 +35,7 @@ void Guild::AddGuildTag(uint32_t guild_id, std::string guild_tag)
 
     guild_list_.Add(GuildTag(guild_id, guild_tag));
         
-    GetEventDispatcher()->Dispatch(make_shared<GuildEvent>
+    PostEvent(make_shared<GuildEvent>
         ("Guild::Orientation",static_pointer_cast<Guild>(shared_from_this())));
 }
 
@@ -53,7 +53,7 @@ void Guild::RemoveGuildTag(uint32_t guild_id)
 
     guild_list_.Remove(iter);
     
-    GetEventDispatcher()->Dispatch(make_shared<GuildEvent>
+    PostEvent(make_shared<GuildEvent>
         ("Guild::Orientation",static_pointer_cast<Guild>(shared_from_this())));
 }
     
@@ -34,6 +34,10 @@ void IntangibleFactory::LoadTemplates()
     try {
 
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         auto statement = conn->prepareStatement("CALL sp_GetIntangibleTemplates();");
         auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
 
@@ -70,8 +74,12 @@ void IntangibleFactory::PersistObject(const shared_ptr<Object>& object)
     {
         try 
         {
-            auto conn = db_manager_->getConnection("galaxy");
-            auto statement = conn->prepareStatement("CALL sp_PersistIntangible(?,?);");
+            auto conn = GetPersistConnection();
+            if (!conn)
+            {
+                return;
+            }
+            auto statement = db_manager_->getPreparedStatement(conn, "CALL sp_PersistIntangible(?,?);");
             
             auto intangible = make_shared<Intangible>();
             statement->setString(1, intangible->GetStfDetailFile());
@@ -80,6 +88,7 @@ void IntangibleFactory::PersistObject(const shared_ptr<Object>& object)
         }
             catch(sql::SQLException &e)
         {
+            RethrowIfPersistingBatch();
             LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
             LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
         }
@@ -91,6 +100,10 @@ void IntangibleFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         auto statement = conn->prepareStatement("CALL sp_DeleteIntangible(?);");
         statement->setUInt64(1, object->GetObjectId());
         statement->execute();
@@ -106,8 +119,16 @@ shared_ptr<Object> IntangibleFactory::CreateObjectFromStorage(uint64_t object_id
 {
     auto intangible = make_shared<Intangible>();
     intangible->SetObjectId(object_id);
+    intangible->SetEventDispatcher(event_dispatcher_);
+    intangible->BeginHydration();
+
     try {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            intangible->EndHydration();
+            return intangible;
+        }
         auto statement = shared_ptr<sql::Statement>(conn->createStatement());
         
         stringstream ss;
@@ -130,6 +151,8 @@ shared_ptr<Object> IntangibleFactory::CreateObjectFromStorage(uint64_t object_id
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
+    intangible->EndHydration();
+
     return intangible;
 }
 
@@ -3,6 +3,8 @@
 
 #include "object.h"
 
+#include <algorithm>
+
 #include <glm/gtx/transform2.hpp>
 
 #include "object_events.h"
@@ -29,6 +31,9 @@ Object::Object()
     , stf_name_string_("")
     , custom_name_(L"")
     , volume_(0)
+    , deltas_(deltas_cache_capacity)
+    , deltas_sequence_(0)
+    , hydrating_(false)
 {
 }
 
@@ -145,7 +150,7 @@ void Object::RemoveAwareObject(const shared_ptr<Object>& object)
 	    boost::lock_guard<boost::mutex> lock(object_mutex_);
         auto find_iter = aware_objects_.find(object->GetObjectId());
 
-        if (find_iter != aware_objects_.end())
+        if (find_iter == aware_objects_.end())
         {
             return;
         }
@@ -153,9 +158,9 @@ void Object::RemoveAwareObject(const shared_ptr<Object>& object)
         aware_objects_.erase(find_iter);
     }
 
-    if (HasController())
+    if (object->HasController())
     {
-        object->Unsubscribe(GetController());
+        Unsubscribe(object->GetController());
     }
 }
 string Object::GetTemplate()
@@ -169,7 +174,7 @@ void Object::SetTemplate(const string& template_string)
         boost::lock_guard<boost::mutex> lock(object_mutex_);
 	    template_string_ = template_string;
     }
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::Template",shared_from_this()));
 }
 void Object::SetObjectId(uint64_t object_id)
@@ -195,7 +200,7 @@ void Object::SetCustomName(wstring custom_name)
         custom_name_ = custom_name;
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::CustomName",shared_from_this()));
 }
 
@@ -241,22 +246,44 @@ void Object::Unsubscribe(const shared_ptr<ObserverInterface>& observer)
     }
 
     observers_.erase(find_iter);
+
+    // no deltas are built while nobody is watching, so the cached baselines fall
+    // behind the object from here on
+    if (observers_.empty())
+    {
+        baselines_.clear();
+        baselines_sequence_.reset();
+    }
 }
 
 void Object::NotifyObservers(const anh::ByteBuffer& message)
 {
-    NotifyObservers<anh::ByteBuffer>(message);
+    NotifyObservers_(anh::observer::BroadcastMessage(message));
+}
+
+void Object::NotifyObservers_(const anh::observer::BroadcastMessage& message)
+{
+	boost::lock_guard<boost::mutex> lock(object_mutex_);
+
+    std::for_each(
+        observers_.begin(),
+        observers_.end(),
+        [&message] (const std::shared_ptr<ObserverInterface>& observer)
+    {
+        message.Notify(*observer);
+    });
 }
 
 bool Object::IsDirty()
 {
 	boost::lock_guard<boost::mutex> lock(object_mutex_);
-    return !deltas_.empty();
+    return !deltas_.empty() || !pending_deltas_.empty();
 }
 void Object::ClearBaselines()
 {
     boost::lock_guard<boost::mutex> lock(object_mutex_);
     baselines_.clear();
+    baselines_sequence_.reset();
 }
 void Object::ClearDeltas()
 {
@@ -265,8 +292,6 @@ void Object::ClearDeltas()
 }
 void Object::MakeClean(std::shared_ptr<swganh::object::ObjectController> controller)
 {
-    ClearBaselines();
-    ClearDeltas();
     // SceneCreateObjectByCrc
     swganh::messages::SceneCreateObjectByCrc scene_object;
     scene_object.object_id = GetObjectId();
@@ -297,22 +322,205 @@ BaselinesCacheContainer Object::GetBaselines()
     return baselines_;
 }
 
-DeltasCacheContainer Object::GetDeltas(uint64_t viewer_id)
+uint32_t Object::GetDeltasSequence()
+{
+	boost::lock_guard<boost::mutex> lock(object_mutex_);
+    return deltas_sequence_;
+}
+
+bool Object::GetDeltasSince(uint32_t sequence, DeltasCacheContainer* deltas)
+{
+	boost::lock_guard<boost::mutex> lock(object_mutex_);
+    return GetDeltasSince_(sequence, deltas);
+}
+
+bool Object::GetDeltasSince_(uint32_t sequence, DeltasCacheContainer* deltas)
+{
+    // every message sent after the given sequence has to still be cached
+    if (sequence < deltas_sequence_ && (deltas_.empty() || deltas_.front().first > sequence + 1))
+    {
+        return false;
+    }
+
+    deltas->clear();
+
+    std::for_each(deltas_.begin(), deltas_.end(),
+        [sequence, deltas] (const SequencedDeltasMessage& delta)
+    {
+        if (delta.first > sequence)
+        {
+            deltas->push_back(delta.second);
+        }
+    });
+
+    return true;
+}
+
+bool Object::SendCachedBaselines(const std::shared_ptr<ObjectController>& controller)
+{
+    BaselinesCacheContainer baselines;
+    DeltasCacheContainer deltas;
+
+    {
+	    boost::lock_guard<boost::mutex> lock(object_mutex_);
+
+        if (baselines_.empty() || !baselines_sequence_ || !GetDeltasSince_(*baselines_sequence_, &deltas))
+        {
+            return false;
+        }
+
+        baselines = baselines_;
+    }
+
+    std::for_each(baselines.begin(), baselines.end(),
+        [&controller] (const BaselinesMessage& baseline)
+    {
+        controller->Notify(baseline);
+    });
+
+    SceneEndBaselines scene_end_baselines;
+    scene_end_baselines.object_id = GetObjectId();
+    controller->Notify(scene_end_baselines);
+
+    std::for_each(deltas.begin(), deltas.end(),
+        [&controller] (const DeltasMessage& delta)
+    {
+        controller->Notify(delta);
+    });
+
+    return true;
+}
+
+size_t Object::GetMessageCacheSize()
 {
 	boost::lock_guard<boost::mutex> lock(object_mutex_);
-    return deltas_;
+
+    size_t cache_size = deltas_.capacity() * sizeof(SequencedDeltasMessage);
+
+    std::for_each(deltas_.begin(), deltas_.end(),
+        [&cache_size] (const SequencedDeltasMessage& delta)
+    {
+        cache_size += delta.second.data.capacity();
+    });
+
+    std::for_each(baselines_.begin(), baselines_.end(),
+        [&cache_size] (const BaselinesMessage& baseline)
+    {
+        cache_size += sizeof(BaselinesMessage) + baseline.data.capacity();
+    });
+
+    return cache_size;
 }
 
 void Object::AddDeltasUpdate(DeltasMessage message)
 {
-    NotifyObservers(message);
+    bool first_pending = false;
+
+    {
+	    boost::lock_guard<boost::mutex> lock(object_mutex_);
+
+        first_pending = pending_deltas_.empty();
+
+        auto& view_deltas = pending_deltas_[message.view_type];
+
+        auto find_iter = std::find_if(
+            view_deltas.begin(),
+            view_deltas.end(),
+            [&message] (const DeltasMessage& pending)
+        {
+            return pending.update_type == message.update_type && !pending.sequenced && !message.sequenced;
+        });
+
+        if (find_iter != view_deltas.end())
+        {
+            *find_iter = move(message);
+        }
+        else
+        {
+            view_deltas.push_back(move(message));
+        }
+    }
+
+    if (first_pending)
+    {
+        PostEvent(make_shared<ObjectEvent>
+            ("Object::DeltasPending", shared_from_this()));
+    }
+}
+
+void Object::FlushDeltas()
+{
+    PendingDeltasContainer pending_deltas;
+
+    {
+	    boost::lock_guard<boost::mutex> lock(object_mutex_);
+        pending_deltas_.swap(pending_deltas);
+    }
+
+    DeltasCacheContainer messages;
+
+    std::for_each(
+        pending_deltas.begin(),
+        pending_deltas.end(),
+        [&messages] (PendingDeltasContainer::value_type& view_deltas)
+    {
+        auto& updates = view_deltas.second;
+
+        // The first update carries the message header, the others follow it in the
+        // message body each prefixed by its update type.
+        DeltasMessage message = move(updates.front());
+
+        std::for_each(
+            updates.begin() + 1,
+            updates.end(),
+            [&message] (const DeltasMessage& update)
+        {
+            message.update_count += update.update_count;
+            message.data.write<uint16_t>(update.update_type);
+            message.data.write(update.data.data(), update.data.size());
+        });
+
+        messages.push_back(move(message));
+    });
+
+    {
+        // Cached for viewers catching up from the cached baselines before any observer
+        // is sent them, so a viewer caught up in between replays them rather than missing them.
+	    boost::lock_guard<boost::mutex> lock(object_mutex_);
 
+        std::for_each(messages.begin(), messages.end(), [this] (const DeltasMessage& message)
+        {
+            deltas_.push_back(make_pair(++deltas_sequence_, message));
+        });
+    }
+
+    std::for_each(messages.begin(), messages.end(), [this] (const DeltasMessage& message)
+    {
+        NotifyObservers(message);
+    });
+}
+
+bool Object::HasPendingDeltas()
+{
 	boost::lock_guard<boost::mutex> lock(object_mutex_);
-    deltas_.push_back(move(message));
+    return !pending_deltas_.empty();
 }
 void Object::AddBaselineToCache(swganh::messages::BaselinesMessage baseline)
 {
     boost::lock_guard<boost::mutex> lock(object_mutex_);
+
+    // the deltas sent from here on are what a viewer given these baselines is missing
+    if (baselines_.empty())
+    {
+        baselines_sequence_ = deltas_sequence_;
+    }
+    else if (baselines_sequence_ && *baselines_sequence_ != deltas_sequence_)
+    {
+        // deltas went out while the baselines were being built, some of them may
+        // already be reflected in the cached baselines
+        baselines_sequence_.reset();
+    }
+
     baselines_.push_back(move(baseline));
 }
 
@@ -323,7 +531,7 @@ void Object::SetPosition(glm::vec3 position)
         position_ = position;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::Position",shared_from_this()));
 }
 glm::vec3 Object::GetPosition()
@@ -346,7 +554,7 @@ void Object::SetOrientation(glm::quat orientation)
         orientation_ = orientation;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::Orientation",shared_from_this()));
 }
 glm::quat Object::GetOrientation()
@@ -375,7 +583,7 @@ void Object::FaceObject(const std::shared_ptr<Object>& object)
  
         }
     }
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::Orientation",shared_from_this()));
 }
 
@@ -401,7 +609,7 @@ void Object::SetContainer(const std::shared_ptr<Object>& container)
         container_ = container;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::Container",shared_from_this()));
 }
 
@@ -418,7 +626,7 @@ void Object::SetComplexity(float complexity)
         complexity_ = complexity;
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::Complexity",shared_from_this()));
 }
 
@@ -436,7 +644,7 @@ void Object::SetStfName(const string& stf_file_name, const string& stf_string)
         stf_name_string_ = stf_string;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::StfName",shared_from_this()));
 }
 
@@ -456,7 +664,7 @@ void Object::SetVolume(uint32_t volume)
 {
     volume_ = volume;
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::Volume",shared_from_this()));
 }
 
@@ -469,7 +677,7 @@ void Object::SetSceneId(uint32_t scene_id)
 {
     scene_id_ = scene_id;
         
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+    PostEvent(make_shared<ObjectEvent>
         ("Object::SceneId",shared_from_this()));
 }
 
@@ -488,9 +696,39 @@ void Object::SetEventDispatcher(anh::EventDispatcher* dispatcher)
     event_dispatcher_ = dispatcher;
 }
 
+void Object::BeginHydration()
+{
+    hydrating_ = true;
+}
+
+void Object::EndHydration()
+{
+    hydrating_ = false;
+
+    OnHydrated();
+
+    PostEvent(make_shared<ObjectEvent>
+        ("Object::Loaded", shared_from_this()));
+}
+
+bool Object::IsHydrating()
+{
+    return hydrating_;
+}
+
+void Object::PostEvent(const shared_ptr<anh::EventInterface>& object_event)
+{
+    if (hydrating_)
+    {
+        return;
+    }
+
+    GetEventDispatcher()->Post(object_event);
+}
+
 void Object::CreateBaselines( std::shared_ptr<ObjectController> controller)
 {
-    GetEventDispatcher()->Dispatch(make_shared<ControllerEvent>
+    PostEvent(make_shared<ControllerEvent>
         ("Object::Baselines", shared_from_this(), controller));
 }
 
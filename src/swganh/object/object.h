@@ -8,11 +8,13 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <utility>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include <boost/circular_buffer.hpp>
 #include <boost/optional.hpp>
 #include <boost/thread/mutex.hpp>
 
@@ -51,6 +53,9 @@ class Object : public anh::observer::ObservableInterface, public std::enable_sha
 public:
     const static uint32_t type = 0;
 
+    /// The number of sent deltas messages kept for viewers catching up from the cached baselines.
+    const static uint32_t deltas_cache_capacity = 64;
+
     typedef ObjectFactory FactoryType;
     typedef ObjectMessageBuilder MessageBuilderType;
 
@@ -237,15 +242,12 @@ public:
             return;
         }
 
-        boost::lock_guard<boost::mutex> lock(object_mutex_);
-
-        std::for_each(
-            observers_.begin(),
-            observers_.end(),
-            [this, &message] (const std::shared_ptr<anh::observer::ObserverInterface>& observer)
+        if (!HasObservers())
         {
-            observer->Notify(message);
-        });
+            return;
+        }
+
+        NotifyObservers_(anh::observer::BroadcastMessage(message));
     }
 
     /**
@@ -256,15 +258,13 @@ public:
     template<typename T>
     void NotifyObservers(const T& message)
     {
-	    boost::lock_guard<boost::mutex> lock(object_mutex_);
-
-        std::for_each(
-            observers_.begin(),
-            observers_.end(),
-            [&message] (const std::shared_ptr<anh::observer::ObserverInterface>& observer)
+        if (!HasObservers())
         {
-            observer->Notify(message);
-        });
+            return;
+        }
+
+        // Serialize once, outside of the lock, and share the result with every observer.
+        NotifyObservers_(anh::observer::BroadcastMessage(message));
     }
 
     void NotifyObservers(const anh::ByteBuffer& message);
@@ -290,13 +290,35 @@ public:
     BaselinesCacheContainer GetBaselines() ;
 
     /**
-     * Returns the deltas messages generated since the last time the
-     * object was made clean.
+     * @return The sequence number of the last deltas message sent to the observers.
+     */
+    uint32_t GetDeltasSequence();
+
+    /**
+     * Returns the deltas messages sent after the given sequence number.
+     *
+     * Only the most recent deltas_cache_capacity messages are kept, a viewer that is
+     * further behind than that needs a fresh set of baselines.
+     *
+     * @param sequence The sequence number of the last deltas message the viewer has.
+     * @param deltas Filled with the deltas messages sent since then, oldest first.
+     * @return True if every message sent since the given sequence is still cached.
+     */
+    bool GetDeltasSince(uint32_t sequence, DeltasCacheContainer* deltas);
+
+    /**
+     * Brings a new viewer up to date from the cached baselines and the deltas sent
+     * since they were built, without regenerating the baselines.
      *
-     * @param viewer_id The id of the object viewing this Object instance.
-     * @return The most recently generated deltas.
+     * @return False if there are no cached baselines or the deltas sent since they
+     *  were built no longer fit in the cache, in which case nothing is sent.
      */
-    DeltasCacheContainer GetDeltas(uint64_t viewer_id) ;
+    bool SendCachedBaselines(const std::shared_ptr<ObjectController>& controller);
+
+    /**
+     * @return The number of bytes held by the cached baselines and deltas messages.
+     */
+    size_t GetMessageCacheSize();
 
     /**
      * Return the client iff template file that describes this Object.
@@ -455,10 +477,26 @@ public:
     /**
      * Stores a deltas message update for the object.
      *
+     * The update is held until the next FlushDeltas, which sends every update made to
+     * a view since the last flush as a single message. A later update to the same
+     * member replaces an earlier one that has not been sent yet. The first update
+     * after a flush posts an Object::DeltasPending event.
+     *
      * @param message The deltas message to store.
      */
     void AddDeltasUpdate(swganh::messages::DeltasMessage message);
 
+    /**
+     * Sends the updates stored since the last flush to the observers, one deltas
+     * message per view.
+     */
+    void FlushDeltas();
+
+    /**
+     * @return True if there are updates waiting for the next flush.
+     */
+    bool HasPendingDeltas();
+
     void AddBaselineToCache(swganh::messages::BaselinesMessage baseline);
 
     /**
@@ -481,6 +519,22 @@ public:
     anh::EventDispatcher* GetEventDispatcher();
     void SetEventDispatcher(anh::EventDispatcher* dispatcher);
 
+    /**
+     * Starts filling in the object from storage. Until EndHydration is called the
+     * setters only store their values, they post no events and so build no deltas.
+     */
+    void BeginHydration();
+
+    /**
+     * Finishes filling in the object from storage and posts a single Object::Loaded event.
+     */
+    void EndHydration();
+
+    /**
+     * @return True while the object is being filled in from storage.
+     */
+    bool IsHydrating();
+
     virtual void CreateBaselines(std::shared_ptr<ObjectController> controller);
     void ClearBaselines();
     void ClearDeltas();
@@ -494,6 +548,17 @@ public:
 protected:
     virtual void OnMakeClean(std::shared_ptr<swganh::object::ObjectController> controller) {}
 
+    /**
+     * Called once the object has been filled in from storage, drops the changes the
+     * network containers queued while their contents were loaded.
+     */
+    virtual void OnHydrated() {}
+
+    /**
+     * Posts an event about a change to the object, unless it's being filled in from storage.
+     */
+    void PostEvent(const std::shared_ptr<anh::EventInterface>& object_event);
+
 	std::atomic<uint64_t> object_id_;                // create
 	std::atomic<uint32_t> scene_id_;				 // create
     std::string template_string_;                    // create
@@ -506,6 +571,10 @@ protected:
     std::atomic<uint32_t> volume_;                   // update 3
 
 private:
+    void NotifyObservers_(const anh::observer::BroadcastMessage& message);
+
+    bool GetDeltasSince_(uint32_t sequence, DeltasCacheContainer* deltas);
+
     mutable boost::mutex object_mutex_;
 
     typedef std::vector<
@@ -515,15 +584,30 @@ private:
     ObjectMap aware_objects_;
     ObjectMap contained_objects_;
 
+    typedef std::map<
+        uint8_t,
+        DeltasCacheContainer
+    > PendingDeltasContainer;
+
+    // a sent deltas message and its sequence number
+    typedef std::pair<
+        uint32_t,
+        swganh::messages::DeltasMessage
+    > SequencedDeltasMessage;
+
     ObserverContainer observers_;
     BaselinesCacheContainer baselines_;
-    DeltasCacheContainer deltas_;
+    boost::circular_buffer<SequencedDeltasMessage> deltas_;
+    uint32_t deltas_sequence_;
+    boost::optional<uint32_t> baselines_sequence_;
+    PendingDeltasContainer pending_deltas_;
 
     std::shared_ptr<Object> container_;
     std::shared_ptr<ObjectController> controller_;
     anh::EventDispatcher* event_dispatcher_;
 
     bool is_dirty_;
+    bool hydrating_;
 
     boost::mutex flags_mutex_;
     std::set<std::string> flags_;
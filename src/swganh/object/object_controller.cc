@@ -68,6 +68,11 @@ void ObjectController::Notify(const anh::ByteBuffer& message)
     client_->SendTo(message);
 }
 
+void ObjectController::Notify(const std::shared_ptr<const anh::ByteBuffer>& message)
+{
+    client_->SendTo(message);
+}
+
 bool ObjectController::SendSystemMessage(std::string filename, std::string label)
 {
     swganh::messages::OutOfBand prose(filename, label);
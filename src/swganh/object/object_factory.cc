@@ -30,18 +30,46 @@ ObjectFactory::ObjectFactory(DatabaseManagerInterface* db_manager,
     , event_dispatcher_(event_dispatcher)
 {}
 
+void ObjectFactory::SetPersistConnection(const shared_ptr<Connection>& connection)
+{
+    persist_connection_ = connection;
+}
+
+shared_ptr<Connection> ObjectFactory::GetPersistConnection()
+{
+    if (persist_connection_)
+    {
+        return persist_connection_;
+    }
+
+    return db_manager_->getConnection("galaxy");
+}
+
+void ObjectFactory::RethrowIfPersistingBatch()
+{
+    if (persist_connection_)
+    {
+        throw;
+    }
+}
+
 void ObjectFactory::PersistObject(const shared_ptr<Object>& object)
 {
     try {
-        auto conn = db_manager_->getConnection("galaxy");
-        auto statement = shared_ptr<sql::PreparedStatement>
-            (conn->prepareStatement("CALL sp_PersistObject(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);"));
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
+        auto statement = db_manager_->getPreparedStatement(conn,
+            "CALL sp_PersistObject(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);");
         PersistObject(object, statement);
         // Now execute the update
         statement->executeUpdate();
     }
     catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -81,6 +109,7 @@ void ObjectFactory::PersistObject(const shared_ptr<Object>& object, const shared
     }
     catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -121,6 +150,10 @@ uint32_t ObjectFactory::LookupType(uint64_t object_id) const
     uint32_t type = 0;
     try {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return type;
+        }
         auto statement = conn->prepareStatement("CALL sp_GetType(?);");
         statement->setUInt64(1, object_id);
         auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());        
@@ -138,26 +171,32 @@ uint32_t ObjectFactory::LookupType(uint64_t object_id) const
     }
 }
 
-void ObjectFactory::LoadContainedObjects(
-    const shared_ptr<Object>& object,
-    const shared_ptr<Statement>& statement)
+ObjectFactory::ContainedObjectList ObjectFactory::ReadContainedObjects(const shared_ptr<Statement>& statement)
 {
+    ContainedObjectList contained_objects;
+
     // Check for contained objects        
     if (statement->getMoreResults())
     {
         unique_ptr<ResultSet> result(statement->getResultSet());
 
-        uint64_t contained_id;
-        uint32_t contained_type;
-
         while (result->next())
         {
-            contained_id = result->getUInt64("id");
-            contained_type = result->getUInt("type_id");
+            contained_objects.push_back(make_pair(result->getUInt64("id"), result->getUInt("type_id")));
+        }
+    }
+
+    return contained_objects;
+}
 
-            auto contained_object = object_manager_->CreateObjectFromStorage(contained_id, contained_type);
+void ObjectFactory::LoadContainedObjects(
+    const shared_ptr<Object>& object,
+    const ContainedObjectList& contained_objects)
+{
+    for (auto& contained : contained_objects)
+    {
+        auto contained_object = object_manager_->CreateObjectFromStorage(contained.first, contained.second);
             
-            object->AddContainedObject(contained_object, Object::LINK);
-        }
+        object->AddContainedObject(contained_object, Object::LINK);
     }
 }
@@ -4,6 +4,10 @@
 #ifndef SWGANH_OBJECT_OBJECT_FACTORY_H_
 #define SWGANH_OBJECT_OBJECT_FACTORY_H_
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "swganh/object/object_factory_interface.h"
 #include "anh/event_dispatcher.h"
 
@@ -13,6 +17,7 @@ class DatabaseManagerInterface;
 }} // anh::database
 
 namespace sql {
+    class Connection;
     class ResultSet;
     class Statement;
     class PreparedStatement;
@@ -66,15 +71,41 @@ namespace object {
 
         virtual void RegisterEventHandlers(){}
         void SetTreArchive(swganh::tre::TreArchive* tre_archive);
+
+        void SetPersistConnection(const std::shared_ptr<sql::Connection>& connection);
     protected:
         
+        /**
+         * @return the connection a batch of objects is being persisted on, or a
+         *  connection from the pool when persisting outside of a batch.
+         */
+        std::shared_ptr<sql::Connection> GetPersistConnection();
+
+        /**
+         * Rethrows the exception being handled when persisting as part of a batch, so
+         * the batch is rolled back and retried rather than committed without the object.
+         * Call from within a catch block.
+         */
+        void RethrowIfPersistingBatch();
 
-        void LoadContainedObjects(const std::shared_ptr<Object>& object,
-            const std::shared_ptr<sql::Statement>& statement);
+        typedef std::vector<std::pair<uint64_t, uint32_t>> ContainedObjectList;
+
+        /**
+         * Reads the ids and types of the contained objects from the statement's next result set.
+         */
+        ContainedObjectList ReadContainedObjects(const std::shared_ptr<sql::Statement>& statement);
+
+        /**
+         * Loads the contained objects into their container. Each one is loaded on a
+         * connection of its own, so the container's connection has to have been
+         * released first or a deep enough hierarchy could exhaust the pool.
+         */
+        void LoadContainedObjects(const std::shared_ptr<Object>& object, const ContainedObjectList& contained_objects);
         
         ObjectManager* object_manager_;
         anh::database::DatabaseManagerInterface* db_manager_;   
         anh::EventDispatcher* event_dispatcher_;
+        std::shared_ptr<sql::Connection> persist_connection_;
     };
 
 }}  // namespace swganh::object
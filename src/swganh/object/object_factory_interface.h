@@ -8,6 +8,10 @@
 #include <memory>
 #include <string>
 
+namespace sql {
+    class Connection;
+}  // namespace sql
+
 namespace swganh {
 namespace object {
 
@@ -38,6 +42,15 @@ namespace object {
          */
         virtual void PersistObject(const std::shared_ptr<Object>& object) = 0;
 
+        /**
+         * Sets the connection objects are persisted on while a batch of them is
+         * written in one transaction.
+         *
+         * @param connection the connection to persist on, or nullptr to go back to
+         *  using a connection from the pool for each write.
+         */
+        virtual void SetPersistConnection(const std::shared_ptr<sql::Connection>& connection) {}
+
         /**
          * Deletes the requested object from storage.
          *
@@ -3,6 +3,15 @@
 
 #include "object_manager.h"
 
+#include <exception>
+#include <stdexcept>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include <cppconn/connection.h>
+#include <cppconn/exception.h>
+
+#include "anh/event_dispatcher.h"
 #include "anh/logger.h"
 
 #include "object_factory.h"
@@ -10,14 +19,73 @@
 using namespace std;
 using namespace swganh::object;
 
+// Objects queued for persisting are written at most this long after being queued.
+static const boost::posix_time::time_duration kPersistPeriod = boost::posix_time::seconds(5);
+
+// The most objects written in a single transaction.
+static const size_t kPersistBatchSize = 250;
+
+// Custom names are indexed regardless of case.
+static wstring NameKey(const wstring& custom_name)
+{
+    return boost::to_lower_copy(custom_name);
+}
+
+static void EraseFromIndex(unordered_multimap<wstring, uint64_t>& index, const wstring& key, uint64_t object_id)
+{
+    auto range = index.equal_range(key);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+        if (iter->second == object_id)
+        {
+            index.erase(iter);
+            return;
+        }
+    }
+}
+
+static void EraseFromIndex(unordered_map<uint32_t, unordered_set<uint64_t>>& index, uint32_t key, uint64_t object_id)
+{
+    auto find_iter = index.find(key);
+    if (find_iter != index.end())
+    {
+        find_iter->second.erase(object_id);
+        if (find_iter->second.empty())
+        {
+            index.erase(find_iter);
+        }
+    }
+}
+
 ObjectManager::ObjectManager(anh::EventDispatcher* event_dispatcher, 
                              anh::database::DatabaseManagerInterface* db_manager)
     : event_dispatcher_(event_dispatcher)
     , db_manager_(db_manager)
-{}
+    , persister_([this] (const ObjectPersister::ObjectBatch& objects) { PersistObjects_(objects); }, kPersistPeriod, kPersistBatchSize)
+{
+    if (event_dispatcher_)
+    {
+        auto reindex = [this] (const shared_ptr<anh::EventInterface>& incoming_event)
+        {
+            ReindexObject_(static_pointer_cast<Object::ObjectEvent>(incoming_event)->Get());
+        };
+
+        custom_name_callback_ = event_dispatcher_->Subscribe("Object::CustomName", reindex);
+        scene_id_callback_ = event_dispatcher_->Subscribe("Object::SceneId", reindex);
+    }
+}
 
 ObjectManager::~ObjectManager()
-{}
+{
+    if (event_dispatcher_)
+    {
+        event_dispatcher_->Unsubscribe("Object::CustomName", custom_name_callback_);
+        event_dispatcher_->Unsubscribe("Object::SceneId", scene_id_callback_);
+    }
+
+    // write out what's still queued while the factories are around to do it
+    persister_.Stop();
+}
 
 void ObjectManager::RegisterObjectType(uint32_t object_type, const shared_ptr<ObjectFactoryInterface>& factory)
 {
@@ -60,7 +128,10 @@ shared_ptr<Object> ObjectManager::LoadObjectById(uint64_t object_id)
         object = CreateObjectFromStorage(object_id);
 
         boost::lock_guard<boost::shared_mutex> lg(object_map_mutex_);
-        object_map_.insert(make_pair(object_id, object));
+        if (object_map_.insert(make_pair(object_id, object)).second)
+        {
+            IndexObject_(object);
+        }
     }
 
     return object;
@@ -75,7 +146,10 @@ shared_ptr<Object> ObjectManager::LoadObjectById(uint64_t object_id, uint32_t ob
         object = CreateObjectFromStorage(object_id, object_type);
 
         boost::lock_guard<boost::shared_mutex> lg(object_map_mutex_);
-        object_map_.insert(make_pair(object_id, object));
+        if (object_map_.insert(make_pair(object_id, object)).second)
+        {
+            IndexObject_(object);
+        }
     }
 
     return object;
@@ -97,26 +171,72 @@ shared_ptr<Object> ObjectManager::GetObjectById(uint64_t object_id)
 void ObjectManager::RemoveObject(const shared_ptr<Object>& object)
 {
     boost::lock_guard<boost::shared_mutex> lg(object_map_mutex_);
-    object_map_.unsafe_erase(object_map_.find(object->GetObjectId()));
+    auto find_iter = object_map_.find(object->GetObjectId());
+
+    if (find_iter != object_map_.end())
+    {
+        object_map_.unsafe_erase(find_iter);
+        UnindexObject_(object->GetObjectId());
+    }
 }
 
 shared_ptr<Object> ObjectManager::GetObjectByCustomName(const wstring& custom_name)
 {
+    auto name_key = NameKey(custom_name);
+
     boost::shared_lock<boost::shared_mutex> lock(object_map_mutex_);
-	auto find_iter = std::find_if(
-        std::begin(object_map_), 
-        std::end(object_map_),
-        [custom_name] (pair<uint64_t, shared_ptr<Object>> key_value)
+    auto range = name_index_.equal_range(name_key);
+
+    shared_ptr<Object> found;
+
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-		return key_value.second->GetCustomName().compare(custom_name) == 0;
-	});
+        auto find_iter = object_map_.find(iter->second);
 
-	if (find_iter == object_map_.end())
+        if (find_iter == object_map_.end())
+        {
+            continue;
+        }
+
+        // an exact match wins over one that differs only in case
+        if (find_iter->second->GetCustomName() == custom_name)
+        {
+            return find_iter->second;
+        }
+
+        if (!found)
+        {
+            found = find_iter->second;
+        }
+    }
+
+    return found;
+}
+
+vector<shared_ptr<Object>> ObjectManager::GetObjectsInScene(uint32_t scene_id)
+{
+    boost::shared_lock<boost::shared_mutex> lock(object_map_mutex_);
+    auto find_iter = scene_index_.find(scene_id);
+
+    if (find_iter == scene_index_.end())
     {
-        return nullptr;
+        return vector<shared_ptr<Object>>();
     }
 
-    return find_iter->second;
+    return GetObjects_(find_iter->second);
+}
+
+vector<shared_ptr<Object>> ObjectManager::GetObjectsByType(uint32_t object_type)
+{
+    boost::shared_lock<boost::shared_mutex> lock(object_map_mutex_);
+    auto find_iter = type_index_.find(object_type);
+
+    if (find_iter == type_index_.end())
+    {
+        return vector<shared_ptr<Object>>();
+    }
+
+    return GetObjects_(find_iter->second);
 }
 
 shared_ptr<Object> ObjectManager::CreateObjectFromStorage(uint64_t object_id)
@@ -188,7 +308,7 @@ void ObjectManager::PersistObject(const std::shared_ptr<Object>& object)
         throw InvalidObjectType("Cannot persist object to storage for an unregistered type.");
     }
 
-    return find_iter->second->PersistObject(object);
+    persister_.MarkDirty(object);
 }
 
 void ObjectManager::PersistObject(uint64_t object_id)
@@ -226,3 +346,169 @@ void ObjectManager::PersistRelatedObjects(uint64_t parent_object_id)
         PersistRelatedObjects(object);
     }
 }
+
+void ObjectManager::FlushPersistedObjects()
+{
+    persister_.Flush();
+}
+
+void ObjectManager::PersistObjects_(const ObjectPersister::ObjectBatch& objects)
+{
+    auto connection = db_manager_->getConnection("galaxy");
+
+    // the pool timed out, the persister keeps the objects dirty and retries them
+    if (!connection)
+    {
+        throw runtime_error("No connection to persist a batch of objects on");
+    }
+
+    exception_ptr error;
+
+    try
+    {
+        connection->setAutoCommit(false);
+
+        for (auto& factory : factories_)
+        {
+            factory.second->SetPersistConnection(connection);
+        }
+
+        for (auto& object : objects)
+        {
+            auto find_iter = factories_.find(object->GetType());
+
+            if (find_iter != factories_.end())
+            {
+                find_iter->second->PersistObject(object);
+            }
+        }
+
+        connection->commit();
+    }
+    catch(sql::SQLException &e)
+    {
+        LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
+        LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+
+        // rethrown once the connection is cleaned up so the persister retries the batch
+        error = current_exception();
+
+        try
+        {
+            if (!connection->isClosed())
+            {
+                connection->rollback();
+            }
+        }
+        catch(sql::SQLException &rollback_error)
+        {
+            LOG(error) << "Rolling back the batch failed: " << rollback_error.what();
+
+            // closed connections are dropped rather than returned to the pool
+            connection->close();
+        }
+    }
+
+    for (auto& factory : factories_)
+    {
+        factory.second->SetPersistConnection(nullptr);
+    }
+
+    // the connection goes back to the pool for others to use
+    if (!connection->isClosed())
+    {
+        connection->setAutoCommit(true);
+    }
+
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+}
+
+void ObjectManager::IndexObject_(const shared_ptr<Object>& object)
+{
+    IndexEntry entry;
+    entry.name_key = NameKey(object->GetCustomName());
+    entry.scene_id = object->GetSceneId();
+    entry.object_type = object->GetType();
+
+    uint64_t object_id = object->GetObjectId();
+
+    name_index_.insert(make_pair(entry.name_key, object_id));
+    scene_index_[entry.scene_id].insert(object_id);
+    type_index_[entry.object_type].insert(object_id);
+
+    index_entries_[object_id] = move(entry);
+}
+
+void ObjectManager::ReindexObject_(const shared_ptr<Object>& object)
+{
+    // read the object's state before taking the lock, it has its own
+    auto name_key = NameKey(object->GetCustomName());
+    uint32_t scene_id = object->GetSceneId();
+    uint64_t object_id = object->GetObjectId();
+
+    boost::lock_guard<boost::shared_mutex> lg(object_map_mutex_);
+    auto find_iter = index_entries_.find(object_id);
+
+    // objects that aren't managed here aren't indexed either
+    if (find_iter == index_entries_.end())
+    {
+        return;
+    }
+
+    auto& entry = find_iter->second;
+
+    if (entry.name_key != name_key)
+    {
+        EraseFromIndex(name_index_, entry.name_key, object_id);
+
+        name_index_.insert(make_pair(name_key, object_id));
+        entry.name_key = move(name_key);
+    }
+
+    if (entry.scene_id != scene_id)
+    {
+        EraseFromIndex(scene_index_, entry.scene_id, object_id);
+
+        scene_index_[scene_id].insert(object_id);
+        entry.scene_id = scene_id;
+    }
+}
+
+void ObjectManager::UnindexObject_(uint64_t object_id)
+{
+    auto find_iter = index_entries_.find(object_id);
+
+    if (find_iter == index_entries_.end())
+    {
+        return;
+    }
+
+    auto& entry = find_iter->second;
+
+    EraseFromIndex(name_index_, entry.name_key, object_id);
+    EraseFromIndex(scene_index_, entry.scene_id, object_id);
+    EraseFromIndex(type_index_, entry.object_type, object_id);
+
+    index_entries_.erase(find_iter);
+}
+
+vector<shared_ptr<Object>> ObjectManager::GetObjects_(const unordered_set<uint64_t>& object_ids)
+{
+    vector<shared_ptr<Object>> objects;
+    objects.reserve(object_ids.size());
+
+    for (uint64_t object_id : object_ids)
+    {
+        auto find_iter = object_map_.find(object_id);
+
+        if (find_iter != object_map_.end())
+        {
+            objects.push_back(find_iter->second);
+        }
+    }
+
+    return objects;
+}
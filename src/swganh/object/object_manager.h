@@ -9,6 +9,9 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
 
@@ -31,6 +34,7 @@ namespace concurrency {
 #include "swganh/object/exception.h"
 #include "swganh/object/object_factory_interface.h"
 #include "swganh/object/object_message_builder.h"
+#include "swganh/object/object_persister.h"
 
 namespace swganh {
 namespace object {
@@ -133,11 +137,29 @@ namespace object {
         /**
          * Finds and returns an object from management based on its custom name.
          *
+         * Names are matched regardless of case.
+         *
          * @param custom_name The custom name of the object to load
          * @return Instance of the requested object, or nullptr if the object does not exist
          */
 		std::shared_ptr<Object> GetObjectByCustomName(const std::wstring& custom_name);
 
+        /**
+         * Finds the managed objects in a scene.
+         *
+         * @param scene_id The id of the scene.
+         * @return The objects in the scene, in no particular order.
+         */
+        std::vector<std::shared_ptr<Object>> GetObjectsInScene(uint32_t scene_id);
+
+        /**
+         * Finds the managed objects of a type.
+         *
+         * @param object_type The type of the objects.
+         * @return The objects of the type, in no particular order.
+         */
+        std::vector<std::shared_ptr<Object>> GetObjectsByType(uint32_t object_type);
+
         /**
          * Creates an instance of a stored object with the specified id.
          *
@@ -214,7 +236,11 @@ namespace object {
         void DeleteObjectFromStorage(const std::shared_ptr<Object>& object);
         
         /**
-         * Persists the object's state to storage.
+         * Queues the object's state to be persisted to storage.
+         *
+         * Objects are written in the background in batches, each batch in a single
+         * transaction. An object queued several times before it's written is only
+         * written once.
          *
          * @param object the object instance to persist.
          */
@@ -241,8 +267,55 @@ namespace object {
          */
 	    void PersistRelatedObjects(uint64_t parent_object_id);
 
+        /**
+         * Writes every object queued for persisting to storage before returning.
+         */
+        void FlushPersistedObjects();
+
+        /**
+         * @return the persister writing queued objects to storage.
+         */
+        ObjectPersister& GetPersister() { return persister_; }
+
     private:
 
+        /**
+         * Writes a batch of objects to storage in a single transaction.
+         *
+         * A failed transaction is rolled back and its exception rethrown, so the
+         * persister keeps the objects dirty and retries them. The same happens when
+         * no connection could be taken from the pool.
+         *
+         * @param objects the objects to write.
+         */
+        void PersistObjects_(const ObjectPersister::ObjectBatch& objects);
+
+        /**
+         * Adds a newly managed object to the name, scene and type indexes.
+         *
+         * @param object The object to index, must not be in the indexes already.
+         */
+        void IndexObject_(const std::shared_ptr<Object>& object);
+
+        /**
+         * Moves a managed object to its current name and scene in the indexes.
+         *
+         * @param object The object that changed.
+         */
+        void ReindexObject_(const std::shared_ptr<Object>& object);
+
+        /**
+         * Removes an object from the indexes.
+         *
+         * @param object_id The id of the object to remove.
+         */
+        void UnindexObject_(uint64_t object_id);
+
+        /**
+         * Collects the objects with the given ids.
+         */
+        std::vector<std::shared_ptr<Object>> GetObjects_(const std::unordered_set<uint64_t>& object_ids);
+
         /**
          * Registers a message builder for a specific object type
          *
@@ -281,6 +354,26 @@ namespace object {
         
         boost::shared_mutex object_map_mutex_;
         concurrency::concurrent_unordered_map<uint64_t, std::shared_ptr<Object>> object_map_;
+
+        // What each managed object is indexed under, to find it again when it changes.
+        struct IndexEntry
+        {
+            std::wstring name_key;
+            uint32_t scene_id;
+            uint32_t object_type;
+        };
+
+        // The indexes are guarded by object_map_mutex_ along with the object map.
+        std::unordered_map<uint64_t, IndexEntry> index_entries_;
+        std::unordered_multimap<std::wstring, uint64_t> name_index_;
+        std::unordered_map<uint32_t, std::unordered_set<uint64_t>> scene_index_;
+        std::unordered_map<uint32_t, std::unordered_set<uint64_t>> type_index_;
+
+        anh::CallbackId custom_name_callback_;
+        anh::CallbackId scene_id_callback_;
+
+        // last so it's stopped, and the objects still queued written, first
+        ObjectPersister persister_;
     };
 
 }}  // namespace swganh::object
@@ -0,0 +1,211 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <boost/chrono.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/event_dispatcher.h"
+#include "swganh/object/object.h"
+#include "swganh/object/object_manager.h"
+#include "swganh/object/creature/creature.h"
+
+using namespace anh;
+using namespace std;
+using namespace swganh::object;
+using namespace swganh::object::creature;
+
+namespace {
+
+wstring NameFor(uint64_t object_id) {
+    wstringstream name;
+    name << L"Name " << object_id;
+    return name.str();
+}
+
+/// Fills in objects of type T with a name made from their id and a scene
+/// instead of reading them from storage.
+template<typename T>
+class FakeFactory : public ObjectFactoryInterface {
+public:
+    explicit FakeFactory(EventDispatcher* event_dispatcher)
+        : event_dispatcher_(event_dispatcher)
+    {}
+
+    void LoadTemplates() {}
+    bool HasTemplate(const string&) { return false; }
+    void PersistObject(const shared_ptr<Object>&) {}
+    void DeleteObjectFromStorage(const shared_ptr<Object>&) {}
+    shared_ptr<Object> CreateObjectFromTemplate(const string&) { return nullptr; }
+    uint32_t LookupType(uint64_t) const { return T::type; }
+
+    shared_ptr<Object> CreateObjectFromStorage(uint64_t object_id) {
+        auto object = make_shared<T>();
+        object->SetEventDispatcher(event_dispatcher_);
+
+        object->BeginHydration();
+        object->SetObjectId(object_id);
+        object->SetCustomName(NameFor(object_id));
+        object->SetSceneId(static_cast<uint32_t>(object_id % 2) + 1);
+        object->EndHydration();
+
+        return object;
+    }
+
+private:
+    EventDispatcher* event_dispatcher_;
+};
+
+class ObjectManagerTests {
+protected:
+    ObjectManagerTests()
+        : event_dispatcher_(io_service_)
+        , object_manager_(&event_dispatcher_, nullptr)
+    {
+        object_manager_.RegisterObjectType(Object::type, make_shared<FakeFactory<Object>>(&event_dispatcher_));
+        object_manager_.RegisterObjectType(Creature::type, make_shared<FakeFactory<Creature>>(&event_dispatcher_));
+    }
+
+    // runs the events posted by the objects
+    void RunEvents() {
+        io_service_.poll();
+        io_service_.reset();
+    }
+
+    static bool Contains(const vector<shared_ptr<Object>>& objects, const shared_ptr<Object>& object) {
+        return find(objects.begin(), objects.end(), object) != objects.end();
+    }
+
+    boost::asio::io_service io_service_;
+    EventDispatcher event_dispatcher_;
+    ObjectManager object_manager_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ObjectManagerTest, ObjectManagerTests)
+
+/// This test verifies that objects are found by their custom name regardless of case.
+BOOST_AUTO_TEST_CASE(ObjectsAreFoundByNameRegardlessOfCase) {
+    auto object = object_manager_.LoadObjectById(1, Object::type);
+    object_manager_.LoadObjectById(2, Object::type);
+
+    BOOST_CHECK(object == object_manager_.GetObjectByCustomName(L"Name 1"));
+    BOOST_CHECK(object == object_manager_.GetObjectByCustomName(L"nAME 1"));
+    BOOST_CHECK(!object_manager_.GetObjectByCustomName(L"Name 3"));
+}
+
+/// This test verifies that the indexes follow an object's name and scene as they change.
+BOOST_AUTO_TEST_CASE(IndexesFollowNameAndSceneChanges) {
+    auto object = object_manager_.LoadObjectById(1, Object::type);
+    BOOST_REQUIRE_EQUAL(2, object->GetSceneId());
+
+    object->SetCustomName(L"Renamed");
+    object->SetSceneId(5);
+    RunEvents();
+
+    BOOST_CHECK(!object_manager_.GetObjectByCustomName(L"Name 1"));
+    BOOST_CHECK(object == object_manager_.GetObjectByCustomName(L"renamed"));
+
+    BOOST_CHECK(object_manager_.GetObjectsInScene(2).empty());
+    BOOST_CHECK(Contains(object_manager_.GetObjectsInScene(5), object));
+}
+
+/// This test verifies that objects are found by scene and by type.
+BOOST_AUTO_TEST_CASE(ObjectsAreFoundBySceneAndType) {
+    auto object = object_manager_.LoadObjectById(1, Object::type);
+    auto creature = object_manager_.LoadObjectById(2, Creature::type);
+    auto other_creature = object_manager_.LoadObjectById(3, Creature::type);
+
+    auto scene_objects = object_manager_.GetObjectsInScene(2);
+    BOOST_CHECK_EQUAL(2, scene_objects.size());
+    BOOST_CHECK(Contains(scene_objects, object));
+    BOOST_CHECK(Contains(scene_objects, other_creature));
+
+    auto creatures = object_manager_.GetObjectsByType(Creature::type);
+    BOOST_CHECK_EQUAL(2, creatures.size());
+    BOOST_CHECK(Contains(creatures, creature));
+    BOOST_CHECK(Contains(creatures, other_creature));
+}
+
+/// This test verifies that removed objects are no longer found through the indexes.
+BOOST_AUTO_TEST_CASE(RemovedObjectsAreUnindexed) {
+    auto object = object_manager_.LoadObjectById(1, Creature::type);
+
+    object_manager_.RemoveObject(object);
+
+    BOOST_CHECK(!object_manager_.GetObjectByCustomName(L"Name 1"));
+    BOOST_CHECK(object_manager_.GetObjectsInScene(2).empty());
+    BOOST_CHECK(object_manager_.GetObjectsByType(Creature::type).empty());
+
+    // changes to an object no longer managed don't put it back
+    object->SetCustomName(L"Renamed");
+    RunEvents();
+
+    BOOST_CHECK(!object_manager_.GetObjectByCustomName(L"Renamed"));
+}
+
+/// Loads 50000 objects and reports the time taken to find one by name by scanning
+/// every loaded object, as the lookup used to, and through the name index.
+BOOST_AUTO_TEST_CASE(NameLookupAt50kObjects) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint64_t object_count = 50000;
+    const uint32_t lookup_count = 1000;
+
+    vector<shared_ptr<Object>> objects;
+    objects.reserve(object_count);
+
+    for (uint64_t i = 0; i < object_count; ++i) {
+        objects.push_back(object_manager_.LoadObjectById(i, Object::type));
+    }
+
+    vector<wstring> names;
+    for (uint32_t i = 0; i < lookup_count; ++i) {
+        names.push_back(NameFor((i * 7919) % object_count));
+    }
+
+    typedef boost::chrono::high_resolution_clock clock;
+
+    auto start = clock::now();
+    uint32_t scanned_found = 0;
+
+    for (auto& name : names) {
+        auto find_iter = find_if(objects.begin(), objects.end(), [&name] (const shared_ptr<Object>& object) {
+            return object->GetCustomName().compare(name) == 0;
+        });
+
+        if (find_iter != objects.end()) {
+            ++scanned_found;
+        }
+    }
+
+    double scan_seconds = boost::chrono::duration<double>(clock::now() - start).count();
+
+    start = clock::now();
+    uint32_t indexed_found = 0;
+
+    for (auto& name : names) {
+        if (object_manager_.GetObjectByCustomName(name)) {
+            ++indexed_found;
+        }
+    }
+
+    double index_seconds = boost::chrono::duration<double>(clock::now() - start).count();
+
+    BOOST_CHECK_EQUAL(lookup_count, scanned_found);
+    BOOST_CHECK_EQUAL(lookup_count, indexed_found);
+
+    BOOST_TEST_MESSAGE(object_count << " objects loaded");
+    BOOST_TEST_MESSAGE("Scanning:     " << scan_seconds * 1000000.0 / lookup_count << "us per name lookup");
+    BOOST_TEST_MESSAGE("Name index:   " << index_seconds * 1000000.0 / lookup_count << "us per name lookup");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
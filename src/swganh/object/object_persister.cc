@@ -0,0 +1,193 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "object_persister.h"
+
+#include <algorithm>
+#include <exception>
+
+#include <boost/thread/thread_time.hpp>
+
+#include "anh/logger.h"
+
+#include "swganh/object/object.h"
+
+using namespace std;
+using namespace swganh::object;
+
+ObjectPersister::ObjectPersister(BatchHandler handler, boost::posix_time::time_duration period, size_t batch_size)
+    : handler_(move(handler))
+    , period_(period)
+    , batch_size_(max<size_t>(batch_size, 1))
+    , stopping_(false)
+    , persisted_count_(0)
+    , batch_count_(0)
+    , dropped_count_(0)
+{
+    worker_ = boost::thread([this] () { Run_(); });
+}
+
+ObjectPersister::~ObjectPersister()
+{
+    Stop();
+}
+
+void ObjectPersister::MarkDirty(const shared_ptr<Object>& object)
+{
+    bool stopped;
+
+    {
+        boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+        dirty_objects_[object->GetObjectId()] = object;
+        stopped = stopping_;
+    }
+
+    if (stopped)
+    {
+        Flush();
+    }
+}
+
+void ObjectPersister::Flush()
+{
+    boost::lock_guard<boost::mutex> persist_lock(persist_mutex_);
+
+    DirtyObjectMap dirty_objects;
+
+    {
+        boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+        dirty_objects.swap(dirty_objects_);
+    }
+
+    if (dirty_objects.empty())
+    {
+        return;
+    }
+
+    ObjectBatch batch;
+    batch.reserve(min(batch_size_, dirty_objects.size()));
+
+    for (auto& entry : dirty_objects)
+    {
+        batch.push_back(move(entry.second));
+
+        if (batch.size() == batch_size_)
+        {
+            Persist_(batch);
+            batch.clear();
+        }
+    }
+
+    if (!batch.empty())
+    {
+        Persist_(batch);
+    }
+}
+
+void ObjectPersister::Stop()
+{
+    {
+        boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+        stopping_ = true;
+    }
+
+    wakeup_.notify_all();
+
+    if (worker_.joinable())
+    {
+        worker_.join();
+    }
+
+    // anything marked while the worker was finishing up is still written, and
+    // failed batches get the rest of their attempts
+    while (GetPendingCount() > 0)
+    {
+        Flush();
+    }
+}
+
+size_t ObjectPersister::GetPendingCount()
+{
+    boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+    return dirty_objects_.size();
+}
+
+void ObjectPersister::Run_()
+{
+    boost::unique_lock<boost::mutex> lock(dirty_mutex_);
+
+    while (!stopping_)
+    {
+        auto next_pass = boost::get_system_time() + period_;
+
+        while (!stopping_ && wakeup_.timed_wait(lock, next_pass))
+        {}
+
+        lock.unlock();
+        Flush();
+        lock.lock();
+    }
+}
+
+void ObjectPersister::Persist_(const ObjectBatch& batch)
+{
+    try
+    {
+        handler_(batch);
+
+        persisted_count_ += batch.size();
+        ++batch_count_;
+    }
+    catch(exception& e)
+    {
+        // retried one at a time so a single bad object doesn't hold up the rest,
+        // only failing on its own counts as an attempt against an object
+        if (batch.size() > 1)
+        {
+            LOG(warning) << "Failed to persist a batch of " << batch.size() << " objects, retrying them individually: " << e.what();
+
+            for (auto& object : batch)
+            {
+                Persist_(ObjectBatch(1, object));
+            }
+
+            return;
+        }
+
+        LOG(error) << "Failed to persist object " << batch.front()->GetObjectId() << ": " << e.what();
+
+        Requeue_(batch.front());
+        return;
+    }
+
+    boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+
+    if (!failed_attempts_.empty())
+    {
+        for (auto& object : batch)
+        {
+            failed_attempts_.erase(object->GetObjectId());
+        }
+    }
+}
+
+void ObjectPersister::Requeue_(const shared_ptr<Object>& object)
+{
+    uint64_t object_id = object->GetObjectId();
+
+    {
+        boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+
+        if (++failed_attempts_[object_id] < max_attempts)
+        {
+            // an object marked dirty again since the batch was taken is already queued
+            dirty_objects_.insert(make_pair(object_id, object));
+            return;
+        }
+
+        failed_attempts_.erase(object_id);
+    }
+
+    ++dropped_count_;
+    LOG(error) << "Gave up on persisting object " << object_id << " after " << max_attempts << " attempts";
+}
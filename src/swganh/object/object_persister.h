@@ -0,0 +1,127 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef SWGANH_OBJECT_OBJECT_PERSISTER_H_
+#define SWGANH_OBJECT_OBJECT_PERSISTER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace swganh {
+namespace object {
+
+    class Object;
+
+    /**
+     * Writes objects back to storage in the background.
+     *
+     * Objects marked dirty are collected until the worker's next pass, made once
+     * every period, which hands them to the batch handler at most batch_size at a
+     * time. An object marked dirty again before it has been written is only
+     * written once.
+     *
+     * A batch the handler throws on is retried one object at a time. An object that
+     * fails on its own is marked dirty again and retried on a later pass, and given
+     * up on after max_attempts failed writes.
+     */
+    class ObjectPersister
+    {
+    public:
+        typedef std::vector<std::shared_ptr<Object>> ObjectBatch;
+        typedef std::function<void (const ObjectBatch&)> BatchHandler;
+
+        /// The number of times writing an object is attempted before it's dropped.
+        static const uint32_t max_attempts = 3;
+
+        /**
+         * @param handler writes a batch of objects to storage.
+         * @param period the time between the worker's passes.
+         * @param batch_size the most objects handed to the handler at once.
+         */
+        ObjectPersister(BatchHandler handler, boost::posix_time::time_duration period, size_t batch_size);
+
+        /**
+         * Stops the worker, writing out everything still marked dirty.
+         */
+        ~ObjectPersister();
+
+        /**
+         * Marks an object to be written on the worker's next pass.
+         *
+         * Once the persister is stopped the object is written immediately on the
+         * calling thread instead.
+         *
+         * @param object the object to write.
+         */
+        void MarkDirty(const std::shared_ptr<Object>& object);
+
+        /**
+         * Writes out everything marked dirty on the calling thread. Objects that
+         * fail to be written stay marked dirty for the next flush.
+         */
+        void Flush();
+
+        /**
+         * Stops the worker and writes out everything still marked dirty, retrying
+         * failed objects until they're written or out of attempts.
+         */
+        void Stop();
+
+        /**
+         * @return the number of objects waiting to be written.
+         */
+        size_t GetPendingCount();
+
+        /**
+         * @return the number of objects written since the persister started.
+         */
+        uint64_t GetPersistedCount() const { return persisted_count_; }
+
+        /**
+         * @return the number of batches handed to the handler since the persister started.
+         */
+        uint64_t GetBatchCount() const { return batch_count_; }
+
+        /**
+         * @return the number of objects dropped after running out of attempts.
+         */
+        uint64_t GetDroppedCount() const { return dropped_count_; }
+
+    private:
+        typedef std::map<uint64_t, std::shared_ptr<Object>> DirtyObjectMap;
+
+        void Run_();
+        void Persist_(const ObjectBatch& batch);
+        void Requeue_(const std::shared_ptr<Object>& object);
+
+        BatchHandler handler_;
+        boost::posix_time::time_duration period_;
+        size_t batch_size_;
+
+        boost::mutex dirty_mutex_;
+        boost::condition_variable wakeup_;
+        DirtyObjectMap dirty_objects_;
+        std::map<uint64_t, uint32_t> failed_attempts_;
+        bool stopping_;
+
+        // held while a batch is written so the handler is never run concurrently
+        boost::mutex persist_mutex_;
+        std::atomic<uint64_t> persisted_count_;
+        std::atomic<uint64_t> batch_count_;
+        std::atomic<uint64_t> dropped_count_;
+
+        boost::thread worker_;
+    };
+
+}}  // namespace swganh::object
+
+#endif  // SWGANH_OBJECT_OBJECT_PERSISTER_H_
@@ -0,0 +1,297 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/chrono.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include "anh/benchmark.h"
+
+#include "swganh/object/object.h"
+#include "swganh/object/object_persister.h"
+
+using namespace std;
+using namespace swganh::object;
+
+namespace {
+
+/// Long enough that the worker never makes a pass on its own during a test.
+const boost::posix_time::time_duration idle_period = boost::posix_time::hours(1);
+
+const uint32_t max_attempts = ObjectPersister::max_attempts;
+
+/// Records the batches it's handed instead of writing them to storage.
+class RecordingStorage {
+public:
+    ObjectPersister::BatchHandler handler() {
+        return [this] (const ObjectPersister::ObjectBatch& batch) {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            batches_.push_back(batch);
+        };
+    }
+
+    vector<ObjectPersister::ObjectBatch> batches() {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return batches_;
+    }
+
+private:
+    boost::mutex mutex_;
+    vector<ObjectPersister::ObjectBatch> batches_;
+};
+
+shared_ptr<Object> CreateObject(uint64_t object_id) {
+    auto object = make_shared<Object>();
+    object->SetObjectId(object_id);
+    return object;
+}
+
+BOOST_AUTO_TEST_SUITE(ObjectPersisterTest)
+
+/// This test verifies that an object marked dirty several times is written once.
+BOOST_AUTO_TEST_CASE(RepeatedWritesToAnObjectAreCoalesced) {
+    RecordingStorage storage;
+    ObjectPersister persister(storage.handler(), idle_period, 100);
+
+    auto object = CreateObject(1);
+    for (int i = 0; i < 10; ++i) {
+        persister.MarkDirty(object);
+    }
+    persister.MarkDirty(CreateObject(2));
+
+    BOOST_CHECK_EQUAL(2, persister.GetPendingCount());
+
+    persister.Flush();
+
+    auto batches = storage.batches();
+    BOOST_REQUIRE_EQUAL(1, batches.size());
+    BOOST_REQUIRE_EQUAL(2, batches[0].size());
+    BOOST_CHECK(object == batches[0][0]);
+    BOOST_CHECK_EQUAL(0, persister.GetPendingCount());
+    BOOST_CHECK_EQUAL(2, persister.GetPersistedCount());
+}
+
+/// This test verifies that no batch handed to storage is larger than the batch size.
+BOOST_AUTO_TEST_CASE(DirtyObjectsAreWrittenInBatches) {
+    RecordingStorage storage;
+    ObjectPersister persister(storage.handler(), idle_period, 4);
+
+    for (uint64_t i = 0; i < 10; ++i) {
+        persister.MarkDirty(CreateObject(i));
+    }
+
+    persister.Flush();
+
+    auto batches = storage.batches();
+    BOOST_REQUIRE_EQUAL(3, batches.size());
+    BOOST_CHECK_EQUAL(4, batches[0].size());
+    BOOST_CHECK_EQUAL(4, batches[1].size());
+    BOOST_CHECK_EQUAL(2, batches[2].size());
+    BOOST_CHECK_EQUAL(3, persister.GetBatchCount());
+}
+
+/// This test verifies that the worker writes dirty objects out on its own.
+BOOST_AUTO_TEST_CASE(WorkerWritesOnItsCadence) {
+    RecordingStorage storage;
+    ObjectPersister persister(storage.handler(), boost::posix_time::milliseconds(10), 100);
+
+    persister.MarkDirty(CreateObject(1));
+
+    for (int i = 0; i < 500 && persister.GetPersistedCount() == 0; ++i) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+
+    BOOST_CHECK_EQUAL(1, persister.GetPersistedCount());
+}
+
+/// This test verifies that everything still dirty is written when the persister stops.
+BOOST_AUTO_TEST_CASE(DirtyObjectsAreWrittenOnShutdown) {
+    RecordingStorage storage;
+
+    {
+        ObjectPersister persister(storage.handler(), idle_period, 100);
+
+        for (uint64_t i = 0; i < 50; ++i) {
+            persister.MarkDirty(CreateObject(i));
+        }
+    }
+
+    auto batches = storage.batches();
+    BOOST_REQUIRE_EQUAL(1, batches.size());
+    BOOST_CHECK_EQUAL(50, batches[0].size());
+}
+
+/// This test verifies that objects marked dirty after stopping are still written.
+BOOST_AUTO_TEST_CASE(ObjectsMarkedAfterStoppingAreWritten) {
+    RecordingStorage storage;
+    ObjectPersister persister(storage.handler(), idle_period, 100);
+
+    persister.Stop();
+    persister.MarkDirty(CreateObject(1));
+
+    BOOST_CHECK_EQUAL(1, persister.GetPersistedCount());
+    BOOST_CHECK_EQUAL(0, persister.GetPendingCount());
+}
+
+/// This test verifies that the objects in a batch that fails to write are retried one
+/// at a time.
+BOOST_AUTO_TEST_CASE(FailedBatchesAreRetriedIndividually) {
+    RecordingStorage storage;
+    auto record = storage.handler();
+    uint32_t attempts = 0;
+
+    ObjectPersister persister([&] (const ObjectPersister::ObjectBatch& batch) {
+        if (++attempts == 1) {
+            throw runtime_error("storage unavailable");
+        }
+        record(batch);
+    }, idle_period, 100);
+
+    persister.MarkDirty(CreateObject(1));
+    persister.MarkDirty(CreateObject(2));
+
+    persister.Flush();
+
+    auto batches = storage.batches();
+    BOOST_REQUIRE_EQUAL(2, batches.size());
+    BOOST_CHECK_EQUAL(1, batches[0].size());
+    BOOST_CHECK_EQUAL(1, batches[1].size());
+    BOOST_CHECK_EQUAL(0, persister.GetPendingCount());
+    BOOST_CHECK_EQUAL(2, persister.GetPersistedCount());
+}
+
+/// This test verifies that an object that fails to write on its own stays dirty and is
+/// written by the next flush.
+BOOST_AUTO_TEST_CASE(FailedObjectsAreRetriedOnTheNextFlush) {
+    RecordingStorage storage;
+    auto record = storage.handler();
+    uint32_t attempts = 0;
+
+    ObjectPersister persister([&] (const ObjectPersister::ObjectBatch& batch) {
+        if (++attempts == 1) {
+            throw runtime_error("storage unavailable");
+        }
+        record(batch);
+    }, idle_period, 100);
+
+    persister.MarkDirty(CreateObject(1));
+
+    persister.Flush();
+
+    BOOST_CHECK_EQUAL(1, persister.GetPendingCount());
+    BOOST_CHECK_EQUAL(0, persister.GetPersistedCount());
+
+    persister.Flush();
+
+    BOOST_CHECK_EQUAL(1, storage.batches().size());
+    BOOST_CHECK_EQUAL(0, persister.GetPendingCount());
+    BOOST_CHECK_EQUAL(1, persister.GetPersistedCount());
+}
+
+/// This test verifies that an object that can't be written is dropped without taking
+/// the rest of its batch with it.
+BOOST_AUTO_TEST_CASE(AnUnwritableObjectOnlyDropsItself) {
+    ObjectPersister persister([] (const ObjectPersister::ObjectBatch& batch) {
+        for (auto& object : batch) {
+            if (object->GetObjectId() == 2) {
+                throw runtime_error("bad object");
+            }
+        }
+    }, idle_period, 100);
+
+    for (uint64_t i = 0; i < 5; ++i) {
+        persister.MarkDirty(CreateObject(i));
+    }
+
+    persister.Stop();
+
+    BOOST_CHECK_EQUAL(4, persister.GetPersistedCount());
+    BOOST_CHECK_EQUAL(1, persister.GetDroppedCount());
+    BOOST_CHECK_EQUAL(0, persister.GetPendingCount());
+}
+
+/// This test verifies that an object is dropped once it has run out of attempts.
+BOOST_AUTO_TEST_CASE(ObjectsAreDroppedAfterMaxAttempts) {
+    uint32_t attempts = 0;
+
+    ObjectPersister persister([&attempts] (const ObjectPersister::ObjectBatch&) {
+        ++attempts;
+        throw runtime_error("storage unavailable");
+    }, idle_period, 100);
+
+    persister.MarkDirty(CreateObject(1));
+    persister.Stop();
+
+    BOOST_CHECK_EQUAL(max_attempts, attempts);
+    BOOST_CHECK_EQUAL(0, persister.GetPendingCount());
+    BOOST_CHECK_EQUAL(1, persister.GetDroppedCount());
+}
+
+/// Persists 2000 objects, each updated 5 times, against a store that takes 100us per
+/// write. Reports the time the game thread spends when writing each update in place
+/// and when marking the objects dirty, and the objects written per second.
+BOOST_AUTO_TEST_CASE(GameThreadLatencyWithWriteBehind) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint64_t object_count = 2000;
+    const uint32_t updates_per_object = 5;
+    const boost::posix_time::time_duration write_time = boost::posix_time::microseconds(100);
+
+    vector<shared_ptr<Object>> objects;
+    for (uint64_t i = 0; i < object_count; ++i) {
+        objects.push_back(CreateObject(i));
+    }
+
+    typedef boost::chrono::high_resolution_clock clock;
+
+    // every update written on the game thread
+    auto start = clock::now();
+
+    for (uint32_t update = 0; update < updates_per_object; ++update) {
+        for (size_t i = 0; i < objects.size(); ++i) {
+            boost::this_thread::sleep(write_time);
+        }
+    }
+
+    double in_place_seconds = boost::chrono::duration<double>(clock::now() - start).count();
+
+    // every update marked dirty and written behind
+    ObjectPersister persister([&write_time] (const ObjectPersister::ObjectBatch& batch) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            boost::this_thread::sleep(write_time);
+        }
+    }, idle_period, 250);
+
+    start = clock::now();
+
+    for (uint32_t update = 0; update < updates_per_object; ++update) {
+        for (auto& object : objects) {
+            persister.MarkDirty(object);
+        }
+    }
+
+    double marking_seconds = boost::chrono::duration<double>(clock::now() - start).count();
+
+    start = clock::now();
+    persister.Flush();
+    double flush_seconds = boost::chrono::duration<double>(clock::now() - start).count();
+
+    BOOST_CHECK_EQUAL(object_count, persister.GetPersistedCount());
+    BOOST_CHECK(marking_seconds < in_place_seconds);
+
+    const double update_count = static_cast<double>(object_count * updates_per_object);
+
+    BOOST_TEST_MESSAGE(object_count << " objects, " << updates_per_object << " updates each");
+    BOOST_TEST_MESSAGE("Written in place: " << in_place_seconds * 1000000.0 / update_count << "us per update on the game thread");
+    BOOST_TEST_MESSAGE("Write-behind:     " << marking_seconds * 1000000.0 / update_count << "us per update on the game thread, "
+        << static_cast<uint64_t>(object_count / flush_seconds) << " objects/s written");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
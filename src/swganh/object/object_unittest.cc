@@ -0,0 +1,350 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <memory>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <boost/chrono.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/benchmark.h"
+#include "anh/byte_buffer.h"
+#include "anh/event_dispatcher.h"
+#include "swganh/object/object.h"
+#include "swganh/object/object_controller.h"
+#include "swganh/object/object_message_builder.h"
+#include "swganh/object/creature/creature.h"
+#include "swganh/messages/scene_end_baselines.h"
+
+using namespace anh;
+using namespace std;
+using namespace swganh::messages;
+using namespace swganh::object;
+using namespace swganh::object::creature;
+
+namespace {
+
+const uint32_t cache_capacity = Object::deltas_cache_capacity;
+
+/// Records what it's sent instead of handing it to a remote client.
+class RecordingController : public ObjectController {
+public:
+    explicit RecordingController(shared_ptr<Object> object)
+        : ObjectController(object, nullptr)
+    {}
+
+    using ObjectController::Notify;
+
+    void Notify(const ByteBuffer& message) {
+        messages_.push_back(message);
+    }
+
+    void Notify(const shared_ptr<const ByteBuffer>& message) {
+        messages_.push_back(*message);
+    }
+
+    // the opcode of each message received, in order
+    vector<uint32_t> opcodes() const {
+        vector<uint32_t> opcodes;
+        for (auto& message : messages_) {
+            opcodes.push_back(message.peekAt<uint32_t>(sizeof(uint16_t)));
+        }
+        return opcodes;
+    }
+
+    vector<ByteBuffer>& messages() { return messages_; }
+
+private:
+    vector<ByteBuffer> messages_;
+};
+
+class ObjectTests {
+protected:
+    ObjectTests()
+        : event_dispatcher_(io_service_)
+    {
+        object_ = make_shared<Object>();
+        object_->SetEventDispatcher(&event_dispatcher_);
+        object_->SetObjectId(0xDEADBABE);
+
+        viewer_ = make_shared<Object>();
+        viewer_->SetEventDispatcher(&event_dispatcher_);
+        viewer_->SetObjectId(0xBABEFACE);
+    }
+
+    // sends an update to the object's volume the way the message builders do
+    void SendVolumeDelta(uint32_t volume) {
+        DeltasMessage message = ObjectMessageBuilder::CreateDeltasMessage(object_, Object::VIEW_3, 5);
+        message.data.write<uint32_t>(volume);
+
+        object_->AddDeltasUpdate(move(message));
+        object_->FlushDeltas();
+    }
+
+    // fills in a creature the way the creature factory does from a row of sp_GetCreature
+    void LoadCreature(const shared_ptr<Creature>& creature) {
+        creature->SetSceneId(1);
+        creature->SetPosition(glm::vec3(-137.0f, 0.0f, -4723.0f));
+        creature->SetOrientation(glm::quat(0.0f, 0.0f, 0.0f, 1.0f));
+        creature->SetComplexity(1.0f);
+        creature->SetStfName("species", "human");
+        creature->SetCustomName(L"Player Name");
+        creature->SetVolume(1);
+        creature->SetTemplate("object/creature/player/shared_human_male.iff");
+
+        creature->SetCustomization("customization");
+        creature->SetOptionsMask(0x80);
+        creature->SetMaxCondition(1000);
+
+        creature->SetBankCredits(2000);
+        creature->SetCashCredits(1000);
+        creature->SetPosture(UPRIGHT);
+        creature->SetScale(1.0f);
+        creature->SetRunSpeed(5.75f);
+        creature->SetWalkingSpeed(1.549f);
+        creature->SetMoodAnimation("neutral");
+
+        for (uint32_t stat = HEALTH; stat <= WILLPOWER; ++stat) {
+            creature->SetStatCurrent(static_cast<StatIndex>(stat), 1000);
+            creature->SetStatMax(static_cast<StatIndex>(stat), 1000);
+            creature->SetStatWound(static_cast<StatIndex>(stat), 0);
+            creature->SetStatBase(static_cast<StatIndex>(stat), 1000);
+        }
+    }
+
+    // runs the events posted by the object
+    void RunEvents() {
+        io_service_.poll();
+        io_service_.reset();
+    }
+
+    boost::asio::io_service io_service_;
+    EventDispatcher event_dispatcher_;
+    shared_ptr<Object> object_;
+    shared_ptr<Object> viewer_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ObjectTest, ObjectTests)
+
+/// This test verifies that only the most recent deltas are kept.
+BOOST_AUTO_TEST_CASE(DeltasCacheIsBounded) {
+    const uint32_t update_count = cache_capacity * 4;
+
+    for (uint32_t i = 0; i < update_count; ++i) {
+        SendVolumeDelta(i);
+    }
+    RunEvents();
+
+    BOOST_CHECK_EQUAL(update_count, object_->GetDeltasSequence());
+
+    DeltasCacheContainer deltas;
+    BOOST_REQUIRE(object_->GetDeltasSince(update_count - cache_capacity, &deltas));
+    BOOST_REQUIRE_EQUAL(cache_capacity, deltas.size());
+    BOOST_CHECK_EQUAL(update_count - cache_capacity, deltas.front().data.peekAt<uint32_t>(0));
+    BOOST_CHECK_EQUAL(update_count - 1, deltas.back().data.peekAt<uint32_t>(0));
+
+    BOOST_CHECK(!object_->GetDeltasSince(update_count - cache_capacity - 1, &deltas));
+}
+
+/// This test verifies that a new viewer is sent the cached baselines and the deltas sent since.
+BOOST_AUTO_TEST_CASE(NewViewersCatchUpFromCachedBaselines) {
+    auto controller = make_shared<RecordingController>(viewer_);
+
+    object_->AddBaselineToCache(ObjectMessageBuilder::BuildBaseline3(object_));
+    object_->AddBaselineToCache(ObjectMessageBuilder::BuildBaseline6(object_));
+
+    SendVolumeDelta(1);
+    SendVolumeDelta(2);
+    RunEvents();
+
+    BOOST_REQUIRE(object_->SendCachedBaselines(controller));
+
+    vector<uint32_t> expected;
+    expected.push_back(BaselinesMessage::Opcode());
+    expected.push_back(BaselinesMessage::Opcode());
+    expected.push_back(SceneEndBaselines::Opcode());
+    expected.push_back(DeltasMessage::Opcode());
+    expected.push_back(DeltasMessage::Opcode());
+
+    auto opcodes = controller->opcodes();
+    BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), opcodes.begin(), opcodes.end());
+}
+
+/// This test verifies that only the deltas sent after a sequence number are replayed, and
+/// that nothing is once the ones in between are gone.
+BOOST_AUTO_TEST_CASE(CachedDeltasAreFoundBySequence) {
+    SendVolumeDelta(1);
+    SendVolumeDelta(2);
+    SendVolumeDelta(3);
+    RunEvents();
+
+    DeltasCacheContainer deltas;
+    BOOST_REQUIRE(object_->GetDeltasSince(1, &deltas));
+    BOOST_REQUIRE_EQUAL(2, deltas.size());
+    BOOST_CHECK_EQUAL(2, deltas.front().data.peekAt<uint32_t>(0));
+    BOOST_CHECK_EQUAL(3, deltas.back().data.peekAt<uint32_t>(0));
+
+    BOOST_REQUIRE(object_->GetDeltasSince(3, &deltas));
+    BOOST_CHECK(deltas.empty());
+
+    object_->ClearDeltas();
+    SendVolumeDelta(4);
+    RunEvents();
+
+    BOOST_CHECK(!object_->GetDeltasSince(2, &deltas));
+    BOOST_REQUIRE(object_->GetDeltasSince(3, &deltas));
+    BOOST_REQUIRE_EQUAL(1, deltas.size());
+    BOOST_CHECK_EQUAL(4, deltas.front().data.peekAt<uint32_t>(0));
+}
+
+/// This test verifies that a fresh set of baselines is needed once the deltas cache has wrapped.
+BOOST_AUTO_TEST_CASE(NewViewersFarBehindNeedFreshBaselines) {
+    auto controller = make_shared<RecordingController>(viewer_);
+
+    object_->AddBaselineToCache(ObjectMessageBuilder::BuildBaseline3(object_));
+
+    for (uint32_t i = 0; i <= cache_capacity; ++i) {
+        SendVolumeDelta(i);
+    }
+    RunEvents();
+
+    BOOST_CHECK(!object_->SendCachedBaselines(controller));
+    BOOST_CHECK(controller->messages().empty());
+}
+
+/// This test verifies that the cached baselines are dropped once the object is no longer observed.
+BOOST_AUTO_TEST_CASE(CachedBaselinesAreDroppedWithTheLastObserver) {
+    auto observer = make_shared<RecordingController>(viewer_);
+    object_->Subscribe(observer);
+
+    object_->AddBaselineToCache(ObjectMessageBuilder::BuildBaseline3(object_));
+    object_->Unsubscribe(observer);
+
+    BOOST_CHECK(object_->GetBaselines().empty());
+    BOOST_CHECK(!object_->SendCachedBaselines(observer));
+}
+
+/// Sends a million delta updates through one observed object and reports the size of
+/// its message cache and the time taken to fetch the deltas a catching up viewer needs.
+BOOST_AUTO_TEST_CASE(MillionDeltaUpdatesStayBounded) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t update_count = 1000000;
+
+    auto observer = make_shared<RecordingController>(viewer_);
+    object_->Subscribe(observer);
+    object_->AddBaselineToCache(ObjectMessageBuilder::BuildBaseline3(object_));
+
+    size_t largest_cache_size = 0;
+
+    auto start = boost::chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < update_count; ++i) {
+        SendVolumeDelta(i);
+
+        if (i % 1000 == 0) {
+            observer->messages().clear();
+            RunEvents();
+            largest_cache_size = max(largest_cache_size, object_->GetMessageCacheSize());
+        }
+    }
+    RunEvents();
+
+    double update_seconds = boost::chrono::duration<double>(boost::chrono::high_resolution_clock::now() - start).count();
+
+    start = boost::chrono::high_resolution_clock::now();
+
+    DeltasCacheContainer deltas;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        object_->GetDeltasSince(update_count - cache_capacity, &deltas);
+    }
+
+    double lookup_seconds = boost::chrono::duration<double>(boost::chrono::high_resolution_clock::now() - start).count();
+
+    BOOST_CHECK_EQUAL(update_count, object_->GetDeltasSequence());
+    BOOST_CHECK_EQUAL(cache_capacity, deltas.size());
+    BOOST_CHECK_EQUAL(largest_cache_size, object_->GetMessageCacheSize());
+
+    BOOST_TEST_MESSAGE(update_count << " delta updates in " << update_seconds << "s, message cache "
+        << object_->GetMessageCacheSize() << " bytes per object");
+    BOOST_TEST_MESSAGE("Catching up a viewer from the cache: " << lookup_seconds * 1000.0 << "us per lookup");
+}
+
+/// This test verifies that filling in an object from storage posts nothing but the loaded event.
+BOOST_AUTO_TEST_CASE(HydratingPostsOnlyTheLoadedEvent) {
+    uint32_t loaded_count = 0, changed_count = 0;
+
+    event_dispatcher_.Subscribe("Object::Loaded", [&loaded_count] (const shared_ptr<EventInterface>&) { ++loaded_count; });
+    event_dispatcher_.Subscribe("Object::Position", [&changed_count] (const shared_ptr<EventInterface>&) { ++changed_count; });
+    event_dispatcher_.Subscribe("Creature::StatCurrent", [&changed_count] (const shared_ptr<EventInterface>&) { ++changed_count; });
+
+    auto creature = make_shared<Creature>();
+    creature->SetEventDispatcher(&event_dispatcher_);
+
+    creature->BeginHydration();
+    LoadCreature(creature);
+    creature->EndHydration();
+    RunEvents();
+
+    BOOST_CHECK_EQUAL(1, loaded_count);
+    BOOST_CHECK_EQUAL(0, changed_count);
+    BOOST_CHECK_EQUAL(1000, creature->GetStatCurrent(HEALTH));
+
+    // the stats loaded aren't left queued as changes for the first deltas message
+    DeltasMessage message;
+    creature->GetCurrentStats().Serialize(message);
+    BOOST_CHECK_EQUAL(0, message.data.read<uint32_t>());
+
+    creature->SetPosition(glm::vec3(0.0f, 0.0f, 0.0f));
+    RunEvents();
+
+    BOOST_CHECK_EQUAL(1, changed_count);
+}
+
+/// Fills in creatures through the setters the way the creature factory does, posting an
+/// event per setter and with hydration, and reports the creatures loaded per second.
+/// Only the work done in the server is measured, not the queries against the database.
+BOOST_AUTO_TEST_CASE(CreatureHydrationThroughput) {
+    if (anh::SkipBenchmark()) {
+        return;
+    }
+
+    const uint32_t creature_count = 10000;
+
+    auto run = [&] (bool hydrate) -> double {
+        auto start = boost::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < creature_count; ++i) {
+            auto creature = make_shared<Creature>();
+            creature->SetEventDispatcher(&event_dispatcher_);
+            creature->SetObjectId(i);
+
+            if (hydrate) {
+                creature->BeginHydration();
+            }
+
+            LoadCreature(creature);
+
+            if (hydrate) {
+                creature->EndHydration();
+            }
+
+            RunEvents();
+        }
+
+        double seconds = boost::chrono::duration<double>(boost::chrono::high_resolution_clock::now() - start).count();
+        return creature_count / seconds;
+    };
+
+    double with_events = run(false);
+    double hydrated = run(true);
+
+    BOOST_TEST_MESSAGE(creature_count << " creatures: " << static_cast<uint64_t>(with_events) << " loaded/s posting events, "
+        << static_cast<uint64_t>(hydrated) << " loaded/s hydrated");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -61,7 +61,7 @@ void Player::AddStatusFlag(StatusFlags flag, StatusIndex index)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         status_flags_[index] = FlagBitmask(status_flags_[index].bitmask | flag);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::StatusBitmask", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -71,7 +71,7 @@ void Player::RemoveStatusFlag(StatusFlags flag, StatusIndex index)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         status_flags_[index] = FlagBitmask(status_flags_[index].bitmask & ~flag);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::StatusBitmask", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -88,7 +88,7 @@ void Player::ClearStatusFlags()
                 value = FlagBitmask(0);
             });
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::StatusBitmask", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -104,7 +104,7 @@ void Player::AddProfileFlag(ProfileFlags flag, StatusIndex index)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         profile_flags_[index] = FlagBitmask(profile_flags_[index].bitmask | flag);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ProfileFlag", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -114,7 +114,7 @@ void Player::RemoveProfileFlag(ProfileFlags flag, StatusIndex index)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         profile_flags_[index] = FlagBitmask(profile_flags_[index].bitmask & ~flag);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ProfileFlag", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -131,7 +131,7 @@ void Player::ClearProfileFlags()
             value = FlagBitmask(0);
         });
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ProfileFlag", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -147,7 +147,7 @@ void Player::SetProfessionTag(string profession_tag)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         profession_tag_ = profession_tag;
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ProfessionTag", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -160,7 +160,7 @@ void Player::SetBornDate(uint32_t born_date)
 {
     born_date_ = born_date;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::BornDate", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -173,7 +173,7 @@ void Player::SetTotalPlayTime(uint32_t play_time)
 {
     total_playtime_ = play_time;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::TotalPlayTime", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -181,7 +181,7 @@ void Player::IncrementTotalPlayTime(uint32_t increment)
 {
     total_playtime_ += increment;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::TotalPlayTime", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -194,7 +194,7 @@ void Player::SetAdminTag(uint8_t tag)
 {
     admin_tag_ = tag;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::AdminTag", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -210,7 +210,7 @@ void Player::AddExperience(XpData experience)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         experience_.Update(experience.type, experience);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -220,7 +220,7 @@ void Player::DeductXp(XpData experience)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         experience_.Update(experience.type, experience);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -239,7 +239,7 @@ void Player::ClearXpType(string type)
         experience_.Remove(iter);
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -254,7 +254,7 @@ void Player::ResetXp(swganh::messages::containers::NetworkMap<std::string, XpDat
         }
         experience_.Reinstall();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -264,7 +264,7 @@ void Player::ClearAllXp()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         experience_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -280,7 +280,7 @@ void Player::AddWaypoint(PlayerWaypointSerializer waypoint)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         waypoints_.Add(waypoint.waypoint->GetObjectId(), waypoint);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Waypoint", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -303,7 +303,7 @@ void Player::RemoveWaypoint(uint64_t waypoint_id)
 
         waypoints_.Remove(find_iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Waypoint", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -313,7 +313,7 @@ void Player::ModifyWaypoint(PlayerWaypointSerializer waypoint)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         waypoints_.Update(waypoint.waypoint->GetObjectId(), waypoint);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Waypoint", static_pointer_cast<Player>(shared_from_this())));;
 }
 
@@ -323,7 +323,7 @@ void Player::ClearAllWaypoints()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         waypoints_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Waypoint", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -336,7 +336,7 @@ void Player::SetCurrentForcePower(uint32_t force_power)
 {
     current_force_power_ = force_power;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ForcePower", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -346,7 +346,7 @@ void Player::IncrementForcePower(int32_t force_power)
 
     current_force_power_ = (new_force_power > GetMaxForcePower()) ? GetMaxForcePower() : new_force_power;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ForcePower", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -359,7 +359,7 @@ void Player::SetMaxForcePower(uint32_t force_power)
 {
     max_force_power_ = force_power;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::MaxForcePower", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -372,7 +372,7 @@ void Player::AddCurrentForceSensitiveQuest(uint32_t quest_mask)
 {
     current_force_sensitive_quests_ = current_force_sensitive_quests_ | quest_mask;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -380,7 +380,7 @@ void Player::RemoveCurrentForceSensitiveQuest(uint32_t quest_mask)
 {
     current_force_sensitive_quests_ = current_force_sensitive_quests_ & ~quest_mask;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -388,7 +388,7 @@ void Player::ClearCurrentForceSensitiveQuests()
 {
     current_force_sensitive_quests_ = 0;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -401,7 +401,7 @@ void Player::AddCompletedForceSensitiveQuest(uint32_t quest_mask)
 {
     completed_force_sensitive_quests_ = completed_force_sensitive_quests_ | quest_mask;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CompletedForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -409,7 +409,7 @@ void Player::RemoveCompletedForceSensitiveQuest(uint32_t quest_mask)
 {
     completed_force_sensitive_quests_ = completed_force_sensitive_quests_ & ~quest_mask;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CompletedForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -417,7 +417,7 @@ void Player::ClearCompletedForceSensitiveQuests()
 {
     completed_force_sensitive_quests_ = 0;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CompletedForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -433,7 +433,7 @@ void Player::AddQuest(QuestJournalData quest)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         quest_journal_.Add(quest.quest_crc, quest);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::QuestJournal", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -457,7 +457,7 @@ void Player::RemoveQuest(QuestJournalData quest)
 
         quest_journal_.Remove(find_iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::QuestJournal", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -467,7 +467,7 @@ void Player::UpdateQuest(QuestJournalData quest)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         quest_journal_.Update(quest.quest_crc, quest);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::QuestJournal", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -477,7 +477,7 @@ void Player::ClearAllQuests()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         quest_journal_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::QuestJournal", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -518,7 +518,7 @@ void Player::SetExperimentationFlag(uint32_t experimentation_flag)
 {
     experimentation_flag_ = experimentation_flag;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ExperimentationFlag", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -531,7 +531,7 @@ void Player::SetCraftingStage(uint32_t crafting_stage)
 {
     crafting_stage_ = crafting_stage;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CraftingStage", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -544,7 +544,7 @@ void Player::SetNearestCraftingStation(uint64_t crafting_station_id)
 {
     nearest_crafting_station_ = crafting_station_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::NearestCraftingStation", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -560,7 +560,7 @@ void Player::AddDraftSchematic(DraftSchematicData schematic)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         draft_schematics_.Add(schematic);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::DraftSchematic", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -576,7 +576,7 @@ void Player::RemoveDraftSchematic(uint32_t schematic_id)
             
         draft_schematics_.Remove(iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::DraftSchematic", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -586,7 +586,7 @@ void Player::ClearDraftSchematics()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         draft_schematics_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::DraftSchematic", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -599,7 +599,7 @@ void Player::AddExperimentationPoints(uint32_t points)
 {
     experimentation_points_ += points;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ExperimentationPoints", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -607,7 +607,7 @@ void Player::RemoveExperimentationPoints(uint32_t points)
 {
     experimentation_points_ -= points;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ExperimentationPoints", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -615,7 +615,7 @@ void Player::ResetExperimentationPoints(uint32_t points)
 {
     experimentation_points_ = points;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::ExperimentationPoints", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -628,7 +628,7 @@ void Player::ResetAccomplishmentCounter(uint32_t counter)
 {
     accomplishment_counter_ = counter;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::AccomplishmentCounter", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -636,7 +636,7 @@ void Player::IncrementAccomplishmentCounter()
 {
     ++accomplishment_counter_;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::AccomplishmentCounter", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -664,7 +664,7 @@ void Player::AddFriend(string friend_name, uint64_t id)
         friends_.Add(Name(friend_name, id));
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Friend", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -685,7 +685,7 @@ void Player::RemoveFriend(string friend_name)
         friends_.ClearDeltas();
         friends_.Remove(iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<NameEvent>
+    PostEvent(make_shared<NameEvent>
         ("Player::RemoveFriend", static_pointer_cast<Player>(shared_from_this()), friend_id));
 }
 
@@ -695,7 +695,7 @@ void Player::ClearFriends()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         friends_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Friend", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -724,7 +724,7 @@ void Player::IgnorePlayer(string player_name, uint64_t player_id)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         ignored_players_.Add(Name(player_name, player_id));
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::IgnorePlayer", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -744,7 +744,7 @@ void Player::StopIgnoringPlayer(string player_name)
         remove_id = iter->id;
         ignored_players_.Remove(iter); 
     } 
-    GetEventDispatcher()->Dispatch(make_shared<NameEvent>("Player::RemoveIgnoredPlayer", static_pointer_cast<Player>(shared_from_this()), remove_id));
+    PostEvent(make_shared<NameEvent>("Player::RemoveIgnoredPlayer", static_pointer_cast<Player>(shared_from_this()), remove_id));
  
 }
 
@@ -755,7 +755,7 @@ void Player::ClearIgnored()
         ignored_players_.Clear();
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::IgnorePlayer", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -768,7 +768,7 @@ void Player::SetLanguage(uint32_t language_id)
 {
     language_ = language_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::Language", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -783,7 +783,7 @@ void Player::IncreaseCurrentStomach(uint32_t stomach)
 
     current_stomach_ = (new_stomach > GetMaxStomach()) ? GetMaxStomach() : new_stomach;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CurrentStomach", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -791,7 +791,7 @@ void Player::DecreaseCurrentStomach(uint32_t stomach)
 {
     current_stomach_ -= stomach;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CurrentStomach", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -799,7 +799,7 @@ void Player::ResetCurrentStomach(uint32_t stomach)
 {
     current_stomach_ = stomach;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CurrentStomach", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -812,7 +812,7 @@ void Player::ResetMaxStomach(uint32_t stomach)
 {
     max_stomach_ = stomach;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::MaxStomach", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -827,7 +827,7 @@ void Player::IncreaseCurrentDrink(uint32_t drink)
 
     current_drink_ = (new_drink > GetMaxDrink()) ? GetMaxDrink() : new_drink;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CurrentDrink", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -835,7 +835,7 @@ void Player::DecreaseCurrentDrink(uint32_t drink)
 {
     current_drink_ -= drink;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CurrentDrink", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -843,7 +843,7 @@ void Player::ResetCurrentDrink(uint32_t drink)
 {
     current_drink_ = drink;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::CurrentDrink", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -856,7 +856,7 @@ void Player::ResetMaxDrink(uint32_t drink)
 {
     max_drink_ = drink;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::MaxDrink", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -869,7 +869,7 @@ void Player::SetJediState(uint32_t jedi_state)
 {
     jedi_state_ = jedi_state;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
+    PostEvent(make_shared<PlayerEvent>
         ("Player::JediState", static_pointer_cast<Player>(shared_from_this())));
 }
 
@@ -922,6 +922,17 @@ bool PlayerWaypointSerializer::operator==(const PlayerWaypointSerializer& other)
 
 void Player::CreateBaselines(shared_ptr<ObjectController> controller)
 {
-    GetEventDispatcher()->Dispatch(make_shared<ControllerEvent>
+    PostEvent(make_shared<ControllerEvent>
         ("Player::Baselines", shared_from_this(), controller));
+}
+
+void Player::OnHydrated()
+{
+    boost::lock_guard<boost::mutex> lock(player_mutex_);
+    experience_.ClearDeltas();
+    waypoints_.ClearDeltas();
+    quest_journal_.ClearDeltas();
+    draft_schematics_.ClearDeltas();
+    friends_.ClearDeltas();
+    ignored_players_.ClearDeltas();
 }
\ No newline at end of file
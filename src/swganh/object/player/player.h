@@ -870,6 +870,9 @@ public:
 
     typedef anh::ValueEvent<std::shared_ptr<Player>> PlayerEvent;
 
+protected:
+    virtual void OnHydrated();
+
 private:
     void SetDeltaBitmask_(uint32_t bitmask, uint16_t update_type, swganh::object::Object::ViewType view_type);
 
@@ -70,29 +70,38 @@ void PlayerFactory::PersistObject(const shared_ptr<Object>& object)
 {
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
-        auto statement = shared_ptr<sql::PreparedStatement>
-			(conn->prepareStatement("CALL sp_PersistPlayer(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);"));
-        ObjectFactory::PersistObject(object, statement);
-
-		auto player = static_pointer_cast<Player>(object);
-		statement->setString(17, player->GetProfessionTag());
-		statement->setUInt64(18, player->GetTotalPlayTime());
-		statement->setUInt(19, player->GetAdminTag());
-		statement->setUInt(20, player->GetMaxForcePower());
-		statement->setUInt(21, player->GetExperimentationFlag());
-		statement->setUInt(22, player->GetCraftingStage());
-		statement->setUInt64(23, player->GetNearestCraftingStation());
-		statement->setUInt(24, player->GetExperimentationPoints());
-		statement->setUInt(25, player->GetAccomplishmentCounter());
-		statement->setUInt(26, player->GetLanguage());
-		statement->setUInt(27, player->GetCurrentStomach());
-		statement->setUInt(28, player->GetMaxStomach());
-		statement->setUInt(29, player->GetCurrentDrink());
-		statement->setUInt(30, player->GetMaxDrink());
-		statement->setUInt(31, player->GetJediState());
-
-        statement->executeUpdate();
+        auto player = static_pointer_cast<Player>(object);
+
+        {
+            // outside of a batch the lists below each take a connection of their own from the
+            // pool, so this one is released first; within a batch they all share its connection
+            auto conn = GetPersistConnection();
+            if (!conn)
+            {
+                return;
+            }
+            auto statement = db_manager_->getPreparedStatement(conn,
+                "CALL sp_PersistPlayer(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);");
+            ObjectFactory::PersistObject(object, statement);
+
+            statement->setString(17, player->GetProfessionTag());
+            statement->setUInt64(18, player->GetTotalPlayTime());
+            statement->setUInt(19, player->GetAdminTag());
+            statement->setUInt(20, player->GetMaxForcePower());
+            statement->setUInt(21, player->GetExperimentationFlag());
+            statement->setUInt(22, player->GetCraftingStage());
+            statement->setUInt64(23, player->GetNearestCraftingStation());
+            statement->setUInt(24, player->GetExperimentationPoints());
+            statement->setUInt(25, player->GetAccomplishmentCounter());
+            statement->setUInt(26, player->GetLanguage());
+            statement->setUInt(27, player->GetCurrentStomach());
+            statement->setUInt(28, player->GetMaxStomach());
+            statement->setUInt(29, player->GetCurrentDrink());
+            statement->setUInt(30, player->GetMaxDrink());
+            statement->setUInt(31, player->GetJediState());
+
+            statement->executeUpdate();
+        }
 
         PersistFriends_(player);
         PersistIgnoredList_(player);
@@ -104,6 +113,7 @@ void PlayerFactory::PersistObject(const shared_ptr<Object>& object)
     }
         catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -115,6 +125,10 @@ void PlayerFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         auto statement = conn->prepareStatement("CALL sp_DeletePlayer(?);");
         statement->setUInt64(1, object->GetObjectId());
         statement->execute();
@@ -130,9 +144,17 @@ shared_ptr<Object> PlayerFactory::CreateObjectFromStorage(uint64_t object_id)
 {
     auto player = make_shared<Player>();
     player->SetObjectId(object_id);
+    player->SetEventDispatcher(event_dispatcher_);
+    player->BeginHydration();
+
     try {
 
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            player->EndHydration();
+            return player;
+        }
         auto statement = shared_ptr<sql::Statement>(conn->createStatement());
         
         stringstream ss;
@@ -182,6 +204,8 @@ shared_ptr<Object> PlayerFactory::CreateObjectFromStorage(uint64_t object_id)
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
+    player->EndHydration();
+
     return player;
 }
 
@@ -266,11 +290,15 @@ void PlayerFactory::PersistXP_(const shared_ptr<Player>& player)
 {
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
         auto xp = player->GetXp();
         for(auto& xpData : xp)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateExperience(?,?);");
+            auto statement = db_manager_->getPreparedStatement(conn, "CALL sp_UpdateExperience(?,?);");
             statement->setString(1,xpData.first);
             statement->setUInt(2,xpData.second.value);
             auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
@@ -278,6 +306,7 @@ void PlayerFactory::PersistXP_(const shared_ptr<Player>& player)
     }
         catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -331,11 +360,15 @@ void PlayerFactory::PersistDraftSchematics_(const shared_ptr<Player>& player)
 {
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
         auto draft_schematics = player->GetDraftSchematics();
         for(auto& schematic : draft_schematics)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateDraftSchematic(?,?,?);");
+            auto statement = db_manager_->getPreparedStatement(conn, "CALL sp_UpdateDraftSchematic(?,?,?);");
             statement->setUInt64(1, player->GetObjectId());
             statement->setUInt(2,schematic.second.schematic_id);
             statement->setUInt(3, schematic.second.schematic_crc);
@@ -344,6 +377,7 @@ void PlayerFactory::PersistDraftSchematics_(const shared_ptr<Player>& player)
     }
         catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -377,12 +411,16 @@ void PlayerFactory::PersistQuestJournal_(const shared_ptr<Player>& player)
 {
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
         auto quests = player->GetQuests();
         
         for(auto& quest : quests)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateQuestJournal(?,?,?,?,?,?);");
+            auto statement = db_manager_->getPreparedStatement(conn, "CALL sp_UpdateQuestJournal(?,?,?,?,?,?);");
             statement->setUInt64(1, player->GetObjectId());
             statement->setUInt64(2, quest.second.owner_id);
             statement->setUInt(3, quest.second.quest_crc);
@@ -395,6 +433,7 @@ void PlayerFactory::PersistQuestJournal_(const shared_ptr<Player>& player)
     }
         catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -429,8 +468,12 @@ void PlayerFactory::PersistForceSensitiveQuests_(const shared_ptr<Player>& playe
 {
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_UpdateFSQuests(?,?,?);");
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
+        auto statement = db_manager_->getPreparedStatement(conn, "CALL sp_UpdateFSQuests(?,?,?);");
         statement->setUInt64(1, player->GetObjectId());
         statement->setUInt(2, player->GetCurrentForceSensitiveQuests());
         statement->setUInt(3, player->GetCompletedForceSensitiveQuests());
@@ -439,6 +482,7 @@ void PlayerFactory::PersistForceSensitiveQuests_(const shared_ptr<Player>& playe
     }
         catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -448,6 +492,10 @@ void PlayerFactory::RemoveFriend_(const std::shared_ptr<Player>& player, uint64_
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         
         auto statement = conn->prepareStatement("CALL sp_RemoveFriend(?,?);");
         statement->setUInt64(1, player->GetObjectId());
@@ -465,12 +513,16 @@ void PlayerFactory::PersistFriends_(const shared_ptr<Player>& player)
 {
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
         auto friends = player->GetFriends();
         
         for(auto& friend_name : friends)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateFriends(?,?);");
+            auto statement = db_manager_->getPreparedStatement(conn, "CALL sp_UpdateFriends(?,?);");
             statement->setUInt64(1, player->GetObjectId());
             statement->setUInt64(2, friend_name.id);
             auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
@@ -478,6 +530,7 @@ void PlayerFactory::PersistFriends_(const shared_ptr<Player>& player)
     }
         catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -524,12 +577,16 @@ void PlayerFactory::PersistIgnoredList_(const shared_ptr<Player>& player)
 {
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
         auto ignored_players = player->GetIgnoredPlayers();
         
         for(auto& player_name : ignored_players)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateIgnoreList(?,?);");
+            auto statement = db_manager_->getPreparedStatement(conn, "CALL sp_UpdateIgnoreList(?,?);");
             statement->setUInt64(1, player->GetObjectId());
             statement->setUInt64(2, player_name.id);
             auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
@@ -537,6 +594,7 @@ void PlayerFactory::PersistIgnoredList_(const shared_ptr<Player>& player)
     }
         catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -546,6 +604,10 @@ void PlayerFactory::RemoveFromIgnoredList_(const shared_ptr<Player>& player, uin
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         
         auto statement = conn->prepareStatement("CALL sp_RemoveIgnoredPlayer(?,?);");
         statement->setUInt64(1, player->GetObjectId());
@@ -177,6 +177,12 @@ void PlayerMessageBuilder::RegisterEventHandlers()
 
 void PlayerMessageBuilder::SendBaselines(const shared_ptr<Player>& player, const shared_ptr<ObjectController>& controller)
 {
+    if (player->SendCachedBaselines(controller))
+    {
+        return;
+    }
+
+    player->ClearBaselines();
     player->AddBaselineToCache(BuildBaseline3(player));
     player->AddBaselineToCache(BuildBaseline6(player));
     player->AddBaselineToCache(BuildBaseline8(player));
@@ -49,7 +49,7 @@ void Tangible::AddCustomization(const string& customization)
         boost::lock_guard<boost::mutex> lock(tangible_mutex_);
         customization_.append(customization);
     }
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::Customization",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -65,7 +65,7 @@ void Tangible::SetCustomization(const string& customization)
         boost::lock_guard<boost::mutex> lock(tangible_mutex_);
         customization_ = customization;
     }
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::Customization",static_pointer_cast<Tangible>(shared_from_this())));
 }
 void Tangible::RemoveComponentCustomization(uint32_t customization)
@@ -84,7 +84,7 @@ void Tangible::RemoveComponentCustomization(uint32_t customization)
         component_customization_list_.Remove(iter);
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::ComponentCustomization",static_pointer_cast<Tangible>(shared_from_this())));
 }
 void Tangible::AddComponentCustomization(uint32_t customization)
@@ -94,7 +94,7 @@ void Tangible::AddComponentCustomization(uint32_t customization)
         component_customization_list_.Add(ComponentCustomization(customization));
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::ComponentCustomization",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -110,7 +110,7 @@ void Tangible::ClearComponentCustomization()
         boost::lock_guard<boost::mutex> lock(tangible_mutex_);
         component_customization_list_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::ComponentCustomization",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -118,14 +118,14 @@ void Tangible::SetOptionsMask(uint32_t options_mask)
 {
     options_bitmask_ = options_mask;
 
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::OptionsMask",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
 void Tangible::ToggleOption(uint32_t option)
 {
 	options_bitmask_ ^= option;
-	GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+	PostEvent(make_shared<TangibleEvent>
         ("Tangible::OptionsMask",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -137,7 +137,7 @@ uint32_t Tangible::GetOptionsMask(void)
 void Tangible::SetIncapTimer(uint32_t incap_timer)
 {
     incap_timer_ = incap_timer;
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::IncapTimer",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -149,7 +149,7 @@ uint32_t Tangible::GetIncapTimer(void)
 void Tangible::SetConditionDamage(uint32_t damage)
 {
     condition_damage_ = damage;
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::ConditionDamage",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -161,7 +161,7 @@ uint32_t Tangible::GetCondition(void)
 void Tangible::SetMaxCondition(uint32_t max_condition)
 {
     max_condition_ = max_condition;
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::MaxCondition",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -173,7 +173,7 @@ uint32_t Tangible::GetMaxCondition(void)
 void Tangible::SetStatic(bool is_static)
 {
     is_static_ = is_static;
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::Static",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -201,7 +201,7 @@ void Tangible::AddDefender(uint64_t defender)
         defender_list_.Add(Defender(defender));
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::Defenders",static_pointer_cast<Tangible>(shared_from_this())));
 }
 void Tangible::RemoveDefender(uint64_t defender)
@@ -220,7 +220,7 @@ void Tangible::RemoveDefender(uint64_t defender)
         defender_list_.Remove(iter);
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::Defenders",static_pointer_cast<Tangible>(shared_from_this())));
 }
 void Tangible::ResetDefenders(std::vector<uint64_t> defenders)
@@ -233,7 +233,7 @@ void Tangible::ResetDefenders(std::vector<uint64_t> defenders)
         });
         defender_list_.Reinstall();
     }
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::Defenders",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -249,7 +249,7 @@ void Tangible::ClearDefenders()
         boost::lock_guard<boost::mutex> lock(tangible_mutex_);
         defender_list_.Clear();
     }   
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
+    PostEvent(make_shared<TangibleEvent>
         ("Tangible::Defenders",static_pointer_cast<Tangible>(shared_from_this())));
 }
 
@@ -267,6 +267,13 @@ bool Tangible::IsAutoAttacking()
 }
 void Tangible::CreateBaselines(std::shared_ptr<ObjectController> controller)
 {
-    GetEventDispatcher()->Dispatch(make_shared<ControllerEvent>
+    PostEvent(make_shared<ControllerEvent>
         ("Tangible::Baselines",shared_from_this(), controller));
+}
+
+void Tangible::OnHydrated()
+{
+    boost::lock_guard<boost::mutex> lock(tangible_mutex_);
+    component_customization_list_.ClearDeltas();
+    defender_list_.ClearDeltas();
 }
\ No newline at end of file
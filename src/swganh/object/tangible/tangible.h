@@ -146,6 +146,8 @@ public:
     bool IsAutoAttacking();
 
     virtual void CreateBaselines(std::shared_ptr<ObjectController> controller);
+protected:
+    virtual void OnHydrated();
 private:
     typedef anh::ValueEvent<std::shared_ptr<Tangible>> TangibleEvent;
     
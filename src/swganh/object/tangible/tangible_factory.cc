@@ -33,6 +33,10 @@ void TangibleFactory::LoadTemplates()
     try {
 
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         auto statement = conn->prepareStatement("CALL sp_GetTangibleTemplates();");
         auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
 
@@ -67,9 +71,13 @@ void TangibleFactory::PersistObject(const shared_ptr<Object>& object)
 {
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
-        auto statement = shared_ptr<sql::PreparedStatement>
-            (conn->prepareStatement("CALL sp_PersistTangible(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);"));
+        auto conn = GetPersistConnection();
+        if (!conn)
+        {
+            return;
+        }
+        auto statement = db_manager_->getPreparedStatement(conn,
+            "CALL sp_PersistTangible(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);");
         ObjectFactory::PersistObject(object, statement);
         // cast to tangible
         auto tangible = static_pointer_cast<Tangible>(object);
@@ -83,6 +91,7 @@ void TangibleFactory::PersistObject(const shared_ptr<Object>& object)
     }
     catch(sql::SQLException &e)
     {
+        RethrowIfPersistingBatch();
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
@@ -93,6 +102,10 @@ void TangibleFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         auto statement = conn->prepareStatement("CALL sp_DeleteTangible(?);");
         statement->setUInt64(1, object->GetObjectId());
         statement->execute();
@@ -132,8 +145,16 @@ shared_ptr<Object> TangibleFactory::CreateObjectFromStorage(uint64_t object_id)
 {
     auto tangible = make_shared<Tangible>();
     tangible->SetObjectId(object_id);
+    tangible->SetEventDispatcher(event_dispatcher_);
+    tangible->BeginHydration();
+
     try {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            tangible->EndHydration();
+            return tangible;
+        }
         auto statement = shared_ptr<sql::Statement>(conn->createStatement());
         
         stringstream ss;
@@ -147,6 +168,8 @@ shared_ptr<Object> TangibleFactory::CreateObjectFromStorage(uint64_t object_id)
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
+    tangible->EndHydration();
+
     return tangible;
 }
 
@@ -73,6 +73,12 @@ void TangibleMessageBuilder::RegisterEventHandlers()
 }
 void TangibleMessageBuilder::SendBaselines(const shared_ptr<Tangible>& tangible, const shared_ptr<ObjectController>& controller)
 {
+    if (tangible->SendCachedBaselines(controller))
+    {
+        return;
+    }
+
+    tangible->ClearBaselines();
     tangible->AddBaselineToCache(BuildBaseline3(tangible));
     tangible->AddBaselineToCache(BuildBaseline6(tangible));
     tangible->AddBaselineToCache(BuildBaseline7(tangible));
@@ -38,7 +38,7 @@ void Waypoint::SetUses(uint32_t uses)
 {
     uses_ = uses;
 
-    GetEventDispatcher()->Dispatch(make_shared<WaypointEvent>
+    PostEvent(make_shared<WaypointEvent>
         ("Waypoint::Uses", static_pointer_cast<Waypoint>(shared_from_this())));
 }
 glm::vec3 Waypoint::GetCoordinates()
@@ -51,21 +51,21 @@ void Waypoint::SetCoordinates(const glm::vec3& coords)
     boost::lock_guard<boost::mutex> lock(waypoint_mutex_);
 	coordinates_ = move(coords);
     
-	GetEventDispatcher()->Dispatch(make_shared<WaypointEvent>
+	PostEvent(make_shared<WaypointEvent>
         ("Waypoint::Coordinates", static_pointer_cast<Waypoint>(shared_from_this())));
 }
 void Waypoint::Activate()
 {
     activated_flag_ = ACTIVATED;
 
-    GetEventDispatcher()->Dispatch(make_shared<WaypointEvent>
+    PostEvent(make_shared<WaypointEvent>
         ("Waypoint::Activated", static_pointer_cast<Waypoint>(shared_from_this())));
 }
 void Waypoint::DeActivate()
 {
     activated_flag_ = DEACTIVATED;
 
-    GetEventDispatcher()->Dispatch(make_shared<WaypointEvent>
+    PostEvent(make_shared<WaypointEvent>
         ("Waypoint::Activated", static_pointer_cast<Waypoint>(shared_from_this())));
 }
 
@@ -86,7 +86,7 @@ void Waypoint::SetPlanet(const string& planet_name)
         planet_name_ = planet_name;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<WaypointEvent>
+    PostEvent(make_shared<WaypointEvent>
         ("Waypoint::Planet", static_pointer_cast<Waypoint>(shared_from_this())));
 }
 
@@ -120,7 +120,7 @@ void Waypoint::SetColor(const string& color)
         color_ = color;
     }
 
-	GetEventDispatcher()->Dispatch(make_shared<WaypointEvent>
+	PostEvent(make_shared<WaypointEvent>
         ("Waypoint::Color", static_pointer_cast<Waypoint>(shared_from_this())));
 }
 
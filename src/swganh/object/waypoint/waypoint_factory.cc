@@ -77,6 +77,10 @@ void WaypointFactory::LoadTemplates()
 {
     try {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         auto statement = conn->prepareStatement("CALL sp_GetWaypointTemplates();");
         auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
 
@@ -125,6 +129,10 @@ void WaypointFactory::PersistObject(const shared_ptr<Object>& object)
         {
             auto waypoint = static_pointer_cast<Waypoint>(object);
             auto conn = db_manager_->getConnection("galaxy");
+            if (!conn)
+            {
+                return;
+            }
             auto statement = conn->prepareStatement("CALL sp_PersistWaypoint(?,?,?,?,?,?,?,?,?,?,?,?,?);");
             statement->setDouble(1,waypoint->GetComplexity());
             statement->setString(2, waypoint->GetStfNameFile());
@@ -158,6 +166,10 @@ void WaypointFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return;
+        }
         auto statement = conn->prepareStatement("CALL sp_DeleteWaypoint(?);");
         statement->setUInt64(1, object->GetObjectId());
         statement->execute();
@@ -175,6 +187,10 @@ shared_ptr<Object> WaypointFactory::CreateObjectFromStorage(uint64_t object_id)
     waypoint->SetObjectId(object_id);
     try{
         auto conn = db_manager_->getConnection("galaxy");
+        if (!conn)
+        {
+            return waypoint;
+        }
         auto statement = shared_ptr<sql::Statement>(conn->createStatement());
         stringstream ss;
         ss << "CALL sp_GetWaypoint(" << object_id << ");";
@@ -0,0 +1,38 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "utilities.h"
+
+#include <atomic>
+
+namespace {
+
+    std::atomic<uint64_t> gil_acquisitions(0);
+    std::atomic<uint64_t> gil_wait_microseconds(0);
+    std::atomic<uint64_t> gil_hold_microseconds(0);
+    std::atomic<uint64_t> gil_max_hold_microseconds(0);
+
+}  // namespace
+
+swganh::scripting::GilTimings swganh::scripting::GetGilTimings()
+{
+    GilTimings timings;
+    timings.acquisitions = gil_acquisitions;
+    timings.wait_microseconds = gil_wait_microseconds;
+    timings.hold_microseconds = gil_hold_microseconds;
+    timings.max_hold_microseconds = gil_max_hold_microseconds;
+
+    return timings;
+}
+
+void swganh::scripting::RecordGilHold(uint64_t wait_microseconds, uint64_t hold_microseconds)
+{
+    ++gil_acquisitions;
+    gil_wait_microseconds += wait_microseconds;
+    gil_hold_microseconds += hold_microseconds;
+
+    uint64_t max_hold = gil_max_hold_microseconds;
+    while (hold_microseconds > max_hold &&
+        !gil_max_hold_microseconds.compare_exchange_weak(max_hold, hold_microseconds))
+    {}
+}
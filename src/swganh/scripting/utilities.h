@@ -4,10 +4,36 @@
 #ifndef SWGANH_SCRIPTING_UTILITIES_H_
 #define SWGANH_SCRIPTING_UTILITIES_H_
 
+#include <cstdint>
+
+#include <boost/chrono/system_clocks.hpp>
 #include <boost/python/detail/wrap_python.hpp>
 
 namespace swganh {
 namespace scripting {
+
+    /**
+     * Totals of the time spent waiting for and holding the GIL through ScopedGilLock.
+     *
+     * Nested locks on a thread that already holds the GIL are counted again.
+     */
+    struct GilTimings
+    {
+        uint64_t acquisitions;
+        uint64_t wait_microseconds;
+        uint64_t hold_microseconds;
+        uint64_t max_hold_microseconds;
+    };
+
+    /**
+     * @return The GIL timings since the server started.
+     */
+    GilTimings GetGilTimings();
+
+    /**
+     * Adds a single hold of the GIL to the timings.
+     */
+    void RecordGilHold(uint64_t wait_microseconds, uint64_t hold_microseconds);
     
     /**
      * User defined mutex type designed to hold an instance of the GIL
@@ -32,22 +58,34 @@ namespace scripting {
 
     /**
      * A simple lock that manages its own internal GilMutex instance.
+     *
+     * The time taken to acquire the GIL and the time it's held are added to the
+     * GIL timings.
      */
     class ScopedGilLock
     {
     public:
         ScopedGilLock()
+            : requested_(boost::chrono::steady_clock::now())
         {
             mutex_.lock();
+            acquired_ = boost::chrono::steady_clock::now();
         }
     
         ~ScopedGilLock()
         {
+            auto released = boost::chrono::steady_clock::now();
             mutex_.unlock();
+
+            RecordGilHold(
+                boost::chrono::duration_cast<boost::chrono::microseconds>(acquired_ - requested_).count(),
+                boost::chrono::duration_cast<boost::chrono::microseconds>(released - acquired_).count());
         }
     
     private:
         GilMutex mutex_;
+        boost::chrono::steady_clock::time_point requested_;
+        boost::chrono::steady_clock::time_point acquired_;
     };
 
     class ScopedGilRelease
@@ -34,7 +34,7 @@ namespace object {
 
 namespace swganh {
 namespace simulation {
-	class SpatialProviderInterface;
+	class SceneManagerInterface;
 
     class MovementManagerInterface
     {
@@ -52,7 +52,7 @@ namespace simulation {
         
         virtual void SendDataTransformWithParentMessage(const std::shared_ptr<swganh::object::Object>& object, uint32_t unknown = 0x0000000B) = 0;
         virtual void SendUpdateDataTransformWithParentMessage(const std::shared_ptr<swganh::object::Object>& object) = 0;
-		virtual void SetSpatialProvider(swganh::simulation::SpatialProviderInterface* spatial_provider) = 0;
+		virtual void SetSceneManager(swganh::simulation::SceneManagerInterface* scene_manager) = 0;
     };
 
 }}  // namespace swganh::simulation
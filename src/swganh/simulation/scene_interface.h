@@ -5,6 +5,7 @@
 #define SWGANH_SIMULATION_SCENE_H_
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -20,6 +21,8 @@ namespace object {
 namespace swganh {
 namespace simulation {
 
+    class SpatialProviderInterface;
+
     class SceneInterface : boost::noncopyable
     {
 	public:
@@ -32,6 +35,32 @@ namespace simulation {
         virtual void AddObject(const std::shared_ptr<swganh::object::Object>& object) = 0;
 
         virtual void RemoveObject(const std::shared_ptr<swganh::object::Object>& object) = 0;
+
+        /**
+         * Refreshes what the given object can see after it has moved.
+         */
+        virtual void UpdateObject(const std::shared_ptr<swganh::object::Object>& object) = 0;
+
+        /**
+         * Queues an object with pending delta updates to be flushed on the next tick.
+         */
+        virtual void QueueDeltas(const std::shared_ptr<swganh::object::Object>& object) = 0;
+
+        /**
+         * Sends the delta updates made to the scene's objects since the last tick.
+         */
+        virtual void FlushDeltas() = 0;
+
+        /**
+         * @return The spatial index of the objects in this scene.
+         */
+        virtual SpatialProviderInterface* GetSpatialProvider() const = 0;
+
+        /**
+         * Runs simulation work for the scene on its strand. Work posted to one scene
+         * runs in order and never concurrently, separate scenes run in parallel.
+         */
+        virtual void Post(std::function<void ()> task) = 0;
     };
 
 }}  // namespace swganh::simulation
@@ -29,6 +29,11 @@ namespace simulation {
 
         virtual void StartScene(const std::string& scene_label) = 0;
         virtual void StopScene(const std::string& scene_label) = 0;
+
+        /**
+         * Sends the delta updates made to objects in every running scene since the last tick.
+         */
+        virtual void FlushDeltas() = 0;
     };
 
 }}  // namespace swganh::simulation